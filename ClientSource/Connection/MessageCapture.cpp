@@ -0,0 +1,312 @@
+/*  Message Capture
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "Common/Compiler.h"
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PrettyPrint.h"
+#include "ClientSource/Libraries/MessageConverter.h"
+#include "BotBaseMessage.h"
+#include "MessageCapture.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+const char MAGIC[8] = {'P', 'A', '-', 'M', 'C', 'A', 'P', '\0'};
+const size_t FILE_HEADER_SIZE = 24;
+const size_t RECORD_HEADER_SIZE = 11;
+
+void put_u32(char* ptr, uint32_t x){
+    for (size_t c = 0; c < 4; c++){
+        ptr[c] = (char)(x >> (8 * c));
+    }
+}
+void put_u64(char* ptr, uint64_t x){
+    for (size_t c = 0; c < 8; c++){
+        ptr[c] = (char)(x >> (8 * c));
+    }
+}
+uint32_t get_u32(const char* ptr){
+    uint32_t x = 0;
+    for (size_t c = 0; c < 4; c++){
+        x |= (uint32_t)(uint8_t)ptr[c] << (8 * c);
+    }
+    return x;
+}
+uint64_t get_u64(const char* ptr){
+    uint64_t x = 0;
+    for (size_t c = 0; c < 8; c++){
+        x |= (uint64_t)(uint8_t)ptr[c] << (8 * c);
+    }
+    return x;
+}
+
+}
+
+
+
+MessageCapture::MessageCapture(std::string filename)
+    : m_filename(std::move(filename))
+    , m_file(fopen(m_filename.c_str(), "wb"))
+    , m_start(std::chrono::steady_clock::now())
+{
+    if (m_file == nullptr){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open capture file.", m_filename);
+    }
+
+    m_active.reserve(BUFFER_SIZE);
+    m_writing.reserve(BUFFER_SIZE);
+
+    int64_t start = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+    char header[FILE_HEADER_SIZE];
+    memcpy(header, MAGIC, sizeof(MAGIC));
+    put_u32(header + 8, VERSION);
+    put_u32(header + 12, 0);
+    put_u64(header + 16, (uint64_t)start);
+    m_active.append(header, FILE_HEADER_SIZE);
+
+    m_thread = std::thread(&MessageCapture::thread_loop, this);
+}
+MessageCapture::~MessageCapture(){
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_stopping = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+    fclose(m_file);
+}
+
+
+void MessageCapture::on_send(const BotBaseMessage& message, bool is_retransmit){
+    append(is_retransmit ? FLAG_RETRANSMIT : 0, message);
+}
+void MessageCapture::on_recv(const BotBaseMessage& message){
+    append(FLAG_RECEIVED, message);
+}
+void MessageCapture::append(uint8_t flags, const BotBaseMessage& message){
+    uint64_t timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - m_start
+    ).count();
+
+    size_t length = message.body.size();
+    if (length > 255){
+        length = 255;
+        flags |= FLAG_TRUNCATED;
+    }
+
+    char header[RECORD_HEADER_SIZE];
+    put_u64(header, timestamp);
+    header[8] = (char)flags;
+    header[9] = (char)message.type;
+    header[10] = (char)length;
+
+    bool flush;
+    {
+        SpinLockGuard lg(m_buffer_lock, "MessageCapture::append()");
+        m_active.append(header, RECORD_HEADER_SIZE);
+        m_active.append(message.body.data(), length);
+        flush = m_active.size() + MAX_RECORD_SIZE > BUFFER_SIZE / 2;
+    }
+
+    //  Only wake the writer once the buffer is half full. Otherwise it picks
+    //  up the records on its next timed flush.
+    if (flush){
+        {
+            std::lock_guard<std::mutex> lg(m_lock);
+            m_flush_requested = true;
+        }
+        m_cv.notify_all();
+    }
+}
+
+
+void MessageCapture::thread_loop(){
+    std::unique_lock<std::mutex> lg(m_lock);
+    while (true){
+        m_cv.wait_for(lg, FLUSH_INTERVAL, [this]{ return m_stopping || m_flush_requested; });
+        m_flush_requested = false;
+        bool stopping = m_stopping;
+
+        lg.unlock();
+        {
+            SpinLockGuard slg(m_buffer_lock, "MessageCapture::thread_loop()");
+            std::swap(m_active, m_writing);
+        }
+        write_out(m_writing);
+        m_writing.clear();
+        lg.lock();
+
+        if (stopping){
+            return;
+        }
+    }
+}
+void MessageCapture::write_out(const std::string& data){
+    if (data.empty()){
+        return;
+    }
+    fwrite(data.data(), 1, data.size(), m_file);
+    fflush(m_file);
+}
+
+
+
+
+
+namespace{
+
+std::string timestamp_to_string(int64_t microseconds_since_epoch){
+#if _WIN32 && _MSC_VER
+#pragma warning(disable:4996)
+#endif
+    time_t seconds = (time_t)(microseconds_since_epoch / 1000000);
+    int64_t micros = microseconds_since_epoch % 1000000;
+    tm local_tm = *localtime(&seconds);
+
+    std::string str;
+    str += std::to_string(local_tm.tm_year + 1900);
+    str += "-" + tostr_padded(2, local_tm.tm_mon + 1);
+    str += "-" + tostr_padded(2, local_tm.tm_mday);
+    str += " " + tostr_padded(2, local_tm.tm_hour);
+    str += ":" + tostr_padded(2, local_tm.tm_min);
+    str += ":" + tostr_padded(2, local_tm.tm_sec);
+    str += "." + tostr_padded(6, micros);
+    return str;
+}
+
+std::string body_to_hex(const std::string& body){
+    const char HEX[] = "0123456789abcdef";
+    std::string str;
+    for (char ch : body){
+        str += HEX[(uint8_t)ch >> 4];
+        str += HEX[(uint8_t)ch & 15];
+    }
+    return str;
+}
+
+std::string csv_quote(const std::string& str){
+    std::string ret = "\"";
+    for (char ch : str){
+        if (ch == '"'){
+            ret += '"';
+        }
+        ret += ch;
+    }
+    ret += '"';
+    return ret;
+}
+
+}
+
+
+void decode_message_capture(
+    const std::string& input_file,
+    const std::string& output_file,
+    MessageCaptureFormat format
+){
+    std::string data;
+    {
+        FILE* file = fopen(input_file.c_str(), "rb");
+        if (file == nullptr){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open capture file.", input_file);
+        }
+        char buffer[64 * 1024];
+        size_t read;
+        while ((read = fread(buffer, 1, sizeof(buffer), file)) != 0){
+            data.append(buffer, read);
+        }
+        fclose(file);
+    }
+
+    if (data.size() < FILE_HEADER_SIZE || memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Not a message capture file.", input_file);
+    }
+    uint32_t version = get_u32(data.data() + 8);
+    if (version != MessageCapture::VERSION){
+        throw FileException(
+            nullptr, PA_CURRENT_FUNCTION,
+            "Unsupported message capture version: " + std::to_string(version),
+            input_file
+        );
+    }
+    int64_t start = (int64_t)get_u64(data.data() + 16);
+
+    FILE* out = fopen(output_file.c_str(), "wb");
+    if (out == nullptr){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open output file.", output_file);
+    }
+
+    std::string line;
+    if (format == MessageCaptureFormat::CSV){
+        line = "Time,Offset (us),Direction,Retransmit,Type,Body,Message\n";
+        fwrite(line.data(), 1, line.size(), out);
+    }
+
+    const char* ptr = data.data() + FILE_HEADER_SIZE;
+    const char* end = data.data() + data.size();
+    BotBaseMessage message;
+    while ((size_t)(end - ptr) >= RECORD_HEADER_SIZE){
+        uint64_t offset = get_u64(ptr);
+        uint8_t flags = (uint8_t)ptr[8];
+        uint8_t length = (uint8_t)ptr[10];
+        if ((size_t)(end - ptr) < RECORD_HEADER_SIZE + length){
+            break;
+        }
+        message.type = (uint8_t)ptr[9];
+        message.body.assign(ptr + RECORD_HEADER_SIZE, length);
+        ptr += RECORD_HEADER_SIZE + length;
+
+        bool received = flags & MessageCapture::FLAG_RECEIVED;
+        bool retransmit = flags & MessageCapture::FLAG_RETRANSMIT;
+        std::string time = timestamp_to_string(start + (int64_t)offset);
+        std::string text = (flags & MessageCapture::FLAG_TRUNCATED)
+            ? "(truncated) length = " + std::to_string(length)
+            : message_to_string(message);
+
+        line.clear();
+        switch (format){
+        case MessageCaptureFormat::TEXT:
+            line += "[";
+            line += time;
+            line += "] ";
+            line += received ? "Receive: " : retransmit ? "Re-Send: " : "Sending: ";
+            line += text.empty() ? "Type 0x" + tostr_hex(message.type) + ": " + body_to_hex(message.body) : text;
+            break;
+        case MessageCaptureFormat::CSV:
+            line += time;
+            line += ",";
+            line += std::to_string(offset);
+            line += received ? ",Receive" : ",Send";
+            line += retransmit ? ",1," : ",0,";
+            line += "0x" + tostr_hex(message.type);
+            line += ",";
+            line += body_to_hex(message.body);
+            line += ",";
+            line += csv_quote(text);
+            break;
+        }
+        line += "\n";
+        fwrite(line.data(), 1, line.size(), out);
+    }
+
+    fclose(out);
+}
+
+
+
+
+}
@@ -0,0 +1,112 @@
+/*  Message Capture
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Record every message to and from the device into a compact binary
+ *  file. Nothing is formatted while capturing. A record is appended to a
+ *  preallocated buffer and a background thread writes the buffer out in
+ *  large chunks. So it is cheap enough to leave on all the time.
+ *
+ *  Use "decode_message_capture()" to turn a capture into text or CSV.
+ *
+ *  File format: (little endian)
+ *      Header:
+ *          char[8]     "PA-MCAP\0"
+ *          uint32      Version
+ *          uint32      Reserved (0)
+ *          int64       Start time. Microseconds since the Unix epoch.
+ *
+ *      Then one record per message:
+ *          uint64      Microseconds since the start time.
+ *          uint8       Flags. (see below)
+ *          uint8       Message type.
+ *          uint8       Body length.
+ *          uint8[]     Body.
+ *
+ */
+
+#ifndef PokemonAutomation_MessageCapture_H
+#define PokemonAutomation_MessageCapture_H
+
+#include <stdint.h>
+#include <string>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "MessageSniffer.h"
+
+namespace PokemonAutomation{
+
+
+class MessageCapture : public MessageSniffer{
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    static constexpr uint8_t FLAG_RECEIVED      = 0x01;
+    static constexpr uint8_t FLAG_RETRANSMIT    = 0x02;
+    static constexpr uint8_t FLAG_TRUNCATED     = 0x04;
+
+    //  Header (11 bytes) + the largest body that fits in a record.
+    static constexpr size_t MAX_RECORD_SIZE = 11 + 255;
+
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+    static constexpr std::chrono::milliseconds FLUSH_INTERVAL = std::chrono::milliseconds(1000);
+
+
+public:
+    //  Throws FileException if the file can't be opened.
+    MessageCapture(std::string filename);
+    ~MessageCapture();
+
+    const std::string& filename() const{ return m_filename; }
+
+    virtual void on_send(const BotBaseMessage& message, bool is_retransmit) override;
+    virtual void on_recv(const BotBaseMessage& message) override;
+
+
+private:
+    void append(uint8_t flags, const BotBaseMessage& message);
+    void thread_loop();
+    void write_out(const std::string& data);
+
+private:
+    const std::string m_filename;
+    FILE* m_file;
+    const std::chrono::steady_clock::time_point m_start;
+
+    //  Senders append to "m_active". The writer thread swaps it with
+    //  "m_writing" and writes that out without holding the spin lock.
+    SpinLock m_buffer_lock;
+    std::string m_active;
+    std::string m_writing;
+
+    bool m_stopping = false;
+    bool m_flush_requested = false;
+    std::mutex m_lock;
+    std::condition_variable m_cv;
+    std::thread m_thread;
+};
+
+
+
+enum class MessageCaptureFormat{
+    TEXT,
+    CSV,
+};
+
+//  Render a capture file written by MessageCapture.
+//  Throws FileException if the files can't be opened or the input is not a
+//  capture. A capture that ends in the middle of a record (because the program
+//  was killed) is decoded up to the last full record.
+void decode_message_capture(
+    const std::string& input_file,
+    const std::string& output_file,
+    MessageCaptureFormat format
+);
+
+
+
+}
+#endif
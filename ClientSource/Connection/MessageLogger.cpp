@@ -17,7 +17,13 @@ namespace PokemonAutomation{
 //    log(msg);
 //}
 void MessageLogger::on_send(const BotBaseMessage& message, bool is_retransmit){
+    MessageSniffer* capture = m_capture.load(std::memory_order_acquire);
+    if (capture != nullptr){
+        capture->on_send(message, is_retransmit);
+    }
+
     bool print = false;
+    bool debug = false;
     do{
         if (is_retransmit){
             print = true;
@@ -39,8 +45,9 @@ void MessageLogger::on_send(const BotBaseMessage& message, bool is_retransmit){
         }
 #endif
 
-        if (m_log_everything.load(std::memory_order_relaxed)){
+        if (!print && m_log_everything.load(std::memory_order_relaxed)){
             print = true;
+            debug = true;
         }
 
     }while (false);
@@ -51,14 +58,21 @@ void MessageLogger::on_send(const BotBaseMessage& message, bool is_retransmit){
     if (str.empty()){
         return;
     }
-    if (is_retransmit){
-        log("Re-Send: " + str);
+    str = (is_retransmit ? "Re-Send: " : "Sending: ") + str;
+    if (debug){
+        log_debug(std::move(str));
     }else{
-        log("Sending: " + str);
+        log(std::move(str));
     }
 }
 void MessageLogger::on_recv(const BotBaseMessage& message){
+    MessageSniffer* capture = m_capture.load(std::memory_order_acquire);
+    if (capture != nullptr){
+        capture->on_recv(message);
+    }
+
     bool print = false;
+    bool debug = false;
     do{
         if (PABB_MSG_IS_ERROR(message.type)){
             print = true;
@@ -67,15 +81,21 @@ void MessageLogger::on_recv(const BotBaseMessage& message){
             print = true;
         }
 
-        if (m_log_everything.load(std::memory_order_relaxed)){
+        if (!print && m_log_everything.load(std::memory_order_relaxed)){
             print = true;
+            debug = true;
         }
 
     }while (false);
     if (!print){
         return;
     }
-    log("Receive: " + message_to_string(message));
+    std::string str = "Receive: " + message_to_string(message);
+    if (debug){
+        log_debug(std::move(str));
+    }else{
+        log(std::move(str));
+    }
 }
 
 
@@ -93,6 +113,12 @@ void SerialLogger::log(const std::string& msg, Color color){
 void SerialLogger::log(std::string msg){
     m_logger.log(msg, COLOR_DARKGREEN);
 }
+void SerialLogger::log_debug(const std::string& msg, Color color){
+    m_logger.log_debug(msg, color);
+}
+void SerialLogger::log_debug(std::string msg){
+    m_logger.log_debug(msg, COLOR_DARKGREEN);
+}
 
 
 
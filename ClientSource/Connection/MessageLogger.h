@@ -27,12 +27,23 @@ public:
 
 
 //    virtual void log(std::string msg) override;
+
+    //  Messages that are only printed because of "log_everything".
+    virtual void log_debug(std::string msg){ log(std::move(msg)); }
+
+    //  Also pass every message to this sniffer. (e.g. a MessageCapture)
+    //  Set to nullptr to stop.
+    void set_capture(MessageSniffer* capture){
+        m_capture.store(capture, std::memory_order_release);
+    }
+
     virtual void on_send(const BotBaseMessage& message, bool is_retransmit) override;
     virtual void on_recv(const BotBaseMessage& message) override;
 
 private:
     std::atomic<bool> m_log_everything_owner;
     std::atomic<bool>& m_log_everything;
+    std::atomic<MessageSniffer*> m_capture{nullptr};
 };
 
 
@@ -44,6 +55,8 @@ public:
     virtual void log(const char* msg, Color color = Color()) override;
     virtual void log(const std::string& msg, Color color = Color()) override;
     virtual void log(std::string msg) override;
+    virtual void log_debug(const std::string& msg, Color color = Color()) override;
+    virtual void log_debug(std::string msg) override;
 
 private:
     Logger& m_logger;
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/PanicDump.h"
+#include "Common/Cpp/Tracing.h"
 #include "Common/Cpp/Concurrency/SpinPause.h"
 #include "Common/Microcontroller/MessageProtocol.h"
 #include "Common/Microcontroller/DeviceRoutines.h"
@@ -95,7 +96,7 @@ void PABotBase::stop(){
     m_retransmit_thread.join();
 
     {
-        SpinLockGuard lg(m_state_lock, "PABotBase::stop()");
+        AdaptiveLockGuard lg(m_state_lock, "PABotBase::stop()");
 
         //  Send a stop request, but don't wait for a response that we may never
         //  receive.
@@ -134,7 +135,7 @@ void PABotBase::wait_for_all_requests(const Cancellable* cancelled){
             throw InvalidConnectionStateException();
         }
         {
-            SpinLockGuard lg1(m_state_lock, "PABotBase::wait_for_all_requests()");
+            AdaptiveLockGuard lg1(m_state_lock, "PABotBase::wait_for_all_requests()");
 #if 0
             m_logger.log(
                 "Waiting for all requests to finish... (Requests: " +
@@ -224,7 +225,7 @@ void PABotBase::clear_all_active_commands(uint64_t seqnum){
 
     //  Remove all commands at or before the specified seqnum.
     std::lock_guard<std::mutex> lg0(m_sleep_lock);
-    SpinLockGuard lg1(m_state_lock, "PABotBase::next_command_interrupt()");
+    AdaptiveLockGuard lg1(m_state_lock, "PABotBase::next_command_interrupt()");
     m_logger.log("Clearing all active commands... (Commands: " + std::to_string(m_pending_commands.size()) + ")", COLOR_DARKGREEN);
 
 //    if (m_pending_commands.size() > 2){
@@ -300,7 +301,7 @@ void PABotBase::process_ack_request(BotBaseMessage message){
 
     AckState state;
     {
-        SpinLockGuard lg(m_state_lock, "PABotBase::process_ack_request()");
+        AdaptiveLockGuard lg(m_state_lock, "PABotBase::process_ack_request()");
 
         if (m_pending_requests.empty()){
             m_sniffer->log("Unexpected request ack message: seqnum = " + std::to_string(seqnum));
@@ -354,7 +355,7 @@ void PABotBase::process_ack_command(BotBaseMessage message){
     const Params* params = (const Params*)message.body.c_str();
     seqnum_t seqnum = params->seqnum;
 
-    SpinLockGuard lg(m_state_lock, "PABotBase::process_ack_command()");
+    AdaptiveLockGuard lg(m_state_lock, "PABotBase::process_ack_command()");
 
     if (m_pending_commands.empty()){
         m_sniffer->log("Unexpected command ack message: seqnum = " + std::to_string(seqnum));
@@ -403,7 +404,7 @@ void PABotBase::process_command_finished(BotBaseMessage message){
 //    m_send_queue.emplace_back((uint8_t)PABB_MSG_ACK, std::string((char*)&ack, sizeof(ack)));
 
     std::lock_guard<std::mutex> lg0(m_sleep_lock);
-    SpinLockGuard lg1(m_state_lock, "PABotBase::process_command_finished() - 0");
+    AdaptiveLockGuard lg1(m_state_lock, "PABotBase::process_command_finished() - 0");
 
     send_message(BotBaseMessage(PABB_MSG_ACK_REQUEST, std::string((char*)&ack, sizeof(ack))), false);
 
@@ -442,6 +443,7 @@ void PABotBase::process_command_finished(BotBaseMessage message){
     }
 }
 void PABotBase::on_recv_message(BotBaseMessage message){
+    PA_TRACE_ZONE("PABotBase::on_recv_message");
     m_sanitizer.check_usage();
 
     switch (message.type){
@@ -483,6 +485,7 @@ void PABotBase::on_recv_message(BotBaseMessage message){
 
 void PABotBase::retransmit_thread(){
     m_sanitizer.check_usage();
+    set_trace_thread_name("PABotBase Retransmit");
 
 //    cout << "retransmit_thread()" << endl;
     auto last_sent = current_time();
@@ -502,7 +505,8 @@ void PABotBase::retransmit_thread(){
         }
 
         //  Process retransmits.
-        SpinLockGuard lg(m_state_lock, "PABotBase::retransmit_thread()");
+        PA_TRACE_ZONE("PABotBase::retransmit");
+        AdaptiveLockGuard lg(m_state_lock, "PABotBase::retransmit_thread()");
 //        std::cout << "retransmit_thread - m_pending_messages.size(): " << m_pending_messages.size() << std::endl;
 //        cout << "m_pending_messages.size()" << endl;
 
@@ -547,7 +551,7 @@ uint64_t PABotBase::try_issue_request(
         throw InternalProgramError(&m_logger, PA_CURRENT_FUNCTION, "Message is too long.");
     }
 
-    SpinLockGuard lg(m_state_lock, "PABotBase::try_issue_request()");
+    AdaptiveLockGuard lg(m_state_lock, "PABotBase::try_issue_request()");
     if (cancelled != nullptr && cancelled->cancelled()){
         throw OperationCancelledException();
     }
@@ -612,7 +616,7 @@ uint64_t PABotBase::try_issue_command(
         throw InternalProgramError(&m_logger, PA_CURRENT_FUNCTION, "Message is too long.");
     }
 
-    SpinLockGuard lg(m_state_lock, "PABotBase::try_issue_command()");
+    AdaptiveLockGuard lg(m_state_lock, "PABotBase::try_issue_command()");
     if (cancelled != nullptr && cancelled->cancelled()){
         throw OperationCancelledException();
     }
@@ -798,7 +802,7 @@ BotBaseMessage PABotBase::wait_for_request(uint64_t seqnum){
     std::unique_lock<std::mutex> lg(m_sleep_lock);
     while (true){
         {
-            SpinLockGuard slg(m_state_lock, "PABotBase::issue_request_and_wait()");
+            AdaptiveLockGuard slg(m_state_lock, "PABotBase::issue_request_and_wait()");
             auto iter = m_pending_requests.find(seqnum);
             if (iter == m_pending_requests.end()){
                 throw OperationCancelledException();
@@ -30,7 +30,7 @@
 #include <condition_variable>
 #include <thread>
 #include "Common/Cpp/AbstractLogger.h"
-#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "Common/Cpp/Concurrency/AdaptiveLock.h"
 #include "ClientSource/Connection/MessageLogger.h"
 #include "ClientSource/Connection/PABotBaseConnection.h"
 #include "BotBase.h"
@@ -183,7 +183,7 @@ private:
     std::map<uint64_t, PendingCommand> m_pending_commands;
 
     //  If you need both locks, always acquire m_sleep_lock first!
-    SpinLock m_state_lock;
+    AdaptiveLock m_state_lock;
     std::mutex m_sleep_lock;
 
     std::condition_variable m_cv;
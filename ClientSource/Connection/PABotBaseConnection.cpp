@@ -5,6 +5,7 @@
  */
 
 #include "Common/CRC32.h"
+#include "Common/Cpp/Tracing.h"
 #include "Common/Microcontroller/MessageProtocol.h"
 #include "ClientSource/Libraries/Logging.h"
 #include "ClientSource/Libraries/MessageConverter.h"
@@ -62,6 +63,7 @@ void PABotBaseConnection::send_message(const BotBaseMessage& message, bool is_re
     if (!m_connection){
         return;
     }
+    PA_TRACE_ZONE("PABotBaseConnection::send_message");
 
 //    log("Sending: " + message_to_string(type, msg));
     m_sniffer->on_send(message, is_retransmit);
@@ -83,6 +85,7 @@ void PABotBaseConnection::send_message(const BotBaseMessage& message, bool is_re
 
 
 void PABotBaseConnection::on_recv(const void* data, size_t bytes){
+    PA_TRACE_ZONE("PABotBaseConnection::on_recv");
     //  Push into receive buffer.
     for (size_t c = 0; c < bytes; c++){
         m_recv_buffer.emplace_back(((const char*)data)[c]);
@@ -15,6 +15,7 @@
 #include <unistd.h>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/PanicDump.h"
+#include "Common/Cpp/Tracing.h"
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "StreamInterface.h"
 
@@ -146,6 +147,7 @@ private:
     }
 
     void recv_loop(){
+        set_trace_thread_name("Serial Receive");
         char buffer[32];
         while (!m_exit.load(std::memory_order_acquire)){
             int actual = read(m_fd, buffer, sizeof(buffer));
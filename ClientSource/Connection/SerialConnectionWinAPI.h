@@ -15,6 +15,7 @@
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Unicode.h"
 #include "Common/Cpp/PanicDump.h"
+#include "Common/Cpp/Tracing.h"
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "Common/Cpp/Concurrency/SpinPause.h"
 #include "ClientSource/Libraries/Logging.h"
@@ -155,6 +156,7 @@ private:
     }
 
     void recv_loop(){
+        set_trace_thread_name("Serial Receive");
 //        std::lock_guard<std::mutex> lg(m_send_lock);
         char buffer[32];
         auto last_recv = current_time();
@@ -22,6 +22,12 @@ public:
     virtual void log(const char* msg, Color color = Color()){
         log(std::string(msg), color);
     }
+
+    //  Low priority output such as a trace of every serial message. A logger
+    //  that can't keep up may drop these before anything else.
+    virtual void log_debug(const std::string& msg, Color color = Color()){
+        log(msg, color);
+    }
 };
 
 
@@ -0,0 +1,240 @@
+/*  Adaptive Lock
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+#include "Common/Cpp/PrettyPrint.h"
+#include "SpinPause.h"
+#include "AdaptiveLock.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+//  About as long as the critical sections of the locks that use this.
+const size_t ADAPTIVE_LOCK_SPINS = 100;
+
+
+
+namespace{
+
+
+//  Sleeping threads wait here. Locks that hash to the same bucket share it.
+struct ParkingBucket{
+    std::mutex lock;
+    std::condition_variable cv;
+};
+const size_t PARKING_BUCKETS = 64;
+ParkingBucket parking_buckets[PARKING_BUCKETS];
+
+ParkingBucket& parking_bucket(const void* address){
+    size_t x = (size_t)address;
+    x ^= x >> 7;
+    x ^= x >> 13;
+    return parking_buckets[x % PARKING_BUCKETS];
+}
+
+
+std::atomic<bool> lock_stats_enabled_flag(false);
+
+
+//  Open addressed by the address of the label. Never shrinks. Slots are
+//  claimed with a CAS so counting never takes a lock.
+struct LockStatsSlot{
+    std::atomic<const char*> label{nullptr};
+    std::atomic<uint64_t> contended{0};
+    std::atomic<uint64_t> parked{0};
+    std::atomic<uint64_t> total_wait_ns{0};
+    std::atomic<uint64_t> max_wait_ns{0};
+};
+const size_t LOCK_STATS_SLOTS = 512;
+LockStatsSlot lock_stats_slots[LOCK_STATS_SLOTS];
+
+//  Everything that doesn't fit in the table.
+const char* LOCK_STATS_OVERFLOW = "(other locks)";
+LockStatsSlot lock_stats_overflow;
+
+
+LockStatsSlot& lock_stats_slot(const char* label){
+    size_t x = (size_t)label;
+    x ^= x >> 9;
+    for (size_t c = 0; c < LOCK_STATS_SLOTS; c++){
+        LockStatsSlot& slot = lock_stats_slots[(x + c) % LOCK_STATS_SLOTS];
+        const char* current = slot.label.load(std::memory_order_acquire);
+        if (current == label){
+            return slot;
+        }
+        if (current == nullptr){
+            if (slot.label.compare_exchange_strong(current, label, std::memory_order_acq_rel)){
+                return slot;
+            }
+            if (current == label){
+                return slot;
+            }
+        }
+    }
+    return lock_stats_overflow;
+}
+void record_contention(const char* label, bool parked, uint64_t wait_ns){
+    LockStatsSlot& slot = lock_stats_slot(label);
+    slot.contended.fetch_add(1, std::memory_order_relaxed);
+    if (parked){
+        slot.parked.fetch_add(1, std::memory_order_relaxed);
+    }
+    slot.total_wait_ns.fetch_add(wait_ns, std::memory_order_relaxed);
+    uint64_t max = slot.max_wait_ns.load(std::memory_order_relaxed);
+    while (wait_ns > max && !slot.max_wait_ns.compare_exchange_weak(max, wait_ns, std::memory_order_relaxed));
+}
+
+uint64_t now_ns(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+
+}
+
+
+
+void AdaptiveLock::acquire_slow(const char* label){
+    const bool stats = lock_stats_enabled();
+    uint64_t start = stats ? now_ns() : 0;
+    bool parked = false;
+
+    //  Spin for a bit in case the holder is about to release it.
+    bool acquired = false;
+    for (size_t c = 0; c < ADAPTIVE_LOCK_SPINS; c++){
+        pause();
+        uint32_t state = m_state.load(std::memory_order_relaxed);
+        if (state == UNLOCKED && m_state.compare_exchange_weak(state, LOCKED, std::memory_order_acquire)){
+            acquired = true;
+            break;
+        }
+    }
+
+    //  Sleep until it's released. Whoever takes the lock from here leaves it
+    //  as PARKED since there may be others still sleeping.
+    if (!acquired){
+        uint32_t state = m_state.exchange(PARKED, std::memory_order_acquire);
+        while (state != UNLOCKED){
+            parked = true;
+            ParkingBucket& bucket = parking_bucket(this);
+            {
+                std::unique_lock<std::mutex> lg(bucket.lock);
+                bucket.cv.wait(lg, [this]{
+                    return m_state.load(std::memory_order_relaxed) != PARKED;
+                });
+            }
+            state = m_state.exchange(PARKED, std::memory_order_acquire);
+        }
+    }
+
+    if (stats){
+        record_contention(label, parked, now_ns() - start);
+    }
+}
+void AdaptiveLock::wake(){
+    //  The bucket may be shared with other locks. So wake everyone and let
+    //  them recheck.
+    ParkingBucket& bucket = parking_bucket(this);
+    std::lock_guard<std::mutex> lg(bucket.lock);
+    bucket.cv.notify_all();
+}
+
+
+
+bool lock_stats_enabled(){
+    return lock_stats_enabled_flag.load(std::memory_order_relaxed);
+}
+void set_lock_stats_enabled(bool enabled){
+    lock_stats_enabled_flag.store(enabled, std::memory_order_relaxed);
+}
+
+std::vector<LockContentionStats> lock_contention_stats(){
+    //  Labels with the same text from different places are merged.
+    std::map<std::string, LockContentionStats> merged;
+    auto add = [&](const char* label, const LockStatsSlot& slot){
+        LockContentionStats& stats = merged[label];
+        stats.label = label;
+        stats.contended += slot.contended.load(std::memory_order_relaxed);
+        stats.parked += slot.parked.load(std::memory_order_relaxed);
+        stats.total_wait_ns += slot.total_wait_ns.load(std::memory_order_relaxed);
+        stats.max_wait_ns = std::max(stats.max_wait_ns, slot.max_wait_ns.load(std::memory_order_relaxed));
+    };
+    for (const LockStatsSlot& slot : lock_stats_slots){
+        const char* label = slot.label.load(std::memory_order_acquire);
+        if (label != nullptr){
+            add(label, slot);
+        }
+    }
+    add(LOCK_STATS_OVERFLOW, lock_stats_overflow);
+
+    std::vector<LockContentionStats> ret;
+    for (auto& item : merged){
+        if (item.second.contended != 0){
+            ret.emplace_back(std::move(item.second));
+        }
+    }
+    std::sort(ret.begin(), ret.end(), [](const LockContentionStats& a, const LockContentionStats& b){
+        return a.total_wait_ns > b.total_wait_ns;
+    });
+    return ret;
+}
+std::vector<LockContentionStats> lock_contention_stats_since(const std::vector<LockContentionStats>& baseline){
+    std::map<std::string, const LockContentionStats*> before;
+    for (const LockContentionStats& item : baseline){
+        before[item.label] = &item;
+    }
+
+    std::vector<LockContentionStats> ret;
+    for (LockContentionStats& item : lock_contention_stats()){
+        auto iter = before.find(item.label);
+        if (iter != before.end()){
+            item.contended -= iter->second->contended;
+            item.parked -= iter->second->parked;
+            item.total_wait_ns -= iter->second->total_wait_ns;
+        }
+        if (item.contended != 0){
+            ret.emplace_back(std::move(item));
+        }
+    }
+    std::sort(ret.begin(), ret.end(), [](const LockContentionStats& a, const LockContentionStats& b){
+        return a.total_wait_ns > b.total_wait_ns;
+    });
+    return ret;
+}
+
+std::string lock_contention_report(const std::vector<LockContentionStats>& baseline, size_t max_lines){
+    std::vector<LockContentionStats> stats = lock_contention_stats_since(baseline);
+    if (stats.empty()){
+        return "";
+    }
+    std::string str = "Most contended locks: (contended / parked / total wait / max wait since startup)";
+    for (size_t c = 0; c < stats.size() && c < max_lines; c++){
+        const LockContentionStats& item = stats[c];
+        str += "\n    ";
+        str += item.label;
+        str += ": " + tostr_u_commas(item.contended);
+        str += " / " + tostr_u_commas(item.parked);
+        str += " / " + tostr_fixed(item.total_wait_ns / 1000000., 3) + " ms";
+        str += " / " + tostr_fixed(item.max_wait_ns / 1000., 1) + " us";
+    }
+    if (stats.size() > max_lines){
+        str += "\n    (" + std::to_string(stats.size() - max_lines) + " more)";
+    }
+    return str;
+}
+
+
+
+}
@@ -0,0 +1,129 @@
+/*  Adaptive Lock
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A lock that spins briefly and then sleeps.
+ *
+ *  Use this instead of SpinLock for locks that are held by several threads at
+ *  once. (the serial connection, the inference pivots, the overlay...)
+ *  SpinLock spins until it gets the lock. When there are more busy threads
+ *  than cores, the holder may not be running and the spinning burns the CPU
+ *  it needs. This lock spins for about as long as a short critical section
+ *  takes and then parks the thread until the lock is released.
+ *
+ *  The uncontended path is the same single CAS as SpinLock. The lock is one
+ *  word. Sleeping threads wait in a small global table of condition
+ *  variables keyed by the address of the lock.
+ *
+ *  Contention stats:
+ *
+ *  If enabled, every acquisition that doesn't get the lock right away is
+ *  counted under the label passed to "acquire()". Labels are compared by
+ *  content. So the same label at different call sites is one row.
+ *
+ *  The counters are process-wide and are never reset, since several programs
+ *  can be running at once. To report on one program, take a snapshot when it
+ *  starts and report the difference when it ends.
+ *
+ */
+
+#ifndef PokemonAutomation_AdaptiveLock_H
+#define PokemonAutomation_AdaptiveLock_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <atomic>
+
+namespace PokemonAutomation{
+
+
+class AdaptiveLock{
+public:
+    AdaptiveLock() : m_state(UNLOCKED) {}
+
+    void acquire(const char* label = "(unnamed lock)"){
+        uint32_t state = UNLOCKED;
+        if (m_state.compare_exchange_strong(state, LOCKED, std::memory_order_acquire)){
+            return;
+        }
+        acquire_slow(label);
+    }
+    bool try_acquire(){
+        uint32_t state = UNLOCKED;
+        return m_state.compare_exchange_strong(state, LOCKED, std::memory_order_acquire);
+    }
+
+    void unlock(){
+        if (m_state.exchange(UNLOCKED, std::memory_order_release) == PARKED){
+            wake();
+        }
+    }
+
+private:
+    void acquire_slow(const char* label);
+    void wake();
+
+private:
+    static constexpr uint32_t UNLOCKED  = 0;
+    static constexpr uint32_t LOCKED    = 1;
+    //  Locked and there may be sleeping threads.
+    static constexpr uint32_t PARKED    = 2;
+
+    std::atomic<uint32_t> m_state;
+};
+
+
+class AdaptiveLockGuard{
+public:
+    AdaptiveLockGuard(const AdaptiveLockGuard&) = delete;
+    void operator=(const AdaptiveLockGuard&) = delete;
+
+    AdaptiveLockGuard(AdaptiveLock& lock, const char* label = "(unnamed lock)")
+        : m_lock(lock)
+    {
+        lock.acquire(label);
+    }
+    ~AdaptiveLockGuard(){
+        m_lock.unlock();
+    }
+
+private:
+    AdaptiveLock& m_lock;
+};
+
+
+
+struct LockContentionStats{
+    std::string label;
+
+    //  Acquisitions that didn't get the lock on the first try.
+    uint64_t contended = 0;
+
+    //  Acquisitions that gave up spinning and slept.
+    uint64_t parked = 0;
+
+    //  Time spent waiting in the contended acquisitions.
+    uint64_t total_wait_ns = 0;
+    uint64_t max_wait_ns = 0;
+};
+
+bool lock_stats_enabled();
+void set_lock_stats_enabled(bool enabled);
+
+//  Everything counted since the process started. Most time waiting first.
+std::vector<LockContentionStats> lock_contention_stats();
+
+//  What was counted since "baseline" was taken from "lock_contention_stats()".
+//  "max_wait_ns" can't be split up this way and is still since the process
+//  started.
+std::vector<LockContentionStats> lock_contention_stats_since(const std::vector<LockContentionStats>& baseline);
+
+//  A table of the "max_lines" most contended locks since "baseline". Empty if
+//  nothing has been contended.
+std::string lock_contention_report(const std::vector<LockContentionStats>& baseline, size_t max_lines = 10);
+
+
+
+}
+#endif
@@ -5,7 +5,7 @@
  *      This class is meant for asynchronous tasks, not for parallel computation.
  * This class will always spawn enough threads run all tasks in parallel.
  *
- * If you need to spam a bunch of compute tasks in parallel, use ParallelTaskRunner.
+ * If you need to spam a bunch of compute tasks in parallel, use ComputationThreadPool.
  *
  */
 
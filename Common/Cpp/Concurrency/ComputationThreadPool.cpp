@@ -0,0 +1,253 @@
+/*  Computation Thread Pool
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include "Common/Cpp/PanicDump.h"
+#include "Common/Cpp/CancellableScope.h"
+#include "Common/Cpp/Tracing.h"
+#include "ComputationThreadPool.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+//  The pool and queue of the current thread if it's a pool thread.
+thread_local ComputationThreadPool* t_computation_pool = nullptr;
+thread_local size_t t_computation_queue = 0;
+
+
+
+ComputationTaskGroup::ComputationTaskGroup(ComputationThreadPool& pool, const Cancellable* cancellable)
+    : m_pool(pool)
+    , m_cancellable(cancellable)
+    , m_remaining(0)
+    , m_cancelled(false)
+{}
+ComputationTaskGroup::~ComputationTaskGroup(){
+    wait_no_throw();
+}
+
+void ComputationTaskGroup::run(std::function<void()>&& func){
+    m_remaining.fetch_add(1, std::memory_order_relaxed);
+    m_pool.push(ComputationThreadPool::Task{this, std::move(func)});
+}
+void ComputationTaskGroup::cancel(){
+    m_cancelled.store(true, std::memory_order_relaxed);
+}
+bool ComputationTaskGroup::cancelled() const{
+    if (m_cancelled.load(std::memory_order_relaxed)){
+        return true;
+    }
+    return m_cancellable != nullptr && m_cancellable->cancelled();
+}
+
+void ComputationTaskGroup::run_task(const std::function<void()>& func) noexcept{
+    if (!cancelled()){
+        try{
+            func();
+        }catch (...){
+            std::lock_guard<std::mutex> lg(m_lock);
+            if (!m_exception){
+                m_exception = std::current_exception();
+            }
+            m_cancelled.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    //  Decrement under the lock so the waiter can't return and destroy this
+    //  group while we're still in here.
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1){
+        m_cv.notify_all();
+    }
+}
+void ComputationTaskGroup::wait_no_throw() noexcept{
+    while (m_remaining.load(std::memory_order_acquire) != 0){
+        //  Help out instead of sleeping. The task we get may not be ours, but
+        //  it's work that needs to be done either way.
+        if (m_pool.try_run_one()){
+            continue;
+        }
+
+        //  Nothing is queued. So whatever is left of this group is already
+        //  running on other threads.
+        std::unique_lock<std::mutex> lg(m_lock);
+        m_cv.wait(lg, [this]{ return m_remaining.load(std::memory_order_acquire) == 0; });
+    }
+
+    //  Synchronize with the last "run_task()".
+    std::lock_guard<std::mutex> lg(m_lock);
+}
+void ComputationTaskGroup::wait(){
+    wait_no_throw();
+    if (m_exception){
+        std::exception_ptr exception = std::move(m_exception);
+        m_exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+    if (m_cancellable != nullptr){
+        m_cancellable->throw_if_cancelled();
+    }
+}
+
+
+
+
+ComputationThreadPool::ComputationThreadPool(std::function<void()>&& new_thread_callback, size_t threads)
+    : m_new_thread_callback(std::move(new_thread_callback))
+    , m_next_queue(0)
+    , m_pending(0)
+    , m_sleeping(0)
+    , m_stopping(false)
+{
+    threads = std::max<size_t>(threads, 1);
+    for (size_t c = 0; c < threads; c++){
+        m_workers.emplace_back(new Worker());
+    }
+    for (size_t c = 0; c < threads; c++){
+        m_threads.emplace_back(run_with_catch, "ComputationThreadPool::thread_loop()", [this, c]{ thread_loop(c); });
+    }
+}
+ComputationThreadPool::~ComputationThreadPool(){
+    {
+        std::lock_guard<std::mutex> lg(m_sleep_lock);
+        m_stopping = true;
+        m_sleep_cv.notify_all();
+    }
+    for (std::thread& thread : m_threads){
+        thread.join();
+    }
+}
+
+
+void ComputationThreadPool::push(Task&& task){
+    size_t index = t_computation_pool == this
+        ? t_computation_queue
+        : m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+    Worker& worker = *m_workers[index];
+
+    //  Count it first so "m_pending" never goes below the real count.
+    m_pending.fetch_add(1, std::memory_order_seq_cst);
+    {
+        SpinLockGuard lg(worker.lock, "ComputationThreadPool::push()");
+        worker.queue.emplace_back(std::move(task));
+        worker.size.store(worker.queue.size(), std::memory_order_relaxed);
+    }
+
+    //  Pairs with "m_sleeping" in "thread_loop()". Either the sleeper sees the
+    //  new task, or we see the sleeper.
+    if (m_sleeping.load(std::memory_order_seq_cst) != 0){
+        std::lock_guard<std::mutex> lg(m_sleep_lock);
+        m_sleep_cv.notify_one();
+    }
+}
+bool ComputationThreadPool::try_pop(Task& task, size_t start){
+    const size_t workers = m_workers.size();
+    const bool own = t_computation_pool == this;
+    for (size_t c = 0; c < workers; c++){
+        Worker& worker = *m_workers[(start + c) % workers];
+        if (worker.size.load(std::memory_order_relaxed) == 0){
+            continue;
+        }
+        SpinLockGuard lg(worker.lock, "ComputationThreadPool::try_pop()");
+        if (worker.queue.empty()){
+            continue;
+        }
+
+        //  Newest from our own queue since it's still in cache. Oldest from
+        //  everyone else's since those are usually the biggest.
+        if (own && c == 0){
+            task = std::move(worker.queue.back());
+            worker.queue.pop_back();
+        }else{
+            task = std::move(worker.queue.front());
+            worker.queue.pop_front();
+        }
+        worker.size.store(worker.queue.size(), std::memory_order_relaxed);
+        m_pending.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+bool ComputationThreadPool::try_run_one(){
+    size_t start = t_computation_pool == this
+        ? t_computation_queue
+        : m_next_queue.load(std::memory_order_relaxed) % m_workers.size();
+    Task task;
+    if (!try_pop(task, start)){
+        return false;
+    }
+    task.group->run_task(task.func);
+    return true;
+}
+
+void ComputationThreadPool::thread_loop(size_t index){
+    t_computation_pool = this;
+    t_computation_queue = index;
+    set_trace_thread_name("Compute Thread " + std::to_string(index));
+    if (m_new_thread_callback){
+        m_new_thread_callback();
+    }
+    while (true){
+        if (try_run_one()){
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lg(m_sleep_lock);
+        m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+        m_sleep_cv.wait(lg, [this]{
+            return m_stopping || m_pending.load(std::memory_order_seq_cst) != 0;
+        });
+        m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+        if (m_stopping){
+            return;
+        }
+    }
+}
+
+
+void ComputationThreadPool::parallel_for(
+    size_t s, size_t e,
+    const std::function<void(size_t index)>& func,
+    size_t block_size
+){
+    parallel_for(nullptr, s, e, func, block_size);
+}
+void ComputationThreadPool::parallel_for(
+    const Cancellable* cancellable,
+    size_t s, size_t e,
+    const std::function<void(size_t index)>& func,
+    size_t block_size
+){
+    if (s >= e){
+        return;
+    }
+    size_t total = e - s;
+    if (block_size == 0){
+        size_t blocks = (m_workers.size() + 1) * 4;
+        block_size = (total + blocks - 1) / blocks;
+    }
+
+    ComputationTaskGroup group(*this, cancellable);
+    for (size_t start = s; start < e;){
+        size_t end = start + std::min(block_size, e - start);
+        group.run([&group, &func, start, end]{
+            for (size_t index = start; index < end && !group.cancelled(); index++){
+                func(index);
+            }
+        });
+        start = end;
+    }
+    group.wait();
+}
+
+
+
+
+}
@@ -0,0 +1,151 @@
+/*  Computation Thread Pool
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A fixed-size pool for splitting CPU work across cores.
+ *
+ *  This is for short compute tasks that never block. (template matching, OCR,
+ *  image kernels...) For tasks that sleep or wait on the console, use
+ *  AsyncDispatcher instead.
+ *
+ *  Each thread has its own queue. Tasks submitted from a pool thread go to
+ *  its own queue. Idle threads steal from the other queues. A thread that
+ *  waits on a task group works on queued tasks instead of sleeping. So task
+ *  groups can be nested without running out of threads.
+ *
+ */
+
+#ifndef PokemonAutomation_ComputationThreadPool_H
+#define PokemonAutomation_ComputationThreadPool_H
+
+#include <memory>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "SpinLock.h"
+
+namespace PokemonAutomation{
+
+class Cancellable;
+class ComputationThreadPool;
+
+
+//  A set of tasks that can be waited on together.
+//
+//  If a task throws, the tasks that haven't started yet are skipped and
+//  "wait()" rethrows the first exception.
+//
+//  If "cancellable" is given and gets cancelled, the tasks that haven't
+//  started yet are skipped and "wait()" throws the cancellation.
+class ComputationTaskGroup{
+public:
+    ComputationTaskGroup(const ComputationTaskGroup&) = delete;
+    void operator=(const ComputationTaskGroup&) = delete;
+
+    ComputationTaskGroup(ComputationThreadPool& pool, const Cancellable* cancellable = nullptr);
+
+    //  Wait for everything to finish. Does not rethrow.
+    ~ComputationTaskGroup();
+
+    void run(std::function<void()>&& func);
+
+    //  Skip all the tasks that haven't started yet.
+    void cancel();
+    bool cancelled() const;
+
+    //  Wait for all the tasks to finish. Rethrows the first exception.
+    void wait();
+
+
+private:
+    friend class ComputationThreadPool;
+
+    void run_task(const std::function<void()>& func) noexcept;
+    void wait_no_throw() noexcept;
+
+private:
+    ComputationThreadPool& m_pool;
+    const Cancellable* m_cancellable;
+
+    std::atomic<size_t> m_remaining;
+    std::atomic<bool> m_cancelled;
+    std::exception_ptr m_exception;
+
+    std::mutex m_lock;
+    std::condition_variable m_cv;
+};
+
+
+
+class ComputationThreadPool{
+public:
+    //  "new_thread_callback" runs at the start of every thread. (e.g. to set priority)
+    ComputationThreadPool(std::function<void()>&& new_thread_callback, size_t threads);
+    ~ComputationThreadPool();
+
+    size_t threads() const{ return m_workers.size(); }
+
+    //  Run "func(index)" for every index in [s, e) and wait for them.
+    //
+    //  Indices are handed out in blocks of "block_size". If zero, the range is
+    //  split into a few blocks per thread.
+    //
+    //  The calling thread works on the blocks too.
+    void parallel_for(
+        size_t s, size_t e,
+        const std::function<void(size_t index)>& func,
+        size_t block_size = 0
+    );
+    void parallel_for(
+        const Cancellable* cancellable,
+        size_t s, size_t e,
+        const std::function<void(size_t index)>& func,
+        size_t block_size = 0
+    );
+
+
+private:
+    struct Task{
+        ComputationTaskGroup* group;
+        std::function<void()> func;
+    };
+    struct Worker{
+        SpinLock lock;
+        std::deque<Task> queue;
+
+        //  Lets other threads skip empty queues without taking the lock.
+        std::atomic<size_t> size{0};
+    };
+
+    friend class ComputationTaskGroup;
+
+    void push(Task&& task);
+    bool try_pop(Task& task, size_t start);
+    bool try_run_one();
+    void thread_loop(size_t index);
+
+private:
+    std::function<void()> m_new_thread_callback;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    //  Round robin for tasks submitted from outside the pool.
+    std::atomic<size_t> m_next_queue;
+
+    std::atomic<size_t> m_pending;
+    std::atomic<size_t> m_sleeping;
+    bool m_stopping;
+    std::mutex m_sleep_lock;
+    std::condition_variable m_sleep_cv;
+
+    std::vector<std::thread> m_threads;
+};
+
+
+
+
+}
+#endif
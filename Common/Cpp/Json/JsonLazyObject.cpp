@@ -0,0 +1,252 @@
+/*  JSON Lazy Object
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include "Common/Cpp/Exceptions.h"
+#include "JsonTools.h"
+#include "JsonLazyObject.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+namespace{
+
+//  Walks over the text without building anything. Only checks enough of the
+//  syntax to find where each value ends. The values themselves are checked
+//  when they are parsed.
+class JsonSkipper{
+public:
+    JsonSkipper(const std::string& filename, const char* begin, const char* ptr, const char* end)
+        : m_filename(filename)
+        , m_begin(begin)
+        , m_ptr(ptr)
+        , m_end(end)
+    {}
+
+    const char* ptr() const{ return m_ptr; }
+    bool done() const{ return m_ptr == m_end; }
+
+    void skip_whitespace(){
+        while (m_ptr < m_end){
+            switch (*m_ptr){
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+                m_ptr++;
+                continue;
+            }
+            return;
+        }
+    }
+    bool try_consume(char ch){
+        if (m_ptr < m_end && *m_ptr == ch){
+            m_ptr++;
+            return true;
+        }
+        return false;
+    }
+    void consume(char ch){
+        if (!try_consume(ch)){
+            fail(std::string("Expected '") + ch + "'.");
+        }
+    }
+
+    //  Returns true if the string has escapes.
+    bool skip_string(){
+        consume('"');
+        bool escaped = false;
+        while (m_ptr < m_end){
+            char ch = *m_ptr++;
+            if (ch == '"'){
+                return escaped;
+            }
+            if (ch == '\\'){
+                escaped = true;
+                m_ptr++;
+            }
+        }
+        fail("Unterminated string.");
+        return false;
+    }
+    void skip_value(){
+        if (m_ptr >= m_end){
+            fail("Expected a value.");
+        }
+        switch (*m_ptr){
+        case '"':
+            skip_string();
+            return;
+        case '{':
+        case '[':
+            skip_container();
+            return;
+        }
+
+        //  Number, true, false or null.
+        const char* start = m_ptr;
+        while (m_ptr < m_end){
+            char ch = *m_ptr;
+            if (ch == ',' || ch == '}' || ch == ']' || ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n'){
+                break;
+            }
+            m_ptr++;
+        }
+        if (m_ptr == start){
+            fail("Expected a value.");
+        }
+    }
+
+    [[noreturn]] void fail(const std::string& message) const{
+        throw FileException(
+            nullptr, PA_CURRENT_FUNCTION,
+            "Invalid JSON at offset " + std::to_string(m_ptr - m_begin) + ": " + message,
+            m_filename
+        );
+    }
+
+private:
+    void skip_container(){
+        size_t depth = 0;
+        while (m_ptr < m_end){
+            switch (*m_ptr){
+            case '"':
+                skip_string();
+                continue;
+            case '{':
+            case '[':
+                depth++;
+                break;
+            case '}':
+            case ']':
+                depth--;
+                if (depth == 0){
+                    m_ptr++;
+                    return;
+                }
+                break;
+            }
+            m_ptr++;
+        }
+        fail("Unterminated object or array.");
+    }
+
+private:
+    const std::string& m_filename;
+    const char* m_begin;
+    const char* m_ptr;
+    const char* m_end;
+};
+
+}
+
+
+
+JsonLazyObject::JsonLazyObject(const std::string& filename)
+    : m_filename(filename)
+    , m_json(file_to_string(filename))
+{
+    index();
+}
+
+void JsonLazyObject::index(){
+    const char* begin = m_json.data();
+    const char* end = begin + m_json.size();
+
+    //  Skip the BOM.
+    if (m_json.size() >= 3 && memcmp(begin, "\xef\xbb\xbf", 3) == 0){
+        begin += 3;
+    }
+
+    JsonSkipper skipper(m_filename, m_json.data(), begin, end);
+    skipper.skip_whitespace();
+    skipper.consume('{');
+    skipper.skip_whitespace();
+
+    if (!skipper.try_consume('}')){
+        while (true){
+            const char* key_begin = skipper.ptr();
+            bool escaped = skipper.skip_string();
+            const char* key_end = skipper.ptr();
+            std::string key = escaped
+                ? parse_json(key_begin, key_end - key_begin).get_string_default()
+                : std::string(key_begin + 1, key_end - 1);
+
+            skipper.skip_whitespace();
+            skipper.consume(':');
+            skipper.skip_whitespace();
+
+            const char* value_begin = skipper.ptr();
+            skipper.skip_value();
+
+            //  Same as the full parser: the last duplicate wins.
+            Entry& entry = m_entries[std::move(key)];
+            entry.begin = value_begin - m_json.data();
+            entry.end = skipper.ptr() - m_json.data();
+
+            skipper.skip_whitespace();
+            if (skipper.try_consume(',')){
+                skipper.skip_whitespace();
+                continue;
+            }
+            skipper.consume('}');
+            break;
+        }
+    }
+
+    skipper.skip_whitespace();
+    if (!skipper.done()){
+        skipper.fail("Trailing characters.");
+    }
+}
+
+
+std::vector<std::string> JsonLazyObject::keys() const{
+    std::vector<std::string> ret;
+    for (const auto& item : m_entries){
+        ret.emplace_back(item.first);
+    }
+    return ret;
+}
+const JsonValue* JsonLazyObject::get_value(const std::string& key) const{
+    auto iter = m_entries.find(key);
+    if (iter == m_entries.end()){
+        return nullptr;
+    }
+
+    Entry& entry = iter->second;
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (!entry.value){
+        const char* text = m_json.data() + entry.begin;
+        size_t length = entry.end - entry.begin;
+        JsonValue value = parse_json(text, length);
+        if (value.is_null() && (length != 4 || memcmp(text, "null", 4) != 0)){
+            throw FileException(
+                nullptr, PA_CURRENT_FUNCTION,
+                "Invalid JSON for key: " + key,
+                m_filename
+            );
+        }
+        entry.value.reset(new JsonValue(std::move(value)));
+    }
+    return entry.value.get();
+}
+const JsonValue& JsonLazyObject::get_value_throw(const std::string& key) const{
+    const JsonValue* value = get_value(key);
+    if (value == nullptr){
+        throw JsonParseException(m_filename, key);
+    }
+    return *value;
+}
+
+
+
+}
@@ -0,0 +1,70 @@
+/*  JSON Lazy Object
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Read-only view of a JSON file whose root is an object.
+ *
+ *  Loading only finds where each top level value starts and ends. A value
+ *  is parsed the first time it is looked up. Use this for big resource files
+ *  where only some of the keys are needed.
+ *
+ */
+
+#ifndef PokemonAutomation_Common_Json_JsonLazyObject_H
+#define PokemonAutomation_Common_Json_JsonLazyObject_H
+
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "JsonValue.h"
+
+namespace PokemonAutomation{
+
+
+class JsonLazyObject{
+    JsonLazyObject(const JsonLazyObject&) = delete;
+    void operator=(const JsonLazyObject&) = delete;
+
+public:
+    //  Throws FileException if the file can't be read or the root isn't an
+    //  object.
+    JsonLazyObject(const std::string& filename);
+
+    const std::string& filename() const{ return m_filename; }
+
+    bool    empty   () const{ return m_entries.empty(); }
+    size_t  size    () const{ return m_entries.size(); }
+
+    bool contains(const std::string& key) const{ return m_entries.find(key) != m_entries.end(); }
+    std::vector<std::string> keys() const;
+
+    //  Returns nullptr if the key doesn't exist.
+    //  Throws FileException if the value isn't valid JSON.
+    const JsonValue* get_value(const std::string& key) const;
+
+    //  Throws JsonParseException if the key doesn't exist.
+    const JsonValue& get_value_throw(const std::string& key) const;
+
+
+private:
+    struct Entry{
+        size_t begin;
+        size_t end;
+        std::unique_ptr<JsonValue> value;
+    };
+
+    void index();
+
+private:
+    std::string m_filename;
+    std::string m_json;
+
+    mutable std::mutex m_lock;
+    mutable std::map<std::string, Entry> m_entries;
+};
+
+
+
+}
+#endif
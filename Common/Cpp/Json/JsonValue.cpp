@@ -4,6 +4,8 @@
  *
  */
 
+#include <vector>
+#include <atomic>
 #include "3rdParty/nlohmann/json.hpp"
 #include "JsonValue.h"
 #include "JsonArray.h"
@@ -351,10 +353,118 @@ bool JsonValue::read_string(std::string& value) const{
 
 
 
+//  Builds the JsonValue straight from nlohmann's SAX events. Parsing into a
+//  nlohmann::json first and converting it means building the whole tree
+//  twice.
+class JsonValueBuilder{
+public:
+    JsonValue& root(){ return m_root; }
+
+    bool null(){
+        return insert(JsonValue());
+    }
+    bool boolean(bool x){
+        return insert(JsonValue(x));
+    }
+    bool number_integer(int64_t x){
+        return insert(JsonValue(x));
+    }
+    bool number_unsigned(uint64_t x){
+        return insert(JsonValue((int64_t)x));
+    }
+    bool number_float(double x, const std::string&){
+        return insert(JsonValue(x));
+    }
+    bool string(std::string& x){
+        return insert(JsonValue(std::move(x)));
+    }
+    bool binary(nlohmann::json::binary_t&){
+        return insert(JsonValue());
+    }
+
+    bool start_object(size_t){
+        return open(JsonValue(JsonObject()));
+    }
+    bool key(std::string& x){
+        m_key = std::move(x);
+        return true;
+    }
+    bool end_object(){
+        m_stack.pop_back();
+        return true;
+    }
+
+    bool start_array(size_t){
+        return open(JsonValue(JsonArray()));
+    }
+    bool end_array(){
+        m_stack.pop_back();
+        return true;
+    }
+
+    bool parse_error(size_t, const std::string&, const nlohmann::detail::exception&){
+        m_root.clear();
+        m_stack.clear();
+        return false;
+    }
+
+private:
+    //  Containers are only ever added at the end of their parent. So the
+    //  pointers on the stack stay valid until the container is closed.
+    JsonValue* add(JsonValue&& value){
+        if (m_stack.empty()){
+            m_root = std::move(value);
+            return &m_root;
+        }
+        JsonValue& parent = *m_stack.back();
+        JsonArray* array = parent.get_array();
+        if (array != nullptr){
+            array->push_back(std::move(value));
+            return &(*array)[array->size() - 1];
+        }
+        JsonValue& slot = (*parent.get_object())[std::move(m_key)];
+        slot = std::move(value);
+        return &slot;
+    }
+    bool insert(JsonValue&& value){
+        add(std::move(value));
+        return true;
+    }
+    bool open(JsonValue&& value){
+        m_stack.emplace_back(add(std::move(value)));
+        return true;
+    }
+
+private:
+    JsonValue m_root;
+    std::vector<JsonValue*> m_stack;
+    std::string m_key;
+};
+
+
+JsonValue parse_json(const char* data, size_t length){
+    //  Invalid JSON returns null.
+    JsonValueBuilder builder;
+    nlohmann::json::sax_parse(data, data + length, &builder);
+    return std::move(builder.root());
+}
 JsonValue parse_json(const std::string& str){
-    return from_nlohmann(nlohmann::json::parse(str, nullptr, false));
+    return parse_json(str.data(), str.size());
+}
+namespace{
+    std::atomic<JsonFileLoader> json_file_loader(nullptr);
+}
+void set_json_file_loader(JsonFileLoader loader){
+    json_file_loader.store(loader, std::memory_order_release);
 }
 JsonValue load_json_file(const std::string& str){
+    JsonFileLoader loader = json_file_loader.load(std::memory_order_acquire);
+    if (loader != nullptr){
+        JsonValue value;
+        if (loader(str, value)){
+            return value;
+        }
+    }
     return parse_json(file_to_string(str));
 }
 std::string JsonValue::dump(int indent) const{
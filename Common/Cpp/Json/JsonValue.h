@@ -156,9 +156,17 @@ private:
     } u;
 };
 
+//  Invalid JSON returns null.
 JsonValue parse_json(const std::string& str);
+JsonValue parse_json(const char* data, size_t length);
 JsonValue load_json_file(const std::string& str);
 
+//  Lets something like a resource bundle serve "load_json_file()" without
+//  reading the file. The loader returns false if it doesn't have the file, in
+//  which case the file is read as usual.
+typedef bool (*JsonFileLoader)(const std::string& filename, JsonValue& value);
+void set_json_file_loader(JsonFileLoader loader);
+
 
 template <typename Type>
 bool JsonValue::read_integer(Type& value, int64_t min, int64_t max) const{
@@ -0,0 +1,298 @@
+/*  Tracing
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <memory>
+#include <vector>
+#include <set>
+#include <mutex>
+#include <fstream>
+#include "Tracing.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+#ifdef PA_TRACE_ENABLE
+
+
+std::atomic<bool> tracing_enabled_flag(false);
+
+void set_tracing_enabled(bool enabled){
+    tracing_enabled_flag.store(enabled, std::memory_order_relaxed);
+}
+
+
+
+namespace{
+
+
+//  Events per thread. Enough for several seconds of the busiest threads.
+constexpr size_t TRACE_BUFFER_SIZE = (size_t)1 << 16;
+
+//  Buffers of threads that have exited are dropped once their last event is
+//  this old.
+constexpr uint64_t TRACE_RETIRED_LIFETIME = 60ull * 1000000000;
+
+
+//  Each slot is a seqlock. "seq" is odd while the slot is being written and
+//  "2 * index + 2" once it holds event "index". The exporter only keeps a copy
+//  if "seq" is the same before and after it and names the event it expected.
+//  The fields are atomic so the racing reads are defined. Relaxed atomics
+//  compile to plain loads and stores.
+struct TraceEvent{
+    std::atomic<uint64_t> seq{0};
+    std::atomic<const char*> name;
+    std::atomic<uint64_t> start;
+    std::atomic<uint64_t> end;
+};
+
+struct ThreadTraceBuffer{
+    ThreadTraceBuffer(uint64_t p_tid)
+        : tid(p_tid)
+        , events(new TraceEvent[TRACE_BUFFER_SIZE])
+    {}
+
+    const uint64_t tid;
+
+    //  Total events ever written. Only the owning thread writes this.
+    std::atomic<uint64_t> written{0};
+    std::unique_ptr<TraceEvent[]> events;
+
+    //  The thread has exited.
+    std::atomic<bool> retired{false};
+
+    //  Protected by the registry lock.
+    std::string name;
+
+    void push(const char* name, uint64_t start_ns, uint64_t end_ns){
+        uint64_t index = written.load(std::memory_order_relaxed);
+        TraceEvent& event = events[index % TRACE_BUFFER_SIZE];
+        event.seq.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        event.name.store(name, std::memory_order_relaxed);
+        event.start.store(start_ns, std::memory_order_relaxed);
+        event.end.store(end_ns, std::memory_order_relaxed);
+        event.seq.store(2 * index + 2, std::memory_order_release);
+        written.store(index + 1, std::memory_order_release);
+    }
+    uint64_t last_end() const{
+        uint64_t index = written.load(std::memory_order_acquire);
+        if (index == 0){
+            return 0;
+        }
+        return events[(index - 1) % TRACE_BUFFER_SIZE].end.load(std::memory_order_relaxed);
+    }
+};
+
+
+struct TraceRegistry{
+    std::mutex lock;
+    uint64_t next_tid = 1;
+    std::vector<std::shared_ptr<ThreadTraceBuffer>> buffers;
+    std::set<std::string> interned;
+
+    static TraceRegistry& instance(){
+        static TraceRegistry registry;
+        return registry;
+    }
+
+    std::shared_ptr<ThreadTraceBuffer> add_thread(){
+        std::lock_guard<std::mutex> lg(lock);
+
+        //  Drop threads that are gone and haven't had anything recent.
+        uint64_t now = trace_now();
+        size_t keep = 0;
+        for (size_t c = 0; c < buffers.size(); c++){
+            ThreadTraceBuffer& buffer = *buffers[c];
+            if (buffer.retired.load(std::memory_order_acquire) && buffer.last_end() + TRACE_RETIRED_LIFETIME < now){
+                continue;
+            }
+            buffers[keep++] = std::move(buffers[c]);
+        }
+        buffers.resize(keep);
+
+        buffers.emplace_back(std::make_shared<ThreadTraceBuffer>(next_tid++));
+        return buffers.back();
+    }
+};
+
+
+//  Owned by each thread that has recorded something.
+struct ThreadTraceHandle{
+    std::shared_ptr<ThreadTraceBuffer> buffer;
+    std::string pending_name;
+
+    ThreadTraceBuffer& get(){
+        if (!buffer){
+            buffer = TraceRegistry::instance().add_thread();
+            if (!pending_name.empty()){
+                set_name(std::move(pending_name));
+            }
+        }
+        return *buffer;
+    }
+    void set_name(std::string name){
+        if (!buffer){
+            pending_name = std::move(name);
+            return;
+        }
+        TraceRegistry& registry = TraceRegistry::instance();
+        std::lock_guard<std::mutex> lg(registry.lock);
+        buffer->name = std::move(name);
+    }
+    ~ThreadTraceHandle(){
+        if (buffer){
+            buffer->retired.store(true, std::memory_order_release);
+        }
+    }
+};
+thread_local ThreadTraceHandle thread_trace_handle;
+
+
+void append_json_string(std::string& str, const char* text){
+    str += '"';
+    for (const char* ptr = text; *ptr != '\0'; ptr++){
+        char ch = *ptr;
+        switch (ch){
+        case '"':
+            str += "\\\"";
+            break;
+        case '\\':
+            str += "\\\\";
+            break;
+        default:
+            if ((unsigned char)ch < 0x20){
+                str += ' ';
+            }else{
+                str += ch;
+            }
+        }
+    }
+    str += '"';
+}
+void append_microseconds(std::string& str, uint64_t ns){
+    str += std::to_string(ns / 1000);
+    str += '.';
+    std::string fraction = std::to_string(ns % 1000);
+    str.append(3 - fraction.size(), '0');
+    str += fraction;
+}
+
+
+}
+
+
+
+void trace_record(const char* name, uint64_t start_ns, uint64_t end_ns){
+    thread_trace_handle.get().push(name, start_ns, end_ns);
+}
+void set_trace_thread_name(std::string name){
+    thread_trace_handle.set_name(std::move(name));
+}
+const char* trace_intern(const std::string& name){
+    TraceRegistry& registry = TraceRegistry::instance();
+    std::lock_guard<std::mutex> lg(registry.lock);
+    return registry.interned.insert(name).first->c_str();
+}
+
+
+
+std::string export_chrome_trace(std::chrono::milliseconds window){
+    struct Snapshot{
+        uint64_t tid;
+        std::string name;
+        std::shared_ptr<ThreadTraceBuffer> buffer;
+    };
+
+    std::vector<Snapshot> threads;
+    {
+        TraceRegistry& registry = TraceRegistry::instance();
+        std::lock_guard<std::mutex> lg(registry.lock);
+        for (const auto& buffer : registry.buffers){
+            threads.emplace_back(Snapshot{buffer->tid, buffer->name, buffer});
+        }
+    }
+
+    uint64_t now = trace_now();
+    uint64_t window_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(window).count();
+    uint64_t threshold = now > window_ns ? now - window_ns : 0;
+
+    std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    json += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"SerialPrograms\"}}";
+
+    struct Event{
+        const char* name;
+        uint64_t start;
+        uint64_t end;
+    };
+    std::vector<Event> events;
+    for (const Snapshot& thread : threads){
+        std::string tid = std::to_string(thread.tid);
+        std::string name = thread.name.empty() ? "Thread " + tid : thread.name;
+        json += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid + ",\"args\":{\"name\":";
+        append_json_string(json, name.c_str());
+        json += "}}";
+
+        //  Copy out everything that may still be in the ring. Drop any slot
+        //  the thread was writing or had already reused while we copied it.
+        const ThreadTraceBuffer& buffer = *thread.buffer;
+        uint64_t end_index = buffer.written.load(std::memory_order_acquire);
+        uint64_t start_index = end_index > TRACE_BUFFER_SIZE ? end_index - TRACE_BUFFER_SIZE : 0;
+        events.clear();
+        for (uint64_t c = start_index; c < end_index; c++){
+            const TraceEvent& event = buffer.events[c % TRACE_BUFFER_SIZE];
+            uint64_t seq = event.seq.load(std::memory_order_acquire);
+            if (seq != 2 * c + 2){
+                continue;
+            }
+            Event copy{
+                event.name.load(std::memory_order_relaxed),
+                event.start.load(std::memory_order_relaxed),
+                event.end.load(std::memory_order_relaxed),
+            };
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (event.seq.load(std::memory_order_relaxed) != seq){
+                continue;
+            }
+            events.emplace_back(copy);
+        }
+
+        for (const Event& event : events){
+            if (event.end < threshold || event.name == nullptr){
+                continue;
+            }
+            json += ",\n{\"name\":";
+            append_json_string(json, event.name);
+            json += ",\"ph\":\"X\",\"pid\":1,\"tid\":" + tid + ",\"ts\":";
+            append_microseconds(json, event.start);
+            json += ",\"dur\":";
+            append_microseconds(json, event.end - event.start);
+            json += "}";
+        }
+    }
+
+    json += "\n]}\n";
+    return json;
+}
+bool save_chrome_trace(const std::string& path, std::chrono::milliseconds window){
+    std::string json = export_chrome_trace(window);
+    std::ofstream file(path, std::ios::binary);
+    if (!file){
+        return false;
+    }
+    file.write(json.c_str(), json.size());
+    return (bool)file;
+}
+
+
+
+#endif
+
+
+}
@@ -0,0 +1,118 @@
+/*  Tracing
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Scoped trace zones for seeing where time goes across threads.
+ *
+ *  Put "PA_TRACE_ZONE("name");" at the top of a scope. While tracing is
+ *  enabled, the start and end of the scope are recorded into a ring buffer
+ *  owned by the current thread. Only the most recent events of each thread
+ *  are kept. Recording never takes a lock.
+ *
+ *  While tracing is disabled, a zone is a single relaxed load of a global
+ *  flag.
+ *
+ *  "export_chrome_trace()" gathers the events of every thread in a time
+ *  window into the Chrome trace event format. Open it in chrome://tracing or
+ *  https://ui.perfetto.dev.
+ *
+ *  Zone names are not copied. They must be string literals or otherwise live
+ *  forever. Use "trace_intern()" to get one for a string built at runtime.
+ *
+ */
+
+#ifndef PokemonAutomation_Tracing_H
+#define PokemonAutomation_Tracing_H
+
+#include <stdint.h>
+#include <string>
+#include <atomic>
+#include <chrono>
+
+#define PA_TRACE_ENABLE
+
+namespace PokemonAutomation{
+
+
+#ifdef PA_TRACE_ENABLE
+
+extern std::atomic<bool> tracing_enabled_flag;
+
+inline bool tracing_enabled(){
+    return tracing_enabled_flag.load(std::memory_order_relaxed);
+}
+void set_tracing_enabled(bool enabled);
+
+//  Nanoseconds on the steady clock.
+inline uint64_t trace_now(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+//  Record an event for the current thread.
+void trace_record(const char* name, uint64_t start_ns, uint64_t end_ns);
+
+//  Name the current thread in exported traces.
+void set_trace_thread_name(std::string name);
+
+//  Returns a pointer to a copy of "name" that lives forever. The same
+//  string always returns the same pointer.
+const char* trace_intern(const std::string& name);
+
+
+class TraceZone{
+public:
+    TraceZone(const TraceZone&) = delete;
+    void operator=(const TraceZone&) = delete;
+
+    TraceZone(const char* name)
+        : m_name(tracing_enabled() ? name : nullptr)
+        , m_start(m_name == nullptr ? 0 : trace_now())
+    {}
+    ~TraceZone(){
+        if (m_name != nullptr){
+            trace_record(m_name, m_start, trace_now());
+        }
+    }
+
+private:
+    const char* m_name;
+    uint64_t m_start;
+};
+
+
+//  Returns the events that ended in the last "window" as Chrome trace JSON.
+std::string export_chrome_trace(std::chrono::milliseconds window);
+
+//  Write "export_chrome_trace()" to "path". Returns false if the file cannot
+//  be written.
+bool save_chrome_trace(const std::string& path, std::chrono::milliseconds window);
+
+
+#else
+
+inline bool tracing_enabled(){ return false; }
+inline void set_tracing_enabled(bool enabled){}
+inline void set_trace_thread_name(std::string name){}
+inline const char* trace_intern(const std::string& name){ return ""; }
+
+class TraceZone{
+public:
+    TraceZone(const char* name){}
+};
+
+inline std::string export_chrome_trace(std::chrono::milliseconds window){ return "{\"traceEvents\":[]}"; }
+inline bool save_chrome_trace(const std::string& path, std::chrono::milliseconds window){ return false; }
+
+#endif
+
+
+#define PA_TRACE_CONCAT_INNER(a, b) a##b
+#define PA_TRACE_CONCAT(a, b) PA_TRACE_CONCAT_INNER(a, b)
+#define PA_TRACE_ZONE(name) PokemonAutomation::TraceZone PA_TRACE_CONCAT(pa_trace_zone_, __LINE__)(name)
+
+
+
+}
+#endif
@@ -74,11 +74,15 @@ SOURCES += \
     ../3rdParty/QtWavFile/WavFile.cpp \
     ../3rdParty/TesseractPA/TesseractPA.cpp \
     ../ClientSource/Connection/BotBase.cpp \
+    ../ClientSource/Connection/MessageCapture.cpp \
     ../ClientSource/Connection/MessageLogger.cpp \
     ../ClientSource/Connection/PABotBase.cpp \
     ../ClientSource/Connection/PABotBaseConnection.cpp \
     ../ClientSource/Libraries/Logging.cpp \
     ../ClientSource/Libraries/MessageConverter.cpp \
+    ../Common/Cpp/Concurrency/AdaptiveLock.cpp \
+    ../Common/Cpp/Concurrency/ComputationThreadPool.cpp \
+    ../Common/Cpp/Tracing.cpp \
     ../Common/CRC32.cpp \
     ../Common/Cpp/CancellableScope.cpp \
     ../Common/Cpp/Color.cpp \
@@ -95,6 +99,7 @@ SOURCES += \
     ../Common/Cpp/Exceptions.cpp \
     ../Common/Cpp/ImageResolution.cpp \
     ../Common/Cpp/Json/JsonArray.cpp \
+    ../Common/Cpp/Json/JsonLazyObject.cpp \
     ../Common/Cpp/Json/JsonObject.cpp \
     ../Common/Cpp/Json/JsonTools.cpp \
     ../Common/Cpp/Json/JsonValue.cpp \
@@ -154,6 +159,7 @@ SOURCES += \
     ../SerialPrograms/Source/PokemonSwSh/Inference/PokemonSwSh_DialogTriangleDetector.cpp \
     Source/CommonFramework/AudioPipeline/AudioInfo.cpp \
     Source/CommonFramework/AudioPipeline/AudioOption.cpp \
+    Source/CommonFramework/AudioPipeline/AudioReplayFeed.cpp \
     Source/CommonFramework/AudioPipeline/AudioSession.cpp \
     Source/CommonFramework/AudioPipeline/AudioStream.cpp \
     Source/CommonFramework/AudioPipeline/AudioTemplate.cpp \
@@ -165,6 +171,7 @@ SOURCES += \
     Source/CommonFramework/AudioPipeline/Spectrum/AudioSpectrumHolder.cpp \
     Source/CommonFramework/AudioPipeline/Spectrum/FFTStreamer.cpp \
     Source/CommonFramework/AudioPipeline/Spectrum/Spectrograph.cpp \
+    Source/CommonFramework/AudioPipeline/Spectrum/SpectrumBufferPool.cpp \
     Source/CommonFramework/AudioPipeline/Tools/AudioFormatUtils.cpp \
     Source/CommonFramework/AudioPipeline/Tools/TimeSampleBuffer.cpp \
     Source/CommonFramework/AudioPipeline/Tools/TimeSampleBufferReader.cpp \
@@ -194,10 +201,14 @@ SOURCES += \
     Source/CommonFramework/ImageMatch/ImageMatchResult.cpp \
     Source/CommonFramework/ImageMatch/SilhouetteDictionaryMatcher.cpp \
     Source/CommonFramework/ImageMatch/SubObjectTemplateMatcher.cpp \
+    Source/CommonFramework/ImageMatch/TemplateMatcherCache.cpp \
+    Source/CommonFramework/ImageMatch/TemplateMatcherWarmup.cpp \
     Source/CommonFramework/ImageMatch/WaterfillTemplateMatcher.cpp \
+    Source/CommonFramework/ImageTools/BinaryImage_FilterHsv32.cpp \
     Source/CommonFramework/ImageTools/BinaryImage_FilterRgb32.cpp \
     Source/CommonFramework/ImageTools/ColorClustering.cpp \
     Source/CommonFramework/ImageTools/FloatPixel.cpp \
+    Source/CommonFramework/ImageTools/ImageBlockStats.cpp \
     Source/CommonFramework/ImageTools/ImageBoxes.cpp \
     Source/CommonFramework/ImageTools/ImageFilter.cpp \
     Source/CommonFramework/ImageTools/ImageGradient.cpp \
@@ -222,10 +233,14 @@ SOURCES += \
     Source/CommonFramework/Inference/SpectrogramMatcher.cpp \
     Source/CommonFramework/Inference/StatAccumulator.cpp \
     Source/CommonFramework/InferenceInfra/AudioInferencePivot.cpp \
+    Source/CommonFramework/InferenceInfra/AudioInferenceReplay.cpp \
+    Source/CommonFramework/InferenceInfra/InferenceProfiler.cpp \
+    Source/CommonFramework/InferenceInfra/InferenceReplay.cpp \
     Source/CommonFramework/InferenceInfra/InferenceRoutines.cpp \
     Source/CommonFramework/InferenceInfra/InferenceSession.cpp \
     Source/CommonFramework/InferenceInfra/VisualInferenceCallback.cpp \
     Source/CommonFramework/InferenceInfra/VisualInferencePivot.cpp \
+    Source/CommonFramework/InferenceInfra/VisualInferenceReplay.cpp \
     Source/CommonFramework/Language.cpp \
     Source/CommonFramework/Logging/FileWindowLogger.cpp \
     Source/CommonFramework/Logging/Logger.cpp \
@@ -270,8 +285,11 @@ SOURCES += \
     Source/CommonFramework/Panels/UI/SettingsPanelWidget.cpp \
     Source/CommonFramework/PersistentSettings.cpp \
     Source/CommonFramework/ProgramSession.cpp \
+    Source/CommonFramework/Resources/ResourceBundle.cpp \
     Source/CommonFramework/Resources/SpriteDatabase.cpp \
+    Source/CommonFramework/Resources/SpriteSheetStore.cpp \
     Source/CommonFramework/SetupSettings.cpp \
+    Source/CommonFramework/Tools/AsyncImageWriter.cpp \
     Source/CommonFramework/Tools/BlackBorderCheck.cpp \
     Source/CommonFramework/Tools/BotBaseHandle.cpp \
     Source/CommonFramework/Tools/ConsoleHandle.cpp \
@@ -290,6 +308,7 @@ SOURCES += \
     Source/CommonFramework/VideoPipeline/Backends/CameraWidgetQt6.cpp \
     Source/CommonFramework/VideoPipeline/Backends/VideoToolsQt5.cpp \
     Source/CommonFramework/VideoPipeline/CameraOption.cpp \
+    Source/CommonFramework/VideoPipeline/RollingVideoBuffer.cpp \
     Source/CommonFramework/VideoPipeline/Stats/ThreadUtilizationStats.cpp \
     Source/CommonFramework/VideoPipeline/UI/CameraSelectorWidget.cpp \
     Source/CommonFramework/VideoPipeline/UI/VideoDisplayWidget.cpp \
@@ -298,6 +317,7 @@ SOURCES += \
     Source/CommonFramework/VideoPipeline/VideoOverlayOption.cpp \
     Source/CommonFramework/VideoPipeline/VideoOverlaySession.cpp \
     Source/CommonFramework/VideoPipeline/VideoOverlayTypes.cpp \
+    Source/CommonFramework/VideoPipeline/VideoReplayFeed.cpp \
     Source/CommonFramework/Windows/ButtonDiagram.cpp \
     Source/CommonFramework/Windows/DpiScaler.cpp \
     Source/CommonFramework/Windows/MainWindow.cpp \
@@ -348,12 +368,26 @@ SOURCES += \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_x64_AVX2.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_x64_AVX512.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_x64_SSE42.cpp \
+    Source/Kernels/ImageFilters/Kernels_ImageFilter_RgbToHsv.cpp \
+    Source/Kernels/ImageFilters/Kernels_ImageFilter_RgbToHsv_arm64_NEON.cpp \
+    Source/Kernels/ImageFilters/Kernels_ImageFilter_RgbToHsv_Default.cpp \
+    Source/Kernels/ImageFilters/Kernels_ImageFilter_RgbToHsv_x64_AVX2.cpp \
+    Source/Kernels/ImageFilters/Kernels_ImageFilter_RgbToHsv_x64_AVX512.cpp \
+    Source/Kernels/ImageFilters/Kernels_ImageFilter_RgbToHsv_x64_SSE41.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_Default.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_arm64_NEON.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_x64_AVX2.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_x64_AVX512.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_x64_SSE41.cpp \
+    Source/Kernels/ImageStats/Kernels_ImagePixelBlockSums.cpp \
+    Source/Kernels/ImageStats/Kernels_ImagePixelBlockSums_Default.cpp \
+    Source/Kernels/ImageStats/Kernels_ImagePixelBlockSums_x64_AVX2.cpp \
+    Source/Kernels/ImageStats/Kernels_ImagePixelBlockSums_x64_SSE41.cpp \
+    Source/Kernels/ImageStats/Kernels_ImagePixelMoments.cpp \
+    Source/Kernels/ImageStats/Kernels_ImagePixelMoments_Default.cpp \
+    Source/Kernels/ImageStats/Kernels_ImagePixelMoments_x64_AVX2.cpp \
+    Source/Kernels/ImageStats/Kernels_ImagePixelMoments_x64_SSE41.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev_Default.cpp \
@@ -364,6 +398,12 @@ SOURCES += \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr_x64_AVX2.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr_x64_AVX512.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr_x64_SSE41.cpp \
+    Source/Kernels/PlaneFilters/Kernels_PlaneFilters.cpp \
+    Source/Kernels/PlaneFilters/Kernels_PlaneFilters_Core_arm64_NEON.cpp \
+    Source/Kernels/PlaneFilters/Kernels_PlaneFilters_Core_Default.cpp \
+    Source/Kernels/PlaneFilters/Kernels_PlaneFilters_Core_x86_AVX2.cpp \
+    Source/Kernels/PlaneFilters/Kernels_PlaneFilters_Core_x86_AVX512.cpp \
+    Source/Kernels/PlaneFilters/Kernels_PlaneFilters_Core_x86_SSE41.cpp \
     Source/Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch.cpp \
     Source/Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch_Core_Default.cpp \
     Source/Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch_Core_x86_AVX2.cpp \
@@ -855,6 +895,7 @@ SOURCES += \
     Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Matchup.cpp \
     Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Moves.cpp \
     Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Pokemon.cpp \
+    Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Simulation.cpp \
     Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Stats.cpp \
     Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Types.cpp \
     Source/PokemonSwSh/PokemonSwSh_Panels.cpp \
@@ -945,6 +986,7 @@ SOURCES += \
     Source/PokemonSwSh/ShinyHuntTracker.cpp \
     Source/Tests/CommandLineTests.cpp \
     Source/Tests/CommonFramework_Tests.cpp \
+    Source/Tests/KernelBenchmarks.cpp \
     Source/Tests/Kernels_Tests.cpp \
     Source/Tests/NintendoSwitch_Tests.cpp \
     Source/Tests/PokemonLA_Tests.cpp \
@@ -1032,6 +1074,7 @@ HEADERS += \
     ../3rdParty/nlohmann/json.hpp \
     ../ClientSource/Connection/BotBase.h \
     ../ClientSource/Connection/BotBaseMessage.h \
+    ../ClientSource/Connection/MessageCapture.h \
     ../ClientSource/Connection/MessageLogger.h \
     ../ClientSource/Connection/MessageSniffer.h \
     ../ClientSource/Connection/PABotBase.h \
@@ -1042,6 +1085,9 @@ HEADERS += \
     ../ClientSource/Connection/StreamInterface.h \
     ../ClientSource/Libraries/Logging.h \
     ../ClientSource/Libraries/MessageConverter.h \
+    ../Common/Cpp/Concurrency/AdaptiveLock.h \
+    ../Common/Cpp/Concurrency/ComputationThreadPool.h \
+    ../Common/Cpp/Tracing.h \
     ../Common/CRC32.h \
     ../Common/Compiler.h \
     ../Common/Cpp/AbstractLogger.h \
@@ -1074,6 +1120,7 @@ HEADERS += \
     ../Common/Cpp/Exceptions.h \
     ../Common/Cpp/ImageResolution.h \
     ../Common/Cpp/Json/JsonArray.h \
+    ../Common/Cpp/Json/JsonLazyObject.h \
     ../Common/Cpp/Json/JsonObject.h \
     ../Common/Cpp/Json/JsonTools.h \
     ../Common/Cpp/Json/JsonValue.h \
@@ -1152,6 +1199,7 @@ HEADERS += \
     Source/CommonFramework/AudioPipeline/AudioInfo.h \
     Source/CommonFramework/AudioPipeline/AudioOption.h \
     Source/CommonFramework/AudioPipeline/AudioPassthroughPair.h \
+    Source/CommonFramework/AudioPipeline/AudioReplayFeed.h \
     Source/CommonFramework/AudioPipeline/AudioSession.h \
     Source/CommonFramework/AudioPipeline/AudioStream.h \
     Source/CommonFramework/AudioPipeline/AudioTemplate.h \
@@ -1163,6 +1211,7 @@ HEADERS += \
     Source/CommonFramework/AudioPipeline/Spectrum/AudioSpectrumHolder.h \
     Source/CommonFramework/AudioPipeline/Spectrum/FFTStreamer.h \
     Source/CommonFramework/AudioPipeline/Spectrum/Spectrograph.h \
+    Source/CommonFramework/AudioPipeline/Spectrum/SpectrumBufferPool.h \
     Source/CommonFramework/AudioPipeline/Tools/AudioFormatUtils.h \
     Source/CommonFramework/AudioPipeline/Tools/AudioNormalization.h \
     Source/CommonFramework/AudioPipeline/Tools/TimeSampleBuffer.h \
@@ -1205,11 +1254,15 @@ HEADERS += \
     Source/CommonFramework/ImageMatch/ImageMatchResult.h \
     Source/CommonFramework/ImageMatch/SilhouetteDictionaryMatcher.h \
     Source/CommonFramework/ImageMatch/SubObjectTemplateMatcher.h \
+    Source/CommonFramework/ImageMatch/TemplateMatcherCache.h \
+    Source/CommonFramework/ImageMatch/TemplateMatcherWarmup.h \
     Source/CommonFramework/ImageMatch/WaterfillTemplateMatcher.h \
+    Source/CommonFramework/ImageTools/BinaryImage_FilterHsv32.h \
     Source/CommonFramework/ImageTools/BinaryImage_FilterRgb32.h \
     Source/CommonFramework/ImageTools/ColorClustering.h \
     Source/CommonFramework/ImageTools/DistanceToLine.h \
     Source/CommonFramework/ImageTools/FloatPixel.h \
+    Source/CommonFramework/ImageTools/ImageBlockStats.h \
     Source/CommonFramework/ImageTools/ImageBoxes.h \
     Source/CommonFramework/ImageTools/ImageFilter.h \
     Source/CommonFramework/ImageTools/ImageGradient.h \
@@ -1239,11 +1292,16 @@ HEADERS += \
     Source/CommonFramework/Inference/VisualDetector.h \
     Source/CommonFramework/InferenceInfra/AudioInferenceCallback.h \
     Source/CommonFramework/InferenceInfra/AudioInferencePivot.h \
+    Source/CommonFramework/InferenceInfra/AudioInferenceReplay.h \
     Source/CommonFramework/InferenceInfra/InferenceCallback.h \
+    Source/CommonFramework/InferenceInfra/InferenceProfiler.h \
+    Source/CommonFramework/InferenceInfra/InferenceReplay.h \
+    Source/CommonFramework/InferenceInfra/InferenceReplay.tpp \
     Source/CommonFramework/InferenceInfra/InferenceRoutines.h \
     Source/CommonFramework/InferenceInfra/InferenceSession.h \
     Source/CommonFramework/InferenceInfra/VisualInferenceCallback.h \
     Source/CommonFramework/InferenceInfra/VisualInferencePivot.h \
+    Source/CommonFramework/InferenceInfra/VisualInferenceReplay.h \
     Source/CommonFramework/Language.h \
     Source/CommonFramework/Logging/FileWindowLogger.h \
     Source/CommonFramework/Logging/Logger.h \
@@ -1290,8 +1348,11 @@ HEADERS += \
     Source/CommonFramework/Panels/UI/SettingsPanelWidget.h \
     Source/CommonFramework/PersistentSettings.h \
     Source/CommonFramework/ProgramSession.h \
+    Source/CommonFramework/Resources/ResourceBundle.h \
     Source/CommonFramework/Resources/SpriteDatabase.h \
+    Source/CommonFramework/Resources/SpriteSheetStore.h \
     Source/CommonFramework/SetupSettings.h \
+    Source/CommonFramework/Tools/AsyncImageWriter.h \
     Source/CommonFramework/Tools/BlackBorderCheck.h \
     Source/CommonFramework/Tools/BotBaseHandle.h \
     Source/CommonFramework/Tools/ConsoleHandle.h \
@@ -1312,6 +1373,7 @@ HEADERS += \
     Source/CommonFramework/VideoPipeline/CameraInfo.h \
     Source/CommonFramework/VideoPipeline/CameraOption.h \
     Source/CommonFramework/VideoPipeline/CameraSession.h \
+    Source/CommonFramework/VideoPipeline/RollingVideoBuffer.h \
     Source/CommonFramework/VideoPipeline/Stats/CpuUtilizationStats.h \
     Source/CommonFramework/VideoPipeline/Stats/ThreadUtilizationStats.h \
     Source/CommonFramework/VideoPipeline/UI/CameraSelectorWidget.h \
@@ -1325,6 +1387,7 @@ HEADERS += \
     Source/CommonFramework/VideoPipeline/VideoOverlayScopes.h \
     Source/CommonFramework/VideoPipeline/VideoOverlaySession.h \
     Source/CommonFramework/VideoPipeline/VideoOverlayTypes.h \
+    Source/CommonFramework/VideoPipeline/VideoReplayFeed.h \
     Source/CommonFramework/Windows/ButtonDiagram.h \
     Source/CommonFramework/Windows/DpiScaler.h \
     Source/CommonFramework/Windows/MainWindow.h \
@@ -1391,7 +1454,11 @@ HEADERS += \
     Source/Kernels/BinaryMatrix/Kernels_SparseBinaryMatrixCore.h \
     Source/Kernels/BinaryMatrix/Kernels_SparseBinaryMatrixCore.tpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic.h \
+    Source/Kernels/ImageFilters/Kernels_ImageFilter_RgbToHsv.h \
+    Source/Kernels/ImageFilters/Kernels_ImageFilter_RgbToHsv_Routines.h \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h \
+    Source/Kernels/ImageStats/Kernels_ImagePixelBlockSums.h \
+    Source/Kernels/ImageStats/Kernels_ImagePixelMoments.h \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr.h \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.h \
     Source/Kernels/Kernels_Alignment.h \
@@ -1404,6 +1471,8 @@ HEADERS += \
     Source/Kernels/PartialWordAccess/Kernels_PartialWordAccess_arm64_NEON.h \
     Source/Kernels/PartialWordAccess/Kernels_PartialWordAccess_x64_AVX2.h \
     Source/Kernels/PartialWordAccess/Kernels_PartialWordAccess_x64_SSE41.h \
+    Source/Kernels/PlaneFilters/Kernels_PlaneFilters.h \
+    Source/Kernels/PlaneFilters/Kernels_PlaneFilters_Routines.h \
     Source/Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch.h \
     Source/Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch_Routines.h \
     Source/Kernels/SpikeConvolution/Kernels_SpikeConvolution.h \
@@ -1908,6 +1977,7 @@ HEADERS += \
     Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Matchup.h \
     Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Moves.h \
     Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Pokemon.h \
+    Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Simulation.h \
     Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Stats.h \
     Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Types.h \
     Source/PokemonSwSh/PokemonSwSh_Panels.h \
@@ -2003,6 +2073,7 @@ HEADERS += \
     Source/PokemonSwSh/ShinyHuntTracker.h \
     Source/Tests/CommandLineTests.h \
     Source/Tests/CommonFramework_Tests.h \
+    Source/Tests/KernelBenchmarks.h \
     Source/Tests/Kernels_Tests.h \
     Source/Tests/NintendoSwitch_Tests.h \
     Source/Tests/PokemonLA_Tests.h \
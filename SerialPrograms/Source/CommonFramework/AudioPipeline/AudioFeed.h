@@ -10,6 +10,7 @@
 #include <memory>
 #include <vector>
 #include "Common/Cpp/Color.h"
+#include "Common/Cpp/Time.h"
 #include "Common/Cpp/Containers/AlignedVector.h"
 
 namespace PokemonAutomation{
@@ -30,10 +31,18 @@ public:
     //  higher frequencies.
     std::shared_ptr<const AlignedVector<float>> magnitudes;
 
-    AudioSpectrum(uint64_t s, size_t rate, std::shared_ptr<const AlignedVector<float>> m)
+    //  When the window ended. For live audio this is when the spectrum was
+    //  computed. For recorded audio it is the position in the recording.
+    WallClock timestamp;
+
+    AudioSpectrum(
+        uint64_t s, size_t rate, std::shared_ptr<const AlignedVector<float>> m,
+        WallClock t = current_time()
+    )
         : stamp(s)
         , sample_rate(rate)
         , magnitudes(std::move(m))
+        , timestamp(t)
     {}
 };
 
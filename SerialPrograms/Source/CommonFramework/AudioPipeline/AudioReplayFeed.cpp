@@ -0,0 +1,139 @@
+/*  Audio Replay Feed
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <QAudioFormat>
+#include "Common/Cpp/Exceptions.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "Tools/AudioFormatUtils.h"
+#include "IO/AudioFileLoader.h"
+#include "AudioStream.h"
+#include "AudioReplayFeed.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+AudioReplayFeed::~AudioReplayFeed(){
+    m_fft->remove_listener(*this);
+}
+AudioReplayFeed::AudioReplayFeed(Logger& logger, const std::string& path, AudioChannelFormat format)
+    : m_logger(logger)
+    , m_path(path)
+    , m_format(format)
+    , m_start(current_time())
+    , m_push_time(m_start)
+{
+    switch (format){
+    case AudioChannelFormat::MONO_48000:
+        m_sample_rate = 48000;
+        m_channels = 1;
+        break;
+    case AudioChannelFormat::DUAL_44100:
+        m_sample_rate = 44100;
+        m_channels = 2;
+        break;
+    default:
+        throw InternalProgramError(&logger, PA_CURRENT_FUNCTION, "Unsupported replay format: " + std::to_string((size_t)format));
+    }
+
+    QAudioFormat audio_format;
+    audio_format.setChannelCount((int)m_channels);
+#if QT_VERSION_MAJOR == 5
+    audio_format.setCodec("audio/pcm");
+#endif
+    audio_format.setSampleRate((int)m_sample_rate);
+    setSampleFormatToFloat(audio_format);
+
+    AudioFileLoader loader(nullptr, path, audio_format);
+    const auto ret = loader.loadFullAudio();
+    const float* data = reinterpret_cast<const float*>(std::get<0>(ret));
+    if (data == nullptr){
+        throw FileException(&logger, PA_CURRENT_FUNCTION, "Unable to decode audio.", path);
+    }
+    m_samples.assign(data, data + std::get<1>(ret) / sizeof(float));
+    m_frames = m_samples.size() / m_channels;
+
+    build_pipeline();
+
+    m_logger.log(
+        "Loaded recording: " + path + " (" + std::to_string(m_sample_rate) + " Hz, " +
+        std::to_string(duration().count()) + " ms)"
+    );
+}
+void AudioReplayFeed::build_pipeline(){
+    if (m_fft){
+        m_fft->remove_listener(*this);
+    }
+    m_reader.reset(new AudioStreamToFloat(AudioSampleFormat::FLOAT32, m_channels, 1.0f, false));
+    m_fft = make_FFT_streamer(m_format);
+    m_reader->add_listener(*m_fft);
+    m_fft->add_listener(*this);
+}
+
+
+std::chrono::milliseconds AudioReplayFeed::duration() const{
+    return std::chrono::milliseconds(m_frames * 1000 / m_sample_rate);
+}
+std::chrono::milliseconds AudioReplayFeed::position() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return std::chrono::milliseconds(m_position * 1000 / m_sample_rate);
+}
+WallClock AudioReplayFeed::start_time() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_start;
+}
+bool AudioReplayFeed::finished() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_position >= m_frames;
+}
+void AudioReplayFeed::push_until(std::chrono::milliseconds time){
+    std::lock_guard<std::mutex> lg(m_lock);
+    size_t end = (size_t)std::max<int64_t>(time.count(), 0) * m_sample_rate / 1000;
+    end = std::min(end, m_frames);
+    if (end <= m_position){
+        return;
+    }
+
+    //  Everything computed from this push is stamped with the end of it.
+    m_push_time = m_start + std::chrono::microseconds((uint64_t)end * 1000000 / m_sample_rate);
+    m_reader->push_bytes(
+        m_samples.data() + m_position * m_channels,
+        (end - m_position) * m_channels * sizeof(float)
+    );
+    m_position = end;
+}
+
+
+void AudioReplayFeed::reset(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_spectrums.clear();
+    build_pipeline();
+    m_start = current_time();
+    m_push_time = m_start;
+    m_position = 0;
+}
+std::vector<AudioSpectrum> AudioReplayFeed::spectrums_since(uint64_t starting_seqnum){
+    return m_spectrums.spectrums_since(starting_seqnum);
+}
+std::vector<AudioSpectrum> AudioReplayFeed::spectrums_latest(size_t num_last_spectrums){
+    return m_spectrums.spectrums_latest(num_last_spectrums);
+}
+void AudioReplayFeed::add_overlay(uint64_t starting_seqnum, size_t end_seqnum, Color color){
+    m_spectrums.add_overlay(starting_seqnum, end_seqnum, color);
+}
+void AudioReplayFeed::on_fft(size_t sample_rate, std::shared_ptr<AlignedVector<float>> fft_output){
+    //  Called inside "push_until()" with the lock held.
+    m_spectrums.push_spectrum(sample_rate, std::move(fft_output), m_push_time);
+}
+
+
+
+
+}
@@ -0,0 +1,104 @@
+/*  Audio Replay Feed
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      An audio feed that plays back a recorded file instead of a live
+ *  device. Used to run audio inference offline for tuning and benchmarking.
+ *
+ *  The file is decoded up front. The samples are then pushed through the same
+ *  pipeline as live audio: AudioStreamToFloat -> AudioFloatToFFT ->
+ *  AudioSpectrumHolder. Nothing is pushed on its own. The caller decides how
+ *  fast to play by calling "push_until()".
+ *
+ *  The timestamps of the spectrums are in audio time starting from
+ *  "start_time()". So detectors see the same timing regardless of how fast the
+ *  recording is played.
+ *
+ */
+
+#ifndef PokemonAutomation_AudioPipeline_AudioReplayFeed_H
+#define PokemonAutomation_AudioPipeline_AudioReplayFeed_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include "AudioFeed.h"
+#include "AudioInfo.h"
+#include "Spectrum/FFTStreamer.h"
+#include "Spectrum/AudioSpectrumHolder.h"
+
+namespace PokemonAutomation{
+
+class Logger;
+
+
+class AudioReplayFeed final : public AudioFeed, private FFTListener{
+public:
+    //  Only MONO_48000 and DUAL_44100 are supported. The file must have the
+    //  same sample rate.
+    //  Throws FileException if the file cannot be decoded.
+    AudioReplayFeed(
+        Logger& logger, const std::string& path,
+        AudioChannelFormat format = AudioChannelFormat::MONO_48000
+    );
+    ~AudioReplayFeed();
+
+    const std::string& path() const{ return m_path; }
+    size_t sample_rate() const{ return m_sample_rate; }
+
+    std::chrono::milliseconds duration() const;
+
+    //  How much of the recording has been pushed so far.
+    std::chrono::milliseconds position() const;
+
+    //  The time of the start of the recording.
+    WallClock start_time() const;
+
+    //  Push everything up to "time" into the pipeline.
+    void push_until(std::chrono::milliseconds time);
+
+    //  Returns true if the entire recording has been pushed.
+    bool finished() const;
+
+
+public:
+    //  Rewind to the start and clear all the spectrums.
+    virtual void reset() override;
+
+    virtual std::vector<AudioSpectrum> spectrums_since(uint64_t starting_seqnum) override;
+    virtual std::vector<AudioSpectrum> spectrums_latest(size_t num_last_spectrums) override;
+    virtual void add_overlay(uint64_t starting_seqnum, size_t end_seqnum, Color color) override;
+
+
+private:
+    virtual void on_fft(size_t sample_rate, std::shared_ptr<AlignedVector<float>> fft_output) override;
+
+    void build_pipeline();
+
+
+private:
+    Logger& m_logger;
+    const std::string m_path;
+    const AudioChannelFormat m_format;
+    size_t m_sample_rate;
+    size_t m_channels;
+
+    //  Interleaved float samples.
+    std::vector<float> m_samples;
+    size_t m_frames;
+
+    mutable std::mutex m_lock;
+    WallClock m_start;
+    size_t m_position = 0;
+    WallClock m_push_time;
+
+    AudioSpectrumHolder m_spectrums;
+    std::unique_ptr<AudioStreamToFloat> m_reader;
+    std::unique_ptr<AudioFloatToFFT> m_fft;
+};
+
+
+
+}
+#endif
@@ -7,6 +7,7 @@
 #include <sstream>
 #include "Common/Cpp/Containers/AlignedVector.tpp"
 #include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/Resources/ResourceBundle.h"
 #include "Kernels/Kernels_Alignment.h"
 #include "Kernels/AbsFFT/Kernels_AbsFFT.h"
 #include "AudioConstants.h"
@@ -37,6 +38,11 @@ AudioTemplate::AudioTemplate(size_t frequencies, size_t windows)
 
 
 AudioTemplate loadAudioTemplate(const std::string& filename, size_t sample_rate){
+    AudioTemplate bundled;
+    if (ResourceBundle::instance().load_audio_template(filename, sample_rate, bundled)){
+        return bundled;
+    }
+
     QAudioFormat outputAudioFormat;
     outputAudioFormat.setChannelCount(1);
 #if QT_VERSION_MAJOR == 5
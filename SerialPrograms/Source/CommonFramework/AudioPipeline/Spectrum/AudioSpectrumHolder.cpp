@@ -145,14 +145,17 @@ PA_FORCE_INLINE uint32_t jetColorMap(float v){
     }
 }
 
-void AudioSpectrumHolder::push_spectrum(size_t sample_rate, std::shared_ptr<const AlignedVector<float>> fft_output){
+void AudioSpectrumHolder::push_spectrum(
+    size_t sample_rate, std::shared_ptr<const AlignedVector<float>> fft_output,
+    WallClock timestamp
+){
     std::lock_guard<std::mutex> lg(m_state_lock);
 
     const AlignedVector<float>& output = *fft_output;
 
     {
         const size_t stamp = (m_spectrums.size() > 0) ? m_spectrums.front().stamp + 1 : m_spectrum_stamp_start;
-        m_spectrums.emplace_front(stamp, sample_rate, fft_output);
+        m_spectrums.emplace_front(stamp, sample_rate, fft_output, timestamp);
         if (m_spectrums.size() > m_spectrum_history_length){
             m_spectrums.pop_back();
         }
@@ -36,7 +36,10 @@ public:
 
 
 public:
-    void push_spectrum(size_t sample_rate, std::shared_ptr<const AlignedVector<float>> fft_output);
+    void push_spectrum(
+        size_t sample_rate, std::shared_ptr<const AlignedVector<float>> fft_output,
+        WallClock timestamp = current_time()
+    );
     void add_overlay(uint64_t starting_stamp, uint64_t end_stamp, Color color);
 
 
@@ -53,6 +53,8 @@ AudioFloatToFFT::AudioFloatToFFT(
     , m_buffer(NUM_FFT_SAMPLES)
     , m_buffered(NUM_FFT_SAMPLES)
     , m_fft_input(NUM_FFT_SAMPLES)
+    , m_fft_scratch(NUM_FFT_SAMPLES)
+    , m_output_pool(NUM_FFT_SAMPLES / 2, 256)
 {
     if (samples_per_frame == 0 || samples_per_frame > 2){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Channels must be 1 or 2.");
@@ -100,21 +102,39 @@ void AudioFloatToFFT::convert(float* fft_input, const float* audio_stream, size_
     }
 }
 void AudioFloatToFFT::run_fft(){
-    float* ptr = m_fft_input.data();
-    size_t remaining = NUM_FFT_SAMPLES;
-    size_t index = m_start;
-    while (remaining > 0){
-        size_t block = std::min(remaining, m_buffer.size() - index);
-        memcpy(ptr, &m_buffer[index], block * sizeof(float));
-        ptr += block;
-        remaining -= block;
-        index += block;
-        if (index == m_buffer.size()){
-            index = 0;
+    std::shared_ptr<AlignedVector<float>> out = m_output_pool.get();
+
+    //  The window always advances by a multiple of a quarter. So each quarter
+    //  of it is contiguous in the ring buffer and can be read in place.
+    const size_t QUARTER = NUM_FFT_SAMPLES / 4;
+    if (m_start % QUARTER == 0){
+        const float* quarters[4];
+        size_t index = m_start;
+        for (size_t c = 0; c < 4; c++){
+            quarters[c] = &m_buffer[index];
+            index += QUARTER;
+            if (index == m_buffer.size()){
+                index = 0;
+            }
         }
+        Kernels::AbsFFT::fft_abs(FFT_LENGTH_POWER_OF_TWO, out->data(), quarters, m_fft_scratch.data());
+    }else{
+        float* ptr = m_fft_input.data();
+        size_t remaining = NUM_FFT_SAMPLES;
+        size_t index = m_start;
+        while (remaining > 0){
+            size_t block = std::min(remaining, m_buffer.size() - index);
+            memcpy(ptr, &m_buffer[index], block * sizeof(float));
+            ptr += block;
+            remaining -= block;
+            index += block;
+            if (index == m_buffer.size()){
+                index = 0;
+            }
+        }
+        Kernels::AbsFFT::fft_abs(FFT_LENGTH_POWER_OF_TWO, out->data(), m_fft_input.data());
     }
-    std::shared_ptr<AlignedVector<float>> out = std::make_unique<AlignedVector<float>>(NUM_FFT_SAMPLES / 2);
-    Kernels::AbsFFT::fft_abs(FFT_LENGTH_POWER_OF_TWO, out->data(), m_fft_input.data());
+
     for (FFTListener* listener : m_listeners){
         listener->on_fft(m_sample_rate, out);
     }
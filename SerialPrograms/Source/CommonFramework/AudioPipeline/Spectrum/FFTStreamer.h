@@ -8,6 +8,7 @@
 #define PokemonAutomation_AudioPipeline_FFTStreamer_H
 
 #include "CommonFramework/AudioPipeline/AudioStream.h"
+#include "SpectrumBufferPool.h"
 
 namespace PokemonAutomation{
 
@@ -49,7 +50,12 @@ private:
     size_t m_start = 0;
     size_t m_end = 0;
 
+    //  Only used if the window wraps around the ring buffer in the middle of
+    //  a quarter. Otherwise the FFT reads directly from "m_buffer".
     AlignedVector<float> m_fft_input;
+    AlignedVector<float> m_fft_scratch;
+
+    SpectrumBufferPool m_output_pool;
 
     std::set<FFTListener*> m_listeners;
 };
@@ -0,0 +1,55 @@
+/*  Spectrum Buffer Pool
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <atomic>
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "SpectrumBufferPool.h"
+
+namespace PokemonAutomation{
+
+
+
+SpectrumBufferPool::SpectrumBufferPool(size_t buffer_size, size_t max_buffers)
+    : m_buffer_size(buffer_size)
+    , m_max_buffers(max_buffers)
+{
+    m_buffers.reserve(max_buffers);
+}
+
+std::shared_ptr<AlignedVector<float>> SpectrumBufferPool::get(){
+    //  Listeners generally release spectra in the order they received them.
+    //  So start the search from the buffer after the last one handed out.
+    //  In steady state, the first buffer checked is free.
+    size_t size = m_buffers.size();
+    for (size_t c = 0; c < size; c++){
+        size_t index = m_next + c;
+        if (index >= size){
+            index -= size;
+        }
+        std::shared_ptr<AlignedVector<float>>& buffer = m_buffers[index];
+        if (buffer.use_count() != 1){
+            continue;
+        }
+
+        //  The last release by another thread must be visible before we
+        //  overwrite the buffer.
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        m_next = index + 1 == size ? 0 : index + 1;
+        return buffer;
+    }
+
+    std::shared_ptr<AlignedVector<float>> buffer = std::make_shared<AlignedVector<float>>(m_buffer_size);
+    if (size < m_max_buffers){
+        m_buffers.emplace_back(buffer);
+        m_next = 0;
+    }
+    return buffer;
+}
+
+
+
+}
@@ -0,0 +1,49 @@
+/*  Spectrum Buffer Pool
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Recycles the output buffers of the FFT so that the audio pipeline does
+ *  not allocate a new spectrum every hop.
+ *
+ *  Every buffer handed out is also held by the pool. Once all the listeners
+ *  have released their copies, the pool is the last holder and the buffer is
+ *  returned for reuse. After the pool has grown enough to cover the longest
+ *  any listener keeps its spectra, it stops allocating.
+ *
+ *  Only the thread that owns the pool may call get(). The buffers themselves
+ *  may be held and released from any thread.
+ *
+ */
+
+#ifndef PokemonAutomation_AudioPipeline_SpectrumBufferPool_H
+#define PokemonAutomation_AudioPipeline_SpectrumBufferPool_H
+
+#include <memory>
+#include <vector>
+#include "Common/Cpp/Containers/AlignedVector.h"
+
+namespace PokemonAutomation{
+
+
+class SpectrumBufferPool{
+public:
+    //  Buffers beyond "max_buffers" are still handed out, but not recycled.
+    SpectrumBufferPool(size_t buffer_size, size_t max_buffers);
+
+    size_t buffer_size() const{ return m_buffer_size; }
+    size_t pooled() const{ return m_buffers.size(); }
+
+    //  Get a buffer of "buffer_size()" floats. The contents are undefined.
+    std::shared_ptr<AlignedVector<float>> get();
+
+private:
+    size_t m_buffer_size;
+    size_t m_max_buffers;
+    size_t m_next = 0;
+    std::vector<std::shared_ptr<AlignedVector<float>>> m_buffers;
+};
+
+
+
+}
+#endif
@@ -4,17 +4,43 @@
  *
  */
 
+#include <QDir>
+#include "Common/Cpp/PrettyPrint.h"
+#include "CommonFramework/Globals.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "SerialPortSession.h"
 
 namespace PokemonAutomation{
 
 
+namespace{
+
+std::unique_ptr<MessageCapture> open_capture(SerialLogger& logger){
+    if (!GlobalSettings::instance().CAPTURE_SERIAL_MESSAGES){
+        return nullptr;
+    }
+    std::string folder = DEBUG_PATH() + "SerialCaptures/";
+    QDir().mkpath(QString::fromStdString(folder));
+    try{
+        std::unique_ptr<MessageCapture> capture(new MessageCapture(folder + now_to_filestring() + ".pacap"));
+        logger.set_capture(capture.get());
+        logger.log("Capturing serial messages to: " + capture->filename(), COLOR_BLUE);
+        return capture;
+    }catch (const FileException& error){
+        logger.log(error.message(), COLOR_RED);
+        return nullptr;
+    }
+}
+
+}
+
+
 
 SerialPortSession::~SerialPortSession(){}
 SerialPortSession::SerialPortSession(Logger& logger, SerialPortOption& option)
     : m_option(option)
     , m_logger(logger, GlobalSettings::instance().LOG_EVERYTHING)
+    , m_capture(open_capture(m_logger))
     , m_connection(m_logger, option.port(), option.minimum_pabotbase())
 {}
 
@@ -30,6 +56,7 @@ QSerialPortInfo SerialPortSession::get() const{
 void SerialPortSession::set(QSerialPortInfo port){
     std::lock_guard<std::mutex> lg(m_lock);
     m_option.set_port(std::move(port));
+    start_capture();
     m_connection.reset(m_option.port());
 }
 void SerialPortSession::set(const QSerialPortInfo* port){
@@ -45,6 +72,11 @@ void SerialPortSession::remove_listener(Listener& listener){
     std::lock_guard<std::mutex> lg(m_lock);
     m_listeners.erase(&listener);
 }
+void SerialPortSession::start_capture(){
+    if (m_capture == nullptr){
+        m_capture = open_capture(m_logger);
+    }
+}
 void SerialPortSession::push_ready(bool ready){
     std::lock_guard<std::mutex> lg(m_lock);
     for (Listener* listener : m_listeners){
@@ -63,6 +95,7 @@ void SerialPortSession::reset(){
     for (Listener* listener : m_listeners){
         listener->on_ready(false);
     }
+    start_capture();
     m_connection.reset(m_option.port());
 }
 
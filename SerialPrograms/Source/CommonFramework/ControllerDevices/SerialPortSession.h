@@ -21,9 +21,11 @@
 #define PokemonAutomation_SerialPortSession_H
 
 #include <set>
+#include <memory>
 #include "Common/Cpp/LifetimeSanitizer.h"
 #include "CommonFramework/Tools/BotBaseHandle.h"
 #include "ClientSource/Connection/MessageLogger.h"
+#include "ClientSource/Connection/MessageCapture.h"
 #include "SerialPortOption.h"
 
 namespace PokemonAutomation{
@@ -61,11 +63,18 @@ public:
 
 private:
     void push_ready(bool ready);
+    void start_capture();
 
 
 private:
     SerialPortOption& m_option;
     SerialLogger m_logger;
+
+    //  Opened the first time the port is (re)started with
+    //  "CAPTURE_SERIAL_MESSAGES" on. Stays open until the session is
+    //  destroyed since the connection threads may be using it.
+    std::unique_ptr<MessageCapture> m_capture;
+
     BotBaseHandle m_connection;
 
     mutable std::mutex m_lock;
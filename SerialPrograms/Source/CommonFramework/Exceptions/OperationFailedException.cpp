@@ -4,11 +4,13 @@
  *
  */
 
+#include "CommonFramework/Globals.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/Notifications/ProgramNotifications.h"
 #include "CommonFramework/Tools/ErrorDumper.h"
 #include "CommonFramework/Tools/ProgramEnvironment.h"
 #include "CommonFramework/Tools/ConsoleHandle.h"
+#include "CommonFramework/VideoPipeline/RollingVideoBuffer.h"
 #include "OperationFailedException.h"
 
 namespace PokemonAutomation{
@@ -38,7 +40,7 @@ void OperationFailedException::send_notification(ProgramEnvironment& env, EventN
     }
     if (m_send_error_report == ErrorReport::SEND_ERROR_REPORT && m_screenshot){
         std::string label = name();
-        std::string filename = dump_image_alone(env.logger(), env.program_info(), label, *m_screenshot);
+        std::string filename = dump_image_alone(env.logger(), env.program_info(), label, m_screenshot);
         send_program_telemetry(
             env.logger(), true, COLOR_RED,
             env.program_info(),
@@ -46,6 +48,8 @@ void OperationFailedException::send_notification(ProgramEnvironment& env, EventN
             embeds,
             filename
         );
+        RollingVideoBuffer::save_all(env.logger(), env.video_feeds(), ERROR_PATH(), label);
+        dump_trace(env.logger(), ERROR_PATH(), label);
     }
     send_program_notification(
         env, notification,
@@ -5,7 +5,12 @@
  */
 
 //#include "Common/Cpp/Concurrency/ScheduledTaskRunner.h"
+#include <algorithm>
+#include <thread>
 #include "Common/Cpp/Concurrency/Watchdog.h"
+#include "Common/Cpp/Concurrency/ComputationThreadPool.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/Environment/Environment.h"
 #include "GlobalServices.h"
 
 namespace PokemonAutomation{
@@ -25,6 +30,25 @@ Watchdog& global_watchdog(){
     static Watchdog watchdog;
     return watchdog;
 }
+ComputationThreadPool& global_compute_pool(){
+    static ComputationThreadPool pool(
+        [](){
+            GlobalSettings::instance().INFERENCE_PRIORITY0.set_on_this_thread();
+        },
+        [](){
+            //  Hyperthreads don't help much with SIMD-heavy work.
+            ProcessorSpecs specs = get_processor_specs();
+            if (specs.cores != 0){
+                return specs.cores;
+            }
+            if (specs.threads != 0){
+                return specs.threads;
+            }
+            return (size_t)std::max(std::thread::hardware_concurrency(), 1u);
+        }()
+    );
+    return pool;
+}
 
 
 
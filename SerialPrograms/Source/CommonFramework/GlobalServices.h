@@ -12,12 +12,16 @@ namespace PokemonAutomation{
 class AsyncDispatcher;
 class ScheduledTaskRunner;
 class Watchdog;
+class ComputationThreadPool;
 
 
 //AsyncDispatcher& global_async_dispatcher();
 //ScheduledTaskRunner& global_scheduled_task_runner();
 Watchdog& global_watchdog();
 
+//  One thread per physical core for parallel inference.
+ComputationThreadPool& global_compute_pool();
+
 
 
 }
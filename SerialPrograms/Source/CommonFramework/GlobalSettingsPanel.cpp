@@ -8,6 +8,8 @@
 #include <set>
 #include <QCryptographicHash>
 #include "Common/Cpp/LifetimeSanitizer.h"
+#include "Common/Cpp/Tracing.h"
+#include "Common/Cpp/Concurrency/AdaptiveLock.h"
 #include "Common/Cpp/Json/JsonValue.h"
 #include "Common/Cpp/Json/JsonArray.h"
 #include "Common/Cpp/Json/JsonObject.h"
@@ -95,6 +97,8 @@ GlobalSettings& GlobalSettings::instance(){
     return settings;
 }
 GlobalSettings::~GlobalSettings(){
+    LOCK_CONTENTION_STATS.remove_listener(*this);
+    ENABLE_TRACING.remove_listener(*this);
     ENABLE_LIFETIME_SANITIZER.remove_listener(*this);
 }
 GlobalSettings::GlobalSettings()
@@ -216,6 +220,75 @@ GlobalSettings::GlobalSettings()
         LockMode::UNLOCK_WHILE_RUNNING,
         IS_BETA_VERSION
     )
+    , ROLLING_VIDEO_SECONDS(
+        "<b>Rolling Video Buffer (seconds):</b><br>"
+        "Keep this many seconds of low-resolution video in memory for each console. "
+        "When a program error or a notification with a kept screenshot happens, save the clips of that program's consoles. "
+        "Zero to disable. This costs a background JPEG encoder per console while enabled. "
+        "The buffer is sized when a program panel opens its consoles. "
+        "So changes take effect the next time you open a program.",
+        LockMode::LOCK_WHILE_RUNNING,
+        0, 0, 60
+    )
+    , ROLLING_VIDEO_AS_IMAGES(
+        "<b>Save Rolling Video as Images:</b><br>"
+        "Save clips from the rolling video buffer as a folder of JPEG images instead of an MJPEG AVI.",
+        LockMode::UNLOCK_WHILE_RUNNING,
+        false
+    )
+    , INFERENCE_PROFILER(
+        "<b>Inference Profiler:</b><br>"
+        "Show the busiest inference callbacks in the video overlay stats: "
+        "share of their pivot's time, calls per second and mean/99th percentile time per call.",
+        LockMode::UNLOCK_WHILE_RUNNING,
+        false
+    )
+    , INFERENCE_PROFILE_CSV(
+        "<b>Save Inference Profiles:</b><br>"
+        "At the end of each program, save the time spent in every inference callback of each console to a CSV in DebugDumps/InferenceProfiles/.",
+        LockMode::UNLOCK_WHILE_RUNNING,
+        false
+    )
+    , ENABLE_TRACING(
+        "<b>Hot Path Tracing: (for debugging)</b><br>"
+        "Record how long the camera, inference, audio, serial and program threads spend in their hot paths. "
+        "When a program stops or hits an error, save the last few seconds as a Chrome trace (chrome://tracing or ui.perfetto.dev).",
+        LockMode::UNLOCK_WHILE_RUNNING,
+        false
+    )
+    , TRACE_SECONDS(
+        "<b>Trace Window (seconds):</b><br>"
+        "How many seconds of tracing to save.",
+        LockMode::UNLOCK_WHILE_RUNNING,
+        10, 1, 60
+    )
+    , LOCK_CONTENTION_STATS(
+        "<b>Lock Contention Stats: (for debugging)</b><br>"
+        "Count how often the connection, inference and overlay locks are contended and how long threads wait on them. "
+        "At the end of each program, log the most contended locks.",
+        LockMode::UNLOCK_WHILE_RUNNING,
+        false
+    )
+    , CAPTURE_SERIAL_MESSAGES(
+        "<b>Capture Serial Messages: (for debugging)</b><br>"
+        "Record every message to and from the device into a compact binary file in DebugDumps/SerialCaptures/. "
+        "Takes effect the next time a serial port is selected or reset. Once open, a capture stays open until the program is closed. "
+        "Use the \"MESSAGE_CAPTURE_DECODE\" block in the settings file to turn a capture into text or CSV.",
+        LockMode::UNLOCK_WHILE_RUNNING,
+        false
+    )
+    , CACHE_TEMPLATE_MATCHERS(
+        "<b>Cache Template Matchers:</b><br>"
+        "Save preprocessed image templates to disk so they don't need to be rebuilt the next time they are used.",
+        LockMode::LOCK_WHILE_RUNNING,
+        true
+    )
+    , PRELOAD_TEMPLATE_MATCHERS(
+        "<b>Preload Template Matchers:</b><br>"
+        "When a program starts, build the image templates that it uses on a background thread.",
+        LockMode::LOCK_WHILE_RUNNING,
+        true
+    )
     , DEVELOPER_TOKEN(
         true,
         "<b>Developer Token:</b><br>Restart application to take full effect after changing this.",
@@ -256,12 +329,28 @@ GlobalSettings::GlobalSettings()
 #endif
     PA_ADD_OPTION(ENABLE_LIFETIME_SANITIZER);
 
+    PA_ADD_OPTION(ROLLING_VIDEO_SECONDS);
+    PA_ADD_OPTION(ROLLING_VIDEO_AS_IMAGES);
+
+    PA_ADD_OPTION(INFERENCE_PROFILER);
+    PA_ADD_OPTION(INFERENCE_PROFILE_CSV);
+
+    PA_ADD_OPTION(ENABLE_TRACING);
+    PA_ADD_OPTION(TRACE_SECONDS);
+    PA_ADD_OPTION(LOCK_CONTENTION_STATS);
+    PA_ADD_OPTION(CAPTURE_SERIAL_MESSAGES);
+
+    PA_ADD_OPTION(CACHE_TEMPLATE_MATCHERS);
+    PA_ADD_OPTION(PRELOAD_TEMPLATE_MATCHERS);
+
     PA_ADD_OPTION(PROCESSOR_LEVEL0);
 
     PA_ADD_OPTION(DEVELOPER_TOKEN);
 
     GlobalSettings::value_changed();
     ENABLE_LIFETIME_SANITIZER.add_listener(*this);
+    ENABLE_TRACING.add_listener(*this);
+    LOCK_CONTENTION_STATS.add_listener(*this);
 }
 
 void GlobalSettings::load_json(const JsonValue& json){
@@ -288,6 +377,8 @@ void GlobalSettings::load_json(const JsonValue& json){
     const JsonObject* command_line_tests_setting = obj->get_object("COMMAND_LINE_TESTS");
     if (command_line_tests_setting){
         command_line_tests_setting->read_boolean(COMMAND_LINE_TEST_MODE, "RUN");
+        command_line_tests_setting->read_boolean(COMMAND_LINE_REPLAY_REAL_TIME, "REPLAY_REAL_TIME");
+        command_line_tests_setting->read_integer(COMMAND_LINE_TEST_THREADS, "THREADS", 0, 1024);
 
         if (!command_line_tests_setting->read_string(COMMAND_LINE_TEST_FOLDER, "FOLDER")){
             COMMAND_LINE_TEST_FOLDER = "CommandLineTests";
@@ -338,6 +429,42 @@ void GlobalSettings::load_json(const JsonValue& json){
             }
         }
     }
+
+    KERNEL_BENCHMARK_FAMILIES.clear();
+    const JsonObject* kernel_benchmarks_setting = obj->get_object("KERNEL_BENCHMARKS");
+    if (kernel_benchmarks_setting){
+        kernel_benchmarks_setting->read_boolean(KERNEL_BENCHMARK_MODE, "RUN");
+        kernel_benchmarks_setting->read_string(KERNEL_BENCHMARK_BASELINE, "BASELINE");
+        kernel_benchmarks_setting->read_integer(KERNEL_BENCHMARK_REPETITIONS, "REPETITIONS", 1, 10000);
+        kernel_benchmarks_setting->read_integer(KERNEL_BENCHMARK_ROUNDS, "ROUNDS", 1, 100);
+        kernel_benchmarks_setting->read_string(KERNEL_BENCHMARK_OUTPUT, "OUTPUT");
+
+        const JsonArray* families = kernel_benchmarks_setting->get_array("FAMILIES");
+        if (families){
+            for (const auto& value: *families){
+                const std::string* name = value.get_string();
+                if (name != nullptr && !name->empty()){
+                    KERNEL_BENCHMARK_FAMILIES.emplace_back(*name);
+                }
+            }
+        }
+    }
+    if (KERNEL_BENCHMARK_OUTPUT.empty()){
+        KERNEL_BENCHMARK_OUTPUT = "KernelBenchmarks.json";
+    }
+
+    const JsonObject* resource_bundle_setting = obj->get_object("RESOURCE_BUNDLE");
+    if (resource_bundle_setting){
+        resource_bundle_setting->read_boolean(RESOURCE_BUNDLE_BUILD, "BUILD");
+        resource_bundle_setting->read_boolean(RESOURCE_BUNDLE_USE, "USE");
+    }
+
+    const JsonObject* message_capture_setting = obj->get_object("MESSAGE_CAPTURE_DECODE");
+    if (message_capture_setting){
+        message_capture_setting->read_string(MESSAGE_CAPTURE_DECODE_INPUT, "INPUT");
+        message_capture_setting->read_string(MESSAGE_CAPTURE_DECODE_OUTPUT, "OUTPUT");
+        message_capture_setting->read_string(MESSAGE_CAPTURE_DECODE_FORMAT, "FORMAT");
+    }
 }
 
 
@@ -348,6 +475,8 @@ JsonValue GlobalSettings::to_json() const{
     JsonObject command_line_test_obj;
     command_line_test_obj["RUN"] = COMMAND_LINE_TEST_MODE;
     command_line_test_obj["FOLDER"] = COMMAND_LINE_TEST_FOLDER;
+    command_line_test_obj["REPLAY_REAL_TIME"] = COMMAND_LINE_REPLAY_REAL_TIME;
+    command_line_test_obj["THREADS"] = COMMAND_LINE_TEST_THREADS;
 
     {
         JsonArray test_list;
@@ -367,6 +496,32 @@ JsonValue GlobalSettings::to_json() const{
 
     obj["COMMAND_LINE_TESTS"] = std::move(command_line_test_obj);
 
+    JsonObject kernel_benchmarks_obj;
+    kernel_benchmarks_obj["RUN"] = KERNEL_BENCHMARK_MODE;
+    kernel_benchmarks_obj["OUTPUT"] = KERNEL_BENCHMARK_OUTPUT;
+    kernel_benchmarks_obj["BASELINE"] = KERNEL_BENCHMARK_BASELINE;
+    kernel_benchmarks_obj["REPETITIONS"] = KERNEL_BENCHMARK_REPETITIONS;
+    kernel_benchmarks_obj["ROUNDS"] = KERNEL_BENCHMARK_ROUNDS;
+    {
+        JsonArray families;
+        for (const auto& name : KERNEL_BENCHMARK_FAMILIES){
+            families.push_back(name);
+        }
+        kernel_benchmarks_obj["FAMILIES"] = std::move(families);
+    }
+    obj["KERNEL_BENCHMARKS"] = std::move(kernel_benchmarks_obj);
+
+    JsonObject resource_bundle_obj;
+    resource_bundle_obj["BUILD"] = RESOURCE_BUNDLE_BUILD;
+    resource_bundle_obj["USE"] = RESOURCE_BUNDLE_USE;
+    obj["RESOURCE_BUNDLE"] = std::move(resource_bundle_obj);
+
+    JsonObject message_capture_obj;
+    message_capture_obj["INPUT"] = MESSAGE_CAPTURE_DECODE_INPUT;
+    message_capture_obj["OUTPUT"] = MESSAGE_CAPTURE_DECODE_OUTPUT;
+    message_capture_obj["FORMAT"] = MESSAGE_CAPTURE_DECODE_FORMAT;
+    obj["MESSAGE_CAPTURE_DECODE"] = std::move(message_capture_obj);
+
     JsonObject debug_obj;
     const auto& debug_settings = PreloadSettings::instance().DEBUG;
     debug_obj["COLOR_CHECK"] = debug_settings.COLOR_CHECK;
@@ -378,6 +533,18 @@ JsonValue GlobalSettings::to_json() const{
 }
 
 void GlobalSettings::value_changed(){
+    bool tracing = ENABLE_TRACING;
+    if (tracing != tracing_enabled()){
+        set_tracing_enabled(tracing);
+        global_logger_tagged().log(tracing ? "Hot Path Tracing: Enabled" : "Hot Path Tracing: Disabled", COLOR_BLUE);
+    }
+
+    bool lock_stats = LOCK_CONTENTION_STATS;
+    if (lock_stats != lock_stats_enabled()){
+        set_lock_stats_enabled(lock_stats);
+        global_logger_tagged().log(lock_stats ? "Lock Contention Stats: Enabled" : "Lock Contention Stats: Disabled", COLOR_BLUE);
+    }
+
     bool enabled = ENABLE_LIFETIME_SANITIZER;
     LifetimeSanitizer::set_enabled(enabled);
     if (enabled){
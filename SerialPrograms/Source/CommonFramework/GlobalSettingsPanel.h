@@ -115,6 +115,20 @@ public:
     BooleanCheckBoxOption ENABLE_FRAME_SCREENSHOTS;
     BooleanCheckBoxOption ENABLE_LIFETIME_SANITIZER;
 
+    SimpleIntegerOption<uint8_t> ROLLING_VIDEO_SECONDS;
+    BooleanCheckBoxOption ROLLING_VIDEO_AS_IMAGES;
+
+    BooleanCheckBoxOption INFERENCE_PROFILER;
+    BooleanCheckBoxOption INFERENCE_PROFILE_CSV;
+
+    BooleanCheckBoxOption ENABLE_TRACING;
+    SimpleIntegerOption<uint8_t> TRACE_SECONDS;
+    BooleanCheckBoxOption LOCK_CONTENTION_STATS;
+    BooleanCheckBoxOption CAPTURE_SERIAL_MESSAGES;
+
+    BooleanCheckBoxOption CACHE_TEMPLATE_MATCHERS;
+    BooleanCheckBoxOption PRELOAD_TEMPLATE_MATCHERS;
+
     ProcessorLevelOption PROCESSOR_LEVEL0;
 
     StringOption DEVELOPER_TOKEN;
@@ -129,6 +143,37 @@ public:
     // Which tests to ignore running under the command line test mode.
     // If a test path appears in both COMMAND_LINE_TEST_LIST and COMMAND_LINE_IGNORE_LIST, it's still ignored.
     std::vector<std::string> COMMAND_LINE_IGNORE_LIST;
+    // Play video replay tests in real time instead of as fast as possible.
+    bool COMMAND_LINE_REPLAY_REAL_TIME = false;
+    // How many tests to run at the same time. 0 to use all cores.
+    // Defaults to 1 since not every test has been checked for thread safety.
+    size_t COMMAND_LINE_TEST_THREADS = 1;
+
+    // Run the kernel microbenchmarks instead of the GUI. See Tests/KernelBenchmarks.h.
+    bool KERNEL_BENCHMARK_MODE = false;
+    // Where to write the results.
+    std::string KERNEL_BENCHMARK_OUTPUT;
+    // Results of a previous run to compare against. Empty for no comparison.
+    std::string KERNEL_BENCHMARK_BASELINE;
+    // Which kernel families to run. Empty to run all of them.
+    std::vector<std::string> KERNEL_BENCHMARK_FAMILIES;
+    // Timed batches per benchmark.
+    size_t KERNEL_BENCHMARK_REPETITIONS = 25;
+    // How many times to run the whole suite. Each benchmark reports its median over the rounds.
+    size_t KERNEL_BENCHMARK_ROUNDS = 5;
+
+    // Pack the resources into a bundle instead of running the GUI. See Resources/ResourceBundle.h.
+    bool RESOURCE_BUNDLE_BUILD = false;
+    // Load resources from the bundle when there is one and it is up to date.
+    // Off until it has been measured to help cold start on real installs.
+    bool RESOURCE_BUNDLE_USE = false;
+
+    // Decode this serial message capture instead of running the GUI. See ClientSource/Connection/MessageCapture.h.
+    std::string MESSAGE_CAPTURE_DECODE_INPUT;
+    // Where to write the decoded capture. Empty to write next to the input.
+    std::string MESSAGE_CAPTURE_DECODE_OUTPUT;
+    // "TEXT" or "CSV".
+    std::string MESSAGE_CAPTURE_DECODE_FORMAT = "TEXT";
 };
 
 
@@ -111,6 +111,9 @@ std::string get_debug_path(){
 std::string get_error_path(){
     return RUNTIME_BASE_PATH() + "ErrorDumps/";
 }
+std::string get_cache_path(){
+    return RUNTIME_BASE_PATH() + "Cache/";
+}
 std::string get_user_file_path(){
     return RUNTIME_BASE_PATH();
 }
@@ -133,6 +136,10 @@ const std::string& ERROR_PATH(){
     static std::string path = get_error_path();
     return path;
 }
+const std::string& CACHE_PATH(){
+    static std::string path = get_cache_path();
+    return path;
+}
 const std::string& USER_FILE_PATH(){
     static std::string path = get_user_file_path();
     return path;
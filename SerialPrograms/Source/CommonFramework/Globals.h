@@ -46,6 +46,10 @@ const std::string& ERROR_PATH();
 // e.g. for a program that records and dumps screenshots, the saved images can go to USER_FILE_PATH()/ScreenshotDumper.
 const std::string& USER_FILE_PATH();
 
+// Folder path (end with "/") to hold files that are generated by the program to speed things up.
+// Everything in here can be safely deleted. It will be regenerated when needed.
+const std::string& CACHE_PATH();
+
 // Resource folder path. Resources include JSON files, images, sound files and others required by
 // various automation programs.
 const std::string& RESOURCE_PATH();
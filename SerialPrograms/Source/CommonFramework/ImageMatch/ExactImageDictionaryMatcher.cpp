@@ -79,18 +79,13 @@ void ExactImageDictionaryMatcher::add(const std::string& slug, ImageRGB32 image)
         m_width = image.width();
         m_height = image.height();
     }
-    auto iter = m_database.find(slug);
-    if (iter != m_database.end()){
+    if (!m_index.emplace(slug, m_matchers.size()).second){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Duplicate slug: " + slug);
     }
-
-    m_database.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(slug),
-        std::forward_as_tuple(std::move(image), m_weight)
-    );
+    m_slugs.emplace_back(slug);
+    m_matchers.emplace_back(std::move(image), m_weight);
 //    if (slug == "linoone-galar" || slug == "coalossal"){
-//        cout << slug << " = " << m_database.find(slug)->second.stats().stddev.sum() << endl;
+//        cout << slug << " = " << m_matchers.back().stats().stddev.sum() << endl;
 //    }
 }
 
@@ -138,12 +133,12 @@ ImageMatchResult ExactImageDictionaryMatcher::match(
 
     // Translate the input image area a bit to careate matching candidates.
     std::vector<ImageRGB32> image_set = make_image_set(image, box, m_width, m_height, tolerance);
-    for (const auto& item : m_database){
-//        if (item.first != "linoone-galar"){
+    for (size_t c = 0; c < m_matchers.size(); c++){
+//        if (m_slugs[c] != "linoone-galar"){
 //            continue;
 //        }
-        double alpha = compare(item.second, image_set);
-        results.add(alpha, item.first);
+        double alpha = compare(m_matchers[c], image_set);
+        results.add(alpha, m_slugs[c]);
         results.clear_beyond_spread(alpha_spread);
     }
 
@@ -173,22 +168,21 @@ ImageMatchResult ExactImageDictionaryMatcher::subset_match(
     return results;
 }
 
-ImageViewRGB32 ExactImageDictionaryMatcher::image_template(const std::string& slug) const{
-    auto it = m_database.find(slug);
-    if (it == m_database.end()){
-        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Unknown slug: " + slug);
-    }
+const WeightedExactImageMatcher* ExactImageDictionaryMatcher::find(const std::string& slug) const{
+    auto it = m_index.find(slug);
+    return it == m_index.end() ? nullptr : &m_matchers[it->second];
+}
 
-    return it->second.image_template();
+ImageViewRGB32 ExactImageDictionaryMatcher::image_template(const std::string& slug) const{
+    return image_matcher(slug).image_template();
 }
 
 const WeightedExactImageMatcher& ExactImageDictionaryMatcher::image_matcher(const std::string& slug) const{
-    auto it = m_database.find(slug);
-    if (it == m_database.end()){
+    const WeightedExactImageMatcher* matcher = find(slug);
+    if (matcher == nullptr){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Unknown slug: " + slug);
     }
-
-    return it->second;
+    return *matcher;
 }
 
 
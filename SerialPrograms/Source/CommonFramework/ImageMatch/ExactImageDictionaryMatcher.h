@@ -71,6 +71,8 @@ private:
         const std::vector<ImageRGB32>& images
     );
 
+    const WeightedExactImageMatcher* find(const std::string& slug) const;
+
 
 private:
     WeightedExactImageMatcher::InverseStddevWeight m_weight;
@@ -79,7 +81,12 @@ private:
 //    QSize m_dimensions;
     size_t m_width = 0;
     size_t m_height = 0;
-    std::map<std::string, WeightedExactImageMatcher> m_database;
+
+    //  Templates in the order they were added. "match()" goes through all of
+    //  them. So they're kept in arrays instead of a tree.
+    std::vector<std::string> m_slugs;
+    std::vector<WeightedExactImageMatcher> m_matchers;
+    std::map<std::string, size_t> m_index;
 };
 
 
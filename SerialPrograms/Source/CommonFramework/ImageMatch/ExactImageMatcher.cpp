@@ -5,7 +5,9 @@
  */
 
 #include <cmath>
+#include <algorithm>
 #include "Common/Cpp/Exceptions.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelMoments.h"
 #include "ImageDiff.h"
 #include "ExactImageMatcher.h"
 
@@ -26,9 +28,42 @@ ExactImageMatcher::ExactImageMatcher(ImageRGB32 image)
     }
 //    cout << m_stats.stddev.sum() << endl;
 }
+ExactImageMatcher::ExactImageMatcher(ImageRGB32 image, const ImageStats& stats)
+    : m_image(std::move(image))
+    , m_stats(stats)
+{
+    if (!m_image){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Image is null.");
+    }
+}
 
-ImageRGB32 ExactImageMatcher::scale_template_brightness(const ImageViewRGB32& image) const{
-    FloatPixel image_brightness = pixel_average(image, m_image);
+//  Sum of squares of differences on one channel after the template is scaled
+//  by "scale".
+static double scaled_sumsqrs(
+    double scale,
+    uint64_t ref_sqr, uint64_t dot, uint64_t img_sqr,
+    const Kernels::PixelMomentsBright& bright
+){
+    //  sum((s*ref - img)^2) = s^2 * sum(ref^2) - 2*s * sum(ref*img) + sum(img^2)
+    double sumsqrs = scale*scale*(double)ref_sqr - 2*scale*(double)dot + (double)img_sqr;
+
+    //  Bright values may saturate. Scale them the same way "scale_brightness()"
+    //  does.
+    for (size_t c = 0; c < Kernels::PIXEL_MOMENTS_BRIGHT_BINS; c++){
+        if (bright.count[c] == 0){
+            continue;
+        }
+        float ref = (float)(c + Kernels::PIXEL_MOMENTS_BRIGHT_START) * (float)scale;
+        double x = (double)std::min((uint32_t)ref, (uint32_t)255);
+        sumsqrs += x*x*(double)bright.count[c] - 2*x*(double)bright.sum[c] + (double)bright.sqr[c];
+    }
+
+    //  Rounding can make a perfect match slightly negative.
+    return std::max(sumsqrs, 0.);
+}
+
+
+FloatPixel ExactImageMatcher::brightness_scale(const FloatPixel& image_brightness) const{
     FloatPixel scale = image_brightness / m_stats.average;
 
     if (std::isnan(scale.r)) scale.r = 1.0;
@@ -36,6 +71,11 @@ ImageRGB32 ExactImageMatcher::scale_template_brightness(const ImageViewRGB32& im
     if (std::isnan(scale.b)) scale.b = 1.0;
     scale.bound(0.85, 1.15);
 
+    return scale;
+}
+ImageRGB32 ExactImageMatcher::scale_template_brightness(const ImageViewRGB32& image) const{
+    FloatPixel scale = brightness_scale(pixel_average(image, m_image));
+
     ImageRGB32 ret = m_image.copy();
     scale_brightness(ret, scale);
 //    ret.save("test.png");
@@ -43,6 +83,26 @@ ImageRGB32 ExactImageMatcher::scale_template_brightness(const ImageViewRGB32& im
 }
 
 
+ImageViewRGB32 ExactImageMatcher::resize_to_template(const ImageViewRGB32& image, ImageRGB32& buffer) const{
+    if (image.width() == m_image.width() && image.height() == m_image.height()){
+        return image;
+    }
+    buffer = image.scale_to(m_image.width(), m_image.height());
+    return buffer;
+}
+double ExactImageMatcher::rmsd(const Kernels::PixelMoments& moments) const{
+    FloatPixel image_brightness((double)moments.sumR, (double)moments.sumG, (double)moments.sumB);
+    image_brightness /= (double)moments.count;
+    FloatPixel scale = brightness_scale(image_brightness);
+
+    double sumsqrs = (double)moments.fixed_sumsqrs;
+    sumsqrs += scaled_sumsqrs(scale.r, moments.ref_sqrR, moments.dotR, moments.img_sqrR, moments.brightR);
+    sumsqrs += scaled_sumsqrs(scale.g, moments.ref_sqrG, moments.dotG, moments.img_sqrG, moments.brightG);
+    sumsqrs += scaled_sumsqrs(scale.b, moments.ref_sqrB, moments.dotB, moments.img_sqrB, moments.brightB);
+    return std::sqrt(sumsqrs / (double)moments.count);
+}
+
+
 double ExactImageMatcher::rmsd(const ImageViewRGB32& image) const{
     if (!image){
         return 1000.;
@@ -51,18 +111,25 @@ double ExactImageMatcher::rmsd(const ImageViewRGB32& image) const{
 //    image.save("test.png");
 
 //    cout << "ExactImageMatcher::rmsd(): image = " << image.width() << " x " << image.height() << endl;
-    ImageRGB32 scaled = image.scale_to(m_image.width(), m_image.height());
+    ImageRGB32 buffer;
+    ImageViewRGB32 scaled = resize_to_template(image, buffer);
 //    cout << "ExactImageMatcher::rmsd(): scaled = " << scaled.width() << " x " << scaled.height() << endl;
-    ImageRGB32 reference = scale_template_brightness(scaled);
 
 #if 0
     static int c = 0;
     image.save("test-" + std::to_string(c) + "-image.png");
-    reference.save("test-" + std::to_string(c) + "-sprite.png");
+    scale_template_brightness(scaled).save("test-" + std::to_string(c) + "-sprite.png");
     c++;
 #endif
 
-    double rmsd = pixel_RMSD(reference, scaled);
+    Kernels::PixelMoments moments;
+    Kernels::pixel_moments(
+        moments,
+        m_image.width(), m_image.height(),
+        m_image.data(), m_image.bytes_per_row(),
+        scaled.data(), scaled.bytes_per_row()
+    );
+    double rmsd = this->rmsd(moments);
 //    cout << "rmsd = " << rmsd << endl;
     return rmsd;
 }
@@ -70,25 +137,41 @@ double ExactImageMatcher::rmsd(const ImageViewRGB32& image, Color background) co
     if (!image){
         return 1000.;
     }
-    ImageRGB32 scaled = image.scale_to(m_image.width(), m_image.height());
-    ImageRGB32 reference = scale_template_brightness(scaled);
+    ImageRGB32 buffer;
+    ImageViewRGB32 scaled = resize_to_template(image, buffer);
 
 #if 0
     static int c = 0;
     scaled.save("test-" + std::to_string(c) + "-image.png");
-    reference.save("test-" + std::to_string(c) + "-sprite.png");
+    scale_template_brightness(scaled).save("test-" + std::to_string(c) + "-sprite.png");
     c++;
 #endif
 
-    return pixel_RMSD(reference, scaled, background);
+    Kernels::PixelMoments moments;
+    Kernels::pixel_moments(
+        moments,
+        m_image.width(), m_image.height(),
+        m_image.data(), m_image.bytes_per_row(),
+        scaled.data(), scaled.bytes_per_row(),
+        (uint32_t)background
+    );
+    return rmsd(moments);
 }
 double ExactImageMatcher::rmsd_masked(const ImageViewRGB32& image) const{
     if (!image){
         return 1000.;
     }
-    ImageRGB32 scaled = image.scale_to(m_image.width(), m_image.height());
-    ImageRGB32 reference = scale_template_brightness(scaled);
-    return pixel_RMSD_masked(reference, scaled);
+    ImageRGB32 buffer;
+    ImageViewRGB32 scaled = resize_to_template(image, buffer);
+
+    Kernels::PixelMoments moments;
+    Kernels::pixel_moments_masked(
+        moments,
+        m_image.width(), m_image.height(),
+        m_image.data(), m_image.bytes_per_row(),
+        scaled.data(), scaled.bytes_per_row()
+    );
+    return rmsd(moments);
 }
 
 
@@ -12,6 +12,9 @@
 #include "CommonFramework/ImageTools/ImageStats.h"
 
 namespace PokemonAutomation{
+namespace Kernels{
+    struct PixelMoments;
+}
 namespace ImageMatch{
 
 
@@ -20,6 +23,8 @@ namespace ImageMatch{
 //  match the input image. Alpha channels as used as masks in matching.
 //  No other treatment like tolerating translation or scaling based on stddevs, hence the name "Exact".
 class ExactImageMatcher{
+public:
+    //  Movable so matchers can be stored by value. (e.g. in a std::vector)
     ExactImageMatcher(ExactImageMatcher&&) = default;
     ExactImageMatcher& operator=(ExactImageMatcher&&) = default;
     ExactImageMatcher(const ExactImageMatcher&) = delete;
@@ -27,6 +32,8 @@ class ExactImageMatcher{
 
 public:
     ExactImageMatcher(ImageRGB32 image_template);
+    //  Use precomputed stats of the template. (e.g. from the template cache)
+    ExactImageMatcher(ImageRGB32 image_template, const ImageStats& stats);
     
     const ImageStats& stats() const{ return m_stats; }
 
@@ -51,10 +58,21 @@ public:
     const ImageRGB32& image_template() const { return m_image; }
 
 private:
+    // Per-channel multiplier that brings the template brightness to `image_brightness`.
+    FloatPixel brightness_scale(const FloatPixel& image_brightness) const;
+
     // scale stored image template according to the brightness of `image`, assign
-    // the scaled template to `reference`.
+    // the scaled template to `reference`. (only used for debugging)
     ImageRGB32 scale_template_brightness(const ImageViewRGB32& image) const;
 
+    // Return `image` if it is already the size of the template. Otherwise
+    // resize it into `buffer` and return that.
+    ImageViewRGB32 resize_to_template(const ImageViewRGB32& image, ImageRGB32& buffer) const;
+
+    // RMSD against the template after scaling its brightness. The scaling is
+    // done analytically from the pixel moments so the template is never copied.
+    double rmsd(const Kernels::PixelMoments& moments) const;
+
 protected:
     ImageRGB32 m_image;
     ImageStats m_stats;
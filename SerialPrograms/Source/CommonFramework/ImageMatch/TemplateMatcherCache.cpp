@@ -0,0 +1,354 @@
+/*  Template Matcher Cache
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDir>
+#include "Common/Cpp/Containers/Pimpl.tpp"
+#include "CommonFramework/Globals.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "TemplateMatcherCache.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+namespace ImageMatch{
+
+
+namespace{
+
+const char CACHE_MAGIC[8] = {'P', 'A', '-', 'T', 'M', 'P', 'L', 0};
+const size_t PIXEL_ALIGNMENT = 64;
+
+struct FileHeader{
+    char magic[8];
+    uint32_t version;
+    uint32_t entries;
+    uint64_t program_version_hash;
+};
+struct EntryHeader{
+    uint64_t key_offset;
+    uint32_t key_length;
+    uint32_t width;
+    uint32_t height;
+    uint32_t reserved;
+    int64_t source_size;
+    int64_t source_modified;
+    double average[3];
+    double stddev[3];
+    uint64_t count;
+    double area_ratio;
+    uint64_t pixel_offset;
+};
+
+uint64_t program_version_hash(){
+    //  FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (char ch : PROGRAM_VERSION){
+        hash ^= (uint8_t)ch;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool get_source_info(const std::string& path, int64_t& size, int64_t& modified){
+    QFileInfo info(QString::fromStdString(path));
+    if (!info.exists()){
+        return false;
+    }
+    size = info.size();
+    modified = info.lastModified().toMSecsSinceEpoch();
+    return true;
+}
+
+size_t align_up(size_t x){
+    return (x + PIXEL_ALIGNMENT - 1) & ~(PIXEL_ALIGNMENT - 1);
+}
+
+}
+
+
+
+struct TemplateMatcherCache::MappedFile{
+    QFile file;
+    const uchar* data = nullptr;
+    size_t size = 0;
+
+    MappedFile(const std::string& path)
+        : file(QString::fromStdString(path))
+    {}
+    ~MappedFile(){
+        if (data != nullptr){
+            file.unmap(const_cast<uchar*>(data));
+        }
+    }
+};
+
+
+ImageViewRGB32 TemplateMatcherCache::Entry::image() const{
+    if (mapped_pixels != nullptr){
+        return ImageViewRGB32(const_cast<uint32_t*>(mapped_pixels), width * sizeof(uint32_t), width, height);
+    }
+    return owned;
+}
+
+
+
+TemplateMatcherCache& TemplateMatcherCache::instance(){
+    static TemplateMatcherCache cache;
+    return cache;
+}
+TemplateMatcherCache::~TemplateMatcherCache(){
+    close_file();
+}
+TemplateMatcherCache::TemplateMatcherCache()
+    : m_path(CACHE_PATH() + "TemplateMatchers.bin")
+{
+    std::lock_guard<std::mutex> lg(m_lock);
+    open_file();
+}
+
+std::string TemplateMatcherCache::make_key(
+    const std::string& path,
+    uint32_t min_color, uint32_t max_color,
+    size_t min_area
+){
+    return path + "|" +
+        std::to_string(min_color) + "|" +
+        std::to_string(max_color) + "|" +
+        std::to_string(min_area);
+}
+
+
+void TemplateMatcherCache::close_file(){
+    m_entries.clear();
+    m_file.clear();
+}
+void TemplateMatcherCache::open_file(){
+    close_file();
+
+    m_file.reset(m_path);
+    MappedFile& file = *m_file;
+    if (!file.file.exists() || !file.file.open(QIODevice::ReadOnly)){
+        m_file.clear();
+        return;
+    }
+
+    file.size = (size_t)file.file.size();
+    if (file.size < sizeof(FileHeader)){
+        m_file.clear();
+        return;
+    }
+    file.data = file.file.map(0, file.size);
+    if (file.data == nullptr){
+        m_file.clear();
+        return;
+    }
+
+    const FileHeader& header = *(const FileHeader*)file.data;
+    if (memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        header.version != VERSION ||
+        header.program_version_hash != program_version_hash() ||
+        file.size < sizeof(FileHeader) + (size_t)header.entries * sizeof(EntryHeader)
+    ){
+        global_logger_tagged().log("Template matcher cache is outdated. It will be rebuilt.", COLOR_ORANGE);
+        m_file.clear();
+        return;
+    }
+
+    const EntryHeader* headers = (const EntryHeader*)(file.data + sizeof(FileHeader));
+    for (uint32_t c = 0; c < header.entries; c++){
+        const EntryHeader& item = headers[c];
+        size_t pixel_bytes = (size_t)item.width * item.height * sizeof(uint32_t);
+        if (item.key_offset + item.key_length > file.size ||
+            item.pixel_offset + pixel_bytes > file.size ||
+            item.pixel_offset % PIXEL_ALIGNMENT != 0
+        ){
+            global_logger_tagged().log("Template matcher cache is corrupted. It will be rebuilt.", COLOR_RED);
+            close_file();
+            return;
+        }
+
+        std::string key((const char*)file.data + item.key_offset, item.key_length);
+        Entry entry{
+            item.source_size,
+            item.source_modified,
+            ImageStats(
+                FloatPixel(item.average[0], item.average[1], item.average[2]),
+                FloatPixel(item.stddev[0], item.stddev[1], item.stddev[2]),
+                item.count
+            ),
+            item.area_ratio,
+            item.width,
+            item.height,
+            (const uint32_t*)(file.data + item.pixel_offset),
+            ImageRGB32(),
+        };
+        m_entries.emplace(std::move(key), std::move(entry));
+    }
+}
+std::string TemplateMatcherCache::serialize(){
+    //  Detach all the entries from the mapped file so it can be replaced.
+    for (auto& item : m_entries){
+        Entry& entry = item.second;
+        if (entry.mapped_pixels != nullptr){
+            entry.owned = entry.image().copy();
+            entry.mapped_pixels = nullptr;
+        }
+    }
+    m_file.clear();
+
+    //  Compute the layout.
+    size_t header_bytes = sizeof(FileHeader) + m_entries.size() * sizeof(EntryHeader);
+    size_t key_bytes = 0;
+    for (const auto& item : m_entries){
+        key_bytes += item.first.size();
+    }
+    size_t pixel_start = align_up(header_bytes + key_bytes);
+
+    std::string buffer(pixel_start, '\0');
+    FileHeader& header = *(FileHeader*)&buffer[0];
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = VERSION;
+    header.entries = (uint32_t)m_entries.size();
+    header.program_version_hash = program_version_hash();
+
+    size_t key_offset = header_bytes;
+    size_t pixel_offset = pixel_start;
+    size_t index = 0;
+    for (const auto& item : m_entries){
+        const Entry& entry = item.second;
+        EntryHeader& out = ((EntryHeader*)&buffer[sizeof(FileHeader)])[index++];
+        out.key_offset = key_offset;
+        out.key_length = (uint32_t)item.first.size();
+        out.width = (uint32_t)entry.width;
+        out.height = (uint32_t)entry.height;
+        out.reserved = 0;
+        out.source_size = entry.source_size;
+        out.source_modified = entry.source_modified;
+        out.average[0] = entry.stats.average.r;
+        out.average[1] = entry.stats.average.g;
+        out.average[2] = entry.stats.average.b;
+        out.stddev[0] = entry.stats.stddev.r;
+        out.stddev[1] = entry.stats.stddev.g;
+        out.stddev[2] = entry.stats.stddev.b;
+        out.count = entry.stats.count;
+        out.area_ratio = entry.area_ratio;
+        out.pixel_offset = pixel_offset;
+
+        memcpy(&buffer[key_offset], item.first.data(), item.first.size());
+        key_offset += item.first.size();
+        pixel_offset = align_up(pixel_offset + entry.width * entry.height * sizeof(uint32_t));
+    }
+    buffer.resize(pixel_offset, '\0');
+
+    pixel_offset = pixel_start;
+    for (const auto& item : m_entries){
+        const Entry& entry = item.second;
+        ImageViewRGB32 image = entry.image();
+        size_t row_bytes = entry.width * sizeof(uint32_t);
+        for (size_t r = 0; r < entry.height; r++){
+            memcpy(&buffer[pixel_offset + r * row_bytes], (const char*)image.data() + r * image.bytes_per_row(), row_bytes);
+        }
+        pixel_offset = align_up(pixel_offset + row_bytes * entry.height);
+    }
+
+    return buffer;
+}
+void TemplateMatcherCache::flush(){
+    std::lock_guard<std::mutex> flush_lock(m_flush_lock);
+
+    std::string buffer;
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        if (!m_dirty){
+            return;
+        }
+        buffer = serialize();
+        m_dirty = false;
+    }
+
+    QDir().mkpath(QString::fromStdString(CACHE_PATH()));
+    QSaveFile file(QString::fromStdString(m_path));
+    if (!file.open(QIODevice::WriteOnly) ||
+        file.write(buffer.data(), buffer.size()) != (qint64)buffer.size() ||
+        !file.commit()
+    ){
+        global_logger_tagged().log("Unable to write template matcher cache: " + m_path, COLOR_RED);
+        return;
+    }
+
+    //  Switch back to the mapped file so the owned copies can be released.
+    //  If more entries were added while writing, keep them in memory until
+    //  the next flush instead.
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (!m_dirty){
+        open_file();
+    }
+}
+
+
+bool TemplateMatcherCache::get(const std::string& key, const std::string& source_path, CachedTemplate& entry){
+    int64_t size, modified;
+    if (!get_source_info(source_path, size, modified)){
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    auto iter = m_entries.find(key);
+    if (iter == m_entries.end()){
+        return false;
+    }
+    const Entry& item = iter->second;
+    if (item.source_size != size || item.source_modified != modified){
+        return false;
+    }
+
+    entry.image = item.image().copy();
+    entry.stats = item.stats;
+    entry.area_ratio = item.area_ratio;
+    return true;
+}
+void TemplateMatcherCache::put(
+    const std::string& key, const std::string& source_path,
+    const ImageViewRGB32& image, const ImageStats& stats, double area_ratio
+){
+    int64_t size, modified;
+    if (!get_source_info(source_path, size, modified)){
+        return;
+    }
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    Entry entry{
+        size,
+        modified,
+        stats,
+        area_ratio,
+        image.width(),
+        image.height(),
+        nullptr,
+        image.copy(),
+    };
+    m_entries.erase(key);
+    m_entries.emplace(key, std::move(entry));
+    m_dirty = true;
+}
+
+
+
+bool template_cache_enabled(){
+    return GlobalSettings::instance().CACHE_TEMPLATE_MATCHERS;
+}
+
+
+
+}
+}
@@ -0,0 +1,125 @@
+/*  Template Matcher Cache
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Building a template matcher requires decoding the template PNG,
+ *  filtering it, running waterfill to crop out the object and computing the
+ *  image stats of the result. This is done lazily the first time a detector
+ *  needs the matcher which causes a visible stall in the middle of a program.
+ *
+ *  This cache stores the preprocessed templates (cropped pixels, stats and
+ *  area ratio) in a single versioned file under CACHE_PATH(). The file is
+ *  memory-mapped on startup and templates are read back directly from it.
+ *
+ *  File Layout: (native endian)
+ *
+ *      FileHeader
+ *      EntryHeader[entries]
+ *      Key strings (concatenated, not null-terminated)
+ *      Pixel data (each entry aligned to 64 bytes, rows tightly packed)
+ *
+ *  Each entry records the size and modification time of the source file.
+ *  If either changes, the entry is considered stale and rebuilt.
+ *
+ *  New entries are only kept in memory until "flush()" is called. Rewriting
+ *  the file on every insert would make filling an empty cache quadratic.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_TemplateMatcherCache_H
+#define PokemonAutomation_CommonFramework_TemplateMatcherCache_H
+
+#include <string>
+#include <map>
+#include <mutex>
+#include "Common/Cpp/Containers/Pimpl.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/ImageTools/ImageStats.h"
+
+namespace PokemonAutomation{
+namespace ImageMatch{
+
+
+struct CachedTemplate{
+    ImageRGB32 image;
+    ImageStats stats;
+    double area_ratio = 0;
+};
+
+
+class TemplateMatcherCache{
+public:
+    //  Bump this whenever the preprocessing of any cached template changes.
+    static const uint32_t VERSION = 1;
+
+    static TemplateMatcherCache& instance();
+
+    //  Build the cache key for a template loaded from "path" with the
+    //  specified preprocessing parameters.
+    static std::string make_key(
+        const std::string& path,
+        uint32_t min_color, uint32_t max_color,
+        size_t min_area
+    );
+
+    //  If "key" is in the cache and still matches "source_path", copy it into
+    //  "entry" and return true. Otherwise return false.
+    bool get(const std::string& key, const std::string& source_path, CachedTemplate& entry);
+
+    //  Add an entry to the cache. It is written out on the next "flush()".
+    void put(
+        const std::string& key, const std::string& source_path,
+        const ImageViewRGB32& image, const ImageStats& stats, double area_ratio
+    );
+
+    //  Write the cache out to disk if anything was added since the last flush.
+    //  Readers are only blocked while the file contents are assembled.
+    void flush();
+
+
+private:
+    TemplateMatcherCache();
+    ~TemplateMatcherCache();
+
+    void open_file();
+    void close_file();
+    std::string serialize();
+
+
+private:
+    struct Entry{
+        int64_t source_size;
+        int64_t source_modified;
+        ImageStats stats;
+        double area_ratio;
+        size_t width;
+        size_t height;
+
+        //  Points into the mapped file. null if this entry was added in this
+        //  session and only exists in "owned".
+        const uint32_t* mapped_pixels;
+        ImageRGB32 owned;
+
+        ImageViewRGB32 image() const;
+    };
+
+    struct MappedFile;
+
+    std::mutex m_flush_lock;
+    std::mutex m_lock;
+    bool m_dirty = false;
+    std::string m_path;
+    Pimpl<MappedFile> m_file;
+    std::map<std::string, Entry> m_entries;
+};
+
+
+
+//  Return true if the template cache is enabled in the global settings.
+bool template_cache_enabled();
+
+
+
+}
+}
+#endif
@@ -0,0 +1,57 @@
+/*  Template Matcher Warmup
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Concurrency/FireForgetDispatcher.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "TemplateMatcherCache.h"
+#include "TemplateMatcherWarmup.h"
+
+namespace PokemonAutomation{
+namespace ImageMatch{
+
+
+
+void TemplateMatcherWarmup::run() const{
+    WallClock start = current_time();
+    for (const std::function<void()>& function : m_functions){
+        try{
+            function();
+        }catch (Exception& e){
+            global_logger_tagged().log("Unable to preload matcher: " + e.to_str(), COLOR_RED);
+        }
+    }
+
+    //  Write out everything that was built here in one go.
+    if (template_cache_enabled()){
+        TemplateMatcherCache::instance().flush();
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(current_time() - start);
+    global_logger_tagged().log(
+        "Preloaded " + std::to_string(m_functions.size()) +
+        " matcher(s) in " + std::to_string(elapsed.count()) + " ms."
+    );
+}
+void TemplateMatcherWarmup::run_async() const{
+    if (m_functions.empty() || !GlobalSettings::instance().PRELOAD_TEMPLATE_MATCHERS){
+        return;
+    }
+
+    //  The matchers are function-local statics so it's safe for the program
+    //  thread to use them while they are being built here. It will just wait.
+    TemplateMatcherWarmup copy(*this);
+    global_dispatcher.dispatch([copy = std::move(copy)]{
+        copy.run();
+    });
+}
+
+
+
+}
+}
@@ -0,0 +1,46 @@
+/*  Template Matcher Warmup
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A list of the lazily constructed matchers that a program uses.
+ *  When the program starts, these are built on a background thread so the
+ *  first detection doesn't stall the program in the middle of a run.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_TemplateMatcherWarmup_H
+#define PokemonAutomation_CommonFramework_TemplateMatcherWarmup_H
+
+#include <vector>
+#include <functional>
+
+namespace PokemonAutomation{
+namespace ImageMatch{
+
+
+class TemplateMatcherWarmup{
+public:
+    //  Add a function that builds a matcher. (e.g. "&ArcPhoneMatcher::instance")
+    template <typename Function>
+    void add(Function function){
+        m_functions.emplace_back([=]{ function(); });
+    }
+
+    bool empty() const{ return m_functions.empty(); }
+
+    //  Build everything synchronously on this thread.
+    void run() const;
+
+    //  Build everything on a background thread. Returns immediately.
+    //  This does nothing if disabled in the global settings.
+    void run_async() const;
+
+private:
+    std::vector<std::function<void()>> m_functions;
+};
+
+
+
+}
+}
+#endif
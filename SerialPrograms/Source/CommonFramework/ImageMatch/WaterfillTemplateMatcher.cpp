@@ -4,6 +4,7 @@
  *
  */
 
+#include <algorithm>
 #include "Common/Cpp/Exceptions.h"
 #include "Kernels/Waterfill/Kernels_Waterfill.h"
 #include "CommonFramework/Globals.h"
@@ -11,6 +12,7 @@
 #include "CommonFramework/ImageTools/BinaryImage_FilterRgb32.h"
 #include "CommonFramework/Logging/Logger.h"
 #include "CommonFramework/Tools/DebugDumper.h"
+#include "TemplateMatcherCache.h"
 #include "WaterfillTemplateMatcher.h"
 
 #include <iostream>
@@ -30,11 +32,20 @@ WaterfillTemplateMatcher::WaterfillTemplateMatcher(
     size_t min_area
 ){
     std::string full_path = RESOURCE_PATH() + path;
-    ImageRGB32 reference(full_path);
 
-    PackedBinaryMatrix matrix = compress_rgb32_to_binary_range(reference, (uint32_t)min_color, (uint32_t)max_color);
-    std::vector<WaterfillObject> objects = find_objects_inplace(matrix, min_area);
-    if (objects.empty()){
+    std::string cache_key;
+    if (template_cache_enabled()){
+        cache_key = TemplateMatcherCache::make_key(path, (uint32_t)min_color, (uint32_t)max_color, min_area);
+        CachedTemplate cached;
+        if (TemplateMatcherCache::instance().get(cache_key, full_path, cached)){
+            m_matcher.reset(new ExactImageMatcher(std::move(cached.image), cached.stats));
+            m_area_ratio = cached.area_ratio;
+            return;
+        }
+    }
+
+    ImageRGB32 reference(full_path);
+    if (!set_template(reference, min_color, max_color, min_area)){
         throw FileException(
             nullptr, PA_CURRENT_FUNCTION,
             "Failed to find any waterfill objects in resource template file.",
@@ -42,6 +53,44 @@ WaterfillTemplateMatcher::WaterfillTemplateMatcher(
         );
     }
 
+    if (!cache_key.empty()){
+        TemplateMatcherCache::instance().put(
+            cache_key, full_path,
+            m_matcher->image_template(), m_matcher->stats(), m_area_ratio
+        );
+    }
+
+    if (PreloadSettings::debug().IMAGE_TEMPLATE_MATCHING){
+        const ImageViewRGB32 exact_image = m_matcher->image_template();
+        cout << "Build waterfil template matcher from " << full_path << ", W x H: " << exact_image.width()
+             << " x " << exact_image.height() <<  ", area ratio: " << m_area_ratio << endl;
+        dump_debug_image(global_logger_command_line(), "CommonFramework/WaterfillTemplateMatcher", "matcher_exact_image", exact_image);
+    }
+}
+
+WaterfillTemplateMatcher::WaterfillTemplateMatcher(
+    const ImageViewRGB32& reference,
+    Color min_color, Color max_color,
+    size_t min_area
+){
+    if (!set_template(reference, min_color, max_color, min_area)){
+        throw InternalProgramError(
+            nullptr, PA_CURRENT_FUNCTION,
+            "Failed to find any waterfill objects in template image."
+        );
+    }
+}
+bool WaterfillTemplateMatcher::set_template(
+    const ImageViewRGB32& reference,
+    Color min_color, Color max_color,
+    size_t min_area
+){
+    PackedBinaryMatrix matrix = compress_rgb32_to_binary_range(reference, (uint32_t)min_color, (uint32_t)max_color);
+    std::vector<WaterfillObject> objects = find_objects_inplace(matrix, min_area);
+    if (objects.empty()){
+        return false;
+    }
+
     const WaterfillObject* best = &objects[0];
     for (const WaterfillObject& object : objects){
         if (best->area < object.area){
@@ -51,13 +100,7 @@ WaterfillTemplateMatcher::WaterfillTemplateMatcher(
 
     m_matcher.reset(new ExactImageMatcher(extract_box_reference(reference, *best).copy()));
     m_area_ratio = best->area_ratio();
-
-    if (PreloadSettings::debug().IMAGE_TEMPLATE_MATCHING){
-        const auto exact_image = extract_box_reference(reference, *best);
-        cout << "Build waterfil template matcher from " << full_path << ", W x H: " << exact_image.width()
-             << " x " << exact_image.height() <<  ", area ratio: " << m_area_ratio << endl;
-        dump_debug_image(global_logger_command_line(), "CommonFramework/WaterfillTemplateMatcher", "matcher_exact_image", exact_image);
-    }
+    return true;
 }
 
 double WaterfillTemplateMatcher::rmsd(const ImageViewRGB32& image) const{
@@ -148,6 +191,45 @@ double WaterfillTemplateMatcher::rmsd_original(const ImageViewRGB32& original_im
     return rmsd;
 }
 
+const ExactImageMatcher& WaterfillTemplateMatcher::coarse_matcher(size_t scale) const{
+    std::lock_guard<std::mutex> lg(m_coarse->lock);
+    auto iter = m_coarse->matchers.find(scale);
+    if (iter == m_coarse->matchers.end()){
+        const ImageRGB32& image_template = m_matcher->image_template();
+        ImageRGB32 scaled = image_template.scale_to(
+            std::max<size_t>(image_template.width() / scale, 1),
+            std::max<size_t>(image_template.height() / scale, 1)
+        );
+        iter = m_coarse->matchers.emplace(scale, ExactImageMatcher(std::move(scaled))).first;
+    }
+    return iter->second;
+}
+double WaterfillTemplateMatcher::rmsd_coarse(
+    const ImageViewRGB32& coarse_image, const WaterfillObject& object,
+    size_t scale, double shape_tolerance
+) const{
+    ImageViewRGB32 image_template = m_matcher->image_template();
+
+    double aspect_error = (double)image_template.width() * object.height();
+    aspect_error /= (double)image_template.height() * object.width();
+    if (aspect_error < m_aspect_ratio_lower / shape_tolerance || aspect_error > m_aspect_ratio_upper * shape_tolerance){
+        return 99999.;
+    }
+
+    if (m_area_ratio != 0){
+        double area_error = object.area_ratio() / m_area_ratio;
+        if (area_error < m_area_ratio_lower / shape_tolerance || area_error > m_area_ratio_upper * shape_tolerance){
+            return 99999.;
+        }
+    }
+
+    ImageViewRGB32 cropped = extract_box_reference(coarse_image, object);
+    if (!cropped){
+        return 99999.;
+    }
+    return coarse_matcher(scale).rmsd(cropped);
+}
+
 
 
 
@@ -8,6 +8,8 @@
 #define PokemonAutomation_CommonFramework_WaterfillTemplateMatcher_H
 
 #include <memory>
+#include <map>
+#include <mutex>
 #include "Common/Compiler.h"
 #include "Common/Cpp/Color.h"
 #include "CommonFramework/ImageTools/ImageBoxes.h"
@@ -46,6 +48,14 @@ public:
         size_t min_area
     );
 
+    //  Same as above, but the reference image is already in memory.
+    //  Throw InternalProgramError when there is no object meeting the requirement.
+    WaterfillTemplateMatcher(
+        const ImageViewRGB32& reference,
+        Color min_color, Color max_color,
+        size_t min_area
+    );
+
     //  Compute RMSD of the current image against the template as-is, using `ExactImageMatcher`.
     // `ExactImageMatcher` will resize the image to match template size and scale template brightness to match the image
     //  before computing RMSD.
@@ -70,6 +80,16 @@ public:
     //  See `double rmsd(const ImageViewRGB32& image) const` on the details of comparing the image against the template.
     virtual double rmsd_original(const ImageViewRGB32& original_image, const WaterfillObject& object) const;
 
+    //  Like `rmsd_original()`, but for an object found on a copy of the image that was downsampled by `scale`.
+    //  The object is compared against a copy of the template downsampled the same way, so it is much cheaper.
+    //  The aspect ratio and area ratio bounds are widened by `shape_tolerance` since the edges are coarse.
+    //  `check_image()` is not called since it usually checks absolute sizes.
+    //  Used by `match_template_by_waterfill_coarse_to_fine()` to reject objects before the full resolution check.
+    double rmsd_coarse(
+        const ImageViewRGB32& coarse_image, const WaterfillObject& object,
+        size_t scale, double shape_tolerance
+    ) const;
+
 protected:
     virtual bool check_image(const ImageViewRGB32& image) const{ return true; };
     bool check_aspect_ratio(size_t candidate_width, size_t candidate_height) const;
@@ -85,6 +105,20 @@ protected:
 
     std::unique_ptr<ExactImageMatcher> m_matcher;
     double m_area_ratio;
+
+private:
+    //  Crop the largest object in the color range out of `reference` and use it as the template.
+    //  Return false if there is no such object.
+    bool set_template(const ImageViewRGB32& reference, Color min_color, Color max_color, size_t min_area);
+
+    const ExactImageMatcher& coarse_matcher(size_t scale) const;
+
+    //  Downsampled templates for `rmsd_coarse()`, by scale. Built on first use.
+    struct CoarseTemplates{
+        std::mutex lock;
+        std::map<size_t, ExactImageMatcher> matchers;
+    };
+    std::unique_ptr<CoarseTemplates> m_coarse = std::make_unique<CoarseTemplates>();
 };
 
 
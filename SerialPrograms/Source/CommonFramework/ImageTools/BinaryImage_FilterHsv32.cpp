@@ -0,0 +1,76 @@
+/*  Binary Image Filter HSV32
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.h"
+#include "CommonFramework/ImageTypes/ImageHSV32.h"
+#include "BinaryImage_FilterHsv32.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+uint32_t pack_hsv(uint8_t alpha, uint8_t hue, uint8_t saturation, uint8_t value){
+    return ((uint32_t)alpha << 24) | ((uint32_t)hue << 16) | ((uint32_t)saturation << 8) | (uint32_t)value;
+}
+
+}
+
+
+PackedBinaryMatrix compress_hsv32_to_binary_range(
+    const ImageViewHSV32& image,
+    uint8_t min_hue, uint8_t max_hue,
+    uint8_t min_saturation, uint8_t max_saturation,
+    uint8_t min_value, uint8_t max_value
+){
+    //  The HSV32 channels are bytes just like RGB32 so the RGB range kernels
+    //  work on them unchanged.
+    PackedBinaryMatrix ret(image.width(), image.height());
+    if (min_hue <= max_hue){
+        Kernels::compress_rgb32_to_binary_range(
+            image.data(), image.bytes_per_row(), ret,
+            pack_hsv(255, min_hue, min_saturation, min_value),
+            pack_hsv(255, max_hue, max_saturation, max_value)
+        );
+        return ret;
+    }
+
+    //  Hue wraps around. Split it into [min_hue, 255] and [0, max_hue] and
+    //  run both in the same pass.
+    PackedBinaryMatrix low(image.width(), image.height());
+    Kernels::CompressRgb32ToBinaryRangeFilter filters[] = {
+        {ret, pack_hsv(255, min_hue, min_saturation, min_value), pack_hsv(255, 255, max_saturation, max_value)},
+        {low, pack_hsv(255, 0, min_saturation, min_value), pack_hsv(255, max_hue, max_saturation, max_value)},
+    };
+    Kernels::compress_rgb32_to_binary_range(
+        image.data(), image.bytes_per_row(),
+        filters, 2
+    );
+    ret |= low;
+    return ret;
+}
+PackedBinaryMatrix compress_rgb32_to_binary_hsv_range(
+    const ImageViewRGB32& image,
+    uint8_t min_hue, uint8_t max_hue,
+    uint8_t min_saturation, uint8_t max_saturation,
+    uint8_t min_value, uint8_t max_value
+){
+    ImageHSV32 hsv(image);
+    return compress_hsv32_to_binary_range(
+        hsv,
+        min_hue, max_hue,
+        min_saturation, max_saturation,
+        min_value, max_value
+    );
+}
+
+
+
+}
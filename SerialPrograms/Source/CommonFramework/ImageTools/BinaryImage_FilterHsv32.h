@@ -0,0 +1,46 @@
+/*  Binary Image Filter HSV32
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Range filters in HSV space. Thresholds on hue and saturation are much
+ *  less sensitive to the brightness of the capture than RGB thresholds.
+ *
+ *  All channels use the same 0-255 scale as ImageHSV32. Hue is circular: if
+ *  "min_hue" > "max_hue", the range wraps around through 0. (e.g. 240 - 16
+ *  selects reds on both sides of 0)
+ *
+ *  Only fully opaque pixels can be in range.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_BinaryImage_FilterHsv32_H
+#define PokemonAutomation_CommonFramework_BinaryImage_FilterHsv32_H
+
+#include <stdint.h>
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/ImageTypes/ImageViewHSV32.h"
+#include "CommonFramework/ImageTypes/BinaryImage.h"
+
+namespace PokemonAutomation{
+
+
+//  Pixels within the HSV range are 1 in the returned matrix. Others are 0.
+PackedBinaryMatrix compress_hsv32_to_binary_range(
+    const ImageViewHSV32& image,
+    uint8_t min_hue, uint8_t max_hue,
+    uint8_t min_saturation, uint8_t max_saturation,
+    uint8_t min_value, uint8_t max_value
+);
+
+//  Same as above, but converts the image to HSV first.
+PackedBinaryMatrix compress_rgb32_to_binary_hsv_range(
+    const ImageViewRGB32& image,
+    uint8_t min_hue, uint8_t max_hue,
+    uint8_t min_saturation, uint8_t max_saturation,
+    uint8_t min_value, uint8_t max_value
+);
+
+
+
+}
+#endif
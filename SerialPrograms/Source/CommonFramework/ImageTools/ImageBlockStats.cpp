@@ -0,0 +1,184 @@
+/*  Image Block Stats
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <cmath>
+#include "Common/Cpp/Exceptions.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqr.h"
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/VideoPipeline/VideoFeed.h"
+#include "ImageBlockStats.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+using Kernels::PIXEL_BLOCK_SIZE;
+
+
+ImageBlockStats::ImageBlockStats(const ImageViewRGB32& image)
+    : m_width(image.width())
+    , m_height(image.height())
+    , m_blocks_x(m_width / PIXEL_BLOCK_SIZE)
+    , m_blocks_y(m_height / PIXEL_BLOCK_SIZE)
+    , m_blocks(m_blocks_x * m_blocks_y)
+{
+    if (m_blocks.empty()){
+        return;
+    }
+    Kernels::pixel_block_sums(
+        m_blocks.data(),
+        m_width, m_height,
+        image.data(), image.bytes_per_row()
+    );
+}
+
+
+namespace{
+
+void add_pixel_sums(
+    Kernels::PixelSums& sums, const ImageViewRGB32& image,
+    size_t min_x, size_t min_y, size_t width, size_t height
+){
+    if (width == 0 || height == 0){
+        return;
+    }
+    ImageViewRGB32 region = image.sub_image(min_x, min_y, width, height);
+    Kernels::pixel_sum_sqr(
+        sums, region.width(), region.height(),
+        region.data(), region.bytes_per_row(),
+        region.data(), region.bytes_per_row()
+    );
+}
+
+}
+
+ImageStats ImageBlockStats::stats(const ImageViewRGB32& image, const ImageFloatBox& box) const{
+    if (image.width() != m_width || image.height() != m_height){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Mismatching Dimensions");
+    }
+
+    ImageViewRGB32 region = extract_box_reference(image, box);
+    size_t width = region.width();
+    size_t height = region.height();
+    if (width == 0 || height == 0){
+        return image_stats(region);
+    }
+
+    size_t offset = (const char*)region.data() - (const char*)image.data();
+    size_t x0 = offset % image.bytes_per_row() / sizeof(uint32_t);
+    size_t y0 = offset / image.bytes_per_row();
+    size_t x1 = x0 + width;
+    size_t y1 = y0 + height;
+
+    //  The blocks that are entirely inside the box.
+    size_t bx0 = (x0 + PIXEL_BLOCK_SIZE - 1) / PIXEL_BLOCK_SIZE;
+    size_t by0 = (y0 + PIXEL_BLOCK_SIZE - 1) / PIXEL_BLOCK_SIZE;
+    size_t bx1 = std::min(x1 / PIXEL_BLOCK_SIZE, m_blocks_x);
+    size_t by1 = std::min(y1 / PIXEL_BLOCK_SIZE, m_blocks_y);
+    if (bx0 >= bx1 || by0 >= by1){
+        return image_stats(region);
+    }
+
+    Kernels::PixelSums sums;
+    for (size_t by = by0; by < by1; by++){
+        const Kernels::PixelBlockSums* block = m_blocks.data() + by * m_blocks_x + bx0;
+        for (size_t bx = bx0; bx < bx1; bx++, block++){
+            sums.count += block->count;
+            sums.sumR += block->sumR;
+            sums.sumG += block->sumG;
+            sums.sumB += block->sumB;
+            sums.sqrR += block->sqrR;
+            sums.sqrG += block->sqrG;
+            sums.sqrB += block->sqrB;
+        }
+    }
+
+    //  The edges of the box that only partially cover a block.
+    size_t cx0 = bx0 * PIXEL_BLOCK_SIZE;
+    size_t cy0 = by0 * PIXEL_BLOCK_SIZE;
+    size_t cx1 = bx1 * PIXEL_BLOCK_SIZE;
+    size_t cy1 = by1 * PIXEL_BLOCK_SIZE;
+    add_pixel_sums(sums, image, x0, y0, width, cy0 - y0);
+    add_pixel_sums(sums, image, x0, cy1, width, y1 - cy1);
+    add_pixel_sums(sums, image, x0, cy0, cx0 - x0, cy1 - cy0);
+    add_pixel_sums(sums, image, cx1, cy0, x1 - cx1, cy1 - cy0);
+
+    //  The sums are exact integers. So this is bit-for-bit the same as
+    //  running "image_stats()" on the whole box.
+    return image_stats(sums);
+}
+
+
+double ImageBlockStats::pixel_RMSD_lower_bound(const ImageBlockStats& reference, const ImageBlockStats& image){
+    if (reference.m_width != image.m_width || reference.m_height != image.m_height){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Mismatching Dimensions");
+    }
+    size_t pixels = reference.m_width * reference.m_height;
+    if (pixels == 0){
+        return 0;
+    }
+
+    //  Within a block, the sum of the squared differences is at least the
+    //  square of the summed difference divided by the block size. Blocks with
+    //  transparent pixels are skipped since "pixel_RMSD()" masks those out.
+    //  It divides by the number of opaque pixels, which is at most "pixels".
+    const uint32_t FULL = PIXEL_BLOCK_SIZE * PIXEL_BLOCK_SIZE;
+    uint64_t sum = 0;
+    size_t blocks = reference.m_blocks.size();
+    for (size_t c = 0; c < blocks; c++){
+        const Kernels::PixelBlockSums& r = reference.m_blocks[c];
+        const Kernels::PixelBlockSums& i = image.m_blocks[c];
+        if (r.count != FULL || i.count != FULL){
+            continue;
+        }
+        int64_t dR = (int64_t)r.sumR - i.sumR;
+        int64_t dG = (int64_t)r.sumG - i.sumG;
+        int64_t dB = (int64_t)r.sumB - i.sumB;
+        sum += dR*dR + dG*dG + dB*dB;
+    }
+
+    //  Division and square root round monotonically. So this can't come out
+    //  above "pixel_RMSD()" even after rounding.
+    return std::sqrt((double)sum / (double)FULL / (double)pixels);
+}
+
+
+
+//  At 1920x1080 with an 80% box, building the blocks and one query cost
+//  about 750us. Reading the box directly costs about 370us and a query on
+//  built blocks about 30us.
+const size_t BLOCK_STATS_BUILD_REQUEST = 3;
+
+std::shared_ptr<const ImageBlockStats> cached_block_stats(const VideoSnapshot& snapshot){
+    VideoSnapshotCache* cache = snapshot.cache.get();
+    if (cache == nullptr || !cache->block_stats_ready.load(std::memory_order_acquire)){
+        return nullptr;
+    }
+    return cache->block_stats;
+}
+std::shared_ptr<const ImageBlockStats> shared_block_stats(const VideoSnapshot& snapshot){
+    VideoSnapshotCache* cache = snapshot.cache.get();
+    if (cache == nullptr || !snapshot.frame){
+        return nullptr;
+    }
+    if (cache->block_stats_ready.load(std::memory_order_acquire)){
+        return cache->block_stats;
+    }
+    if (cache->block_stats_requests.fetch_add(1, std::memory_order_relaxed) + 1 < BLOCK_STATS_BUILD_REQUEST){
+        return nullptr;
+    }
+    std::call_once(cache->block_stats_built, [&]{
+        cache->block_stats = std::make_shared<const ImageBlockStats>(*snapshot.frame);
+        cache->block_stats_ready.store(true, std::memory_order_release);
+    });
+    return cache->block_stats;
+}
+
+
+
+}
@@ -0,0 +1,71 @@
+/*  Image Block Stats
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      An image downsampled to 1/8 resolution where every 8x8 block keeps the
+ *  pixel sums and sums of squares. It is cached in the video snapshot, so
+ *  every callback looking at that frame shares it.
+ *
+ *  Building it reads the whole frame. That costs about twice as much as
+ *  reading a large box directly, so it only pays off when several checks
+ *  look at the same frame. "shared_block_stats()" builds it on the third
+ *  request for a snapshot.
+ *
+ *  "stats()" gives exactly the same result as "image_stats()" on the same
+ *  box. It only reads the pixels along the edges of the box that don't fill a
+ *  whole block. So the thresholds of the existing detectors don't change.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_ImageBlockStats_H
+#define PokemonAutomation_CommonFramework_ImageBlockStats_H
+
+#include <memory>
+#include <vector>
+#include "Kernels/ImageStats/Kernels_ImagePixelBlockSums.h"
+#include "ImageStats.h"
+#include "ImageBoxes.h"
+
+namespace PokemonAutomation{
+
+struct VideoSnapshot;
+
+
+class ImageBlockStats{
+public:
+    ImageBlockStats(const ImageViewRGB32& image);
+
+    size_t width() const{ return m_width; }
+    size_t height() const{ return m_height; }
+
+    //  Same as "image_stats(extract_box_reference(image, box))".
+    //  "image" must be the image these stats were built from.
+    ImageStats stats(const ImageViewRGB32& image, const ImageFloatBox& box) const;
+
+    //  Never more than "pixel_RMSD(reference, image)" on the images these were
+    //  built from. Both images must have the same dimensions.
+    static double pixel_RMSD_lower_bound(const ImageBlockStats& reference, const ImageBlockStats& image);
+
+private:
+    size_t m_width;
+    size_t m_height;
+    size_t m_blocks_x;
+    size_t m_blocks_y;
+    std::vector<Kernels::PixelBlockSums> m_blocks;
+};
+
+
+//  The block stats of the snapshot's frame if something already built them.
+//  Otherwise null. Never builds them.
+std::shared_ptr<const ImageBlockStats> cached_block_stats(const VideoSnapshot& snapshot);
+
+//  The block stats of the snapshot's frame, shared by all copies of the
+//  snapshot. Returns null for the first requests for a snapshot, so a frame
+//  that only one or two checks look at never pays for them. The caller
+//  should then read the frame directly. The third request builds them.
+std::shared_ptr<const ImageBlockStats> shared_block_stats(const VideoSnapshot& snapshot);
+
+
+
+}
+#endif
@@ -57,7 +57,9 @@ ImageStats image_stats(const ImageViewRGB32& image){
         image.data(), image.bytes_per_row(),
         image.data(), image.bytes_per_row()
     );
-
+    return image_stats(sums);
+}
+ImageStats image_stats(const Kernels::PixelSums& sums){
     FloatPixel sum((double)sums.sumR, (double)sums.sumG, (double)sums.sumB);
     FloatPixel sqr((double)sums.sqrR, (double)sums.sqrG, (double)sums.sqrB);
 
@@ -5,12 +5,14 @@
  */
 
 #include <map>
+#include <algorithm>
 #include "Common/Cpp/Color.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Types.h"
 #include "CommonFramework/ImageMatch/WaterfillTemplateMatcher.h"
 #include "CommonFramework/ImageTools/BinaryImage_FilterRgb32.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "WaterfillUtilities.h"
@@ -133,6 +135,118 @@ bool match_template_by_waterfill(
 }
 
 
+bool match_template_by_waterfill_coarse_to_fine(
+    const ImageViewRGB32 &image,
+    const ImageMatch::WaterfillTemplateMatcher &matcher,
+    const std::vector<std::pair<uint32_t, uint32_t>> &filters,
+    const std::pair<size_t, size_t> &area_thresholds,
+    double rmsd_threshold,
+    std::function<bool(Kernels::Waterfill::WaterfillObject& object)> check_matched_object,
+    const WaterfillPyramidOptions& options)
+{
+    const size_t scale = std::max<size_t>(options.scale, 1);
+    const size_t coarse_width = image.width() / scale;
+    const size_t coarse_height = image.height() / scale;
+    if (scale == 1 || coarse_width == 0 || coarse_height == 0){
+        return match_template_by_waterfill(
+            image, matcher, filters, area_thresholds, rmsd_threshold, std::move(check_matched_object)
+        );
+    }
+
+    const bool debug = PreloadSettings::debug().IMAGE_TEMPLATE_MATCHING;
+    if (debug){
+        std::cout << "Match template by waterfill (coarse-to-fine x" << scale << "), "
+                  << filters.size() << " filter(s)" << std::endl;
+    }
+
+    ImageRGB32 coarse = image.scale_to(coarse_width, coarse_height);
+    std::vector<PackedBinaryMatrix> coarse_matrices = compress_rgb32_to_binary_range(coarse, filters);
+
+    //  Area thresholds at the coarse level. Be generous since edges get blended.
+    const size_t scale_sqr = scale * scale;
+    const size_t coarse_min_area = std::max<size_t>(area_thresholds.first / scale_sqr / 2, 1);
+    const size_t coarse_max_area = area_thresholds.second == SIZE_MAX
+        ? SIZE_MAX
+        : area_thresholds.second / scale_sqr * 2 + 1;
+    const double coarse_rmsd_threshold = rmsd_threshold * options.coarse_rmsd_multiplier;
+
+    std::unique_ptr<Kernels::Waterfill::WaterfillSession> session = Kernels::Waterfill::make_WaterfillSession();
+    std::unique_ptr<Kernels::Waterfill::WaterfillSession> seed_session = Kernels::Waterfill::make_WaterfillSession();
+    Kernels::Waterfill::WaterfillObject object;
+
+    bool detected = false;
+    for (size_t f = 0; f < filters.size(); f++){
+        //  Coarse pass: Collect the full resolution boxes of the objects that survive.
+        std::vector<ImagePixelBox> candidates;
+        session->set_source(coarse_matrices[f]);
+        auto finder = session->make_iterator(coarse_min_area);
+        while (finder->find_next(object, false)){
+            if (object.area > coarse_max_area){
+                continue;
+            }
+            double rmsd = matcher.rmsd_coarse(coarse, object, scale, options.shape_tolerance);
+            if (debug){
+                std::cout << "Coarse object area: " << object.area << ", rmsd: " << rmsd << std::endl;
+            }
+            if (rmsd >= coarse_rmsd_threshold){
+                continue;
+            }
+            //  Map back to full resolution with a margin of one coarse pixel.
+            ImagePixelBox box(
+                object.min_x * scale, object.min_y * scale,
+                object.max_x * scale, object.max_y * scale
+            );
+            box = box.expand_as(scale);
+            box.clip(image.width(), image.height());
+            candidates.emplace_back(box);
+        }
+        if (candidates.empty()){
+            continue;
+        }
+
+        //  Fine pass: Filter the whole image so that objects are never cut off
+        //  at the edge of a box. But only waterfill the objects under the
+        //  candidates. Each one is removed from the matrix once it is found.
+        PackedBinaryMatrix matrix = compress_rgb32_to_binary_range(image, filters[f].first, filters[f].second);
+        session->set_source(matrix);
+        for (const ImagePixelBox& box : candidates){
+            //  Every piece of the box is a seed for a full resolution object.
+            //  Pieces of an object that was already found are no longer set.
+            PackedBinaryMatrix pieces = matrix.submatrix(box.min_x, box.min_y, box.width(), box.height());
+            seed_session->set_source(pieces);
+            auto seeds = seed_session->make_iterator(1);
+            Kernels::Waterfill::WaterfillObject piece;
+            while (seeds->find_next(piece, false)){
+                if (!session->find_object_on_bit(object, false, box.min_x + piece.body_x, box.min_y + piece.body_y)){
+                    continue;
+                }
+                if (debug){
+                    std::cout << "Object area: " << object.area << std::endl;
+                }
+                if (object.area < area_thresholds.first || object.area > area_thresholds.second){
+                    continue;
+                }
+                double rmsd = matcher.rmsd_original(image, object);
+                if (debug){
+                    std::cout << "Object rmsd: " << rmsd << std::endl;
+                }
+                if (rmsd >= rmsd_threshold){
+                    continue;
+                }
+                detected = true;
+                if (check_matched_object(object)){
+                    return true;
+                }
+            }
+        }
+    }
+    if (debug){
+        std::cout << "End match template by waterfill (coarse-to-fine)" << std::endl;
+    }
+    return detected;
+}
+
+
 void draw_matrix_on_image(
     const PackedBinaryMatrix& matrix,
     uint32_t color, ImageRGB32& image, size_t offset_x, size_t offset_y
@@ -61,6 +61,35 @@ bool match_template_by_waterfill(
     double rmsd_threshold,
     std::function<bool(Kernels::Waterfill::WaterfillObject& object)> check_matched_object);
 
+// Options for `match_template_by_waterfill_coarse_to_fine()`.
+struct WaterfillPyramidOptions{
+    // The coarse pass runs on the image downsampled by this much.
+    size_t scale = 2;
+    // A coarse object is kept if its RMSD against the downsampled template is below
+    // `rmsd_threshold * coarse_rmsd_multiplier`. Downsampling blends edges, so this should be above 1.
+    double coarse_rmsd_multiplier = 1.5;
+    // The matcher's aspect ratio and area ratio bounds are widened by this much for the coarse pass.
+    double shape_tolerance = 1.25;
+};
+
+// Same as `match_template_by_waterfill()`, but cheaper on images with many candidate objects.
+// First filter and waterfill a downsampled copy of the image. Objects there are rejected by area, by
+// aspect and area ratio, and by RMSD against a downsampled template. The image is only filtered at full
+// resolution if some objects survive. Then the full resolution objects under the survivors are found and
+// checked exactly as `match_template_by_waterfill()` checks them. On images with only a few objects this
+// is slower, since the downsampling costs more than the RMSD checks it saves.
+// So every object it matches is also matched by `match_template_by_waterfill()`. It can miss objects that
+// are only a few pixels wide after downsampling. Check a detector's tests before switching it over.
+// The order of `check_matched_object()` calls is not the same as `match_template_by_waterfill()`.
+bool match_template_by_waterfill_coarse_to_fine(
+    const ImageViewRGB32 &image,
+    const ImageMatch::WaterfillTemplateMatcher &matcher,
+    const std::vector<std::pair<uint32_t, uint32_t>> &filters,
+    const std::pair<size_t, size_t> &area_thresholds,
+    double rmsd_threshold,
+    std::function<bool(Kernels::Waterfill::WaterfillObject& object)> check_matched_object,
+    const WaterfillPyramidOptions& options = WaterfillPyramidOptions());
+
 // Draw matrix on an image. Used for debugging the matrix.
 // color: color of the pixels from the matrix to render on the image.
 // offset_x, offset_y: the offset of the matrix when rendered on the image.
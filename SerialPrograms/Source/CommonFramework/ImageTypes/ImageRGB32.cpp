@@ -9,6 +9,7 @@
 #include "Common/Cpp/Containers/Pimpl.tpp"
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "CommonFramework/Resources/ResourceBundle.h"
 #include "ImageViewRGB32.h"
 #include "ImageRGB32.h"
 
@@ -60,6 +61,9 @@ ImageRGB32::ImageRGB32(size_t width, size_t height)
     m_ptr = m_data->self.data();
 }
 ImageRGB32::ImageRGB32(const std::string& filename){
+    if (ResourceBundle::instance().load_image(filename, *this)){
+        return;
+    }
     QImage image(QString::fromStdString(filename));
     if (image.isNull()){
         throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open image.", filename);
@@ -83,7 +83,10 @@ bool AudioPerSpectrumDetectorBase::process_spectrums(
     }
 //    cout << "New spectrums - " << new_spectrums.size() << endl;
 
-    WallClock now = current_time();
+    //  Go by the time of the audio rather than the wall clock so that the
+    //  detector behaves the same when a recording is replayed faster than real
+    //  time. For live audio, the two are within an inference period.
+    WallClock now = new_spectrums[0].timestamp;
     m_spectrums_processed += new_spectrums.size();
 
     //  Clear last detection.
@@ -82,6 +82,8 @@ public:
     void log_results();
 
     float lowest_error() const{ return m_lowest_error; }
+    // The error coefficient of the most recent match. 1.0 if nothing has matched in the last second.
+    float last_error() const{ return m_last_error; }
 
 protected:
     // To be implemented by derived classes:
@@ -10,6 +10,7 @@
 #include "Common/Cpp/Containers/AlignedVector.tpp"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/AudioPipeline/AudioTemplate.h"
+#include "CommonFramework/Resources/ResourceBundle.h"
 #include "AudioTemplateCache.h"
 
 
@@ -33,7 +34,9 @@ const AudioTemplate* AudioTemplateCache::get_nothrow_internal(const std::string&
     }
 
     std::string full_path = full_path_no_ext + ".wav";
-    if (!QFileInfo::exists(QString::fromStdString(full_path))){
+    if (!ResourceBundle::instance().contains(full_path) &&
+        !QFileInfo::exists(QString::fromStdString(full_path))
+    ){
         full_path = full_path_no_ext + ".mp3";
     }
 
@@ -9,6 +9,8 @@
  */
 
 #include "CommonFramework/ImageTools/SolidColorTest.h"
+#include "CommonFramework/ImageTools/ImageBlockStats.h"
+#include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayScopes.h"
 #include "BlackScreenDetector.h"
 
@@ -35,6 +37,13 @@ void BlackScreenDetector::make_overlays(VideoOverlaySet& items) const{
 bool BlackScreenDetector::detect(const ImageViewRGB32& screen) const{
     return is_black(extract_box_reference(screen, m_box), m_max_rgb_sum, m_max_stddev_sum);
 }
+bool BlackScreenDetector::detect(const VideoSnapshot& screen) const{
+    std::shared_ptr<const ImageBlockStats> blocks = shared_block_stats(screen);
+    if (!blocks){
+        return detect(*screen.frame);
+    }
+    return is_black(blocks->stats(*screen.frame, m_box), m_max_rgb_sum, m_max_stddev_sum);
+}
 
 
 
@@ -54,6 +63,13 @@ void WhiteScreenDetector::make_overlays(VideoOverlaySet& items) const{
 bool WhiteScreenDetector::detect(const ImageViewRGB32& screen) const{
     return is_white(extract_box_reference(screen, m_box), m_min_rgb_sum, m_max_stddev_sum);
 }
+bool WhiteScreenDetector::detect(const VideoSnapshot& screen) const{
+    std::shared_ptr<const ImageBlockStats> blocks = shared_block_stats(screen);
+    if (!blocks){
+        return detect(*screen.frame);
+    }
+    return is_white(blocks->stats(*screen.frame, m_box), m_min_rgb_sum, m_max_stddev_sum);
+}
 
 
 
@@ -68,6 +84,9 @@ BlackScreenWatcher::BlackScreenWatcher(
 void BlackScreenWatcher::make_overlays(VideoOverlaySet& items) const{
     BlackScreenDetector::make_overlays(items);
 }
+bool BlackScreenWatcher::process_frame(const VideoSnapshot& frame){
+    return detect(frame);
+}
 bool BlackScreenWatcher::process_frame(const ImageViewRGB32& frame, WallClock timestamp){
     return detect(frame);
 }
@@ -86,6 +105,9 @@ BlackScreenOverWatcher::BlackScreenOverWatcher(
 void BlackScreenOverWatcher::make_overlays(VideoOverlaySet& items) const{
     m_detector.make_overlays(items);
 }
+bool BlackScreenOverWatcher::process_frame(const VideoSnapshot& frame){
+    return black_is_over(frame);
+}
 bool BlackScreenOverWatcher::process_frame(const ImageViewRGB32& frame, WallClock timestamp){
     return black_is_over(frame);
 }
@@ -96,6 +118,13 @@ bool BlackScreenOverWatcher::black_is_over(const ImageViewRGB32& frame){
     }
     return m_has_been_black;
 }
+bool BlackScreenOverWatcher::black_is_over(const VideoSnapshot& frame){
+    if (m_detector.detect(frame)){
+        m_has_been_black = true;
+        return false;
+    }
+    return m_has_been_black;
+}
 
 
 
@@ -112,6 +141,9 @@ void WhiteScreenOverWatcher::make_overlays(VideoOverlaySet& items) const{
     m_detector.make_overlays(items);
 }
 
+bool WhiteScreenOverWatcher::process_frame(const VideoSnapshot& frame){
+    return white_is_over(frame);
+}
 bool WhiteScreenOverWatcher::process_frame(const ImageViewRGB32& frame, WallClock timestamp){
     return white_is_over(frame);
 }
@@ -122,6 +154,13 @@ bool WhiteScreenOverWatcher::white_is_over(const ImageViewRGB32& frame){
     }
     return m_has_been_white;
 }
+bool WhiteScreenOverWatcher::white_is_over(const VideoSnapshot& frame){
+    if (m_detector.detect(frame)){
+        m_has_been_white = true;
+        return false;
+    }
+    return m_has_been_white;
+}
 
 
 
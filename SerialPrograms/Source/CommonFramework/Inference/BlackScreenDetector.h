@@ -18,6 +18,8 @@
 
 namespace PokemonAutomation{
 
+struct VideoSnapshot;
+
 
 class BlackScreenDetector : public StaticScreenDetector{
 public:
@@ -31,6 +33,10 @@ public:
     virtual void make_overlays(VideoOverlaySet& items) const override;
     virtual bool detect(const ImageViewRGB32& screen) const override;
 
+    //  Same result, but uses the snapshot's block stats instead of scanning
+    //  the whole box when other checks are looking at the same frame.
+    bool detect(const VideoSnapshot& screen) const;
+
 private:
     Color m_color;
     ImageFloatBox m_box;
@@ -49,6 +55,10 @@ public:
     virtual void make_overlays(VideoOverlaySet& items) const override;
     virtual bool detect(const ImageViewRGB32& screen) const override;
 
+    //  Same result, but uses the snapshot's block stats instead of scanning
+    //  the whole box when other checks are looking at the same frame.
+    bool detect(const VideoSnapshot& screen) const;
+
 private:
     Color m_color;
     ImageFloatBox m_box;
@@ -67,6 +77,7 @@ public:
     );
 
     virtual void make_overlays(VideoOverlaySet& items) const override;
+    virtual bool process_frame(const VideoSnapshot& frame) override;
     virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp) override;
 };
 
@@ -81,9 +92,11 @@ public:
     );
 
     bool black_is_over(const ImageViewRGB32& frame);
+    bool black_is_over(const VideoSnapshot& frame);
 
     virtual void make_overlays(VideoOverlaySet& items) const override;
 
+    virtual bool process_frame(const VideoSnapshot& frame) override;
     virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp) override;
 
 private:
@@ -104,9 +117,11 @@ public:
     );
 
     bool white_is_over(const ImageViewRGB32& frame);
+    bool white_is_over(const VideoSnapshot& frame);
 
     virtual void make_overlays(VideoOverlaySet& items) const override;
 
+    virtual bool process_frame(const VideoSnapshot& frame) override;
     virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp) override;
 
 private:
@@ -5,6 +5,7 @@
  */
 
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/ImageTools/ImageBlockStats.h"
 #include "CommonFramework/ImageMatch/ImageDiff.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayScopes.h"
 #include "FrozenImageDetector.h"
@@ -42,6 +43,18 @@ bool FrozenImageDetector::process_frame(const VideoSnapshot& frame){
         return false;
     }
 
+    //  When the screen is changing, the block averages alone are usually
+    //  enough to tell. But building them costs more than the full comparison.
+    //  So only use them if other callbacks already built them for both frames.
+    std::shared_ptr<const ImageBlockStats> previous_blocks = cached_block_stats(m_previous);
+    std::shared_ptr<const ImageBlockStats> current_blocks = cached_block_stats(frame);
+    if (previous_blocks && current_blocks &&
+        ImageBlockStats::pixel_RMSD_lower_bound(*previous_blocks, *current_blocks) > m_rmsd_threshold
+    ){
+        m_previous = frame;
+        return false;
+    }
+
     double rmsd = ImageMatch::pixel_RMSD(m_previous, frame);
 //    cout << "rmsd = " << rmsd << endl;
     if (rmsd > m_rmsd_threshold){
@@ -5,7 +5,9 @@
  */
 
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Tracing.h"
 #include "CommonFramework/AudioPipeline/AudioFeed.h"
+#include "InferenceProfiler.h"
 #include "AudioInferencePivot.h"
 
 //#include <iostream>
@@ -22,6 +24,12 @@ struct AudioInferencePivot::PeriodicCallback{
     AudioInferenceCallback& callback;
     std::chrono::milliseconds period;
 
+    //  The label of the callback for trace zones.
+    const char* trace_name;
+
+    //  Looked up the first time this is profiled.
+    InferenceProfiler::Entry* profile = nullptr;
+
     uint64_t last_seqnum = ~(uint64_t)0;
 
     StatAccumulatorI32 stats;
@@ -36,13 +44,18 @@ struct AudioInferencePivot::PeriodicCallback{
         , set_when_triggered(p_set_when_triggered)
         , callback(p_callback)
         , period(p_period)
+        , trace_name(trace_intern(p_callback.label()))
     {}
 };
 
 
-AudioInferencePivot::AudioInferencePivot(CancellableScope& scope, AudioFeed& feed, AsyncDispatcher& dispatcher)
+AudioInferencePivot::AudioInferencePivot(
+    CancellableScope& scope, AudioFeed& feed, AsyncDispatcher& dispatcher,
+    InferenceProfiler* profiler
+)
     : PeriodicRunner(dispatcher)
     , m_feed(feed)
+    , m_profiler(profiler)
 {
     attach(scope);
 }
@@ -85,6 +98,7 @@ StatAccumulatorI32 AudioInferencePivot::remove_callback(AudioInferenceCallback&
     return stats;
 }
 void AudioInferencePivot::run(void* event, bool is_back_to_back) noexcept{
+    PA_TRACE_ZONE("AudioInferencePivot::run");
     PeriodicCallback& callback = *(PeriodicCallback*)event;
     try{
         std::vector<AudioSpectrum> spectrums;
@@ -103,10 +117,18 @@ void AudioInferencePivot::run(void* event, bool is_back_to_back) noexcept{
             callback.last_seqnum = spectrums[0].stamp;
         }
 
+        TraceZone trace_callback(callback.trace_name);
         WallClock time0 = current_time();
         bool stop = callback.callback.process_spectrums(spectrums, m_feed);
         WallClock time1 = current_time();
-        callback.stats += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+        uint32_t microseconds = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+        callback.stats += microseconds;
+        if (m_profiler && InferenceProfiler::enabled()){
+            if (callback.profile == nullptr){
+                callback.profile = &m_profiler->entry(InferenceType::AUDIO, callback.callback.label());
+            }
+            m_profiler->report(*callback.profile, time1, microseconds);
+        }
         if (stop){
             if (callback.set_when_triggered){
                 InferenceCallback* expected = nullptr;
@@ -16,12 +16,17 @@
 namespace PokemonAutomation{
 
 class AudioFeed;
+class InferenceProfiler;
 
 
 
 class AudioInferencePivot final : public PeriodicRunner, public OverlayStat{
 public:
-    AudioInferencePivot(CancellableScope& scope, AudioFeed& feed, AsyncDispatcher& dispatcher);
+    //  If "profiler" is set, the time of every call is also reported to it.
+    AudioInferencePivot(
+        CancellableScope& scope, AudioFeed& feed, AsyncDispatcher& dispatcher,
+        InferenceProfiler* profiler = nullptr
+    );
     virtual ~AudioInferencePivot();
 
     //  If this callback returns true:
@@ -46,6 +51,7 @@ private:
     struct PeriodicCallback;
 
     AudioFeed& m_feed;
+    InferenceProfiler* m_profiler;
     SpinLock m_lock;
     std::map<AudioInferenceCallback*, PeriodicCallback> m_map;
 
@@ -0,0 +1,134 @@
+/*  Audio Inference Replay
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "CommonFramework/AudioPipeline/AudioReplayFeed.h"
+#include "CommonFramework/Inference/AudioPerSpectrumDetectorBase.h"
+#include "AudioInferenceCallback.h"
+#include "AudioInferencePivot.h"
+#include "InferenceReplay.tpp"
+#include "AudioInferenceReplay.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+namespace{
+
+class AudioReplayCallback : public ReplayCallback<AudioInferenceCallback>{
+public:
+    AudioReplayCallback(AudioInferenceCallback& callback, WallClock start, InferenceReplayCallbackResult& result)
+        : ReplayCallback(callback, start, result)
+        , m_detector(dynamic_cast<AudioPerSpectrumDetectorBase*>(&callback))
+    {}
+
+    void finish(){
+        if (m_detector != nullptr){
+            m_result.lowest_error = m_detector->lowest_error();
+        }
+    }
+
+    virtual bool process_spectrums(
+        const std::vector<AudioSpectrum>& new_spectrums,
+        AudioFeed& audio_feed
+    ) override{
+        if (!m_callback.process_spectrums(new_spectrums, audio_feed) || new_spectrums.empty()){
+            return false;
+        }
+        record(new_spectrums[0].timestamp);
+        if (m_detector != nullptr){
+            m_result.scores.emplace_back(m_detector->last_error());
+        }
+        return false;
+    }
+
+    //  The last spectrum this callback has seen. Same bookkeeping as
+    //  AudioInferencePivot.
+    uint64_t last_seqnum = ~(uint64_t)0;
+
+private:
+    AudioPerSpectrumDetectorBase* m_detector;
+};
+
+
+class AudioReplayDriver{
+public:
+    using CallbackType = AudioInferenceCallback;
+    using Wrapper = AudioReplayCallback;
+    using PivotType = AudioInferencePivot;
+    static constexpr InferenceType TYPE = InferenceType::AUDIO;
+    static constexpr const char* MEDIA = "Audio";
+
+    AudioReplayDriver(AudioReplayFeed& feed)
+        : m_feed(feed)
+    {}
+
+    std::string path() const{ return m_feed.path(); }
+    size_t frames() const{ return 0; }
+    std::chrono::milliseconds duration() const{ return m_feed.duration(); }
+    WallClock start_time() const{ return m_feed.start_time(); }
+    AudioReplayFeed& feed(){ return m_feed; }
+    void reset(){ m_feed.reset(); }
+
+    void play_real_time(CancellableScope& scope){
+        //  How often to push audio into the pipeline. Live audio arrives in
+        //  chunks of about this size.
+        const std::chrono::milliseconds CHUNK(10);
+
+        WallClock start = m_feed.start_time();
+        while (!m_feed.finished()){
+            m_feed.push_until(std::chrono::duration_cast<std::chrono::milliseconds>(current_time() - start));
+            scope.wait_for(CHUNK);
+        }
+    }
+
+    //  Unlike video, the audio at exactly the end of the recording can still
+    //  be seen by a callback.
+    bool before_end(std::chrono::milliseconds time) const{
+        return time <= m_feed.duration();
+    }
+    void advance(Wrapper& callback, std::chrono::milliseconds time){
+        m_feed.push_until(time);
+        m_spectrums = callback.last_seqnum == ~(uint64_t)0
+            ? m_feed.spectrums_latest(1)
+            : m_feed.spectrums_since(callback.last_seqnum + 1);
+        if (!m_spectrums.empty()){
+            callback.last_seqnum = m_spectrums[0].stamp;
+        }
+    }
+    void process(Wrapper& callback){
+        callback.process_spectrums(m_spectrums, m_feed);
+    }
+    void finish(){
+        m_feed.push_until(m_feed.duration());
+    }
+
+private:
+    AudioReplayFeed& m_feed;
+    std::vector<AudioSpectrum> m_spectrums;
+};
+
+}
+
+
+
+InferenceReplayReport run_audio_replay(
+    Logger& logger, AudioReplayFeed& feed,
+    const std::vector<PeriodicInferenceCallback>& callbacks,
+    bool real_time,
+    std::chrono::milliseconds default_period
+){
+    AudioReplayDriver driver(feed);
+    return run_inference_replay(logger, driver, callbacks, default_period, real_time);
+}
+
+
+
+
+}
@@ -0,0 +1,47 @@
+/*  Audio Inference Replay
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Run a set of audio inference callbacks over a recording without a
+ *  console or GUI. This is the audio counterpart of VisualInferenceReplay.
+ *
+ *  As with video, a callback returning true does not stop anything. Every
+ *  trigger is recorded and the whole recording is played.
+ *
+ *  In real-time mode, the recording is pushed at the speed it was recorded and
+ *  the callbacks run on a real AudioInferencePivot.
+ *
+ *  Otherwise, the pivot's schedule is simulated in audio time on the calling
+ *  thread. Before each callback runs, exactly as much audio is pushed as would
+ *  have arrived by then. So each call sees the same batch of spectrums it
+ *  would see live, but without any waiting.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_AudioInferenceReplay_H
+#define PokemonAutomation_CommonFramework_AudioInferenceReplay_H
+
+#include <vector>
+#include <chrono>
+#include "InferenceCallback.h"
+#include "InferenceReplay.h"
+
+namespace PokemonAutomation{
+
+class Logger;
+class AudioReplayFeed;
+
+
+//  Play the entire recording through the callbacks.
+//  All the callbacks must be audio.
+InferenceReplayReport run_audio_replay(
+    Logger& logger, AudioReplayFeed& feed,
+    const std::vector<PeriodicInferenceCallback>& callbacks,
+    bool real_time,
+    std::chrono::milliseconds default_period = std::chrono::milliseconds(20)
+);
+
+
+
+}
+#endif
@@ -0,0 +1,350 @@
+/*  Inference Profiler
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include <QDir>
+#include <QFile>
+#include "Common/Cpp/PrettyPrint.h"
+#include "CommonFramework/Globals.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "InferenceProfiler.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+//  Latency histogram with 4 buckets per power of two. (within 25% of the true value)
+class LatencyHistogram{
+public:
+    static constexpr size_t SUB_BUCKETS = 4;
+    static constexpr size_t BUCKETS = 32 * SUB_BUCKETS;
+
+    void operator+=(uint32_t x){
+        m_buckets[index(x)]++;
+    }
+
+    //  Returns the upper bound of the bucket holding the "fraction" quantile.
+    double quantile(uint64_t count, double fraction) const{
+        uint64_t target = (uint64_t)(count * fraction);
+        uint64_t seen = 0;
+        for (size_t c = 0; c < BUCKETS; c++){
+            seen += m_buckets[c];
+            if (seen > target){
+                return upper_bound(c);
+            }
+        }
+        return upper_bound(BUCKETS - 1);
+    }
+
+private:
+    static size_t index(uint32_t x){
+        if (x < SUB_BUCKETS){
+            return x;
+        }
+        size_t exp = 0;
+        while ((x >> exp) >= 2 * SUB_BUCKETS){
+            exp++;
+        }
+        //  x >> exp is now in [SUB_BUCKETS, 2*SUB_BUCKETS).
+        return (exp + 1) * SUB_BUCKETS + ((x >> exp) - SUB_BUCKETS);
+    }
+    static double upper_bound(size_t index){
+        if (index < SUB_BUCKETS){
+            return (double)index;
+        }
+        size_t exp = index / SUB_BUCKETS - 1;
+        size_t mantissa = index % SUB_BUCKETS + SUB_BUCKETS;
+        return (double)(((uint64_t)(mantissa + 1) << exp) - 1);
+    }
+
+private:
+    uint64_t m_buckets[BUCKETS] = {};
+};
+
+
+
+struct InferenceProfiler::Entry{
+    struct Sample{
+        WallClock timestamp;
+        uint32_t microseconds;
+    };
+
+    //  Last WINDOW of calls.
+    std::deque<Sample> window;
+
+    //  Whole run.
+    WallClock first_call = WallClock::max();
+    WallClock last_call = WallClock::min();
+    uint64_t calls = 0;
+    uint64_t total_us = 0;
+    uint32_t max_us = 0;
+    LatencyHistogram histogram;
+
+    void expire(WallClock now){
+        WallClock threshold = now - WINDOW;
+        while (!window.empty() && window.front().timestamp < threshold){
+            window.pop_front();
+        }
+    }
+};
+
+
+class InferenceProfiler::OverlayLine : public OverlayStat{
+public:
+    OverlayLine(InferenceProfiler& profiler, size_t index)
+        : m_profiler(profiler)
+        , m_index(index)
+    {}
+    virtual OverlayStatSnapshot get_current() override{
+        return m_profiler.overlay_line(m_index);
+    }
+
+private:
+    InferenceProfiler& m_profiler;
+    size_t m_index;
+};
+
+
+
+InferenceProfiler::~InferenceProfiler() = default;
+InferenceProfiler::InferenceProfiler()
+    : m_overlay_time(WallClock::min())
+{
+    for (size_t c = 0; c < OVERLAY_LINES; c++){
+        m_overlay_lines.emplace_back(new OverlayLine(*this, c));
+    }
+}
+
+InferenceProfiler::EntryMap& InferenceProfiler::map(InferenceType type){
+    return type == InferenceType::VISUAL ? m_video : m_audio;
+}
+const InferenceProfiler::EntryMap& InferenceProfiler::map(InferenceType type) const{
+    return type == InferenceType::VISUAL ? m_video : m_audio;
+}
+
+
+bool InferenceProfiler::enabled(){
+    const GlobalSettings& settings = GlobalSettings::instance();
+    return settings.INFERENCE_PROFILER || settings.INFERENCE_PROFILE_CSV;
+}
+InferenceProfiler::Entry& InferenceProfiler::entry(InferenceType type, const std::string& label){
+    SpinLockGuard lg(m_lock);
+    EntryMap& entries = map(type);
+    auto iter = entries.find(label);
+    if (iter == entries.end()){
+        iter = entries.emplace(label, std::make_unique<Entry>()).first;
+    }
+    return *iter->second;
+}
+void InferenceProfiler::report(Entry& entry, WallClock timestamp, uint32_t microseconds){
+    SpinLockGuard lg(m_lock);
+    entry.expire(timestamp);
+    entry.window.emplace_back(Entry::Sample{timestamp, microseconds});
+
+    entry.first_call = std::min(entry.first_call, timestamp);
+    entry.last_call = std::max(entry.last_call, timestamp);
+    entry.calls++;
+    entry.total_us += microseconds;
+    entry.max_us = std::max(entry.max_us, microseconds);
+    entry.histogram += microseconds;
+}
+
+
+std::vector<InferenceProfiler::Row> InferenceProfiler::current() const{
+    const double window_us = (double)std::chrono::duration_cast<std::chrono::microseconds>(WINDOW).count();
+    WallClock now = current_time();
+
+    std::vector<Row> ret;
+    std::vector<uint32_t> latencies;
+
+    SpinLockGuard lg(m_lock);
+    for (InferenceType type : {InferenceType::VISUAL, InferenceType::AUDIO}){
+        //  Entries are only trimmed when they are reported to. So callbacks
+        //  that have stopped running need to be filtered here.
+        WallClock threshold = now - WINDOW;
+        uint64_t pivot_us = 0;
+        size_t start = ret.size();
+        for (const auto& item : map(type)){
+            const Entry& entry = *item.second;
+            latencies.clear();
+            uint64_t total_us = 0;
+            for (const Entry::Sample& sample : entry.window){
+                if (sample.timestamp >= threshold){
+                    latencies.emplace_back(sample.microseconds);
+                    total_us += sample.microseconds;
+                }
+            }
+            if (latencies.empty()){
+                continue;
+            }
+
+            Row row;
+            row.type = type;
+            row.label = item.first;
+            row.calls = latencies.size();
+            row.total_us = total_us;
+            row.mean_us = (double)total_us / latencies.size();
+            row.max_us = *std::max_element(latencies.begin(), latencies.end());
+            auto p99 = latencies.begin() + latencies.size() * 99 / 100;
+            std::nth_element(latencies.begin(), p99, latencies.end());
+            row.p99_us = *p99;
+            row.utilization = total_us / window_us;
+
+            //  Measure the rate over the span of the samples so callbacks that
+            //  just started aren't underreported.
+            auto span = std::chrono::duration_cast<std::chrono::microseconds>(now - entry.window.front().timestamp);
+            span = std::max(span, std::chrono::microseconds(std::chrono::seconds(1)));
+            span = std::min(span, std::chrono::duration_cast<std::chrono::microseconds>(WINDOW));
+            row.calls_per_second = latencies.size() * 1000000. / span.count();
+
+            pivot_us += total_us;
+            ret.emplace_back(std::move(row));
+        }
+        for (size_t c = start; c < ret.size(); c++){
+            ret[c].share = pivot_us == 0 ? 0 : (double)ret[c].total_us / pivot_us;
+        }
+    }
+
+    std::sort(ret.begin(), ret.end(), [](const Row& a, const Row& b){
+        return a.total_us > b.total_us;
+    });
+    return ret;
+}
+std::vector<InferenceProfiler::Row> InferenceProfiler::totals() const{
+    std::vector<Row> ret;
+
+    SpinLockGuard lg(m_lock);
+    for (InferenceType type : {InferenceType::VISUAL, InferenceType::AUDIO}){
+        uint64_t pivot_us = 0;
+        size_t start = ret.size();
+        for (const auto& item : map(type)){
+            const Entry& entry = *item.second;
+
+            Row row;
+            row.type = type;
+            row.label = item.first;
+            row.calls = entry.calls;
+            row.total_us = entry.total_us;
+            row.mean_us = (double)entry.total_us / entry.calls;
+            row.max_us = entry.max_us;
+            row.p99_us = std::min(entry.histogram.quantile(entry.calls, 0.99), (double)entry.max_us);
+
+            auto span = std::chrono::duration_cast<std::chrono::microseconds>(entry.last_call - entry.first_call);
+            if (span.count() > 0){
+                row.calls_per_second = (entry.calls - 1) * 1000000. / span.count();
+                row.utilization = (double)entry.total_us / span.count();
+            }
+
+            pivot_us += entry.total_us;
+            ret.emplace_back(std::move(row));
+        }
+        for (size_t c = start; c < ret.size(); c++){
+            ret[c].share = pivot_us == 0 ? 0 : (double)ret[c].total_us / pivot_us;
+        }
+    }
+
+    std::sort(ret.begin(), ret.end(), [](const Row& a, const Row& b){
+        return a.total_us > b.total_us;
+    });
+    return ret;
+}
+
+
+std::string InferenceProfiler::to_csv() const{
+    std::string csv = "Type,Label,Calls,Calls/s,Mean (us),P99 (us),Max (us),Total (ms),Pivot Share (%),Utilization (%)\n";
+    for (const Row& row : totals()){
+        std::string label = row.label;
+        std::replace(label.begin(), label.end(), '"', '\'');
+        csv += row.type == InferenceType::VISUAL ? "Video," : "Audio,";
+        csv += "\"" + label + "\",";
+        csv += std::to_string(row.calls) + ",";
+        csv += tostr_fixed(row.calls_per_second, 2) + ",";
+        csv += tostr_fixed(row.mean_us, 1) + ",";
+        csv += tostr_fixed(row.p99_us, 0) + ",";
+        csv += std::to_string(row.max_us) + ",";
+        csv += tostr_fixed(row.total_us / 1000., 1) + ",";
+        csv += tostr_fixed(row.share * 100, 2) + ",";
+        csv += tostr_fixed(row.utilization * 100, 2) + "\n";
+    }
+    return csv;
+}
+std::string InferenceProfiler::save_csv(Logger& logger, const std::string& name) const{
+    {
+        SpinLockGuard lg(m_lock);
+        if (m_video.empty() && m_audio.empty()){
+            return "";
+        }
+    }
+
+    std::string folder = DEBUG_PATH() + "InferenceProfiles/";
+    QDir().mkpath(QString::fromStdString(folder));
+    std::string path = folder + now_to_filestring() + "-" + name + ".csv";
+
+    std::string csv = to_csv();
+    QFile file(QString::fromStdString(path));
+    if (!file.open(QIODevice::WriteOnly) || file.write(csv.c_str(), csv.size()) != (qint64)csv.size()){
+        logger.log("Unable to save inference profile to: " + path, COLOR_RED);
+        return "";
+    }
+    return path;
+}
+
+
+std::vector<OverlayStat*> InferenceProfiler::overlay_stats(){
+    std::vector<OverlayStat*> ret;
+    for (const auto& line : m_overlay_lines){
+        ret.emplace_back(line.get());
+    }
+    return ret;
+}
+OverlayStatSnapshot InferenceProfiler::overlay_line(size_t index){
+    if (!GlobalSettings::instance().INFERENCE_PROFILER){
+        return OverlayStatSnapshot();
+    }
+
+    SpinLockGuard lg(m_overlay_lock);
+
+    //  All the lines are redrawn together. Only recompute a few times a
+    //  second so the numbers are readable.
+    WallClock now = current_time();
+    if (m_overlay_time == WallClock::min() || now - m_overlay_time > std::chrono::milliseconds(500)){
+        m_overlay_time = now;
+        m_overlay_cache.clear();
+        for (const Row& row : current()){
+            if (m_overlay_cache.size() >= OVERLAY_LINES){
+                break;
+            }
+            Color color = COLOR_WHITE;
+            if (row.utilization > 0.50){
+                color = COLOR_RED;
+            }else if (row.utilization > 0.25){
+                color = COLOR_ORANGE;
+            }else if (row.utilization > 0.10){
+                color = COLOR_YELLOW;
+            }
+            m_overlay_cache.emplace_back(OverlayStatSnapshot{
+                (row.type == InferenceType::VISUAL ? "V: " : "A: ") + row.label + ": " +
+                tostr_fixed(row.share * 100, 0) + "%, " +
+                tostr_fixed(row.calls_per_second, 1) + "/s, " +
+                tostr_fixed(row.mean_us, 0) + "/" + tostr_fixed(row.p99_us, 0) + " us",
+                color
+            });
+        }
+    }
+
+    return index < m_overlay_cache.size()
+        ? m_overlay_cache[index]
+        : OverlayStatSnapshot();
+}
+
+
+
+}
@@ -0,0 +1,122 @@
+/*  Inference Profiler
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      CPU time of every inference callback on one console.
+ *
+ *  The video and audio pivots report the time of each call here. The last
+ *  few seconds are kept for the live numbers in the video overlay. A
+ *  histogram over the whole program run is kept for the CSV.
+ *
+ *  Callbacks are grouped by their label. So the same detector running in
+ *  several inference sessions shows up as one row.
+ *
+ *  The pivots only report while "enabled()". They look up the entry of each
+ *  callback once and reuse it for every call after that.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_InferenceProfiler_H
+#define PokemonAutomation_CommonFramework_InferenceProfiler_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "CommonFramework/VideoPipeline/VideoOverlayTypes.h"
+#include "InferenceCallback.h"
+
+namespace PokemonAutomation{
+
+class Logger;
+
+
+class InferenceProfiler{
+public:
+    //  How many of the busiest callbacks to show in the overlay.
+    static constexpr size_t OVERLAY_LINES = 6;
+
+    //  How much history to use for the live numbers.
+    static constexpr std::chrono::seconds WINDOW = std::chrono::seconds(5);
+
+    struct Row{
+        InferenceType type;
+        std::string label;
+        uint64_t calls = 0;
+        double calls_per_second = 0;
+        double mean_us = 0;
+        double p99_us = 0;
+        uint32_t max_us = 0;
+        uint64_t total_us = 0;
+
+        //  Fraction of the time of its pivot (video or audio) spent in this callback.
+        double share = 0;
+
+        //  Fraction of one core spent in this callback.
+        double utilization = 0;
+    };
+
+
+    struct Entry;
+
+
+public:
+    InferenceProfiler();
+    ~InferenceProfiler();
+
+    //  Returns true if either the overlay or the CSV is turned on in the
+    //  global settings. Otherwise nothing reads the reports.
+    static bool enabled();
+
+    //  The entry for a callback. It lives as long as the profiler.
+    Entry& entry(InferenceType type, const std::string& label);
+
+    //  Called by the pivots after every call to a callback.
+    void report(Entry& entry, WallClock timestamp, uint32_t microseconds);
+
+    //  Callbacks that ran in the last WINDOW. Busiest first.
+    std::vector<Row> current() const;
+
+    //  Everything since this profiler was created. Busiest first.
+    std::vector<Row> totals() const;
+
+    std::string to_csv() const;
+
+    //  Save "to_csv()" to "DEBUG_PATH()/InferenceProfiles/".
+    //  Returns the path of the file. Empty if nothing has run or the file
+    //  can't be written. The latter is logged.
+    std::string save_csv(Logger& logger, const std::string& name) const;
+
+    //  Add these to the video overlay to show the busiest callbacks.
+    //  They only show anything if GlobalSettings::INFERENCE_PROFILER is on.
+    std::vector<OverlayStat*> overlay_stats();
+
+
+private:
+    class OverlayLine;
+    using EntryMap = std::map<std::string, std::unique_ptr<Entry>>;
+
+    EntryMap& map(InferenceType type);
+    const EntryMap& map(InferenceType type) const;
+
+    OverlayStatSnapshot overlay_line(size_t index);
+
+
+private:
+    mutable SpinLock m_lock;
+    EntryMap m_video;
+    EntryMap m_audio;
+
+    SpinLock m_overlay_lock;
+    WallClock m_overlay_time;
+    std::vector<OverlayStatSnapshot> m_overlay_cache;
+    std::vector<std::unique_ptr<OverlayLine>> m_overlay_lines;
+};
+
+
+
+}
+#endif
@@ -0,0 +1,65 @@
+/*  Inference Replay
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/PrettyPrint.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "InferenceReplay.h"
+
+namespace PokemonAutomation{
+
+
+
+bool InferenceReplayReport::triggered() const{
+    for (const InferenceReplayCallbackResult& result : callbacks){
+        if (!result.triggers.empty()){
+            return true;
+        }
+    }
+    return false;
+}
+std::string InferenceReplayReport::dump() const{
+    const size_t MAX_TRIGGERS = 20;
+
+    std::string str = "Replay: " + path + "\n";
+    if (frames != 0){
+        str += "Frames = " + tostr_u_commas(frames) + ", ";
+    }
+    str += media + " = " + tostr_u_commas(duration.count()) + " ms";
+    str += ", Wall = " + tostr_u_commas(wall_time.count()) + " ms";
+    if (wall_time.count() > 0){
+        str += " (" + tostr_fixed((double)duration.count() / wall_time.count(), 1) + "x real time)";
+    }
+    str += "\n";
+
+    for (const InferenceReplayCallbackResult& result : callbacks){
+        str += result.label + ": ";
+        str += result.stats.count() == 0 ? "Never ran." : result.stats.dump(" ms", 1000);
+        if (result.lowest_error >= 0){
+            str += "\n    Lowest Error = " + tostr_default(result.lowest_error);
+        }
+        str += "\n    Triggers = " + std::to_string(result.triggers.size());
+        for (size_t c = 0; c < result.triggers.size() && c < MAX_TRIGGERS; c++){
+            str += c == 0 ? ": " : ", ";
+            str += std::to_string(result.triggers[c].count()) + " ms";
+            if (c < result.scores.size()){
+                str += " (" + tostr_default(result.scores[c]) + ")";
+            }
+        }
+        if (result.triggers.size() > MAX_TRIGGERS){
+            str += ", ...";
+        }
+        str += "\n";
+    }
+    return str;
+}
+void InferenceReplayReport::log(Logger& logger) const{
+    logger.log(dump(), COLOR_MAGENTA);
+}
+
+
+
+
+}
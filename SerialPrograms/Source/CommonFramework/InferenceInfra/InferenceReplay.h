@@ -0,0 +1,62 @@
+/*  Inference Replay
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      The report shared by the offline replay harnesses.
+ *  (VisualInferenceReplay and AudioInferenceReplay)
+ *
+ *  The scheduling and trigger recording they share is in
+ *  "InferenceReplay.tpp".
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_InferenceReplay_H
+#define PokemonAutomation_CommonFramework_InferenceReplay_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include "CommonFramework/Inference/StatAccumulator.h"
+
+namespace PokemonAutomation{
+
+class Logger;
+
+
+struct InferenceReplayCallbackResult{
+    std::string label;
+
+    //  Time spent in each call to the callback. Units are microseconds.
+    StatAccumulatorI32 stats;
+
+    //  Recording time of every call on which the callback returned true.
+    std::vector<std::chrono::milliseconds> triggers;
+
+    //  Only for audio detectors derived from AudioPerSpectrumDetectorBase.
+    //  The error coefficient of each trigger and the lowest seen over the
+    //  entire recording. Otherwise these are empty and negative.
+    std::vector<float> scores;
+    float lowest_error = -1;
+};
+
+struct InferenceReplayReport{
+    std::string path;
+    std::string media;                  //  "Video" or "Audio".
+    size_t frames = 0;                  //  Zero if the recording has no frames.
+    std::chrono::milliseconds duration{0};
+    std::chrono::milliseconds wall_time{0};
+
+    //  Same order as the callbacks that were passed in.
+    std::vector<InferenceReplayCallbackResult> callbacks;
+
+    //  Returns true if any callback triggered.
+    bool triggered() const;
+
+    std::string dump() const;
+    void log(Logger& logger) const;
+};
+
+
+
+}
+#endif
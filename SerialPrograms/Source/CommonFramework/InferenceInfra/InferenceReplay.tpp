@@ -0,0 +1,212 @@
+/*  Inference Replay
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Scheduling shared by the offline replay harnesses.
+ *
+ *  "run_inference_replay()" is parameterized on a driver that knows how to
+ *  play one kind of recording. The driver provides:
+ *
+ *      using CallbackType;     //  VisualInferenceCallback or AudioInferenceCallback
+ *      using Wrapper;          //  ReplayCallback<CallbackType> that overrides the process function.
+ *      using PivotType;        //  VisualInferencePivot or AudioInferencePivot
+ *      static constexpr InferenceType TYPE;
+ *      static constexpr const char* MEDIA;     //  "Video" or "Audio"
+ *
+ *      std::string path() const;
+ *      size_t frames() const;
+ *      std::chrono::milliseconds duration() const;
+ *      WallClock start_time() const;
+ *      auto& feed();           //  The feed to give the pivot.
+ *      void reset();
+ *
+ *      //  Real time: Play the whole recording while the pivot runs.
+ *      void play_real_time(CancellableScope& scope);
+ *
+ *      //  Max speed: Whether a callback is still due at "time". Bring the
+ *      //  feed up to "time" for "callback". Then make the call that is timed.
+ *      bool before_end(std::chrono::milliseconds time) const;
+ *      void advance(Wrapper& callback, std::chrono::milliseconds time);
+ *      void process(Wrapper& callback);
+ *      void finish();          //  Play whatever is left.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_InferenceReplay_TPP
+#define PokemonAutomation_CommonFramework_InferenceReplay_TPP
+
+#include <memory>
+#include <algorithm>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/CancellableScope.h"
+#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "InferenceCallback.h"
+#include "InferenceReplay.h"
+
+namespace PokemonAutomation{
+
+
+
+//  Records triggers instead of letting them end the session.
+//  Derive from this and override the process function of "CallbackType" to
+//  forward to "m_callback" and call "record()" when it returns true.
+template <typename CallbackType>
+class ReplayCallback : public CallbackType{
+public:
+    ReplayCallback(CallbackType& callback, WallClock start, InferenceReplayCallbackResult& result)
+        : CallbackType(callback.label())
+        , m_callback(callback)
+        , m_start(start)
+        , m_result(result)
+    {}
+
+    //  Called once after the whole recording has been played.
+    void finish(){}
+
+protected:
+    void record(WallClock timestamp){
+        m_result.triggers.emplace_back(std::chrono::duration_cast<std::chrono::milliseconds>(timestamp - m_start));
+    }
+
+protected:
+    CallbackType& m_callback;
+    WallClock m_start;
+    InferenceReplayCallbackResult& m_result;
+};
+
+
+
+template <typename Driver>
+void run_inference_replay_real_time(
+    Driver& driver,
+    std::vector<std::unique_ptr<typename Driver::Wrapper>>& callbacks,
+    const std::vector<std::chrono::milliseconds>& periods,
+    std::vector<InferenceReplayCallbackResult>& results
+){
+    CancellableHolder<CancellableScope> scope;
+    AsyncDispatcher dispatcher(nullptr, 0);
+    typename Driver::PivotType pivot(scope, driver.feed(), dispatcher);
+
+    auto remove_all = [&]{
+        for (size_t c = 0; c < callbacks.size(); c++){
+            results[c].stats = pivot.remove_callback(*callbacks[c]);
+        }
+    };
+
+    try{
+        for (size_t c = 0; c < callbacks.size(); c++){
+            pivot.add_callback(scope, nullptr, *callbacks[c], periods[c]);
+        }
+        driver.play_real_time(scope);
+    }catch (...){
+        remove_all();
+        throw;
+    }
+    remove_all();
+}
+
+//  Simulate the pivot's schedule in recording time on this thread. Each
+//  callback is called at its period and sees what it would see live at that
+//  time. But there is no waiting.
+template <typename Driver>
+void run_inference_replay_max_speed(
+    Driver& driver,
+    std::vector<std::unique_ptr<typename Driver::Wrapper>>& callbacks,
+    const std::vector<std::chrono::milliseconds>& periods,
+    std::vector<InferenceReplayCallbackResult>& results
+){
+    //  Next time each callback is due. Always run the earliest one.
+    std::vector<std::chrono::milliseconds> next(callbacks.size(), std::chrono::milliseconds(0));
+    while (true){
+        size_t index = std::min_element(next.begin(), next.end()) - next.begin();
+        std::chrono::milliseconds now = next[index];
+        if (!driver.before_end(now)){
+            break;
+        }
+
+        driver.advance(*callbacks[index], now);
+
+        WallClock time0 = current_time();
+        driver.process(*callbacks[index]);
+        WallClock time1 = current_time();
+        results[index].stats += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+
+        next[index] += periods[index];
+    }
+    driver.finish();
+}
+
+
+
+//  Play the entire recording through the callbacks.
+//  All the callbacks must be of "Driver::TYPE".
+template <typename Driver>
+InferenceReplayReport run_inference_replay(
+    Logger& logger, Driver& driver,
+    const std::vector<PeriodicInferenceCallback>& callbacks,
+    std::chrono::milliseconds default_period,
+    bool real_time
+){
+    using CallbackType = typename Driver::CallbackType;
+    using Wrapper = typename Driver::Wrapper;
+
+    InferenceReplayReport report;
+    report.path = driver.path();
+    report.media = Driver::MEDIA;
+    report.frames = driver.frames();
+    report.duration = driver.duration();
+
+    std::vector<CallbackType*> matched;
+    std::vector<std::chrono::milliseconds> periods;
+    for (const PeriodicInferenceCallback& callback : callbacks){
+        if (callback.callback == nullptr){
+            continue;
+        }
+        if (callback.callback->type() != Driver::TYPE){
+            throw InternalProgramError(
+                &logger, PA_CURRENT_FUNCTION,
+                std::string("Only ") + (Driver::TYPE == InferenceType::VISUAL ? "visual" : "audio") +
+                " callbacks can be replayed over this recording."
+            );
+        }
+        matched.emplace_back(static_cast<CallbackType*>(callback.callback));
+        periods.emplace_back(callback.period > std::chrono::milliseconds(0) ? callback.period : default_period);
+    }
+    if (matched.empty()){
+        return report;
+    }
+
+    driver.reset();
+    WallClock start = driver.start_time();
+
+    report.callbacks.resize(matched.size());
+    std::vector<std::unique_ptr<Wrapper>> wrapped;
+    for (size_t c = 0; c < matched.size(); c++){
+        report.callbacks[c].label = matched[c]->label();
+        wrapped.emplace_back(new Wrapper(*matched[c], start, report.callbacks[c]));
+    }
+
+    logger.log(
+        "Replaying " + report.path + " through " + std::to_string(matched.size()) + " callback(s)" +
+        (real_time ? " in real time..." : " at max speed..."),
+        COLOR_BLUE
+    );
+
+    if (real_time){
+        run_inference_replay_real_time(driver, wrapped, periods, report.callbacks);
+    }else{
+        run_inference_replay_max_speed(driver, wrapped, periods, report.callbacks);
+    }
+    for (std::unique_ptr<Wrapper>& callback : wrapped){
+        callback->finish();
+    }
+
+    report.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(current_time() - start);
+    return report;
+}
+
+
+
+}
+#endif
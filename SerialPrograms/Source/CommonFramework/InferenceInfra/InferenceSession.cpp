@@ -74,6 +74,8 @@ InferenceSession::InferenceSession(
     , m_overlays(console.overlay())
     , m_triggered(nullptr)
 {
+    //  Publish all the boxes of all the callbacks at once.
+    OverlayTransaction transaction(console.overlay());
     try{
         for (size_t c = 0; c < callbacks.size(); c++){
             const PeriodicInferenceCallback& callback = callbacks[c];
@@ -5,7 +5,9 @@
  */
 
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Tracing.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
+#include "InferenceProfiler.h"
 #include "VisualInferencePivot.h"
 
 #include <iostream>
@@ -21,6 +23,12 @@ struct VisualInferencePivot::PeriodicCallback{
     std::atomic<InferenceCallback*>* set_when_triggered;
     VisualInferenceCallback& callback;
     std::chrono::milliseconds period;
+
+    //  The label of the callback for trace zones.
+    const char* trace_name;
+
+    //  Looked up the first time this is profiled.
+    InferenceProfiler::Entry* profile = nullptr;
     StatAccumulatorI32 stats;
     uint64_t last_seqnum;
 
@@ -34,15 +42,20 @@ struct VisualInferencePivot::PeriodicCallback{
         , set_when_triggered(p_set_when_triggered)
         , callback(p_callback)
         , period(p_period)
+        , trace_name(trace_intern(p_callback.label()))
         , last_seqnum(0)
     {}
 };
 
 
 
-VisualInferencePivot::VisualInferencePivot(CancellableScope& scope, VideoFeed& feed, AsyncDispatcher& dispatcher)
+VisualInferencePivot::VisualInferencePivot(
+    CancellableScope& scope, VideoFeed& feed, AsyncDispatcher& dispatcher,
+    InferenceProfiler* profiler
+)
     : PeriodicRunner(dispatcher)
     , m_feed(feed)
+    , m_profiler(profiler)
 {
     attach(scope);
 }
@@ -56,7 +69,7 @@ void VisualInferencePivot::add_callback(
     VisualInferenceCallback& callback,
     std::chrono::milliseconds period
 ){
-    SpinLockGuard lg(m_lock);
+    AdaptiveLockGuard lg(m_lock, "VisualInferencePivot::add_callback()");
     auto iter = m_map.find(&callback);
     if (iter != m_map.end()){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Attempted to add the same callback twice.");
@@ -74,7 +87,7 @@ void VisualInferencePivot::add_callback(
     }
 }
 StatAccumulatorI32 VisualInferencePivot::remove_callback(VisualInferenceCallback& callback){
-    SpinLockGuard lg(m_lock);
+    AdaptiveLockGuard lg(m_lock, "VisualInferencePivot::remove_callback()");
     auto iter = m_map.find(&callback);
     if (iter == m_map.end()){
         return StatAccumulatorI32();
@@ -85,6 +98,7 @@ StatAccumulatorI32 VisualInferencePivot::remove_callback(VisualInferenceCallback
     return stats;
 }
 void VisualInferencePivot::run(void* event, bool is_back_to_back) noexcept{
+    PA_TRACE_ZONE("VisualInferencePivot::run");
     PeriodicCallback& callback = *(PeriodicCallback*)event;
     try{
         //  Reuse the cached screenshot.
@@ -94,10 +108,18 @@ void VisualInferencePivot::run(void* event, bool is_back_to_back) noexcept{
             m_seqnum++;
         }
 
+        TraceZone trace_callback(callback.trace_name);
         WallClock time0 = current_time();
         bool stop = callback.callback.process_frame(m_last);
         WallClock time1 = current_time();
-        callback.stats += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+        uint32_t microseconds = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+        callback.stats += microseconds;
+        if (m_profiler && InferenceProfiler::enabled()){
+            if (callback.profile == nullptr){
+                callback.profile = &m_profiler->entry(InferenceType::VISUAL, callback.callback.label());
+            }
+            m_profiler->report(*callback.profile, time1, microseconds);
+        }
         callback.last_seqnum = m_seqnum;
         if (stop){
             if (callback.set_when_triggered){
@@ -7,7 +7,7 @@
 #ifndef PokemonAutomation_CommonFramework_VisualInferencePivot_H
 #define PokemonAutomation_CommonFramework_VisualInferencePivot_H
 
-#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "Common/Cpp/Concurrency/AdaptiveLock.h"
 #include "Common/Cpp/Concurrency/PeriodicScheduler.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayTypes.h"
@@ -17,12 +17,17 @@
 namespace PokemonAutomation{
 
 class VideoFeed;
+class InferenceProfiler;
 
 
 
 class VisualInferencePivot final : public PeriodicRunner, public OverlayStat{
 public:
-    VisualInferencePivot(CancellableScope& scope, VideoFeed& feed, AsyncDispatcher& dispatcher);
+    //  If "profiler" is set, the time of every call is also reported to it.
+    VisualInferencePivot(
+        CancellableScope& scope, VideoFeed& feed, AsyncDispatcher& dispatcher,
+        InferenceProfiler* profiler = nullptr
+    );
     virtual ~VisualInferencePivot();
 
     //  If this callback returns true:
@@ -47,7 +52,8 @@ private:
     struct PeriodicCallback;
 
     VideoFeed& m_feed;
-    SpinLock m_lock;
+    InferenceProfiler* m_profiler;
+    AdaptiveLock m_lock;
     std::map<VisualInferenceCallback*, PeriodicCallback> m_map;
     VideoSnapshot m_last;
     uint64_t m_seqnum = 0;
@@ -0,0 +1,106 @@
+/*  Visual Inference Replay
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "CommonFramework/VideoPipeline/VideoReplayFeed.h"
+#include "VisualInferenceCallback.h"
+#include "VisualInferencePivot.h"
+#include "InferenceReplay.tpp"
+#include "VisualInferenceReplay.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+namespace{
+
+class VisualReplayCallback : public ReplayCallback<VisualInferenceCallback>{
+public:
+    using ReplayCallback::ReplayCallback;
+
+    virtual void make_overlays(VideoOverlaySet& items) const override{
+        m_callback.make_overlays(items);
+    }
+    virtual bool process_frame(const VideoSnapshot& frame) override{
+        if (m_callback.process_frame(frame)){
+            record(frame.timestamp);
+        }
+        return false;
+    }
+};
+
+
+class VisualReplayDriver{
+public:
+    using CallbackType = VisualInferenceCallback;
+    using Wrapper = VisualReplayCallback;
+    using PivotType = VisualInferencePivot;
+    static constexpr InferenceType TYPE = InferenceType::VISUAL;
+    static constexpr const char* MEDIA = "Video";
+
+    VisualReplayDriver(VideoReplayFeed& feed)
+        : m_feed(feed)
+    {}
+
+    std::string path() const{ return m_feed.path(); }
+    size_t frames() const{ return m_feed.frame_count(); }
+    std::chrono::milliseconds duration() const{ return m_feed.duration(); }
+    WallClock start_time() const{ return m_feed.start_time(); }
+    VideoReplayFeed& feed(){ return m_feed; }
+    void reset(){
+        m_feed.reset();
+        m_frame = 0;
+    }
+
+    void play_real_time(CancellableScope& scope){
+        scope.wait_until(m_feed.start_time() + m_feed.duration());
+    }
+
+    bool before_end(std::chrono::milliseconds time) const{
+        return time < m_feed.duration();
+    }
+    void advance(Wrapper&, std::chrono::milliseconds time){
+        //  Advance to whichever frame is showing at this time.
+        const size_t frames = m_feed.frame_count();
+        while (m_frame + 1 < frames && m_feed.frame_time(m_frame + 1) <= time){
+            m_frame++;
+        }
+        m_feed.seek(m_frame);
+        m_snapshot = m_feed.snapshot();
+    }
+    void process(Wrapper& callback){
+        callback.process_frame(m_snapshot);
+    }
+    void finish(){
+        m_feed.seek(m_feed.frame_count());
+    }
+
+private:
+    VideoReplayFeed& m_feed;
+    size_t m_frame = 0;
+    VideoSnapshot m_snapshot;
+};
+
+}
+
+
+
+InferenceReplayReport run_visual_replay(
+    Logger& logger, VideoReplayFeed& feed,
+    const std::vector<PeriodicInferenceCallback>& callbacks,
+    std::chrono::milliseconds default_period
+){
+    VisualReplayDriver driver(feed);
+    return run_inference_replay(logger, driver, callbacks, default_period, feed.real_time());
+}
+
+
+
+
+}
@@ -0,0 +1,47 @@
+/*  Visual Inference Replay
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Run a set of visual inference callbacks over a recording without a
+ *  console or GUI. This is the offline counterpart of InferenceSession and is
+ *  used to benchmark detectors and check them for false triggers.
+ *
+ *  Unlike InferenceSession, a callback returning true does not stop anything.
+ *  Every trigger is recorded and the whole recording is played.
+ *
+ *  If the feed is in real-time mode, the callbacks run on a real
+ *  VisualInferencePivot so the timings include everything a live session sees.
+ *
+ *  Otherwise, the pivot's schedule is simulated in video time on the calling
+ *  thread. Each callback is called at its period and sees whatever frame is
+ *  current at that time, exactly as it would live. But there is no waiting,
+ *  so the recording plays as fast as the callbacks can run.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_VisualInferenceReplay_H
+#define PokemonAutomation_CommonFramework_VisualInferenceReplay_H
+
+#include <vector>
+#include <chrono>
+#include "InferenceCallback.h"
+#include "InferenceReplay.h"
+
+namespace PokemonAutomation{
+
+class Logger;
+class VideoReplayFeed;
+
+
+//  Play the entire recording through the callbacks.
+//  All the callbacks must be visual.
+InferenceReplayReport run_visual_replay(
+    Logger& logger, VideoReplayFeed& feed,
+    const std::vector<PeriodicInferenceCallback>& callbacks,
+    std::chrono::milliseconds default_period = std::chrono::milliseconds(50)
+);
+
+
+
+}
+#endif
@@ -4,6 +4,7 @@
  *
  */
 
+#include <algorithm>
 #include <QCoreApplication>
 #include <QMenuBar>
 #include <QDir>
@@ -24,19 +25,47 @@ Logger& global_logger_raw(){
 }
 
 
+struct FileWindowLogger::Slot{
+    uint64_t sequence;
+    std::string msg;
+    Color color;
+};
+
+//  Single producer (the thread that owns it), single consumer (the writer).
+struct FileWindowLogger::Ring{
+    static constexpr size_t SLOTS = 512;
+
+    //  Debug messages are dropped past this so there is always room left for
+    //  the normal ones.
+    static constexpr size_t DEBUG_LIMIT = SLOTS * 3 / 4;
+
+    alignas(64) std::atomic<size_t> head{0};    //  Only written by the producer.
+    alignas(64) std::atomic<size_t> tail{0};    //  Only written by the writer.
+    Slot slots[SLOTS];
+};
+
+
+
 FileWindowLogger::~FileWindowLogger(){
     {
         std::lock_guard<std::mutex> lg(m_lock);
-        m_stopping = true;
+        m_stopping.store(true, std::memory_order_release);
         m_cv.notify_all();
     }
     m_thread.join();
 }
 FileWindowLogger::FileWindowLogger(const std::string& path)
-    : m_file(QString::fromStdString(path))
-    , m_max_queue_size(10000)
+    : m_id([]{
+        static std::atomic<uint64_t> next_id(1);
+        return next_id.fetch_add(1, std::memory_order_relaxed);
+    }())
+    , m_file(QString::fromStdString(path))
     , m_stopping(false)
-    , m_thread(&FileWindowLogger::thread_loop, this)
+    , m_writer_idle(false)
+    , m_rings_changed(false)
+    , m_sequence(0)
+    , m_dropped(0)
+    , m_has_windows(false)
 {
     bool exists = m_file.exists();
     m_file.open(QIODevice::WriteOnly | QIODevice::Append);
@@ -44,27 +73,86 @@ FileWindowLogger::FileWindowLogger(const std::string& path)
         std::string bom = "\xef\xbb\xbf";
         m_file.write(bom.c_str(), bom.size());
     }
+    m_file_buffer.reserve(64 * 1024);
+    m_thread = std::thread(&FileWindowLogger::thread_loop, this);
 }
 void FileWindowLogger::operator+=(FileWindowLoggerWindow& widget){
     std::lock_guard<std::mutex> lg(m_lock);
     m_windows.insert(&widget);
+    m_has_windows.store(true, std::memory_order_relaxed);
 }
 void FileWindowLogger::operator-=(FileWindowLoggerWindow& widget){
     std::lock_guard<std::mutex> lg(m_lock);
     m_windows.erase(&widget);
+    m_has_windows.store(!m_windows.empty(), std::memory_order_relaxed);
 }
 
 void FileWindowLogger::log(const std::string& msg, Color color){
-    std::unique_lock<std::mutex> lg(m_lock);
-    m_cv.wait(lg, [this]{ return m_queue.size() < m_max_queue_size; });
-    m_queue.emplace_back(msg, color);
-    m_cv.notify_all();
+    push(msg, color, false);
 }
 void FileWindowLogger::log(std::string&& msg, Color color){
-    std::unique_lock<std::mutex> lg(m_lock);
-    m_cv.wait(lg, [this]{ return m_queue.size() < m_max_queue_size; });
-    m_queue.emplace_back(std::move(msg), color);
-    m_cv.notify_all();
+    push(std::move(msg), color, false);
+}
+void FileWindowLogger::log_debug(const std::string& msg, Color color){
+    push(msg, color, true);
+}
+
+
+FileWindowLogger::Ring& FileWindowLogger::thread_ring(){
+    //  Keyed by logger ID rather than address so a new logger never picks up
+    //  a ring that belonged to a destroyed one.
+    thread_local std::vector<std::pair<uint64_t, std::shared_ptr<Ring>>> rings;
+    for (const auto& item : rings){
+        if (item.first == m_id){
+            return *item.second;
+        }
+    }
+
+    std::shared_ptr<Ring> ring = std::make_shared<Ring>();
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_rings.emplace_back(ring);
+        m_rings_changed.store(true, std::memory_order_release);
+    }
+    rings.emplace_back(m_id, ring);
+    return *ring;
+}
+template <typename StringType>
+void FileWindowLogger::push(StringType&& msg, Color color, bool debug){
+    Ring& ring = thread_ring();
+    size_t head = ring.head.load(std::memory_order_relaxed);
+    while (true){
+        size_t used = head - ring.tail.load(std::memory_order_acquire);
+        if (debug && used >= Ring::DEBUG_LIMIT){
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            wake_writer();
+            return;
+        }
+        if (used < Ring::SLOTS){
+            break;
+        }
+        //  Full. Wait for the writer to catch up.
+        wake_writer();
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    //  Assign into the slot so it reuses the capacity of the last message.
+    Slot& slot = ring.slots[head % Ring::SLOTS];
+    slot.sequence = m_sequence.fetch_add(1, std::memory_order_relaxed);
+    slot.msg = std::forward<StringType>(msg);
+    slot.color = color;
+    ring.head.store(head + 1, std::memory_order_release);
+
+    wake_writer();
+}
+void FileWindowLogger::wake_writer(){
+    //  Pairs with the fence in "thread_loop()". Either the writer sees the new
+    //  message before it sleeps or we see that it is asleep.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_writer_idle.load(std::memory_order_relaxed) && m_writer_idle.exchange(false, std::memory_order_relaxed)){
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_cv.notify_all();
+    }
 }
 
 
@@ -90,22 +178,23 @@ std::string FileWindowLogger::normalize_newlines(const std::string& msg){
 
     return str;
 }
-std::string FileWindowLogger::to_file_str(const std::string& msg){
+void FileWindowLogger::append_file_str(std::string& str, const std::string& msg){
     //  Replace all newlines with:
     //      <br>    for the output window.
     //      \r\n    for the log file.
 
-    std::string str;
-    for (char ch : msg){
-        if (ch == '\n'){
-            str += "\r\n";
-            continue;
+    size_t index = 0;
+    while (true){
+        size_t pos = msg.find('\n', index);
+        if (pos == std::string::npos){
+            str.append(msg, index, std::string::npos);
+            break;
         }
-        str += ch;
+        str.append(msg, index, pos - index);
+        str += "\r\n";
+        index = pos + 1;
     }
     str += "\r\n";
-
-    return str;
 }
 QString FileWindowLogger::to_window_str(const std::string& msg, Color color){
     //  Replace all newlines with:
@@ -135,42 +224,155 @@ QString FileWindowLogger::to_window_str(const std::string& msg, Color color){
 
     return QString::fromStdString(str);
 }
-void FileWindowLogger::internal_log(const std::string& msg, Color color){
-    std::string line = normalize_newlines(msg);
-    {
-        if (!m_windows.empty()){
-            QString str = to_window_str(line, color);
-            for (FileWindowLoggerWindow* window : m_windows){
-                window->log(str);
-            }
+bool FileWindowLogger::drain(){
+    //  Take everything that is in the rings right now.
+    m_batch.clear();
+    m_drain_heads.clear();
+    for (const std::shared_ptr<Ring>& ring : m_drain_rings){
+        size_t tail = ring->tail.load(std::memory_order_relaxed);
+        size_t head = ring->head.load(std::memory_order_acquire);
+        for (size_t c = tail; c < head; c++){
+            m_batch.emplace_back(&ring->slots[c % Ring::SLOTS]);
         }
+        m_drain_heads.emplace_back(head);
     }
-    {
-        m_file.write(to_file_str(msg).c_str());
-        m_file.flush();
+    uint64_t dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+    if (m_batch.empty() && dropped == 0){
+        return false;
+    }
+
+    //  Put the threads back together in the order the messages were logged.
+    std::sort(
+        m_batch.begin(), m_batch.end(),
+        [](const Slot* x, const Slot* y){
+            return x->sequence < y->sequence;
+        }
+    );
+
+    bool windows = m_has_windows.load(std::memory_order_relaxed);
+    m_file_buffer.clear();
+    for (Slot* slot : m_batch){
+        append_file_str(m_file_buffer, slot->msg);
+        if (windows){
+            m_window_lines.emplace_back(normalize_newlines(slot->msg), slot->color);
+        }
+        slot->msg.clear();
+    }
+    if (dropped != 0){
+        std::string msg = "Logging can't keep up. Dropped " + std::to_string(dropped) + " debug message(s).";
+        append_file_str(m_file_buffer, msg);
+        if (windows){
+            m_window_lines.emplace_back(std::move(msg), COLOR_RED);
+        }
+    }
+    while (m_window_lines.size() > WINDOW_MAX_LINES){
+        m_window_lines.pop_front();
+    }
+
+    //  Hand the slots back.
+    for (size_t c = 0; c < m_drain_rings.size(); c++){
+        m_drain_rings[c]->tail.store(m_drain_heads[c], std::memory_order_release);
+    }
+
+    m_file.write(m_file_buffer.data(), m_file_buffer.size());
+    m_file.flush();
+    return true;
+}
+void FileWindowLogger::update_windows(bool force){
+    if (m_window_lines.empty()){
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (!force && now < m_last_window_update + WINDOW_REFRESH_INTERVAL){
+        return;
+    }
+    m_last_window_update = now;
+
+    QStringList lines;
+    lines.reserve((int)m_window_lines.size());
+    for (const auto& item : m_window_lines){
+        lines.append(to_window_str(item.first, item.second));
+    }
+    m_window_lines.clear();
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    for (FileWindowLoggerWindow* window : m_windows){
+        window->log(lines);
     }
 }
 void FileWindowLogger::thread_loop(){
-    std::unique_lock<std::mutex> lg(m_lock);
     while (true){
-        m_cv.wait(lg, [&]{
-            return m_stopping || !m_queue.empty();
-        });
-        if (m_stopping){
+        bool stopping = m_stopping.load(std::memory_order_acquire);
+
+        if (m_rings_changed.exchange(false, std::memory_order_acquire)){
+            std::lock_guard<std::mutex> lg(m_lock);
+            m_drain_rings = m_rings;
+        }
+
+        bool drained = drain();
+        update_windows(stopping);
+
+        //  Forget the rings of threads that have exited.
+        bool retired = false;
+        for (const std::shared_ptr<Ring>& ring : m_drain_rings){
+            if (ring.use_count() == 2 &&
+                ring->tail.load(std::memory_order_relaxed) == ring->head.load(std::memory_order_acquire)
+            ){
+                retired = true;
+            }
+        }
+        if (retired){
+            //  Once both lists hold every ring, a count of 2 means the thread
+            //  that owned it is gone.
+            std::lock_guard<std::mutex> lg(m_lock);
+            m_drain_rings = m_rings;
+            m_rings.erase(
+                std::remove_if(
+                    m_rings.begin(), m_rings.end(),
+                    [](const std::shared_ptr<Ring>& ring){
+                        return ring.use_count() == 2 &&
+                            ring->tail.load(std::memory_order_relaxed) == ring->head.load(std::memory_order_acquire);
+                    }
+                ),
+                m_rings.end()
+            );
+            m_drain_rings = m_rings;
+        }
+
+        if (drained){
+            continue;
+        }
+        if (stopping){
+            //  Everything that was logged before the destructor is written.
             break;
         }
-        auto& item = m_queue.front();
-        std::string msg = std::move(item.first);
-        Color color = item.second;
-        m_queue.pop_front();
 
-        lg.unlock();
-        internal_log(msg, color);
-        lg.lock();
+        //  Nothing to do. Go to sleep.
+        m_writer_idle.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool pending = m_dropped.load(std::memory_order_relaxed) != 0;
+        for (const std::shared_ptr<Ring>& ring : m_drain_rings){
+            if (ring->tail.load(std::memory_order_relaxed) != ring->head.load(std::memory_order_acquire)){
+                pending = true;
+            }
+        }
+        if (pending){
+            m_writer_idle.store(false, std::memory_order_relaxed);
+            continue;
+        }
 
-        if (m_queue.size() <= m_max_queue_size / 2){
-            m_cv.notify_all();
+        std::unique_lock<std::mutex> lg(m_lock);
+        auto woken = [this]{
+            return !m_writer_idle.load(std::memory_order_relaxed) ||
+                m_stopping.load(std::memory_order_relaxed) ||
+                m_rings_changed.load(std::memory_order_relaxed);
+        };
+        if (m_window_lines.empty()){
+            m_cv.wait(lg, woken);
+        }else{
+            m_cv.wait_until(lg, m_last_window_update + WINDOW_REFRESH_INTERVAL, woken);
         }
+        m_writer_idle.store(false, std::memory_order_relaxed);
     }
 }
 
@@ -204,9 +406,11 @@ FileWindowLoggerWindow::FileWindowLoggerWindow(FileWindowLogger& logger, QWidget
 
     connect(
         this, &FileWindowLoggerWindow::signal_log,
-        m_text, [this](QString msg){
-//            cout << "signal_log(): " << msg.toStdString() << endl;
-            m_text->append(msg);
+        m_text, [this](QStringList lines){
+//            cout << "signal_log(): " << lines.join("\n").toStdString() << endl;
+            for (const QString& line : lines){
+                m_text->append(line);
+            }
         }
     );
 
@@ -224,7 +428,10 @@ FileWindowLoggerWindow::~FileWindowLoggerWindow(){
 
 void FileWindowLoggerWindow::log(QString msg){
 //    cout << "FileWindowLoggerWindow::log(): " << msg.toStdString() << endl;
-    emit signal_log(msg);
+    emit signal_log(QStringList{std::move(msg)});
+}
+void FileWindowLoggerWindow::log(QStringList lines){
+    emit signal_log(lines);
 }
 
 
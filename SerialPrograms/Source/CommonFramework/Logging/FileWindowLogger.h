@@ -2,16 +2,32 @@
  *
  *  From: https://github.com/PokemonAutomation/Arduino-Source
  *
+ *      Every thread that logs gets its own lock-free ring buffer. A single
+ *  writer thread drains all of them in the order the messages were logged and
+ *  writes each batch to the file with one call.
+ *
+ *  If a thread logs faster than the file can keep up, its "log_debug()"
+ *  messages are dropped once the ring is mostly full. Normal messages wait for
+ *  space instead.
+ *
+ *  The windows get the same lines at most every WINDOW_REFRESH_INTERVAL. If
+ *  more than WINDOW_MAX_LINES arrive in between, only the newest are shown.
+ *
  */
 
 #ifndef PokemonAutomation_Logging_FileWindowLogger_H
 #define PokemonAutomation_Logging_FileWindowLogger_H
 
+#include <stdint.h>
+#include <vector>
 #include <deque>
 #include <set>
+#include <memory>
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
+#include <chrono>
 #include <QFile>
 #include <QTextEdit>
 #include <QMainWindow>
@@ -23,6 +39,10 @@ class FileWindowLoggerWindow;
 
 
 class FileWindowLogger : public Logger{
+public:
+    static constexpr std::chrono::milliseconds WINDOW_REFRESH_INTERVAL = std::chrono::milliseconds(50);
+    static constexpr size_t WINDOW_MAX_LINES = 1000;
+
 public:
     ~FileWindowLogger();
     FileWindowLogger(const std::string& path);
@@ -32,23 +52,51 @@ public:
 
     virtual void log(const std::string& msg, Color color = Color()) override;
     virtual void log(std::string&& msg, Color color = Color()) override;
+    virtual void log_debug(const std::string& msg, Color color = Color()) override;
 
 private:
+    struct Slot;
+    struct Ring;
+
     static std::string normalize_newlines(const std::string& msg);
-    static std::string to_file_str(const std::string& msg);
+    static void append_file_str(std::string& str, const std::string& msg);
     static QString to_window_str(const std::string& msg, Color color);
 
-    void internal_log(const std::string& msg, Color color);
+    Ring& thread_ring();
+    template <typename StringType>
+    void push(StringType&& msg, Color color, bool debug);
+    void wake_writer();
+
+    //  These only run on the writer thread.
     void thread_loop();
+    bool drain();
+    void update_windows(bool force);
 
 private:
+    const uint64_t m_id;
     QFile m_file;
-    size_t m_max_queue_size;
+
     std::mutex m_lock;
     std::condition_variable m_cv;
-    bool m_stopping;
-    std::deque<std::pair<std::string, Color>> m_queue;
+    std::atomic<bool> m_stopping;
+    std::atomic<bool> m_writer_idle;
+    std::atomic<bool> m_rings_changed;
+    std::atomic<uint64_t> m_sequence;
+    std::atomic<uint64_t> m_dropped;
+
+    //  Protected by "m_lock".
+    std::vector<std::shared_ptr<Ring>> m_rings;
     std::set<FileWindowLoggerWindow*> m_windows;
+    std::atomic<bool> m_has_windows;
+
+    //  Writer thread only.
+    std::vector<std::shared_ptr<Ring>> m_drain_rings;
+    std::vector<size_t> m_drain_heads;
+    std::vector<Slot*> m_batch;
+    std::string m_file_buffer;
+    std::deque<std::pair<std::string, Color>> m_window_lines;
+    std::chrono::steady_clock::time_point m_last_window_update;
+
     std::thread m_thread;
 };
 
@@ -61,9 +109,10 @@ public:
     virtual ~FileWindowLoggerWindow();
 
     void log(QString msg);
+    void log(QStringList lines);
 
 signals:
-    void signal_log(QString msg);
+    void signal_log(QStringList lines);
 
 private:
     FileWindowLogger& m_logger;
@@ -24,12 +24,17 @@ TaggedLogger::TaggedLogger(Logger& logger, std::string tag)
     , m_tag(std::move(tag))
 {}
 
-void TaggedLogger::log(const std::string& msg, Color color){
-    std::string str =
+std::string TaggedLogger::tag(const std::string& msg) const{
+    return
         current_time_to_str() +
         " - [" + m_tag + "]: " +
         msg;
-    m_logger.log(std::move(str), color);
+}
+void TaggedLogger::log(const std::string& msg, Color color){
+    m_logger.log(tag(msg), color);
+}
+void TaggedLogger::log_debug(const std::string& msg, Color color){
+    m_logger.log_debug(tag(msg), color);
 }
 
 
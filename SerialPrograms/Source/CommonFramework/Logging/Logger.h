@@ -33,6 +33,10 @@ public:
     Logger& base_logger(){ return m_logger; }
 
     virtual void log(const std::string& msg, Color color = Color()) override;
+    virtual void log_debug(const std::string& msg, Color color = Color()) override;
+
+private:
+    std::string tag(const std::string& msg) const;
 
 private:
     Logger& m_logger;
@@ -8,12 +8,17 @@
 #include <Integrations/DppIntegration/DppClient.h>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/ImageResolution.h"
+#include "ClientSource/Connection/MessageCapture.h"
 #include "PersistentSettings.h"
 #include "Tests/CommandLineTests.h"
+#include "Tests/KernelBenchmarks.h"
 #include "CrashDump.h"
 #include "Environment/HardwareValidation.h"
 #include "Logging/Logger.h"
 #include "Logging/OutputRedirector.h"
+#include "Resources/ResourceBundle.h"
+#include "Tools/AsyncImageWriter.h"
+#include "ImageMatch/TemplateMatcherCache.h"
 //#include "Tools/StatsDatabase.h"
 #include "Integrations/SleepyDiscordRunner.h"
 #include "Globals.h"
@@ -43,6 +48,32 @@ void set_working_directory(){
     }
 }
 
+int decode_message_capture_file(){
+    const GlobalSettings& settings = GlobalSettings::instance();
+    const std::string& input = settings.MESSAGE_CAPTURE_DECODE_INPUT;
+    MessageCaptureFormat format = MessageCaptureFormat::TEXT;
+    if (settings.MESSAGE_CAPTURE_DECODE_FORMAT == "CSV"){
+        format = MessageCaptureFormat::CSV;
+    }else if (settings.MESSAGE_CAPTURE_DECODE_FORMAT != "TEXT"){
+        global_logger_tagged().log("Unknown message capture format: " + settings.MESSAGE_CAPTURE_DECODE_FORMAT, COLOR_RED);
+        return 1;
+    }
+
+    std::string output = settings.MESSAGE_CAPTURE_DECODE_OUTPUT;
+    if (output.empty()){
+        output = input + (format == MessageCaptureFormat::CSV ? ".csv" : ".txt");
+    }
+
+    try{
+        decode_message_capture(input, output, format);
+    }catch (const FileException& error){
+        global_logger_tagged().log(error.message(), COLOR_RED);
+        return 1;
+    }
+    global_logger_tagged().log("Decoded message capture to: " + output, COLOR_BLUE);
+    return 0;
+}
+
 int main(int argc, char *argv[]){
     setup_crash_handler();
 
@@ -82,8 +113,23 @@ int main(int argc, char *argv[]){
         global_logger_tagged().log(error.message(), COLOR_RED);
     }
 
+    if (GlobalSettings::instance().RESOURCE_BUNDLE_BUILD){
+        return build_resource_bundle(global_logger_tagged()) ? 0 : 1;
+    }
+    if (GlobalSettings::instance().RESOURCE_BUNDLE_USE){
+        ResourceBundle::instance().open(global_logger_tagged());
+    }
+
     if (GlobalSettings::instance().COMMAND_LINE_TEST_MODE){
-        return run_command_line_tests();
+        int ret = run_command_line_tests();
+        AsyncImageWriter::instance().stop();
+        return ret;
+    }
+    if (GlobalSettings::instance().KERNEL_BENCHMARK_MODE){
+        return run_kernel_benchmarks();
+    }
+    if (!GlobalSettings::instance().MESSAGE_CAPTURE_DECODE_INPUT.empty()){
+        return decode_message_capture_file();
     }
 
     //  Check whether the hardware is powerful enough to run this program.
@@ -122,6 +168,11 @@ int main(int argc, char *argv[]){
     // Write program settings back to the json file.
     PERSISTENT_SETTINGS().write();
 
+    //  Save any template matchers that were built lazily during this session.
+    if (ImageMatch::template_cache_enabled()){
+        ImageMatch::TemplateMatcherCache::instance().flush();
+    }
+
 #ifdef PA_SLEEPY
     Integration::SleepyDiscordRunner::sleepy_terminate();
 #endif
@@ -130,5 +181,9 @@ int main(int argc, char *argv[]){
     Integration::DppClient::Client::instance().disconnect();
 #endif
 
+    //  Finish writing any screenshots and error dumps while the logger is
+    //  still alive.
+    AsyncImageWriter::instance().stop();
+
     return ret;
 }
@@ -8,6 +8,7 @@
 #include <QFile>
 #include "Common/Cpp/PrettyPrint.h"
 #include "CommonFramework/Globals.h"
+#include "CommonFramework/Tools/AsyncImageWriter.h"
 #include "MessageAttachment.h"
 
 namespace PokemonAutomation{
@@ -38,6 +39,11 @@ PendingFileSend::~PendingFileSend(){
         return;
     }
 
+    //  Don't delete it before it's finished writing.
+    if (m_saved.valid()){
+        m_saved.wait();
+    }
+
     QFile file(QString::fromStdString(m_filepath));
     file.remove();
 }
@@ -48,6 +54,9 @@ PendingFileSend::PendingFileSend(const std::string& file, bool keep_file)
 {
     QFileInfo info(QString::fromStdString(file));
     m_filename = info.fileName().toStdString();
+
+    //  The file may still be in the process of being written.
+    m_saved = AsyncImageWriter::instance().pending(file);
 }
 #if 0
 PendingFileSend::PendingFileSend(Logger& logger, const std::string& text_attachment)
@@ -93,13 +102,15 @@ PendingFileSend::PendingFileSend(Logger& logger, const ImageAttachment& image)
         m_filepath = "TempFiles/" + m_filename;
     }
 
-    if (image.image.save(m_filepath)){
-        logger.log("Saved image to: " + m_filepath, COLOR_BLUE);
-    }else{
-        logger.log("Unable to save screenshot to: " + m_filepath, COLOR_RED);
-        m_filename.clear();
-        m_filepath.clear();
+    logger.log("Saving image to: " + m_filepath, COLOR_BLUE);
+    m_saved = AsyncImageWriter::instance().save(logger, image.image, m_filepath);
+}
+const std::string& PendingFileSend::filepath() const{
+    static const std::string EMPTY;
+    if (m_saved.valid() && !m_saved.get()){
+        return EMPTY;
     }
+    return m_filepath;
 }
 void PendingFileSend::extend_lifetime(){
     m_extend_lifetime.store(true, std::memory_order_release);
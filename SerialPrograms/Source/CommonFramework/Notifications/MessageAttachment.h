@@ -9,6 +9,7 @@
 
 #include <atomic>
 #include <memory>
+#include <future>
 #include "CommonFramework/Logging/Logger.h"
 #include "CommonFramework/Options/ScreenshotFormatOption.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
@@ -41,8 +42,16 @@ public:
 //    PendingFileSend(Logger& logger, const std::string& text_attachment);
     PendingFileSend(Logger& logger, const ImageAttachment& image);
 
+    //  Screenshots are written in the background. This does not wait for it.
     const std::string& filename() const{ return m_filename; }
-    const std::string& filepath() const{ return m_filepath; }
+
+    //  Waits for the file to be written. Returns empty if it failed.
+    const std::string& filepath() const;
+
+    //  Waits for the file to be written. False if there is no file or it
+    //  failed to save.
+    bool has_file() const{ return !filepath().empty(); }
+
     bool keep_file() const{ return m_keep_file; }
 
     //  Work around bug in Sleepy that destroys file before it's not needed anymore.
@@ -54,6 +63,7 @@ private:
 //    QFile m_file;
     std::string m_filename;
     std::string m_filepath;
+    std::shared_future<bool> m_saved;
 };
 
 
@@ -15,6 +15,7 @@
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/Tools/ProgramEnvironment.h"
 #include "CommonFramework/Tools/StatsTracking.h"
+#include "CommonFramework/VideoPipeline/RollingVideoBuffer.h"
 #include "Integrations/DiscordWebhook.h"
 #include "Integrations/SleepyDiscordRunner.h"
 #include "ProgramNotifications.h"
@@ -94,7 +95,7 @@ void send_raw_notification(
     const ImageAttachment& image
 ){
     std::shared_ptr<PendingFileSend> file(new PendingFileSend(logger, image));
-    bool hasFile = !file->filepath().empty();
+    bool hasFile = file->has_file();
 
     JsonObject embed;
     JsonArray embeds;
@@ -152,7 +153,7 @@ void send_raw_notification(
     const std::string& filepath
 ){
     std::shared_ptr<PendingFileSend> file(new PendingFileSend(filepath, true));
-    bool hasFile = !file->filepath().empty();
+    bool hasFile = file->has_file();
 
     JsonObject embed;
     JsonArray embeds;
@@ -335,6 +336,11 @@ void send_program_notification(
         messages,
         ImageAttachment(image, settings.screenshot(), keep_file)
     );
+
+    //  The screenshot is being kept. So keep the lead-up to it as well.
+    if (keep_file && image){
+        RollingVideoBuffer::save_all(env.logger(), env.video_feeds(), SCREENSHOTS_PATH(), title);
+    }
 }
 
 
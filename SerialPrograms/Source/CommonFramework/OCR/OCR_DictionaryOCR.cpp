@@ -7,7 +7,9 @@
 #include "Common/Cpp/Json/JsonValue.h"
 #include "Common/Cpp/Json/JsonArray.h"
 #include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Json/JsonLazyObject.h"
 #include "Common/Qt/StringToolsQt.h"
+#include "CommonFramework/Resources/ResourceBundle.h"
 #include "OCR_StringNormalization.h"
 #include "OCR_TextMatcher.h"
 #include "OCR_DictionaryOCR.h"
@@ -34,41 +36,62 @@ DictionaryOCR::DictionaryOCR(
         if (subset != nullptr && subset->find(token) == subset->end()){
             continue;
         }
-        std::vector<std::string>& candidates = m_database[token];
-        for (const auto& item1 : item0.second.get_array_throw()){
-            const std::string& candidate = item1.get_string_throw();
-            std::u32string normalized = normalize_utf32(candidate);
-            std::set<std::string>& set = m_candidate_to_token[normalized];
-            if (!set.empty()){
-                global_logger_tagged().log("DictionaryOCR - Duplicate Candidate: " + token);
-//                cout << "Duplicate Candidate: " << it.key().toUtf8().data() << endl;
+        add_token(token, item0.second, first_only);
+    }
+    log_size();
+}
+DictionaryOCR::DictionaryOCR(
+    const std::string& json_path,
+    const std::set<std::string>* subset,
+    double random_match_chance,
+    bool first_only
+)
+    : m_random_match_chance(random_match_chance)
+{
+    if (subset != nullptr && !ResourceBundle::instance().contains(json_path)){
+        //  Only parse the entries in the subset.
+        JsonLazyObject json(json_path);
+        for (const std::string& token : *subset){
+            const JsonValue* value = json.get_value(token);
+            if (value != nullptr){
+                add_token(token, *value, first_only);
             }
-            set.insert(token);
-            candidates.emplace_back(candidate);
-            if (first_only){
-                break;
+        }
+    }else{
+        //  The bundle is already parsed, so taking all of it is cheap.
+        JsonValue json = load_json_file(json_path);
+        for (const auto& item : json.get_object_throw(json_path)){
+            if (subset == nullptr || subset->find(item.first) != subset->end()){
+                add_token(item.first, item.second, first_only);
             }
         }
     }
+    log_size();
+}
+void DictionaryOCR::add_token(const std::string& token, const JsonValue& json, bool first_only){
+    std::vector<std::string>& candidates = m_database[token];
+    for (const auto& item : json.get_array_throw()){
+        const std::string& candidate = item.get_string_throw();
+        std::u32string normalized = normalize_utf32(candidate);
+        std::set<std::string>& set = m_candidate_to_token[normalized];
+        if (!set.empty()){
+            global_logger_tagged().log("DictionaryOCR - Duplicate Candidate: " + token);
+//            cout << "Duplicate Candidate: " << it.key().toUtf8().data() << endl;
+        }
+        set.insert(token);
+        candidates.emplace_back(candidate);
+        if (first_only){
+            break;
+        }
+    }
+}
+void DictionaryOCR::log_size() const{
     global_logger_tagged().log(
         "DictionaryOCR - Tokens: " + std::to_string(m_database.size()) +
         ", Match Candidates: " + std::to_string(m_candidate_to_token.size())
     );
 //    cout << "Tokens: " << m_database.size() << ", Match Candidates: " << m_candidate_to_token.size() << endl;
 }
-DictionaryOCR::DictionaryOCR(
-    const std::string& json_path,
-    const std::set<std::string>* subset,
-    double random_match_chance,
-    bool first_only
-)
-    : DictionaryOCR(
-        load_json_file(json_path).get_object_throw(json_path),
-        subset,
-        random_match_chance,
-        first_only
-    )
-{}
 
 JsonObject DictionaryOCR::to_json() const{
     JsonObject obj;
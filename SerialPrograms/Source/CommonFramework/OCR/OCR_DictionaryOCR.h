@@ -14,6 +14,7 @@
 #include "OCR_StringMatchResult.h"
 
 namespace PokemonAutomation{
+    class JsonValue;
     class JsonObject;
 namespace OCR{
 
@@ -46,6 +47,10 @@ public:
     void add_candidate(std::string token, const std::u32string& candidate);
 
 
+private:
+    void add_token(const std::string& token, const JsonValue& json, bool first_only);
+    void log_size() const;
+
 private:
     SpinLock m_lock;
     double m_random_match_chance;
@@ -10,7 +10,8 @@
 #include <QDir>
 #include "3rdParty/TesseractPA/TesseractPA.h"
 #include "Common/Cpp/Exceptions.h"
-#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "Common/Cpp/Tracing.h"
+#include "Common/Cpp/Concurrency/AdaptiveLock.h"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/Logging/Logger.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
@@ -50,7 +51,7 @@ public:
         TesseractAPI* instance;
         while (true){
             {
-                SpinLockGuard lg(m_lock, "TesseractPool::run()");
+                AdaptiveLockGuard lg(m_lock, "TesseractPool::run()");
                 if (!m_idle.empty()){
                     instance = m_idle.back();
                     m_idle.pop_back();
@@ -71,7 +72,7 @@ public:
 //        cout << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << endl;
 
         {
-            SpinLockGuard lg(m_lock, "TesseractPool::run()");
+            AdaptiveLockGuard lg(m_lock, "TesseractPool::run()");
             m_idle.emplace_back(instance);
         }
 
@@ -101,7 +102,7 @@ public:
             throw InternalSystemError(nullptr, PA_CURRENT_FUNCTION, "Could not initialize TesseractAPI.");
         }
 
-        SpinLockGuard lg(m_lock, "TesseractPool::run()");
+        AdaptiveLockGuard lg(m_lock, "TesseractPool::run()");
 
         m_instances.emplace_back(std::move(api));
         try{
@@ -116,7 +117,7 @@ public:
         size_t current_instances;
         while (true){
             {
-                SpinLockGuard lg(m_lock, "TesseractPool::run()");
+                AdaptiveLockGuard lg(m_lock, "TesseractPool::run()");
                 current_instances = m_instances.size();
             }
             if (current_instances >= instances){
@@ -150,22 +151,23 @@ private:
     const std::string& m_language_code;
     const std::string m_training_data_path;
 
-    SpinLock m_lock;
+    AdaptiveLock m_lock;
     std::vector<std::unique_ptr<TesseractAPI>> m_instances;
     std::vector<TesseractAPI*> m_idle;
 };
 
-SpinLock ocr_pool_lock;
+AdaptiveLock ocr_pool_lock;
 std::map<Language, TesseractPool> ocr_pool;
 
 
 std::string ocr_read(Language language, const ImageViewRGB32& image){
+    PA_TRACE_ZONE("Tesseract::ocr_read");
 //    static size_t c = 0;
 //    image.save("ocr-" + std::to_string(c++) + ".png");
 
     std::map<Language, TesseractPool>::iterator iter;
     {
-        SpinLockGuard lg(ocr_pool_lock, "ocr_read()");
+        AdaptiveLockGuard lg(ocr_pool_lock, "ocr_read()");
         iter = ocr_pool.find(language);
         if (iter == ocr_pool.end()){
             iter = ocr_pool.emplace(language, language).first;
@@ -176,7 +178,7 @@ std::string ocr_read(Language language, const ImageViewRGB32& image){
 void ensure_instances(Language language, size_t instances){
     std::map<Language, TesseractPool>::iterator iter;
     {
-        SpinLockGuard lg(ocr_pool_lock, "ocr_read()");
+        AdaptiveLockGuard lg(ocr_pool_lock, "ocr_read()");
         iter = ocr_pool.find(language);
         if (iter == ocr_pool.end()){
             iter = ocr_pool.emplace(language, language).first;
@@ -0,0 +1,633 @@
+/*  Resource Bundle
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include <QFile>
+#include <QSaveFile>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QDateTime>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Containers/Pimpl.tpp"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Json/JsonTools.h"
+#include "CommonFramework/Globals.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/AudioPipeline/AudioTemplate.h"
+#include "ResourceBundle.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+const char BUNDLE_NAME[] = "ResourceBundle.bin";
+const char BUNDLE_MAGIC[8] = {'P', 'A', '-', 'R', 'S', 'R', 'C', 0};
+const uint32_t BUNDLE_VERSION = 2;
+const size_t DATA_ALIGNMENT = 64;
+
+enum EntryType : uint32_t{
+    ENTRY_JSON              = 1,
+    ENTRY_IMAGE             = 2,
+    ENTRY_AUDIO_TEMPLATE    = 3,
+};
+
+//  Layout:
+//      BundleHeader
+//      Entry[entries]          Sorted by name.
+//      Data                    Each entry aligned to DATA_ALIGNMENT.
+//      Names
+struct BundleHeader{
+    char magic[8];
+    uint32_t version;
+    uint32_t entries;
+    uint64_t names_offset;
+    uint64_t names_size;
+    char program_version[32];   //  PROGRAM_VERSION of the build. Null terminated.
+    uint64_t source_stamp;      //  "stamp_files()" of the loose files at the build.
+};
+
+size_t align_up(size_t x){
+    return (x + DATA_ALIGNMENT - 1) & ~(DATA_ALIGNMENT - 1);
+}
+
+std::string bundle_path(){
+    return RESOURCE_PATH() + BUNDLE_NAME;
+}
+
+//  Returns false if "path" isn't under RESOURCE_PATH().
+bool relative_path(const std::string& path, std::string& relative){
+    const std::string& root = RESOURCE_PATH();
+    if (path.size() <= root.size() || path.compare(0, root.size(), root) != 0){
+        return false;
+    }
+    relative = path.substr(root.size());
+    for (char& ch : relative){
+        if (ch == '\\'){
+            ch = '/';
+        }
+    }
+    return true;
+}
+
+//  Every file under RESOURCE_PATH() except the bundle. Relative and sorted.
+std::vector<std::string> list_resource_files(){
+    std::vector<std::string> files;
+    QDir root_dir(QString::fromStdString(RESOURCE_PATH()));
+    QDirIterator iter(root_dir.path(), QDir::Files, QDirIterator::Subdirectories);
+    while (iter.hasNext()){
+        std::string relative = root_dir.relativeFilePath(iter.next()).toStdString();
+        if (relative != BUNDLE_NAME){
+            files.emplace_back(std::move(relative));
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+//  Hash of the name, size and modification time of every file. (FNV-1a)
+//  Adding, removing or editing any resource changes it. It only needs a stat
+//  per file, not a read.
+uint64_t stamp_files(const std::vector<std::string>& files){
+    const std::string& root = RESOURCE_PATH();
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&](const void* data, size_t bytes){
+        for (size_t c = 0; c < bytes; c++){
+            hash ^= ((const uint8_t*)data)[c];
+            hash *= 1099511628211ull;
+        }
+    };
+    for (const std::string& relative : files){
+        QFileInfo info(QString::fromStdString(root + relative));
+        int64_t size = info.size();
+        int64_t modified = info.lastModified().toMSecsSinceEpoch();
+        mix(relative.data(), relative.size() + 1);
+        mix(&size, sizeof(size));
+        mix(&modified, sizeof(modified));
+    }
+    return hash;
+}
+
+bool has_extension(const std::string& path, const char* extension){
+    size_t length = strlen(extension);
+    return path.size() > length && path.compare(path.size() - length, length, extension) == 0;
+}
+
+//  Audio templates are named "<name>-<sample rate>.wav". Returns 0 if the
+//  name doesn't have a sample rate.
+size_t audio_sample_rate(const std::string& path){
+    size_t dot = path.rfind('.');
+    size_t dash = path.rfind('-', dot);
+    if (dot == std::string::npos || dash == std::string::npos || dash + 1 == dot){
+        return 0;
+    }
+    size_t rate = 0;
+    for (size_t c = dash + 1; c < dot; c++){
+        char ch = path[c];
+        if (ch < '0' || ch > '9'){
+            return 0;
+        }
+        rate = rate * 10 + (ch - '0');
+    }
+    return rate;
+}
+
+
+
+//  Binary JSON
+//
+//  Each value is a one byte tag followed by:
+//      Integer / Float:    8 bytes.
+//      String:             uint32 length, then the bytes.
+//      Array:              uint32 count, then the values.
+//      Object:             uint32 count, then (key string, value) pairs.
+
+enum BinaryJsonTag : uint8_t{
+    TAG_NULL,
+    TAG_FALSE,
+    TAG_TRUE,
+    TAG_INTEGER,
+    TAG_FLOAT,
+    TAG_STRING,
+    TAG_ARRAY,
+    TAG_OBJECT,
+};
+
+template <typename Type>
+void append(std::string& out, Type x){
+    out.append((const char*)&x, sizeof(Type));
+}
+void append_string(std::string& out, const std::string& str){
+    append<uint32_t>(out, (uint32_t)str.size());
+    out += str;
+}
+
+void encode_json(std::string& out, const JsonValue& value){
+    switch (value.type()){
+    case JsonType::EMPTY:
+        append<uint8_t>(out, TAG_NULL);
+        return;
+    case JsonType::BOOLEAN:
+        append<uint8_t>(out, value.get_boolean_default() ? TAG_TRUE : TAG_FALSE);
+        return;
+    case JsonType::INTEGER:
+        append<uint8_t>(out, TAG_INTEGER);
+        append<int64_t>(out, value.get_integer_default());
+        return;
+    case JsonType::FLOAT:
+        append<uint8_t>(out, TAG_FLOAT);
+        append<double>(out, value.get_double_default());
+        return;
+    case JsonType::STRING:
+        append<uint8_t>(out, TAG_STRING);
+        append_string(out, *value.get_string());
+        return;
+    case JsonType::ARRAY:{
+        const JsonArray& array = *value.get_array();
+        append<uint8_t>(out, TAG_ARRAY);
+        append<uint32_t>(out, (uint32_t)array.size());
+        for (const JsonValue& item : array){
+            encode_json(out, item);
+        }
+        return;
+    }
+    case JsonType::OBJECT:{
+        const JsonObject& object = *value.get_object();
+        append<uint8_t>(out, TAG_OBJECT);
+        append<uint32_t>(out, (uint32_t)object.size());
+        for (const auto& item : object){
+            append_string(out, item.first);
+            encode_json(out, item.second);
+        }
+        return;
+    }
+    }
+}
+
+class BinaryJsonReader{
+public:
+    BinaryJsonReader(const std::string& filename, const char* ptr, const char* end)
+        : m_filename(filename)
+        , m_ptr(ptr)
+        , m_end(end)
+    {}
+
+    JsonValue read_value(){
+        switch (read<uint8_t>()){
+        case TAG_NULL:
+            return JsonValue();
+        case TAG_FALSE:
+            return JsonValue(false);
+        case TAG_TRUE:
+            return JsonValue(true);
+        case TAG_INTEGER:
+            return JsonValue(read<int64_t>());
+        case TAG_FLOAT:
+            return JsonValue(read<double>());
+        case TAG_STRING:
+            return JsonValue(read_string());
+        case TAG_ARRAY:{
+            JsonArray array;
+            uint32_t count = read<uint32_t>();
+            for (uint32_t c = 0; c < count; c++){
+                array.push_back(read_value());
+            }
+            return array;
+        }
+        case TAG_OBJECT:{
+            JsonObject object;
+            uint32_t count = read<uint32_t>();
+            for (uint32_t c = 0; c < count; c++){
+                std::string key = read_string();
+                object[std::move(key)] = read_value();
+            }
+            return object;
+        }
+        }
+        fail();
+    }
+    bool done() const{ return m_ptr == m_end; }
+
+private:
+    template <typename Type>
+    Type read(){
+        if ((size_t)(m_end - m_ptr) < sizeof(Type)){
+            fail();
+        }
+        Type x;
+        memcpy(&x, m_ptr, sizeof(Type));
+        m_ptr += sizeof(Type);
+        return x;
+    }
+    std::string read_string(){
+        uint32_t length = read<uint32_t>();
+        if ((size_t)(m_end - m_ptr) < length){
+            fail();
+        }
+        std::string ret(m_ptr, length);
+        m_ptr += length;
+        return ret;
+    }
+    [[noreturn]] void fail() const{
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Corrupt JSON in resource bundle.", m_filename);
+    }
+
+private:
+    const std::string& m_filename;
+    const char* m_ptr;
+    const char* m_end;
+};
+
+
+}
+
+
+
+struct ResourceBundle::Entry{
+    uint32_t name_offset;   //  Relative to the start of the names.
+    uint32_t name_length;
+    uint32_t type;
+    uint32_t sample_rate;   //  Audio templates only.
+    uint32_t width;         //  Image width or spectrum frequencies.
+    uint32_t height;        //  Image height or spectrogram windows.
+    uint64_t data_offset;
+    uint64_t data_size;
+};
+
+struct ResourceBundle::MappedFile{
+    QFile file;
+    const uchar* data = nullptr;
+    size_t size = 0;
+
+    MappedFile(const std::string& path)
+        : file(QString::fromStdString(path))
+    {}
+    ~MappedFile(){
+        if (data != nullptr){
+            file.unmap(const_cast<uchar*>(data));
+        }
+    }
+};
+
+
+
+ResourceBundle& ResourceBundle::instance(){
+    static ResourceBundle bundle;
+    return bundle;
+}
+ResourceBundle::~ResourceBundle() = default;
+ResourceBundle::ResourceBundle() = default;
+
+
+bool ResourceBundle::open(Logger& logger){
+    if (is_open()){
+        return true;
+    }
+
+    WallClock start = current_time();
+    std::string path = bundle_path();
+    m_file.reset(path);
+    MappedFile& file = *m_file;
+    if (!file.file.exists() || !file.file.open(QIODevice::ReadOnly)){
+        m_file.clear();
+        return false;
+    }
+    file.size = (size_t)file.file.size();
+    if (file.size >= sizeof(BundleHeader)){
+        file.data = file.file.map(0, file.size);
+    }
+    if (file.data == nullptr){
+        logger.log("Unable to map resource bundle: " + path, COLOR_RED);
+        m_file.clear();
+        return false;
+    }
+
+    //  Check everything up front so the lookups don't have to.
+    const BundleHeader& header = *(const BundleHeader*)file.data;
+    size_t index_end = sizeof(BundleHeader) + (size_t)header.entries * sizeof(Entry);
+    bool ok =
+        memcmp(header.magic, BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC)) == 0 &&
+        header.version == BUNDLE_VERSION &&
+        index_end <= header.names_offset &&
+        header.names_offset + header.names_size <= file.size;
+
+    const Entry* entries = (const Entry*)(file.data + sizeof(BundleHeader));
+    const char* names = (const char*)file.data + header.names_offset;
+    std::string_view previous;
+    for (uint32_t c = 0; ok && c < header.entries; c++){
+        const Entry& entry = entries[c];
+        std::string_view current(names + entry.name_offset, entry.name_length);
+        size_t expected_size = entry.data_size;
+        switch (entry.type){
+        case ENTRY_IMAGE:
+        case ENTRY_AUDIO_TEMPLATE:
+            expected_size = (size_t)entry.width * entry.height * sizeof(uint32_t);
+            break;
+        }
+        ok =
+            (uint64_t)entry.name_offset + entry.name_length <= header.names_size &&
+            (c == 0 || previous < current) &&
+            entry.data_offset % DATA_ALIGNMENT == 0 &&
+            entry.data_offset >= index_end &&
+            entry.data_offset + entry.data_size <= header.names_offset &&
+            entry.data_size == expected_size;
+        previous = current;
+    }
+    if (!ok){
+        logger.log("Ignoring invalid or outdated resource bundle: " + path, COLOR_RED);
+        m_file.clear();
+        return false;
+    }
+
+    //  The bundle wins over the loose files. So refuse it if it was built
+    //  from anything other than what is on disk now.
+    std::string built_by(header.program_version, strnlen(header.program_version, sizeof(header.program_version)));
+    if (built_by != PROGRAM_VERSION){
+        logger.log(
+            "Ignoring resource bundle built by version " + built_by + ". Rebuild it: " + path,
+            COLOR_RED
+        );
+        m_file.clear();
+        return false;
+    }
+    if (header.source_stamp != stamp_files(list_resource_files())){
+        logger.log("Ignoring resource bundle. The resources have changed since it was built. Rebuild it: " + path, COLOR_RED);
+        m_file.clear();
+        return false;
+    }
+
+    m_data = file.data;
+    m_entries = entries;
+    m_entry_count = header.entries;
+    m_names = names;
+
+    set_json_file_loader([](const std::string& filename, JsonValue& value){
+        return ResourceBundle::instance().load_json(filename, value);
+    });
+
+    logger.log(
+        "Using resource bundle: " + path + " (" + std::to_string(m_entry_count) + " entries, opened in " +
+        std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(current_time() - start).count()) + " ms)",
+        COLOR_BLUE
+    );
+    return true;
+}
+
+
+std::string_view ResourceBundle::name(const Entry& entry) const{
+    return std::string_view(m_names + entry.name_offset, entry.name_length);
+}
+const ResourceBundle::Entry* ResourceBundle::find(const std::string& path, uint32_t type) const{
+    if (!is_open()){
+        return nullptr;
+    }
+    std::string relative;
+    if (!relative_path(path, relative)){
+        return nullptr;
+    }
+    const Entry* end = m_entries + m_entry_count;
+    const Entry* iter = std::lower_bound(
+        m_entries, end, relative,
+        [this](const Entry& entry, const std::string& key){
+            return name(entry) < key;
+        }
+    );
+    if (iter == end || name(*iter) != relative){
+        return nullptr;
+    }
+    if (type != 0 && iter->type != type){
+        return nullptr;
+    }
+    return iter;
+}
+bool ResourceBundle::contains(const std::string& path) const{
+    return find(path, 0) != nullptr;
+}
+bool ResourceBundle::load_json(const std::string& path, JsonValue& value) const{
+    const Entry* entry = find(path, ENTRY_JSON);
+    if (entry == nullptr){
+        return false;
+    }
+    const char* data = (const char*)m_data + entry->data_offset;
+    BinaryJsonReader reader(path, data, data + entry->data_size);
+    value = reader.read_value();
+    if (!reader.done()){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Corrupt JSON in resource bundle.", path);
+    }
+    return true;
+}
+bool ResourceBundle::load_image(const std::string& path, ImageRGB32& image) const{
+    const Entry* entry = find(path, ENTRY_IMAGE);
+    if (entry == nullptr){
+        return false;
+    }
+    size_t row_bytes = entry->width * sizeof(uint32_t);
+    const uint8_t* data = m_data + entry->data_offset;
+    image = ImageRGB32(entry->width, entry->height);
+    for (size_t r = 0; r < entry->height; r++){
+        memcpy((char*)image.data() + r * image.bytes_per_row(), data + r * row_bytes, row_bytes);
+    }
+    return true;
+}
+bool ResourceBundle::load_audio_template(const std::string& path, size_t sample_rate, AudioTemplate& audio_template) const{
+    const Entry* entry = find(path, ENTRY_AUDIO_TEMPLATE);
+    if (entry == nullptr || entry->sample_rate != sample_rate){
+        return false;
+    }
+    size_t spectrum_bytes = entry->width * sizeof(float);
+    const uint8_t* data = m_data + entry->data_offset;
+    audio_template = AudioTemplate(entry->width, entry->height);
+    for (size_t c = 0; c < entry->height; c++){
+        memcpy(audio_template.getWindow(c), data + c * spectrum_bytes, spectrum_bytes);
+    }
+    return true;
+}
+
+
+
+
+bool ResourceBundle::pack_file(Entry& entry, std::string& payload, const std::string& path){
+    if (has_extension(path, ".json")){
+        JsonValue json = parse_json(file_to_string(path));
+        entry.type = ENTRY_JSON;
+        encode_json(payload, json);
+        return true;
+    }
+    if (has_extension(path, ".png")){
+        ImageRGB32 image(path);
+        size_t row_bytes = image.width() * sizeof(uint32_t);
+        entry.type = ENTRY_IMAGE;
+        entry.width = (uint32_t)image.width();
+        entry.height = (uint32_t)image.height();
+        payload.resize(row_bytes * image.height());
+        for (size_t r = 0; r < image.height(); r++){
+            memcpy(&payload[r * row_bytes], (const char*)image.data() + r * image.bytes_per_row(), row_bytes);
+        }
+        return true;
+    }
+    if (has_extension(path, ".wav") || has_extension(path, ".mp3")){
+        size_t sample_rate = audio_sample_rate(path);
+        if (sample_rate == 0){
+            return false;
+        }
+        AudioTemplate audio_template = loadAudioTemplate(path, sample_rate);
+        if (audio_template.numFrequencies() == 0){
+            return false;
+        }
+        size_t spectrum_bytes = audio_template.numFrequencies() * sizeof(float);
+        entry.type = ENTRY_AUDIO_TEMPLATE;
+        entry.sample_rate = (uint32_t)sample_rate;
+        entry.width = (uint32_t)audio_template.numFrequencies();
+        entry.height = (uint32_t)audio_template.numWindows();
+        payload.resize(spectrum_bytes * audio_template.numWindows());
+        for (size_t c = 0; c < audio_template.numWindows(); c++){
+            memcpy(&payload[c * spectrum_bytes], audio_template.getWindow(c), spectrum_bytes);
+        }
+        return true;
+    }
+    return false;
+}
+
+
+bool build_resource_bundle(Logger& logger){
+    if (ResourceBundle::instance().is_open()){
+        logger.log("Can't rebuild the resource bundle while it is in use.", COLOR_RED);
+        return false;
+    }
+
+    const std::string& root = RESOURCE_PATH();
+    std::string path = bundle_path();
+    logger.log("Building resource bundle: " + path);
+
+    std::vector<std::string> files = list_resource_files();
+    uint64_t source_stamp = stamp_files(files);
+
+    QSaveFile file(QString::fromStdString(path));
+    if (!file.open(QIODevice::WriteOnly)){
+        logger.log("Unable to open: " + path, COLOR_RED);
+        return false;
+    }
+
+    //  The index is sized for every file. Files that aren't packed leave
+    //  unused space behind it.
+    std::vector<ResourceBundle::Entry> entries;
+    std::string names;
+    size_t offset = align_up(sizeof(BundleHeader) + files.size() * sizeof(ResourceBundle::Entry));
+    size_t total_bytes = 0;
+    for (const std::string& relative : files){
+        ResourceBundle::Entry entry{};
+        std::string payload;
+        try{
+            if (!ResourceBundle::pack_file(entry, payload, root + relative)){
+                continue;
+            }
+        }catch (const Exception& e){
+            logger.log("Skipping " + relative + ": " + e.message(), COLOR_RED);
+            continue;
+        }
+
+        entry.name_offset = (uint32_t)names.size();
+        entry.name_length = (uint32_t)relative.size();
+        entry.data_offset = offset;
+        entry.data_size = payload.size();
+        names += relative;
+
+        if (!file.seek(offset) || file.write(payload.data(), payload.size()) != (qint64)payload.size()){
+            logger.log("Unable to write: " + path, COLOR_RED);
+            file.cancelWriting();
+            return false;
+        }
+        offset = align_up(offset + payload.size());
+        total_bytes += payload.size();
+        entries.emplace_back(entry);
+    }
+
+    BundleHeader header{};
+    memcpy(header.magic, BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC));
+    header.version = BUNDLE_VERSION;
+    header.entries = (uint32_t)entries.size();
+    header.names_offset = offset;
+    header.names_size = names.size();
+    if (PROGRAM_VERSION.size() >= sizeof(header.program_version)){
+        logger.log("Program version is too long for the bundle header: " + PROGRAM_VERSION, COLOR_RED);
+        file.cancelWriting();
+        return false;
+    }
+    memcpy(header.program_version, PROGRAM_VERSION.data(), PROGRAM_VERSION.size());
+    header.source_stamp = source_stamp;
+
+    size_t index_bytes = entries.size() * sizeof(ResourceBundle::Entry);
+    if (!file.seek(offset) || file.write(names.data(), names.size()) != (qint64)names.size() ||
+        !file.seek(0) || file.write((const char*)&header, sizeof(header)) != (qint64)sizeof(header) ||
+        file.write((const char*)entries.data(), index_bytes) != (qint64)index_bytes ||
+        !file.commit()
+    ){
+        logger.log("Unable to write: " + path, COLOR_RED);
+        return false;
+    }
+
+    logger.log(
+        "Packed " + std::to_string(entries.size()) + " of " + std::to_string(files.size()) +
+        " files. (" + std::to_string(total_bytes) + " bytes)",
+        COLOR_BLUE
+    );
+    return true;
+}
+
+
+
+}
@@ -0,0 +1,94 @@
+/*  Resource Bundle
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      The loose files under RESOURCE_PATH() packed into one indexed file that
+ *  is memory-mapped at startup. Entries are stored ready to use:
+ *    - PNG images as decoded 32-bit pixels.
+ *    - JSON files as a compact binary encoding of the JsonValue tree.
+ *    - Audio templates as their spectrograms.
+ *
+ *  "load_json_file()", "ImageRGB32(path)" and "loadAudioTemplate()" check the
+ *  bundle first and only go to the disk if the file isn't in it. So the bundle
+ *  is optional. But when it is present it wins over the loose files.
+ *
+ *  To keep it from serving stale resources, the bundle records the program
+ *  version that built it and a hash of the name, size and modification time
+ *  of every loose file. "open()" refuses the bundle if either one differs.
+ *  Checking the hash costs a directory walk and a stat per file, but no
+ *  reads or decoding.
+ *
+ *  Loading from the bundle is off by default. Turn it on with "USE" in the
+ *  "RESOURCE_BUNDLE" settings block.
+ *
+ */
+
+#ifndef PokemonAutomation_Resources_ResourceBundle_H
+#define PokemonAutomation_Resources_ResourceBundle_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include "Common/Cpp/Containers/Pimpl.h"
+
+namespace PokemonAutomation{
+
+class Logger;
+class JsonValue;
+class ImageRGB32;
+class AudioTemplate;
+
+
+class ResourceBundle{
+public:
+    static ResourceBundle& instance();
+    ~ResourceBundle();
+
+    //  Map the bundle if there is one and start serving files from it.
+    //  Call this once at startup before anything loads resources.
+    //  Returns false if there is no usable bundle, or it is out of date.
+    bool open(Logger& logger);
+
+    bool is_open() const{ return m_entries != nullptr; }
+    size_t size() const{ return m_entry_count; }
+
+    //  "path" is a full path starting with RESOURCE_PATH().
+    //  The loaders return false if the file isn't in the bundle. They throw
+    //  FileException if the entry is corrupt.
+    bool contains(const std::string& path) const;
+    bool load_json(const std::string& path, JsonValue& value) const;
+    bool load_image(const std::string& path, ImageRGB32& image) const;
+    bool load_audio_template(const std::string& path, size_t sample_rate, AudioTemplate& audio_template) const;
+
+
+private:
+    struct Entry;
+    struct MappedFile;
+
+    ResourceBundle();
+    friend bool build_resource_bundle(Logger& logger);
+
+    //  Returns false if the file doesn't go into the bundle.
+    static bool pack_file(Entry& entry, std::string& payload, const std::string& path);
+
+    const Entry* find(const std::string& path, uint32_t type) const;
+    std::string_view name(const Entry& entry) const;
+
+private:
+    Pimpl<MappedFile> m_file;
+    const uint8_t* m_data = nullptr;
+    const Entry* m_entries = nullptr;
+    size_t m_entry_count = 0;
+    const char* m_names = nullptr;
+};
+
+
+//  Pack the loose files under RESOURCE_PATH() into the bundle.
+//  Must run before the bundle is opened. Returns false on failure.
+bool build_resource_bundle(Logger& logger);
+
+
+
+}
+#endif
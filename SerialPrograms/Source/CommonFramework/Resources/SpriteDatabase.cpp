@@ -4,11 +4,9 @@
  *
  */
 
-#include "Common/Cpp/Json/JsonValue.h"
-#include "Common/Cpp/Json/JsonObject.h"
-#include "CommonFramework/Globals.h"
+#include "Common/Cpp/Exceptions.h"
 #include "CommonFramework/ImageTools/ImageBoxes.h"
-#include "CommonFramework/ImageMatch/ImageCropper.h"
+#include "SpriteSheetStore.h"
 #include "SpriteDatabase.h"
 
 namespace PokemonAutomation{
@@ -16,32 +14,17 @@ namespace PokemonAutomation{
 
 
 SpriteDatabase::SpriteDatabase(const char* sprite_path, const char* json_path)
-    : m_backing_image(RESOURCE_PATH() + sprite_path)
+    : m_sheet(SpriteSheetStore::instance().get(sprite_path, json_path))
 {
-    std::string path = RESOURCE_PATH() + json_path;
-    JsonValue json = load_json_file(path);
-    JsonObject& root = json.get_object_throw(path);
-
-    int64_t width = root.get_integer_throw("spriteWidth", path);
-    int64_t height = root.get_integer_throw("spriteHeight", path);
-    if (width <= 0){
-        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Invalid width.", path);
-    }
-    if (height <= 0){
-        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Invalid height.", path);
-    }
-
-    JsonObject& locations = root.get_object_throw("spriteLocations", path);
-    for (auto& item : locations){
-        const std::string& slug = item.first;
-        JsonObject& obj = item.second.get_object_throw(path);
-        int y = (int)obj.get_integer_throw("top", path);
-        int x = (int)obj.get_integer_throw("left", path);
-
-        ImageViewRGB32 sprite = extract_box_reference(m_backing_image, ImagePixelBox(x, y, x + width, y + height));
-        m_database.emplace(
-            slug,
-            Sprite{sprite, ImageMatch::trim_image_alpha(sprite)}
+    const ImageViewRGB32& image = m_sheet->image();
+    for (const SpriteSheet::Entry& entry : m_sheet->entries()){
+        m_database.emplace_hint(
+            m_database.end(),
+            entry.slug,
+            Sprite{
+                extract_box_reference(image, entry.sprite),
+                extract_box_reference(image, entry.icon),
+            }
         );
     }
 }
@@ -8,10 +8,12 @@
 #define PokemonAutomation_Resources_SpriteCompositeImage_H
 
 #include <map>
+#include <memory>
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 
 namespace PokemonAutomation{
 
+class SpriteSheet;
 
 class SpriteDatabase{
 public:
@@ -32,6 +34,9 @@ public:
     //          (next pokemon) ...
     //      }
     //  }
+    //
+    //  The pixels are owned by the process-wide SpriteSheetStore. So multiple
+    //  databases built from the same files will share them.
     SpriteDatabase(const char* sprite_path, const char* json_path);
 
 public:
@@ -59,7 +64,7 @@ public:
 
 private:
     std::map<std::string, Sprite> m_database;
-    ImageRGB32 m_backing_image;
+    std::shared_ptr<const SpriteSheet> m_sheet;
 };
 
 
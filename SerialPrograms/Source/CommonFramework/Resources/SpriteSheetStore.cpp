@@ -0,0 +1,341 @@
+/*  Sprite Sheet Store
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDir>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Containers/Pimpl.tpp"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "CommonFramework/Globals.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/ImageMatch/ImageCropper.h"
+#include "SpriteSheetStore.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+const char SHEET_MAGIC[8] = {'P', 'A', '-', 'S', 'P', 'R', 'T', 0};
+const uint32_t SHEET_VERSION = 1;
+const size_t PIXEL_ALIGNMENT = 64;
+
+struct SheetHeader{
+    char magic[8];
+    uint32_t version;
+    uint32_t entries;
+    uint32_t width;
+    uint32_t height;
+    int64_t png_size;
+    int64_t png_modified;
+    int64_t json_size;
+    int64_t json_modified;
+    uint64_t pixel_offset;
+};
+struct SheetEntry{
+    uint32_t slug_offset;
+    uint32_t slug_length;
+    uint32_t sprite[4];
+    uint32_t icon[4];
+};
+
+bool get_file_info(const std::string& path, int64_t& size, int64_t& modified){
+    QFileInfo info(QString::fromStdString(path));
+    if (!info.exists()){
+        return false;
+    }
+    size = info.size();
+    modified = info.lastModified().toMSecsSinceEpoch();
+    return true;
+}
+
+std::string cache_path_for(const std::string& sprite_path){
+    std::string name = sprite_path;
+    for (char& ch : name){
+        if (ch == '/' || ch == '\\' || ch == '.'){
+            ch = '_';
+        }
+    }
+    return CACHE_PATH() + "Sprites/" + name + ".bin";
+}
+
+void write_box(uint32_t out[4], const ImagePixelBox& box){
+    out[0] = (uint32_t)box.min_x;
+    out[1] = (uint32_t)box.min_y;
+    out[2] = (uint32_t)box.max_x;
+    out[3] = (uint32_t)box.max_y;
+}
+ImagePixelBox read_box(const uint32_t in[4]){
+    return ImagePixelBox(in[0], in[1], in[2], in[3]);
+}
+
+}
+
+
+
+struct SpriteSheet::MappedFile{
+    QFile file;
+    const uchar* data = nullptr;
+    size_t size = 0;
+
+    MappedFile(const std::string& path)
+        : file(QString::fromStdString(path))
+    {}
+    ~MappedFile(){
+        if (data != nullptr){
+            file.unmap(const_cast<uchar*>(data));
+        }
+    }
+};
+
+
+
+SpriteSheet::~SpriteSheet() = default;
+SpriteSheet::SpriteSheet(const std::string& sprite_path, const std::string& json_path)
+    : m_cache_path(cache_path_for(sprite_path))
+{
+    std::string full_sprite_path = RESOURCE_PATH() + sprite_path;
+    std::string full_json_path = RESOURCE_PATH() + json_path;
+
+    int64_t png_size, png_modified, json_size, json_modified;
+    bool have_info =
+        get_file_info(full_sprite_path, png_size, png_modified) &&
+        get_file_info(full_json_path, json_size, json_modified);
+
+    if (have_info && load_cache(png_size, png_modified, json_size, json_modified)){
+        return;
+    }
+
+    load_source(full_sprite_path, full_json_path);
+
+    //  Replace the decoded image with the mapped file so that the pages can be
+    //  shared with anything else that has the file open.
+    if (have_info &&
+        write_cache(png_size, png_modified, json_size, json_modified) &&
+        load_cache(png_size, png_modified, json_size, json_modified)
+    ){
+        m_decoded = ImageRGB32();
+    }
+}
+
+bool SpriteSheet::is_mapped() const{
+    return m_file && m_file->data != nullptr;
+}
+
+const SpriteSheet::Entry* SpriteSheet::find(const std::string& slug) const{
+    auto iter = std::lower_bound(
+        m_entries.begin(), m_entries.end(), slug,
+        [](const Entry& entry, const std::string& key){
+            return entry.slug < key;
+        }
+    );
+    if (iter == m_entries.end() || iter->slug != slug){
+        return nullptr;
+    }
+    return &*iter;
+}
+
+
+bool SpriteSheet::load_cache(int64_t png_size, int64_t png_modified, int64_t json_size, int64_t json_modified){
+    m_file.reset(m_cache_path);
+    MappedFile& file = *m_file;
+    if (!file.file.exists() || !file.file.open(QIODevice::ReadOnly)){
+        m_file.clear();
+        return false;
+    }
+    file.size = (size_t)file.file.size();
+    if (file.size < sizeof(SheetHeader)){
+        m_file.clear();
+        return false;
+    }
+    file.data = file.file.map(0, file.size);
+    if (file.data == nullptr){
+        m_file.clear();
+        return false;
+    }
+
+    const SheetHeader& header = *(const SheetHeader*)file.data;
+    size_t pixel_bytes = (size_t)header.width * header.height * sizeof(uint32_t);
+    if (memcmp(header.magic, SHEET_MAGIC, sizeof(SHEET_MAGIC)) != 0 ||
+        header.version != SHEET_VERSION ||
+        header.png_size != png_size || header.png_modified != png_modified ||
+        header.json_size != json_size || header.json_modified != json_modified ||
+        header.pixel_offset % PIXEL_ALIGNMENT != 0 ||
+        header.pixel_offset + pixel_bytes > file.size ||
+        sizeof(SheetHeader) + (size_t)header.entries * sizeof(SheetEntry) > header.pixel_offset
+    ){
+        m_file.clear();
+        return false;
+    }
+
+    std::vector<Entry> entries;
+    entries.reserve(header.entries);
+    const SheetEntry* index = (const SheetEntry*)(file.data + sizeof(SheetHeader));
+    for (uint32_t c = 0; c < header.entries; c++){
+        const SheetEntry& item = index[c];
+        if ((size_t)item.slug_offset + item.slug_length > header.pixel_offset){
+            m_file.clear();
+            return false;
+        }
+        entries.emplace_back(Entry{
+            std::string((const char*)file.data + item.slug_offset, item.slug_length),
+            read_box(item.sprite),
+            read_box(item.icon),
+        });
+    }
+
+    m_entries = std::move(entries);
+    m_image = ImageViewRGB32(
+        (uint32_t*)(file.data + header.pixel_offset),
+        header.width * sizeof(uint32_t),
+        header.width, header.height
+    );
+    return true;
+}
+void SpriteSheet::load_source(const std::string& sprite_path, const std::string& json_path){
+    m_decoded = ImageRGB32(sprite_path);
+    m_image = m_decoded;
+
+    JsonValue json = load_json_file(json_path);
+    JsonObject& root = json.get_object_throw(json_path);
+
+    int64_t width = root.get_integer_throw("spriteWidth", json_path);
+    int64_t height = root.get_integer_throw("spriteHeight", json_path);
+    if (width <= 0){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Invalid width.", json_path);
+    }
+    if (height <= 0){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Invalid height.", json_path);
+    }
+
+    JsonObject& locations = root.get_object_throw("spriteLocations", json_path);
+    m_entries.clear();
+    for (auto& item : locations){
+        JsonObject& obj = item.second.get_object_throw(json_path);
+        size_t y = (size_t)obj.get_integer_throw("top", json_path);
+        size_t x = (size_t)obj.get_integer_throw("left", json_path);
+
+        ImagePixelBox box(x, y, x + width, y + height);
+        ImageViewRGB32 sprite = extract_box_reference(m_image, box);
+        ImagePixelBox icon = ImageMatch::enclosing_rectangle_with_pixel_filter(
+            sprite,
+            [](Color pixel){ return pixel.alpha() >= 128; }
+        );
+        icon.min_x += x;
+        icon.max_x += x;
+        icon.min_y += y;
+        icon.max_y += y;
+
+        m_entries.emplace_back(Entry{item.first, box, icon});
+    }
+
+    std::sort(
+        m_entries.begin(), m_entries.end(),
+        [](const Entry& x, const Entry& y){
+            return x.slug < y.slug;
+        }
+    );
+}
+bool SpriteSheet::write_cache(int64_t png_size, int64_t png_modified, int64_t json_size, int64_t json_modified) const{
+    size_t slug_bytes = 0;
+    for (const Entry& entry : m_entries){
+        slug_bytes += entry.slug.size();
+    }
+    size_t index_bytes = sizeof(SheetHeader) + m_entries.size() * sizeof(SheetEntry);
+    size_t pixel_offset = (index_bytes + slug_bytes + PIXEL_ALIGNMENT - 1) & ~(PIXEL_ALIGNMENT - 1);
+    size_t row_bytes = m_image.width() * sizeof(uint32_t);
+
+    std::string buffer(pixel_offset + row_bytes * m_image.height(), '\0');
+
+    SheetHeader& header = *(SheetHeader*)&buffer[0];
+    memcpy(header.magic, SHEET_MAGIC, sizeof(SHEET_MAGIC));
+    header.version = SHEET_VERSION;
+    header.entries = (uint32_t)m_entries.size();
+    header.width = (uint32_t)m_image.width();
+    header.height = (uint32_t)m_image.height();
+    header.png_size = png_size;
+    header.png_modified = png_modified;
+    header.json_size = json_size;
+    header.json_modified = json_modified;
+    header.pixel_offset = pixel_offset;
+
+    SheetEntry* index = (SheetEntry*)&buffer[sizeof(SheetHeader)];
+    size_t slug_offset = index_bytes;
+    for (size_t c = 0; c < m_entries.size(); c++){
+        const Entry& entry = m_entries[c];
+        index[c].slug_offset = (uint32_t)slug_offset;
+        index[c].slug_length = (uint32_t)entry.slug.size();
+        write_box(index[c].sprite, entry.sprite);
+        write_box(index[c].icon, entry.icon);
+        memcpy(&buffer[slug_offset], entry.slug.data(), entry.slug.size());
+        slug_offset += entry.slug.size();
+    }
+
+    for (size_t r = 0; r < m_image.height(); r++){
+        memcpy(
+            &buffer[pixel_offset + r * row_bytes],
+            (const char*)m_image.data() + r * m_image.bytes_per_row(),
+            row_bytes
+        );
+    }
+
+    QDir().mkpath(QString::fromStdString(CACHE_PATH() + "Sprites/"));
+    QSaveFile file(QString::fromStdString(m_cache_path));
+    if (!file.open(QIODevice::WriteOnly) ||
+        file.write(buffer.data(), buffer.size()) != (qint64)buffer.size() ||
+        !file.commit()
+    ){
+        global_logger_tagged().log("Unable to write sprite cache: " + m_cache_path, COLOR_RED);
+        return false;
+    }
+    return true;
+}
+
+
+
+
+SpriteSheetStore& SpriteSheetStore::instance(){
+    static SpriteSheetStore store;
+    return store;
+}
+std::shared_ptr<const SpriteSheet> SpriteSheetStore::get(const std::string& sprite_path, const std::string& json_path){
+    std::string key = sprite_path + "|" + json_path;
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    auto iter = m_sheets.find(key);
+    if (iter != m_sheets.end()){
+        std::shared_ptr<const SpriteSheet> sheet = iter->second.lock();
+        if (sheet){
+            return sheet;
+        }
+    }
+
+    //  Prune anything that has been released.
+    for (auto it = m_sheets.begin(); it != m_sheets.end();){
+        if (it->second.expired()){
+            it = m_sheets.erase(it);
+        }else{
+            ++it;
+        }
+    }
+
+    std::shared_ptr<const SpriteSheet> sheet = std::make_shared<SpriteSheet>(sprite_path, json_path);
+    m_sheets[key] = sheet;
+    return sheet;
+}
+
+
+
+}
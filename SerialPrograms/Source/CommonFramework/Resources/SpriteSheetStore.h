@@ -0,0 +1,90 @@
+/*  Sprite Sheet Store
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Process-wide store of composite sprite sheets. Every user of the same
+ *  sheet shares one copy of the pixels. A sheet is freed when the last user
+ *  releases it.
+ *
+ *  The first time a sheet is loaded, the PNG is decoded and the json parsed.
+ *  The raw pixels are then written to CACHE_PATH() along with a sorted index
+ *  of the sprites. Subsequent loads memory-map that file instead so loading is
+ *  just a page-in.
+ *
+ */
+
+#ifndef PokemonAutomation_Resources_SpriteSheetStore_H
+#define PokemonAutomation_Resources_SpriteSheetStore_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "Common/Cpp/Containers/Pimpl.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
+
+namespace PokemonAutomation{
+
+
+class SpriteSheet{
+public:
+    struct Entry{
+        std::string slug;
+        ImagePixelBox sprite;   //  Location of the sprite on the sheet.
+        ImagePixelBox icon;     //  Sprite with 0-alpha boundaries cropped. (relative to the sheet)
+    };
+
+public:
+    ~SpriteSheet();
+    SpriteSheet(const std::string& sprite_path, const std::string& json_path);
+
+    //  True if the pixels are backed by the memory-mapped cache file.
+    bool is_mapped() const;
+
+    const ImageViewRGB32& image() const{ return m_image; }
+
+    //  Sorted by slug.
+    const std::vector<Entry>& entries() const{ return m_entries; }
+
+    //  Returns null if not found.
+    const Entry* find(const std::string& slug) const;
+
+
+private:
+    bool load_cache(int64_t png_size, int64_t png_modified, int64_t json_size, int64_t json_modified);
+    void load_source(const std::string& sprite_path, const std::string& json_path);
+    bool write_cache(int64_t png_size, int64_t png_modified, int64_t json_size, int64_t json_modified) const;
+
+
+private:
+    struct MappedFile;
+
+    std::string m_cache_path;
+    Pimpl<MappedFile> m_file;
+    ImageRGB32 m_decoded;   //  Only used if the cache is unavailable.
+    ImageViewRGB32 m_image;
+    std::vector<Entry> m_entries;
+};
+
+
+
+class SpriteSheetStore{
+public:
+    static SpriteSheetStore& instance();
+
+    //  Paths are relative to RESOURCE_PATH().
+    std::shared_ptr<const SpriteSheet> get(const std::string& sprite_path, const std::string& json_path);
+
+private:
+    SpriteSheetStore() = default;
+
+    std::mutex m_lock;
+    std::map<std::string, std::weak_ptr<const SpriteSheet>> m_sheets;
+};
+
+
+
+}
+#endif
@@ -0,0 +1,161 @@
+/*  Async Image Writer
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <QFile>
+#include "Common/Cpp/PanicDump.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "AsyncImageWriter.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+AsyncImageWriter& AsyncImageWriter::instance(){
+    static AsyncImageWriter writer;
+    return writer;
+}
+AsyncImageWriter::AsyncImageWriter() = default;
+AsyncImageWriter::~AsyncImageWriter(){
+    stop();
+}
+void AsyncImageWriter::stop(){
+    //  Don't lose anything that's still queued.
+    {
+        std::unique_lock<std::mutex> lg(m_lock);
+        m_stopping = true;
+        m_cv.notify_all();
+    }
+    if (m_thread.joinable()){
+        m_thread.join();
+    }
+}
+
+
+bool AsyncImageWriter::write(const ImageRGB32& image, const std::vector<std::string>& paths){
+    if (paths.empty()){
+        return true;
+    }
+    if (!image.save(paths[0])){
+        global_logger_tagged().log("Unable to save image to: " + paths[0], COLOR_RED);
+        return false;
+    }
+    bool ok = true;
+    for (size_t c = 1; c < paths.size(); c++){
+        QFile::remove(QString::fromStdString(paths[c]));
+        if (!QFile::copy(QString::fromStdString(paths[0]), QString::fromStdString(paths[c]))){
+            global_logger_tagged().log("Unable to save image to: " + paths[c], COLOR_RED);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+
+std::shared_future<bool> AsyncImageWriter::save(Logger& logger, const ImageViewRGB32& image, std::string path){
+    return save(logger, std::make_shared<const ImageRGB32>(image.copy()), std::move(path));
+}
+std::shared_future<bool> AsyncImageWriter::save(Logger& logger, std::shared_ptr<const ImageRGB32> image, std::string path){
+    if (!image || !*image){
+        logger.log("Unable to save null image to: " + path, COLOR_RED);
+        std::promise<bool> promise;
+        promise.set_value(false);
+        return promise.get_future().share();
+    }
+
+    std::unique_lock<std::mutex> lg(m_lock);
+
+    //  Same frame is already queued. Attach to it.
+    for (std::unique_ptr<Task>& task : m_queue){
+        if (task->image == image){
+            task->paths.emplace_back(path);
+            m_pending[path] = task->future;
+            return task->future;
+        }
+    }
+
+    //  Queue is full or the writer has been stopped. Do it here.
+    if (m_stopping || m_queue.size() >= MAX_QUEUED){
+        bool stopping = m_stopping;
+        lg.unlock();
+        if (!stopping){
+            logger.log("Image write queue is full. Saving synchronously: " + path, COLOR_ORANGE);
+        }
+        std::promise<bool> promise;
+        promise.set_value(write(*image, {path}));
+        return promise.get_future().share();
+    }
+
+    std::unique_ptr<Task> task(new Task);
+    task->image = std::move(image);
+    task->paths.emplace_back(path);
+    task->future = task->promise.get_future().share();
+    std::shared_future<bool> ret = task->future;
+    m_pending[path] = ret;
+    m_queue.emplace_back(std::move(task));
+    m_cv.notify_all();
+
+    //  Lazy create thread.
+    if (!m_thread.joinable()){
+        m_thread = std::thread(run_with_catch, "AsyncImageWriter::thread_loop()", [this]{ thread_loop(); });
+    }
+
+    return ret;
+}
+
+std::shared_future<bool> AsyncImageWriter::pending(const std::string& path){
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        auto iter = m_pending.find(path);
+        if (iter != m_pending.end()){
+            return iter->second;
+        }
+    }
+    std::promise<bool> promise;
+    promise.set_value(true);
+    return promise.get_future().share();
+}
+
+
+void AsyncImageWriter::thread_loop(){
+    while (true){
+        std::unique_ptr<Task> task;
+        {
+            std::unique_lock<std::mutex> lg(m_lock);
+            if (m_queue.empty()){
+                if (m_stopping){
+                    return;
+                }
+                m_cv.wait(lg);
+                continue;
+            }
+            task = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        bool ok = false;
+        try{
+            ok = write(*task->image, task->paths);
+        }catch (...){}
+
+        {
+            std::lock_guard<std::mutex> lg(m_lock);
+            for (const std::string& path : task->paths){
+                m_pending.erase(path);
+            }
+        }
+        task->promise.set_value(ok);
+    }
+}
+
+
+
+
+}
@@ -0,0 +1,91 @@
+/*  Async Image Writer
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Encodes and writes images to disk on a background thread. Encoding a
+ *  full-resolution PNG can take over 100ms which is too long to block a
+ *  program thread in the middle of a button sequence.
+ *
+ *  The queue is bounded. If it is full, the image is encoded on the calling
+ *  thread instead. So a flood of saves slows down the caller rather than
+ *  growing without limit or losing files.
+ *
+ *  Saving the same frame again while it is still queued does not encode it a
+ *  second time. The new path is attached to the queued write and gets a copy
+ *  of the file.
+ *
+ */
+
+#ifndef PokemonAutomation_AsyncImageWriter_H
+#define PokemonAutomation_AsyncImageWriter_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <future>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+namespace PokemonAutomation{
+
+class Logger;
+class ImageViewRGB32;
+class ImageRGB32;
+
+
+class AsyncImageWriter{
+public:
+    static constexpr size_t MAX_QUEUED = 8;
+
+    static AsyncImageWriter& instance();
+    ~AsyncImageWriter();
+
+    //  Save "image" to "path". The format is determined by the extension.
+    //  Returns a future that becomes true once the file is on disk, or false if
+    //  it could not be written.
+    //
+    //  The first overload shares the image. The second makes a copy of it.
+    std::shared_future<bool> save(Logger& logger, std::shared_ptr<const ImageRGB32> image, std::string path);
+    std::shared_future<bool> save(Logger& logger, const ImageViewRGB32& image, std::string path);
+
+    //  If "path" is waiting to be written, return the future for it.
+    //  Otherwise return a future that is already true.
+    std::shared_future<bool> pending(const std::string& path);
+
+    //  Write out everything that is still queued and join the worker.
+    //  Call this at the end of the program. The worker logs, so it must not be
+    //  left running into static destruction. Later saves are done on the
+    //  calling thread.
+    void stop();
+
+
+private:
+    struct Task{
+        std::shared_ptr<const ImageRGB32> image;
+        std::vector<std::string> paths;     //  First is encoded. Rest are copies.
+        std::promise<bool> promise;
+        std::shared_future<bool> future;
+    };
+
+    AsyncImageWriter();
+
+    static bool write(const ImageRGB32& image, const std::vector<std::string>& paths);
+    void thread_loop();
+
+
+private:
+    std::mutex m_lock;
+    std::condition_variable m_cv;
+    std::deque<std::unique_ptr<Task>> m_queue;
+    std::map<std::string, std::shared_future<bool>> m_pending;
+    bool m_stopping = false;
+    std::thread m_thread;
+};
+
+
+
+}
+#endif
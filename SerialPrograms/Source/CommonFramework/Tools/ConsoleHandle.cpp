@@ -4,10 +4,13 @@
  *
  */
 
+#include "Common/Cpp/Color.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/VideoPipeline/VideoOverlay.h"
 #include "CommonFramework/VideoPipeline/Stats/ThreadUtilizationStats.h"
 #include "CommonFramework/InferenceInfra/VisualInferencePivot.h"
 #include "CommonFramework/InferenceInfra/AudioInferencePivot.h"
+#include "CommonFramework/InferenceInfra/InferenceProfiler.h"
 #include "ConsoleHandle.h"
 
 //#include <iostream>
@@ -19,6 +22,19 @@ namespace PokemonAutomation{
 
 ConsoleHandle::ConsoleHandle(ConsoleHandle&& x) = default;
 ConsoleHandle::~ConsoleHandle(){
+    if (m_inference_profiler){
+        for (OverlayStat* stat : m_inference_profiler->overlay_stats()){
+            m_overlay.remove_stat(*stat);
+        }
+        if (GlobalSettings::instance().INFERENCE_PROFILE_CSV){
+            try{
+                std::string path = m_inference_profiler->save_csv(m_logger, "Console" + std::to_string(m_index));
+                if (!path.empty()){
+                    m_logger.log("Saved inference profile to: " + path, COLOR_BLUE);
+                }
+            }catch (...){}
+        }
+    }
     m_overlay.remove_stat(*m_audio_pivot);
     m_overlay.remove_stat(*m_video_pivot);
     m_overlay.remove_stat(*m_thread_utilization);
@@ -46,10 +62,14 @@ ConsoleHandle::ConsoleHandle(
 }
 
 void ConsoleHandle::initialize_inference_threads(CancellableScope& scope, AsyncDispatcher& dispatcher){
-    m_video_pivot = std::make_unique<VisualInferencePivot>(scope, m_video, dispatcher);
-    m_audio_pivot = std::make_unique<AudioInferencePivot>(scope, m_audio, dispatcher);
+    m_inference_profiler = std::make_unique<InferenceProfiler>();
+    m_video_pivot = std::make_unique<VisualInferencePivot>(scope, m_video, dispatcher, m_inference_profiler.get());
+    m_audio_pivot = std::make_unique<AudioInferencePivot>(scope, m_audio, dispatcher, m_inference_profiler.get());
     m_overlay.add_stat(*m_video_pivot);
     m_overlay.add_stat(*m_audio_pivot);
+    for (OverlayStat* stat : m_inference_profiler->overlay_stats()){
+        m_overlay.add_stat(*stat);
+    }
 }
 
 
@@ -20,6 +20,7 @@ class VideoFeed;
 class VideoOverlay;
 class AudioFeed;
 class ThreadUtilizationStat;
+class InferenceProfiler;
 class VisualInferencePivot;
 class AudioInferencePivot;
 
@@ -65,6 +66,7 @@ public:
 
     VisualInferencePivot& video_inference_pivot(){ return *m_video_pivot; }
     AudioInferencePivot& audio_inference_pivot(){ return *m_audio_pivot; }
+    InferenceProfiler& inference_profiler(){ return *m_inference_profiler; }
 
 
 public:
@@ -78,6 +80,7 @@ private:
     VideoOverlay& m_overlay;
     AudioFeed& m_audio;
     std::unique_ptr<ThreadUtilizationStat> m_thread_utilization;
+    std::unique_ptr<InferenceProfiler> m_inference_profiler;
     std::unique_ptr<VisualInferencePivot> m_video_pivot;
     std::unique_ptr<AudioInferencePivot> m_audio_pivot;
 };
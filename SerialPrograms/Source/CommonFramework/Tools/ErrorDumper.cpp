@@ -7,14 +7,17 @@
 #include <mutex>
 #include <QDir>
 #include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/Tracing.h"
 #include "CommonFramework/Exceptions/OperationFailedException.h"
 #include "CommonFramework/Globals.h"
-#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/Notifications/EventNotificationOption.h"
 #include "CommonFramework/Notifications/ProgramInfo.h"
 #include "CommonFramework/Notifications/ProgramNotifications.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "CommonFramework/VideoPipeline/VideoOverlay.h"
+#include "AsyncImageWriter.h"
 #include "ConsoleHandle.h"
 #include "ErrorDumper.h"
 #include "ProgramEnvironment.h"
@@ -22,11 +25,8 @@ namespace PokemonAutomation{
 
 
 
-std::string dump_image_alone(
-    Logger& logger,
-    const ProgramInfo& program_info, const std::string& label,
-    const ImageViewRGB32& image
-){
+namespace{
+std::string make_error_image_name(const std::string& label){
     static std::mutex lock;
     std::lock_guard<std::mutex> lg(lock);
 
@@ -35,8 +35,40 @@ std::string dump_image_alone(
     name += "-";
     name += label;
     name += ".png";
+    return name;
+}
+}
+std::string dump_image_alone(
+    Logger& logger,
+    const ProgramInfo& program_info, const std::string& label,
+    const ImageViewRGB32& image
+){
+    std::string name = make_error_image_name(label);
+    logger.log("Saving failed inference image to: " + name, COLOR_RED);
+    AsyncImageWriter::instance().save(logger, image, name);
+    return name;
+}
+std::string dump_image_alone(
+    Logger& logger,
+    const ProgramInfo& program_info, const std::string& label,
+    std::shared_ptr<const ImageRGB32> image
+){
+    std::string name = make_error_image_name(label);
     logger.log("Saving failed inference image to: " + name, COLOR_RED);
-    image.save(name);
+    AsyncImageWriter::instance().save(logger, std::move(image), name);
+    return name;
+}
+std::string dump_trace(Logger& logger, const std::string& folder, const std::string& label){
+    if (!tracing_enabled()){
+        return "";
+    }
+    QDir().mkpath(QString::fromStdString(folder));
+    std::string name = folder + now_to_filestring() + "-" + label + ".trace.json";
+    if (!save_chrome_trace(name, std::chrono::seconds(GlobalSettings::instance().TRACE_SECONDS))){
+        logger.log("Unable to save trace to: " + name, COLOR_RED);
+        return "";
+    }
+    logger.log("Saved trace to: " + name, COLOR_BLUE);
     return name;
 }
 std::string dump_image(
@@ -8,6 +8,7 @@
 #define PokemonAutomation_ErrorDumper_H
 
 #include <string>
+#include <memory>
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 
 namespace PokemonAutomation{
@@ -15,15 +16,24 @@ namespace PokemonAutomation{
 class ConsoleHandle;
 class EventNotificationOption;
 class ImageViewRGB32;
+class ImageRGB32;
 class Logger;
 class ProgramEnvironment;
 struct ProgramInfo;
 
+// Dump error image to ./ErrorDumps/ folder. The image is written in the
+// background. Return image path.
 std::string dump_image_alone(
     Logger& logger,
     const ProgramInfo& program_info, const std::string& label,
     const ImageViewRGB32& image
 );
+// Same as above, but shares the image instead of copying it.
+std::string dump_image_alone(
+    Logger& logger,
+    const ProgramInfo& program_info, const std::string& label,
+    std::shared_ptr<const ImageRGB32> image
+);
 // Dump error image to ./ErrorDumps/ folder. Also send image as telemetry if user allows.
 // Return image path.
 std::string dump_image(
@@ -32,6 +42,11 @@ std::string dump_image(
     const ImageViewRGB32& image
 );
 
+// If hot path tracing is enabled, save the last GlobalSettings::TRACE_SECONDS
+// of trace zones to "folder" as a Chrome trace. Return the path. Empty if
+// nothing was saved.
+std::string dump_trace(Logger& logger, const std::string& folder, const std::string& label);
+
 #if 0
 // dump a screenshot to ./ErrorDumps/ folder and throw an OperationFailedException.
 // Also send image as telemetry if user allows.
@@ -26,6 +26,8 @@ struct ProgramEnvironmentData{
     AsyncDispatcher m_realtime_dispatcher;
     AsyncDispatcher m_inference_dispatcher;
 
+    std::vector<VideoFeed*> m_video_feeds;
+
     ProgramEnvironmentData(
         const ProgramInfo& program_info
     )
@@ -74,6 +76,14 @@ AsyncDispatcher& ProgramEnvironment::inference_dispatcher(){
 }
 
 
+const std::vector<VideoFeed*>& ProgramEnvironment::video_feeds() const{
+    return m_data->m_video_feeds;
+}
+void ProgramEnvironment::add_video_feed(VideoFeed& feed){
+    m_data->m_video_feeds.emplace_back(&feed);
+}
+
+
 void ProgramEnvironment::update_stats(){
     m_session.report_stats_changed();
 }
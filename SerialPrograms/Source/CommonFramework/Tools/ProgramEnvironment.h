@@ -7,6 +7,7 @@
 #ifndef PokemonAutomation_ProgramEnvironment_H
 #define PokemonAutomation_ProgramEnvironment_H
 
+#include <vector>
 #include "Common/Cpp/Containers/Pimpl.h"
 #include "Common/Cpp/AbstractLogger.h"
 
@@ -14,6 +15,7 @@ namespace PokemonAutomation{
 
 class AsyncDispatcher;
 class StatsTracker;
+class VideoFeed;
 class ProgramSession;
 struct ProgramInfo;
 
@@ -56,6 +58,13 @@ public:
     const StatsTracker* historical_stats() const{ return m_historical_stats; }
     std::string historical_stats_str() const;
 
+public:
+    //  Video feeds of the consoles this program is running on.
+    const std::vector<VideoFeed*>& video_feeds() const;
+
+protected:
+    void add_video_feed(VideoFeed& feed);
+
 
 private:
     ProgramSession& m_session;
@@ -15,6 +15,7 @@
 #include <QVideoSink>
 //#include "Common/Cpp/Exceptions.h"
 //#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Tracing.h"
 #include "CommonFramework/VideoPipeline/CameraOption.h"
 #include "MediaServicesQt6.h"
 #include "CameraWidgetQt6.h"
@@ -92,7 +93,6 @@ CameraSession::CameraSession(Logger& logger, Resolution default_resolution)
     , m_default_resolution(default_resolution)
     , m_resolution(default_resolution)
     , m_last_frame_seqnum(0)
-    , m_last_image_timestamp(WallClock::min())
     , m_stats_conversion("ConvertFrame", "ms", 1000, std::chrono::seconds(10))
 {}
 
@@ -174,6 +174,8 @@ void CameraSession::report_rendered_frame(WallClock timestamp){
 }
 
 VideoSnapshot CameraSession::snapshot(){
+    PA_TRACE_ZONE("CameraSession::snapshot");
+
     //  Prevent multiple concurrent screenshots from entering here.
     std::lock_guard<std::mutex> lg(m_lock);
 
@@ -188,8 +190,8 @@ VideoSnapshot CameraSession::snapshot(){
     {
         SpinLockGuard lg0(m_frame_lock);
         frame_seqnum = m_last_frame_seqnum;
-        if (!m_last_image.isNull() && m_last_image_seqnum == frame_seqnum){
-            return VideoSnapshot(m_last_image, m_last_image_timestamp);
+        if (m_last_snapshot && m_last_image_seqnum == frame_seqnum){
+            return m_last_snapshot;
         }
         frame = m_last_frame;
         frame_timestamp = m_last_frame_timestamp;
@@ -208,14 +210,18 @@ VideoSnapshot CameraSession::snapshot(){
         image = image.convertToFormat(QImage::Format_ARGB32);
     }
 
-    m_last_image = std::move(image);
-    m_last_image_timestamp = frame_timestamp;
-    m_last_image_seqnum = frame_seqnum;
+    //  Keep the snapshot itself, not just the image. Callers that ask again
+    //  for the same frame get the same pixels and the same derived data.
+    //  (see VideoSnapshotCache)
+    VideoSnapshot ret(std::move(image), frame_timestamp);
 
     WallClock time1 = current_time();
     m_stats_conversion.report_data(m_logger, std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count());
 
-    return VideoSnapshot(m_last_image, m_last_image_timestamp);
+    SpinLockGuard lg0(m_frame_lock);
+    m_last_snapshot = ret;
+    m_last_image_seqnum = frame_seqnum;
+    return ret;
 }
 double CameraSession::fps_source(){
     SpinLockGuard lg(m_frame_lock);
@@ -249,8 +255,7 @@ void CameraSession::shutdown(){
     m_last_frame_timestamp = current_time();
     m_last_frame_seqnum++;
 
-    m_last_image = QImage();
-    m_last_image_timestamp = m_last_frame_timestamp;
+    m_last_snapshot.clear();
     m_last_image_seqnum = m_last_frame_seqnum;
 
 }
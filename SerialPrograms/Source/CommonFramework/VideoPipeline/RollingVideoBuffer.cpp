@@ -0,0 +1,420 @@
+/*  Rolling Video Buffer
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <set>
+#include <algorithm>
+#include <QBuffer>
+#include <QImage>
+#include <QFile>
+#include <QDir>
+#include "Common/Cpp/PanicDump.h"
+#include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/Concurrency/FireForgetDispatcher.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "VideoFeed.h"
+#include "RollingVideoBuffer.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+namespace{
+
+std::mutex& registry_lock(){
+    static std::mutex lock;
+    return lock;
+}
+std::set<RollingVideoBuffer*>& registry(){
+    static std::set<RollingVideoBuffer*> buffers;
+    return buffers;
+}
+
+
+//  Minimal MJPEG AVI writer. (RIFF AVI 1.0 with an idx1 index)
+class AviWriter{
+public:
+    void u16(uint16_t x){
+        m_data.append((const char*)&x, sizeof(x));
+    }
+    void u32(uint32_t x){
+        m_data.append((const char*)&x, sizeof(x));
+    }
+    void fourcc(const char* x){
+        m_data.append(x, 4);
+    }
+
+    //  Start a chunk. Returns the position of its size field.
+    size_t begin_chunk(const char* id){
+        fourcc(id);
+        size_t pos = m_data.size();
+        u32(0);
+        return pos;
+    }
+    size_t begin_list(const char* type, const char* id){
+        size_t pos = begin_chunk(type);
+        fourcc(id);
+        return pos;
+    }
+    void end_chunk(size_t pos){
+        uint32_t size = (uint32_t)(m_data.size() - pos - 4);
+        memcpy(&m_data[pos], &size, sizeof(size));
+        if (m_data.size() & 1){
+            m_data += '\0';
+        }
+    }
+
+    std::string& data(){ return m_data; }
+
+private:
+    std::string m_data;
+};
+
+std::string make_mjpeg_avi(const std::vector<RollingVideoBuffer::Frame>& frames){
+    const RollingVideoBuffer::Frame& last = frames.back();
+    uint32_t width = (uint32_t)last.width;
+    uint32_t height = (uint32_t)last.height;
+
+    //  Use the actual capture rate rather than the nominal one.
+    double fps = (double)RollingVideoBuffer::FRAMES_PER_SECOND;
+    if (frames.size() > 1){
+        double seconds = std::chrono::duration<double>(last.timestamp - frames[0].timestamp).count();
+        if (seconds > 0){
+            fps = (frames.size() - 1) / seconds;
+        }
+    }
+    uint32_t rate = (uint32_t)(fps * 1000 + 0.5);
+    if (rate == 0){
+        rate = 1;
+    }
+
+    uint32_t max_frame = 0;
+    for (const RollingVideoBuffer::Frame& frame : frames){
+        max_frame = std::max(max_frame, (uint32_t)frame.jpeg.size());
+    }
+
+    AviWriter avi;
+    size_t riff = avi.begin_list("RIFF", "AVI ");
+
+    size_t hdrl = avi.begin_list("LIST", "hdrl");
+    {
+        size_t avih = avi.begin_chunk("avih");
+        avi.u32((uint32_t)(1000000 / fps));     //  dwMicroSecPerFrame
+        avi.u32((uint32_t)(max_frame * fps));   //  dwMaxBytesPerSec
+        avi.u32(0);                             //  dwPaddingGranularity
+        avi.u32(0x10);                          //  dwFlags = AVIF_HASINDEX
+        avi.u32((uint32_t)frames.size());       //  dwTotalFrames
+        avi.u32(0);                             //  dwInitialFrames
+        avi.u32(1);                             //  dwStreams
+        avi.u32(max_frame);                     //  dwSuggestedBufferSize
+        avi.u32(width);
+        avi.u32(height);
+        avi.u32(0);
+        avi.u32(0);
+        avi.u32(0);
+        avi.u32(0);
+        avi.end_chunk(avih);
+
+        size_t strl = avi.begin_list("LIST", "strl");
+        size_t strh = avi.begin_chunk("strh");
+        avi.fourcc("vids");
+        avi.fourcc("MJPG");
+        avi.u32(0);                             //  dwFlags
+        avi.u16(0);                             //  wPriority
+        avi.u16(0);                             //  wLanguage
+        avi.u32(0);                             //  dwInitialFrames
+        avi.u32(1000);                          //  dwScale
+        avi.u32(rate);                          //  dwRate
+        avi.u32(0);                             //  dwStart
+        avi.u32((uint32_t)frames.size());       //  dwLength
+        avi.u32(max_frame);                     //  dwSuggestedBufferSize
+        avi.u32(0xffffffff);                    //  dwQuality
+        avi.u32(0);                             //  dwSampleSize
+        avi.u16(0);                             //  rcFrame
+        avi.u16(0);
+        avi.u16((uint16_t)width);
+        avi.u16((uint16_t)height);
+        avi.end_chunk(strh);
+
+        size_t strf = avi.begin_chunk("strf");
+        avi.u32(40);                            //  biSize
+        avi.u32(width);
+        avi.u32(height);
+        avi.u16(1);                             //  biPlanes
+        avi.u16(24);                            //  biBitCount
+        avi.fourcc("MJPG");                     //  biCompression
+        avi.u32(width * height * 3);            //  biSizeImage
+        avi.u32(0);
+        avi.u32(0);
+        avi.u32(0);
+        avi.u32(0);
+        avi.end_chunk(strf);
+        avi.end_chunk(strl);
+    }
+    avi.end_chunk(hdrl);
+
+    std::vector<std::pair<uint32_t, uint32_t>> index;
+    size_t movi = avi.begin_list("LIST", "movi");
+    size_t movi_start = movi + 4;
+    for (const RollingVideoBuffer::Frame& frame : frames){
+        index.emplace_back((uint32_t)(avi.data().size() - movi_start), (uint32_t)frame.jpeg.size());
+        size_t chunk = avi.begin_chunk("00dc");
+        avi.data() += frame.jpeg;
+        avi.end_chunk(chunk);
+    }
+    avi.end_chunk(movi);
+
+    size_t idx1 = avi.begin_chunk("idx1");
+    for (const auto& item : index){
+        avi.fourcc("00dc");
+        avi.u32(0x10);                          //  AVIIF_KEYFRAME
+        avi.u32(item.first);
+        avi.u32(item.second);
+    }
+    avi.end_chunk(idx1);
+
+    avi.end_chunk(riff);
+    return std::move(avi.data());
+}
+
+bool write_file(const std::string& path, const std::string& data){
+    QFile file(QString::fromStdString(path));
+    if (!file.open(QIODevice::WriteOnly)){
+        return false;
+    }
+    return file.write(data.data(), data.size()) == (qint64)data.size();
+}
+
+}
+
+
+
+RollingVideoBuffer::RollingVideoBuffer(Logger& logger, VideoFeed& feed, std::string name, size_t seconds)
+    : m_logger(logger)
+    , m_feed(feed)
+    , m_name(std::move(name))
+    , m_duration(seconds * 1000)
+    , m_arena(seconds * BYTES_PER_SECOND)
+{
+    if (seconds == 0){
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lg(registry_lock());
+        registry().insert(this);
+    }
+    m_thread = std::thread(run_with_catch, "RollingVideoBuffer::thread_loop()", [this]{ thread_loop(); });
+}
+RollingVideoBuffer::~RollingVideoBuffer(){
+    {
+        std::lock_guard<std::mutex> lg(registry_lock());
+        registry().erase(this);
+    }
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_stopping = true;
+        m_cv.notify_all();
+    }
+    if (m_thread.joinable()){
+        m_thread.join();
+    }
+}
+
+
+void RollingVideoBuffer::push_frame(WallClock timestamp, size_t width, size_t height, const char* data, size_t bytes){
+    //  Don't let a single frame take more than a quarter of the buffer.
+    if (bytes > m_arena.size() / 4){
+        return;
+    }
+
+    std::lock_guard<std::mutex> lg(m_lock);
+
+    //  Wrap around. Everything past the write pointer is from the previous
+    //  pass and is the oldest.
+    if (m_write + bytes > m_arena.size()){
+        while (!m_entries.empty() && m_entries.front().offset >= m_write){
+            m_entries.pop_front();
+        }
+        m_write = 0;
+    }
+
+    //  Evict whatever is in the way.
+    while (!m_entries.empty()){
+        const Entry& entry = m_entries.front();
+        if (entry.offset >= m_write + bytes || entry.offset + entry.bytes <= m_write){
+            break;
+        }
+        m_entries.pop_front();
+    }
+
+    //  Evict frames that are too old.
+    while (!m_entries.empty() && m_entries.front().timestamp + m_duration < timestamp){
+        m_entries.pop_front();
+    }
+
+    memcpy(m_arena.data() + m_write, data, bytes);
+    m_entries.emplace_back(Entry{timestamp, width, height, m_write, bytes});
+    m_write += bytes;
+}
+std::vector<RollingVideoBuffer::Frame> RollingVideoBuffer::frames() const{
+    std::vector<Frame> ret;
+    std::lock_guard<std::mutex> lg(m_lock);
+    ret.reserve(m_entries.size());
+    for (const Entry& entry : m_entries){
+        ret.emplace_back(Frame{
+            entry.timestamp,
+            entry.width,
+            entry.height,
+            std::string(m_arena.data() + entry.offset, entry.bytes),
+        });
+    }
+    return ret;
+}
+
+
+void RollingVideoBuffer::thread_loop(){
+    GlobalSettings::instance().COMPUTE_PRIORITY0.set_on_this_thread();
+
+    const std::chrono::milliseconds PERIOD(1000 / FRAMES_PER_SECOND);
+    std::shared_ptr<const ImageRGB32> last_frame;
+    WallClock next = current_time();
+    while (true){
+        {
+            std::unique_lock<std::mutex> lg(m_lock);
+            if (m_stopping){
+                return;
+            }
+            m_cv.wait_until(lg, next);
+            if (m_stopping){
+                return;
+            }
+        }
+        next += PERIOD;
+        WallClock now = current_time();
+        if (next < now){
+            next = now;
+        }
+
+        VideoSnapshot snapshot = m_feed.snapshot();
+        if (!snapshot || snapshot.frame == last_frame){
+            continue;
+        }
+        last_frame = snapshot.frame;
+        WallClock timestamp = snapshot.timestamp == WallClock::min() ? now : snapshot.timestamp;
+
+        const ImageRGB32& image = *snapshot.frame;
+        size_t width = std::min(FRAME_WIDTH, image.width());
+        size_t height = (image.height() * width + image.width() / 2) / image.width();
+        if (height == 0){
+            continue;
+        }
+
+        QByteArray jpeg;
+        QBuffer buffer(&jpeg);
+        buffer.open(QIODevice::WriteOnly);
+        QImage scaled = image.scaled_to_QImage(width, height);
+        if (!scaled.save(&buffer, "JPG", JPEG_QUALITY)){
+            continue;
+        }
+
+        push_frame(timestamp, width, height, jpeg.data(), jpeg.size());
+    }
+}
+
+
+std::string RollingVideoBuffer::save_avi(const std::string& folder, const std::string& label) const{
+    std::vector<Frame> frames = this->frames();
+    if (frames.empty()){
+        return "";
+    }
+
+    //  The stream can only have one resolution. Keep the frames that match
+    //  the latest one.
+    size_t width = frames.back().width;
+    size_t height = frames.back().height;
+    frames.erase(
+        std::remove_if(
+            frames.begin(), frames.end(),
+            [=](const Frame& frame){ return frame.width != width || frame.height != height; }
+        ),
+        frames.end()
+    );
+
+    QDir().mkpath(QString::fromStdString(folder));
+    std::string path = folder + now_to_filestring() + "-" + label + "-" + m_name + ".avi";
+    m_logger.log("Saving video clip to: " + path, COLOR_BLUE);
+    global_dispatcher.dispatch([path, frames = std::move(frames)]{
+        if (!write_file(path, make_mjpeg_avi(frames))){
+            global_logger_tagged().log("Unable to save video clip to: " + path, COLOR_RED);
+        }
+    });
+    return path;
+}
+std::string RollingVideoBuffer::save_image_sequence(const std::string& folder, const std::string& label) const{
+    std::vector<Frame> frames = this->frames();
+    if (frames.empty()){
+        return "";
+    }
+
+    std::string path = folder + now_to_filestring() + "-" + label + "-" + m_name + "/";
+    QDir().mkpath(QString::fromStdString(path));
+    m_logger.log("Saving video frames to: " + path, COLOR_BLUE);
+    global_dispatcher.dispatch([path, frames = std::move(frames)]{
+        WallClock start = frames[0].timestamp;
+        for (size_t c = 0; c < frames.size(); c++){
+            int64_t ms = std::chrono::duration_cast<std::chrono::milliseconds>(frames[c].timestamp - start).count();
+            std::string index = std::to_string(c);
+            index = std::string(index.size() < 4 ? 4 - index.size() : 0, '0') + index;
+            std::string name = path + "frame-" + index + "-" + std::to_string(ms) + "ms.jpg";
+            if (!write_file(name, frames[c].jpeg)){
+                global_logger_tagged().log("Unable to save video frame to: " + name, COLOR_RED);
+                return;
+            }
+        }
+    });
+    return path;
+}
+
+
+void RollingVideoBuffer::save_all(
+    Logger& logger, const std::vector<VideoFeed*>& feeds,
+    const std::string& folder, const std::string& label
+){
+    const GlobalSettings& settings = GlobalSettings::instance();
+    if (settings.ROLLING_VIDEO_SECONDS == 0){
+        return;
+    }
+    bool as_images = settings.ROLLING_VIDEO_AS_IMAGES;
+
+    std::string name = label;
+    for (char& ch : name){
+        if (strchr("\\/:*?\"<>|", ch) != nullptr){
+            ch = '_';
+        }
+    }
+
+    std::lock_guard<std::mutex> lg(registry_lock());
+    for (RollingVideoBuffer* buffer : registry()){
+        if (std::find(feeds.begin(), feeds.end(), &buffer->m_feed) == feeds.end()){
+            continue;
+        }
+        if (as_images){
+            buffer->save_image_sequence(folder, name);
+        }else{
+            buffer->save_avi(folder, name);
+        }
+    }
+}
+
+
+
+
+}
@@ -0,0 +1,109 @@
+/*  Rolling Video Buffer
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Keeps the last few seconds of a video feed in memory so that a short
+ *  clip can be saved when something interesting happens. (shiny found, error)
+ *
+ *  Frames are sampled from the feed at a low rate, downscaled and compressed
+ *  to JPEG on a low-priority thread. The compressed frames are stored in a
+ *  preallocated ring so memory usage is fixed regardless of how long the
+ *  program runs. If frames compress poorly, the oldest are evicted sooner and
+ *  the clip is shorter.
+ *
+ *  Clips can be saved as an MJPEG AVI or as a sequence of JPEG images. Either
+ *  way, the frames are written out as they are stored without re-encoding.
+ *
+ */
+
+#ifndef PokemonAutomation_VideoPipeline_RollingVideoBuffer_H
+#define PokemonAutomation_VideoPipeline_RollingVideoBuffer_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "Common/Cpp/Time.h"
+
+namespace PokemonAutomation{
+
+class Logger;
+class VideoFeed;
+
+
+class RollingVideoBuffer{
+public:
+    static constexpr size_t FRAMES_PER_SECOND = 10;
+    static constexpr size_t FRAME_WIDTH = 640;
+    static constexpr int JPEG_QUALITY = 75;
+
+    //  Memory reserved per second of video.
+    static constexpr size_t BYTES_PER_SECOND = FRAMES_PER_SECOND * 64 * 1024;
+
+    struct Frame{
+        WallClock timestamp;
+        size_t width;
+        size_t height;
+        std::string jpeg;
+    };
+
+public:
+    //  "name" is appended to the saved file names to tell consoles apart.
+    RollingVideoBuffer(Logger& logger, VideoFeed& feed, std::string name, size_t seconds);
+    ~RollingVideoBuffer();
+
+    //  Copy out all the frames currently in the buffer. Oldest first.
+    std::vector<Frame> frames() const;
+
+    //  Save the current contents of the buffer. The file is written in the
+    //  background. Returns the path it will be written to, or empty if there
+    //  is nothing to save.
+    std::string save_avi(const std::string& folder, const std::string& label) const;
+    std::string save_image_sequence(const std::string& folder, const std::string& label) const;
+
+    //  Save the buffers of the given feeds using the format in the global
+    //  settings. Feeds without a buffer are skipped. Does nothing if rolling
+    //  video is disabled.
+    static void save_all(
+        Logger& logger, const std::vector<VideoFeed*>& feeds,
+        const std::string& folder, const std::string& label
+    );
+
+
+private:
+    void push_frame(WallClock timestamp, size_t width, size_t height, const char* data, size_t bytes);
+    void thread_loop();
+
+
+private:
+    struct Entry{
+        WallClock timestamp;
+        size_t width;
+        size_t height;
+        size_t offset;
+        size_t bytes;
+    };
+
+    Logger& m_logger;
+    VideoFeed& m_feed;
+    const std::string m_name;
+    const std::chrono::milliseconds m_duration;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_cv;
+    bool m_stopping = false;
+
+    //  Compressed frames in a ring. "m_entries" is oldest first.
+    std::vector<char> m_arena;
+    size_t m_write = 0;
+    std::deque<Entry> m_entries;
+
+    std::thread m_thread;
+};
+
+
+
+}
+#endif
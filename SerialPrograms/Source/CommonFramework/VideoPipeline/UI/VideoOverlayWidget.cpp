@@ -6,6 +6,9 @@
 
 #include <QPainter>
 #include <QResizeEvent>
+#include <QTimer>
+#include <QScreen>
+#include <QGuiApplication>
 #include "CommonFramework/GlobalServices.h"
 #include "VideoOverlayWidget.h"
 
@@ -35,6 +38,7 @@ VideoOverlayWidget::VideoOverlayWidget(QWidget& parent, VideoOverlaySession& ses
     , m_texts(std::make_shared<std::vector<OverlayText>>(session.texts()))
     , m_log(std::make_shared<std::vector<OverlayLogLine>>(session.log_texts()))
     , m_stats(nullptr)
+    , m_repaint_pending(false)
 {
     setAttribute(Qt::WA_NoSystemBackground);
     setAttribute(Qt::WA_TranslucentBackground);
@@ -51,29 +55,38 @@ VideoOverlayWidget::VideoOverlayWidget(QWidget& parent, VideoOverlaySession& ses
 }
 
 void VideoOverlayWidget::enabled_boxes(bool enabled){
-    QMetaObject::invokeMethod(this, [this]{ this->update(); });
+    request_repaint();
 }
 void VideoOverlayWidget::enabled_text(bool enabled){
-    QMetaObject::invokeMethod(this, [this]{ this->update(); });
+    request_repaint();
 }
 void VideoOverlayWidget::enabled_log(bool enabled){
-    QMetaObject::invokeMethod(this, [this]{ this->update(); });
+    request_repaint();
 }
 void VideoOverlayWidget::enabled_stats(bool enabled){
-    QMetaObject::invokeMethod(this, [this]{ this->update(); });
+    request_repaint();
 }
 
 void VideoOverlayWidget::update_boxes(const std::shared_ptr<const std::vector<OverlayBox>>& boxes){
-    SpinLockGuard lg(m_lock, "VideoOverlay::update_boxes()");
-    m_boxes = boxes;
+    {
+        SpinLockGuard lg(m_lock, "VideoOverlay::update_boxes()");
+        m_boxes = boxes;
+    }
+    request_repaint();
 }
 void VideoOverlayWidget::update_text(const std::shared_ptr<const std::vector<OverlayText>>& texts){
-    SpinLockGuard lg(m_lock, "VideoOverlay::update_text()");
-    m_texts = texts;
+    {
+        SpinLockGuard lg(m_lock, "VideoOverlay::update_text()");
+        m_texts = texts;
+    }
+    request_repaint();
 }
 void VideoOverlayWidget::update_log(const std::shared_ptr<const std::vector<OverlayLogLine>>& texts){
-    SpinLockGuard lg(m_lock, "VideoOverlay::update_log_text()");
-    m_log = texts;
+    {
+        SpinLockGuard lg(m_lock, "VideoOverlay::update_log_text()");
+        m_log = texts;
+    }
+    request_repaint();
 }
 #if 0
 void VideoOverlayWidget::update_log_background(const std::shared_ptr<const std::vector<VideoOverlaySession::Box>>& bg_boxes){
@@ -87,13 +100,43 @@ void VideoOverlayWidget::update_stats(const std::list<OverlayStat*>* stats){
 }
 
 void VideoOverlayWidget::on_watchdog_timeout(){
-    QMetaObject::invokeMethod(this, [this]{ this->update(); });
+    //  Stats change without notification. So repaint periodically even if
+    //  nothing else has changed.
+    request_repaint();
 //    static int c = 0;
 //    cout << "VideoOverlayWidget::on_watchdog_timeout(): " << c++ << endl;
 }
 
+void VideoOverlayWidget::request_repaint(){
+    if (m_repaint_pending.exchange(true, std::memory_order_acq_rel)){
+        return;
+    }
+    QMetaObject::invokeMethod(this, [this]{ run_repaint(); });
+}
+void VideoOverlayWidget::run_repaint(){
+    //  Don't repaint faster than the display can show it.
+    double refresh_rate = 60;
+    QScreen* screen = QGuiApplication::primaryScreen();
+    if (screen != nullptr && screen->refreshRate() > 0){
+        refresh_rate = screen->refreshRate();
+    }
+    auto period = std::chrono::microseconds((int64_t)(1000000 / refresh_rate));
+    auto elapsed = std::chrono::steady_clock::now() - m_last_paint;
+    if (elapsed < period){
+        int wait_ms = (int)std::chrono::duration_cast<std::chrono::milliseconds>(period - elapsed).count() + 1;
+        QTimer::singleShot(wait_ms, this, [this]{ run_repaint(); });
+        return;
+    }
+
+    //  Clear the flag first. Any change after this point will schedule
+    //  another repaint.
+    m_repaint_pending.store(false, std::memory_order_release);
+    this->update();
+}
+
 void VideoOverlayWidget::resizeEvent(QResizeEvent* event){}
 void VideoOverlayWidget::paintEvent(QPaintEvent*){
+    m_last_paint = std::chrono::steady_clock::now();
     QPainter painter(this);
 
     {
@@ -8,6 +8,8 @@
 #define PokemonAutomation_VideoPipeline_VideoOverlayWidget_H
 
 #include <map>
+#include <atomic>
+#include <chrono>
 #include <QWidget>
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "Common/Cpp/Concurrency/Watchdog.h"
@@ -48,6 +50,13 @@ private:
     virtual void resizeEvent(QResizeEvent* event) override;
     virtual void paintEvent(QPaintEvent*) override;
 
+private:
+    //  Schedule a repaint. This can be called from any thread. Any number of
+    //  calls before the next repaint result in just one repaint. Repaints are
+    //  also capped to the refresh rate of the display.
+    void request_repaint();
+    void run_repaint();
+
 private:
     void update_boxes(QPainter& painter);
     void update_text (QPainter& painter);
@@ -62,6 +71,9 @@ private:
     std::shared_ptr<const std::vector<OverlayText>> m_texts;
     std::shared_ptr<const std::vector<OverlayLogLine>> m_log;
     const std::list<OverlayStat*>* m_stats;
+
+    std::atomic<bool> m_repaint_pending;
+    std::chrono::steady_clock::time_point m_last_paint;
 };
 
 
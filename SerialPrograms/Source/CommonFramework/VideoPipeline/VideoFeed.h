@@ -8,11 +8,26 @@
 #define PokemonAutomation_VideoFeedInterface_H
 
 #include <memory>
+#include <mutex>
+#include <atomic>
 #include "Common/Cpp/Time.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 
 namespace PokemonAutomation{
 
+class ImageBlockStats;
+
+
+//  Data derived from a snapshot's frame. It is built when it is first needed
+//  and shared by every copy of the snapshot. So callbacks looking at the same
+//  frame only pay for it once.
+struct VideoSnapshotCache{
+    std::atomic<size_t> block_stats_requests{0};
+    std::atomic<bool> block_stats_ready{false};
+    std::once_flag block_stats_built;
+    std::shared_ptr<const ImageBlockStats> block_stats;
+};
+
 
 struct VideoSnapshot{
     //  The frame itself. Null means no snapshot was available.
@@ -22,6 +37,9 @@ struct VideoSnapshot{
     //  This will be as close as possible to when the frame was taken.
     WallClock timestamp = WallClock::min();
 
+    //  See "CommonFramework/ImageTools/ImageBlockStats.h".
+    std::shared_ptr<VideoSnapshotCache> cache;
+
     VideoSnapshot()
          : frame(std::make_shared<const ImageRGB32>())
          , timestamp(WallClock::min())
@@ -29,6 +47,7 @@ struct VideoSnapshot{
     VideoSnapshot(ImageRGB32 p_frame, WallClock p_timestamp)
          : frame(std::make_shared<const ImageRGB32>(std::move(p_frame)))
          , timestamp(p_timestamp)
+         , cache(std::make_shared<VideoSnapshotCache>())
     {}
 
     //  Returns true if the snapshot is valid.
@@ -42,6 +61,7 @@ struct VideoSnapshot{
     void clear(){
         frame.reset();
         timestamp = WallClock::min();
+        cache.reset();
     }
 };
 
@@ -55,6 +55,15 @@ public:
     virtual void add_stat(OverlayStat& stat) = 0;
     virtual void remove_stat(OverlayStat& stat) = 0;
 
+    //  Batch multiple changes into one update. Between these two calls, changes
+    //  are recorded but not pushed to the UI. The commit then publishes one
+    //  snapshot of everything that changed. Transactions may be nested. Only
+    //  the outermost commit publishes.
+    //
+    //  Use `OverlayTransaction` to make sure every begin is paired with a commit.
+    virtual void begin_transaction(){}
+    virtual void commit_transaction(){}
+
 };
 
 
@@ -115,6 +115,30 @@ private:
 
 
 
+// Batches all the overlay changes made during its lifetime into a single update.
+// Use this when adding or removing many items at once so that the UI does not
+// redraw for each of them.
+class OverlayTransaction{
+    OverlayTransaction(const OverlayTransaction&) = delete;
+    void operator=(const OverlayTransaction&) = delete;
+
+public:
+    OverlayTransaction(VideoOverlay& overlay)
+        : m_overlay(overlay)
+    {
+        overlay.begin_transaction();
+    }
+    ~OverlayTransaction(){
+        m_overlay.commit_transaction();
+    }
+
+private:
+    VideoOverlay& m_overlay;
+};
+
+
+
+
 // Used by video inference sessions to manage inference boxes.
 // VideoOverlaySet will be passed to the inference callbacks in a session
 // to store inference boxes. When the session ends, VideoOverlaySet::clear()
@@ -131,6 +155,7 @@ public:
     {}
 
     void clear(){
+        OverlayTransaction transaction(m_overlay);
         m_boxes.clear();
     }
     void add(Color color, const ImageFloatBox& box, std::string label = ""){
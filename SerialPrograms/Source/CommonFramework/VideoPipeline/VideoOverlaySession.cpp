@@ -15,17 +15,17 @@ namespace PokemonAutomation{
 
 
 void VideoOverlaySession::add_listener(Listener& listener){
-    SpinLockGuard lg(m_lock);
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::add_listener()");
     m_listeners.insert(&listener);
 }
 void VideoOverlaySession::remove_listener(Listener& listener){
-    SpinLockGuard lg(m_lock);
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::remove_listener()");
     m_listeners.erase(&listener);
 }
 
 
 VideoOverlaySession::~VideoOverlaySession(){
-    SpinLockGuard lg(m_lock);
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::~VideoOverlaySession()");
     for (Listener* listeners : m_listeners){
         listeners->update_stats(nullptr);
     }
@@ -46,7 +46,7 @@ void VideoOverlaySession::get(VideoOverlayOption& option){
     option.stats.store(stats, std::memory_order_relaxed);
 }
 void VideoOverlaySession::set(const VideoOverlayOption& option){
-    SpinLockGuard lg(m_lock, "VideoOverlaySession::set_enabled_boxes()");
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::set_enabled_boxes()");
     bool boxes = option.boxes.load(std::memory_order_relaxed);
     bool text = option.text.load(std::memory_order_relaxed);
     bool log = option.log.load(std::memory_order_relaxed);
@@ -65,28 +65,28 @@ void VideoOverlaySession::set(const VideoOverlayOption& option){
 
 
 void VideoOverlaySession::set_enabled_boxes(bool enabled){
-    SpinLockGuard lg(m_lock, "VideoOverlaySession::set_enabled_boxes()");
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::set_enabled_boxes()");
     m_option.boxes.store(enabled, std::memory_order_relaxed);
     for (Listener* listeners : m_listeners){
         listeners->enabled_boxes(enabled);
     }
 }
 void VideoOverlaySession::set_enabled_text(bool enabled){
-    SpinLockGuard lg(m_lock, "VideoOverlaySession::set_enabled_text()");
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::set_enabled_text()");
     m_option.text.store(enabled, std::memory_order_relaxed);
     for (Listener* listeners : m_listeners){
         listeners->enabled_text(enabled);
     }
 }
 void VideoOverlaySession::set_enabled_log(bool enabled){
-    SpinLockGuard lg(m_lock, "VideoOverlaySession::set_enabled_log()");
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::set_enabled_log()");
     m_option.log.store(enabled, std::memory_order_relaxed);
     for (Listener* listeners : m_listeners){
         listeners->enabled_log(enabled);
     }
 }
 void VideoOverlaySession::set_enabled_stats(bool enabled){
-    SpinLockGuard lg(m_lock, "VideoOverlaySession::set_enabled_stats()");
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::set_enabled_stats()");
     m_option.stats.store(enabled, std::memory_order_relaxed);
     for (Listener* listeners : m_listeners){
         listeners->enabled_stats(enabled);
@@ -95,18 +95,47 @@ void VideoOverlaySession::set_enabled_stats(bool enabled){
 
 
 
+void VideoOverlaySession::begin_transaction(){
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::begin_transaction()");
+    m_transaction_depth++;
+}
+void VideoOverlaySession::commit_transaction(){
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::commit_transaction()");
+    if (m_transaction_depth == 0 || --m_transaction_depth > 0){
+        return;
+    }
+    if (m_boxes_dirty){
+        m_boxes_dirty = false;
+        push_box_update();
+    }
+    if (m_texts_dirty){
+        m_texts_dirty = false;
+        push_text_update();
+    }
+    if (m_log_dirty){
+        m_log_dirty = false;
+        push_log_text_update();
+    }
+}
+
+
+
 void VideoOverlaySession::add_box(const OverlayBox& box){
-    SpinLockGuard lg(m_lock, "VideoOverlaySession::add_box()");
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::add_box()");
     m_boxes.insert(&box);
     push_box_update();
 }
 void VideoOverlaySession::remove_box(const OverlayBox& box){
-    SpinLockGuard lg(m_lock, "VideoOverlaySession::remove_box()");
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::remove_box()");
     m_boxes.erase(&box);
     push_box_update();
 }
 
 void VideoOverlaySession::push_box_update(){
+    if (m_transaction_depth > 0){
+        m_boxes_dirty = true;
+        return;
+    }
     if (m_listeners.empty()){
         return;
     }
@@ -122,7 +151,7 @@ void VideoOverlaySession::push_box_update(){
 }
 
 std::vector<OverlayBox> VideoOverlaySession::boxes() const{
-    SpinLockGuard lg(m_lock);
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::boxes()");
     std::vector<OverlayBox> ret;
     for (const auto& item : m_boxes){
         ret.emplace_back(*item);
@@ -131,17 +160,21 @@ std::vector<OverlayBox> VideoOverlaySession::boxes() const{
 }
 
 void VideoOverlaySession::add_text(const OverlayText& text){
-    SpinLockGuard lg(m_lock, "VideoOverlaySession::add_text()");
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::add_text()");
     m_texts.insert(&text);
     push_text_update();
 }
 void VideoOverlaySession::remove_text(const OverlayText& text){
-    SpinLockGuard lg(m_lock, "VideoOverlaySession::remove_text()");
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::remove_text()");
     m_texts.erase(&text);
     push_text_update();
 }
 
 void VideoOverlaySession::push_text_update(){
+    if (m_transaction_depth > 0){
+        m_texts_dirty = true;
+        return;
+    }
     if (m_listeners.empty()){
         return;
     }
@@ -157,7 +190,7 @@ void VideoOverlaySession::push_text_update(){
 }
 
 std::vector<OverlayText> VideoOverlaySession::texts() const{
-    SpinLockGuard lg(m_lock);
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::texts()");
     std::vector<OverlayText> ret;
     for (const auto& item : m_texts){
         ret.emplace_back(*item);
@@ -166,7 +199,7 @@ std::vector<OverlayText> VideoOverlaySession::texts() const{
 }
 
 void VideoOverlaySession::add_log(std::string message, Color color){
-    SpinLockGuard lg(m_lock, "VideoOverlaySession::add_log_text()");
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::add_log_text()");
     m_log_texts.emplace_front(color, std::move(message));
 
     if (m_log_texts.size() > LOG_MAX_LINES){
@@ -177,12 +210,16 @@ void VideoOverlaySession::add_log(std::string message, Color color){
 }
 
 void VideoOverlaySession::clear_log(){
-    SpinLockGuard lg(m_lock, "VideoOverlaySession::clear_log_texts()");
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::clear_log_texts()");
     m_log_texts.clear();
     push_log_text_update();
 }
 
 void VideoOverlaySession::push_log_text_update(){
+    if (m_transaction_depth > 0){
+        m_log_dirty = true;
+        return;
+    }
     if (m_listeners.empty()){
         return;
     }
@@ -198,7 +235,7 @@ void VideoOverlaySession::push_log_text_update(){
 }
 
 std::vector<OverlayLogLine> VideoOverlaySession::log_texts() const{
-    SpinLockGuard lg(m_lock);
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::log_texts()");
     std::vector<OverlayLogLine> ret;
     for(const auto& item : m_log_texts){
         ret.emplace_back(item);
@@ -210,7 +247,7 @@ std::vector<OverlayLogLine> VideoOverlaySession::log_texts() const{
 
 
 void VideoOverlaySession::add_stat(OverlayStat& stat){
-    SpinLockGuard lg(m_lock);
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::add_stat()");
     auto map_iter = m_stats.find(&stat);
     if (map_iter != m_stats.end()){
         return;
@@ -237,7 +274,7 @@ void VideoOverlaySession::add_stat(OverlayStat& stat){
     }
 }
 void VideoOverlaySession::remove_stat(OverlayStat& stat){
-    SpinLockGuard lg(m_lock);
+    AdaptiveLockGuard lg(m_lock, "VideoOverlaySession::remove_stat()");
     auto iter = m_stats.find(&stat);
     if (iter == m_stats.end()){
         return;
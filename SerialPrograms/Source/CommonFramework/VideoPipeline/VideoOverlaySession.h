@@ -21,7 +21,7 @@
 #include <deque>
 #include "Common/Compiler.h"
 #include "Common/Cpp/Color.h"
-#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "Common/Cpp/Concurrency/AdaptiveLock.h"
 #include "CommonFramework/ImageTools/ImageBoxes.h"
 #include "VideoOverlay.h"
 #include "VideoOverlayOption.h"
@@ -99,14 +99,20 @@ public:
     virtual void add_stat(OverlayStat& stat) override;
     virtual void remove_stat(OverlayStat& stat) override;
 
+    //  The transaction is shared by all threads. Changes from any thread made
+    //  while a transaction is open are published on the outermost commit.
+    virtual void begin_transaction() override;
+    virtual void commit_transaction() override;
+
 private:
-    //  Push updates to the various listeners.
+    //  Push updates to the various listeners. If a transaction is open, these
+    //  only mark the item type as dirty.
     void push_box_update();
     void push_text_update();
     void push_log_text_update();
 
 private:
-    mutable SpinLock m_lock;
+    mutable AdaptiveLock m_lock;
 
     VideoOverlayOption& m_option;
 
@@ -117,6 +123,11 @@ private:
     std::list<OverlayStat*> m_stats_order;
     std::map<OverlayStat*, std::list<OverlayStat*>::iterator> m_stats;
 
+    size_t m_transaction_depth = 0;
+    bool m_boxes_dirty = false;
+    bool m_texts_dirty = false;
+    bool m_log_dirty = false;
+
     std::set<Listener*> m_listeners;
 };
 
@@ -0,0 +1,291 @@
+/*  Video Replay Feed
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QImage>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Containers/Pimpl.tpp"
+#include "CommonFramework/Logging/Logger.h"
+#include "VideoReplayFeed.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+struct VideoReplayFeed::AviFile{
+    QFile file;
+
+    AviFile(const std::string& path)
+        : file(QString::fromStdString(path))
+    {}
+};
+
+
+namespace{
+
+bool read_fourcc(QFile& file, char id[4]){
+    return file.read(id, 4) == 4;
+}
+bool read_u32(QFile& file, uint32_t& x){
+    return file.read((char*)&x, sizeof(x)) == sizeof(x);
+}
+
+//  Parse the "-123ms" at the end of the file name. Returns -1 if there isn't one.
+int64_t parse_frame_time(const std::string& basename){
+    if (basename.size() < 3 || basename.compare(basename.size() - 2, 2, "ms") != 0){
+        return -1;
+    }
+    size_t end = basename.size() - 2;
+    size_t start = end;
+    while (start > 0 && basename[start - 1] >= '0' && basename[start - 1] <= '9'){
+        start--;
+    }
+    if (start == end || start == 0 || basename[start - 1] != '-'){
+        return -1;
+    }
+    return std::stoll(basename.substr(start, end - start));
+}
+
+}
+
+
+
+VideoReplayFeed::~VideoReplayFeed() = default;
+VideoReplayFeed::VideoReplayFeed(Logger& logger, const std::string& path, bool real_time)
+    : m_logger(logger)
+    , m_path(path)
+    , m_real_time(real_time)
+    , m_start(current_time())
+{
+    QFileInfo info(QString::fromStdString(path));
+    if (info.isDir()){
+        load_images(path);
+    }else{
+        load_avi(path);
+    }
+    if (m_frames.empty()){
+        throw FileException(&m_logger, PA_CURRENT_FUNCTION, "Recording has no frames.", path);
+    }
+    m_logger.log(
+        "Loaded recording: " + path + " (" + std::to_string(m_frames.size()) + " frames, " +
+        std::to_string(duration().count()) + " ms)"
+    );
+}
+
+
+void VideoReplayFeed::load_avi(const std::string& path){
+    m_avi.reset(path);
+    QFile& file = m_avi->file;
+    if (!file.open(QIODevice::ReadOnly)){
+        throw FileException(&m_logger, PA_CURRENT_FUNCTION, "Unable to open file.", path);
+    }
+
+    char id[4];
+    uint32_t size;
+    if (!read_fourcc(file, id) || memcmp(id, "RIFF", 4) != 0 ||
+        !read_u32(file, size) ||
+        !read_fourcc(file, id) || memcmp(id, "AVI ", 4) != 0
+    ){
+        throw FileException(&m_logger, PA_CURRENT_FUNCTION, "Not an AVI file.", path);
+    }
+
+    //  If the recording was cut off, the RIFF size may be wrong.
+    uint64_t end = std::min<uint64_t>((uint64_t)size + 8, (uint64_t)file.size());
+
+    uint32_t usec_per_frame = 0;
+    bool mjpeg = false;
+    std::vector<std::pair<uint64_t, uint32_t>> chunks;
+
+    //  Walk the chunks. Step into the lists that matter and skip everything else.
+    uint64_t pos = 12;
+    while (pos + 8 <= end){
+        if (!file.seek(pos) || !read_fourcc(file, id) || !read_u32(file, size)){
+            break;
+        }
+        uint64_t data = pos + 8;
+        uint64_t next = data + size + (size & 1);
+
+        if (memcmp(id, "LIST", 4) == 0){
+            char type[4];
+            if (!read_fourcc(file, type)){
+                break;
+            }
+            if (memcmp(type, "hdrl", 4) == 0 || memcmp(type, "strl", 4) == 0 ||
+                memcmp(type, "movi", 4) == 0 || memcmp(type, "rec ", 4) == 0
+            ){
+                pos = data + 4;
+                continue;
+            }
+        }else if (memcmp(id, "avih", 4) == 0){
+            read_u32(file, usec_per_frame);
+        }else if (memcmp(id, "strf", 4) == 0 && size >= 20){
+            //  BITMAPINFOHEADER::biCompression
+            char compression[4];
+            if (file.seek(data + 16) && read_fourcc(file, compression)){
+                mjpeg |= memcmp(compression, "MJPG", 4) == 0 || memcmp(compression, "mjpg", 4) == 0;
+            }
+        }else if (id[2] == 'd' && (id[3] == 'c' || id[3] == 'b')){
+            //  Empty chunks are dropped frames. Hold the previous one.
+            if (size > 0 && data + size <= end){
+                chunks.emplace_back(data, size);
+            }
+        }
+
+        pos = next;
+    }
+
+    if (!mjpeg){
+        throw FileException(&m_logger, PA_CURRENT_FUNCTION, "Only MJPEG AVI files are supported.", path);
+    }
+
+    double frame_ms = usec_per_frame > 0 ? usec_per_frame / 1000. : 1000. / DEFAULT_FPS;
+    m_frames.reserve(chunks.size());
+    for (size_t c = 0; c < chunks.size(); c++){
+        m_frames.emplace_back(Frame{
+            std::chrono::milliseconds((int64_t)(c * frame_ms + 0.5)),
+            "",
+            chunks[c].first,
+            chunks[c].second,
+        });
+    }
+}
+void VideoReplayFeed::load_images(const std::string& path){
+    QDir dir(QString::fromStdString(path));
+    QFileInfoList files = dir.entryInfoList(
+        {"*.png", "*.jpg", "*.jpeg", "*.bmp"},
+        QDir::Files, QDir::Name
+    );
+
+    bool have_times = true;
+    for (const QFileInfo& file : files){
+        int64_t ms = parse_frame_time(file.completeBaseName().toStdString());
+        have_times &= ms >= 0;
+        m_frames.emplace_back(Frame{
+            std::chrono::milliseconds(ms),
+            file.filePath().toStdString(),
+            0, 0,
+        });
+    }
+
+    if (!have_times){
+        m_logger.log("Image names have no timestamps. Assuming " + std::to_string((int)DEFAULT_FPS) + " fps.", COLOR_ORANGE);
+        for (size_t c = 0; c < m_frames.size(); c++){
+            m_frames[c].time = std::chrono::milliseconds((int64_t)(c * 1000 / DEFAULT_FPS));
+        }
+        return;
+    }
+
+    //  File names may not be zero-padded.
+    std::stable_sort(
+        m_frames.begin(), m_frames.end(),
+        [](const Frame& x, const Frame& y){
+            return x.time < y.time;
+        }
+    );
+}
+
+
+std::chrono::milliseconds VideoReplayFeed::duration() const{
+    //  Include the display time of the last frame.
+    std::chrono::milliseconds last = m_frames.back().time;
+    if (m_frames.size() < 2){
+        return last + std::chrono::milliseconds((int64_t)(1000 / DEFAULT_FPS));
+    }
+    return last + last / (int64_t)(m_frames.size() - 1);
+}
+WallClock VideoReplayFeed::start_time() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_start;
+}
+void VideoReplayFeed::seek(size_t index){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_position = index;
+}
+bool VideoReplayFeed::finished() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (m_real_time){
+        return current_time() - m_start >= duration();
+    }
+    return m_position >= m_frames.size();
+}
+
+
+void VideoReplayFeed::reset(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_start = current_time();
+    m_position = 0;
+    m_cached_index = (size_t)-1;
+}
+size_t VideoReplayFeed::current_index() const{
+    if (!m_real_time){
+        return std::min(m_position, m_frames.size() - 1);
+    }
+    std::chrono::milliseconds elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(current_time() - m_start);
+    auto iter = std::upper_bound(
+        m_frames.begin(), m_frames.end(), elapsed,
+        [](std::chrono::milliseconds time, const Frame& frame){
+            return time < frame.time;
+        }
+    );
+    return iter == m_frames.begin() ? 0 : iter - m_frames.begin() - 1;
+}
+VideoSnapshot VideoReplayFeed::snapshot(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    size_t index = current_index();
+    if (index != m_cached_index){
+        m_cached = decode(index);
+        m_cached_index = index;
+    }
+    return m_cached;
+}
+VideoSnapshot VideoReplayFeed::decode(size_t index){
+    const Frame& frame = m_frames[index];
+    WallClock timestamp = m_start + frame.time;
+
+    if (!m_avi){
+        return VideoSnapshot(ImageRGB32(frame.path), timestamp);
+    }
+
+    QFile& file = m_avi->file;
+    QByteArray data;
+    if (file.seek(frame.offset)){
+        data = file.read(frame.bytes);
+    }
+    QImage image = QImage::fromData(data, "JPG");
+    if (image.isNull()){
+        m_logger.log("Unable to decode frame " + std::to_string(index) + " of: " + m_path, COLOR_RED);
+        return VideoSnapshot();
+    }
+    if (image.format() != QImage::Format_RGB32 && image.format() != QImage::Format_ARGB32){
+        image = image.convertToFormat(QImage::Format_ARGB32);
+    }
+    return VideoSnapshot(ImageRGB32(std::move(image)), timestamp);
+}
+
+
+double VideoReplayFeed::fps_source(){
+    if (m_frames.size() < 2){
+        return DEFAULT_FPS;
+    }
+    double seconds = std::chrono::duration<double>(m_frames.back().time).count();
+    return seconds > 0 ? (m_frames.size() - 1) / seconds : DEFAULT_FPS;
+}
+double VideoReplayFeed::fps_display(){
+    return fps_source();
+}
+
+
+
+
+}
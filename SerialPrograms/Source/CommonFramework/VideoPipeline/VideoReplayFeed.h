@@ -0,0 +1,115 @@
+/*  Video Replay Feed
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A video feed that plays back a recording instead of a live camera.
+ *  Used to run visual inference offline for benchmarking and regression tests.
+ *
+ *  Two kinds of recordings are supported:
+ *
+ *  -   MJPEG AVI files. (as saved by RollingVideoBuffer)
+ *  -   A folder of images. The frames are played in file name order. If the
+ *      file names end with "-<number>ms" (as saved by RollingVideoBuffer),
+ *      that is used as the frame time. Otherwise the frames are spaced evenly
+ *      at DEFAULT_FPS.
+ *
+ *  In real-time mode, "snapshot()" returns whichever frame is current based on
+ *  the time since "reset()". In manual mode, it returns the frame at the
+ *  cursor and the caller steps through the video with "seek()" as fast as it
+ *  wants.
+ *
+ *  Either way, the timestamps of the snapshots are in video time. They start
+ *  at "start_time()" and advance by the spacing of the frames in the file.
+ *
+ */
+
+#ifndef PokemonAutomation_VideoPipeline_VideoReplayFeed_H
+#define PokemonAutomation_VideoPipeline_VideoReplayFeed_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include "Common/Cpp/Containers/Pimpl.h"
+#include "VideoFeed.h"
+
+namespace PokemonAutomation{
+
+class Logger;
+
+
+class VideoReplayFeed : public VideoFeed{
+public:
+    static constexpr double DEFAULT_FPS = 10;
+
+    //  "path" is either an AVI file or a folder of images.
+    //  Throws FileException if it cannot be read.
+    VideoReplayFeed(Logger& logger, const std::string& path, bool real_time);
+    ~VideoReplayFeed();
+
+    const std::string& path() const{ return m_path; }
+    bool real_time() const{ return m_real_time; }
+
+    size_t frame_count() const{ return m_frames.size(); }
+
+    //  Time of a frame relative to the start of the video.
+    std::chrono::milliseconds frame_time(size_t index) const{ return m_frames[index].time; }
+    std::chrono::milliseconds duration() const;
+
+    //  The timestamp of the first frame.
+    WallClock start_time() const;
+
+    //  Manual mode only. Move the cursor to "index".
+    void seek(size_t index);
+
+    //  Returns true if playback has gone past the last frame.
+    bool finished() const;
+
+
+public:
+    //  Restart playback from the first frame.
+    virtual void reset() override;
+
+    virtual VideoSnapshot snapshot() override;
+
+    //  Both are the average frame rate of the recording.
+    virtual double fps_source() override;
+    virtual double fps_display() override;
+
+
+private:
+    struct AviFile;
+    struct Frame{
+        std::chrono::milliseconds time;
+        std::string path;       //  Image sequence: The image file.
+        uint64_t offset;        //  AVI: Position of the JPEG in the file.
+        uint32_t bytes;
+    };
+
+    void load_avi(const std::string& path);
+    void load_images(const std::string& path);
+
+    size_t current_index() const;
+    VideoSnapshot decode(size_t index);
+
+
+private:
+    Logger& m_logger;
+    const std::string m_path;
+    const bool m_real_time;
+
+    std::vector<Frame> m_frames;
+    Pimpl<AviFile> m_avi;
+
+    mutable std::mutex m_lock;
+    WallClock m_start;
+    size_t m_position = 0;
+
+    //  The most recently decoded frame.
+    size_t m_cached_index = (size_t)-1;
+    VideoSnapshot m_cached;
+};
+
+
+
+}
+#endif
@@ -18,6 +18,10 @@ void fft_abs_Default(int k, float* abs, float* real);
 void fft_abs_x86_SSE41(int k, float* abs, float* real);
 void fft_abs_x86_AVX2(int k, float* abs, float* real);
 
+void fft_abs_Default(int k, float* abs, const float* const quarters[4], float* scratch);
+void fft_abs_x86_SSE41(int k, float* abs, const float* const quarters[4], float* scratch);
+void fft_abs_x86_AVX2(int k, float* abs, const float* const quarters[4], float* scratch);
+
 
 void fft_abs(int k, float* abs, float* real){
     if (k <= 0){
@@ -44,6 +48,36 @@ void fft_abs(int k, float* abs, float* real){
 #endif
     fft_abs_Default(k, abs, real);
 }
+void fft_abs(int k, float* abs, const float* const quarters[4], float* scratch){
+    if (k <= 1){
+        throw "FFT length must be at least 2^2.";
+    }
+    if ((size_t)abs & 63){
+        throw "abs must be aligned to 64 bytes.";
+    }
+    if ((size_t)scratch & 63){
+        throw "scratch must be aligned to 64 bytes.";
+    }
+    for (size_t c = 0; c < 4; c++){
+        if ((size_t)quarters[c] & 63){
+            throw "Input must be aligned to 64 bytes.";
+        }
+    }
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        fft_abs_x86_AVX2(k, abs, quarters, scratch);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        fft_abs_x86_SSE41(k, abs, quarters, scratch);
+        return;
+    }
+#endif
+    fft_abs_Default(k, abs, quarters, scratch);
+}
 
 
 
@@ -25,6 +25,19 @@ namespace AbsFFT{
 //
 void fft_abs(int k, float* abs, float* real);
 
+//
+//  Same as above, but the input is not modified.
+//
+//    - The input is given as its 4 consecutive quarters, each of length
+//      2^(k-2). They do not need to be contiguous with each other.
+//      (e.g. a window into a ring buffer)
+//    - "scratch" is workspace of length 2^k.
+//    - "abs", "scratch" and all the quarters must be aligned to 64 bytes.
+//
+//  This avoids copying the input into a temporary buffer first.
+//
+void fft_abs(int k, float* abs, const float* const quarters[4], float* scratch);
+
 
 
 }
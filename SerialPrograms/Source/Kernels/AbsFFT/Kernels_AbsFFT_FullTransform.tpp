@@ -4,6 +4,7 @@
  *
  */
 
+#include <string.h>
 #include <cmath>
 #include "Kernels_AbsFFT_BitReverse.h"
 #include "Kernels_AbsFFT_ComplexToAbs.h"
@@ -97,20 +98,13 @@ void fft_abs_scalar(const TwiddleTable<Context>& table, int k, float* abs, float
 }
 
 
+//  Everything after the initial split-radix reduction.
 template <typename Context>
-void fft_abs(const TwiddleTable<Context>& table, int k, float* abs, float* real){
+void fft_abs_reduced(const TwiddleTable<Context>& table, int k, float* abs, float* real){
     using vtype = typename Context::vtype;
 
-    if (k - 2 < Context::BASE_COMPLEX_TRANSFORM_K){
-        fft_abs_scalar<Context>(table, k, abs, real);
-        return;
-    }
-
     size_t block = (size_t)1 << (k - 2);
 
-    //  Initial split-radix reduction.
-    Reductions<Context>::fft_real_split_reduce(table, k, (vtype*)real, (vtype*)abs);
-
     //  Transform complex upper-half.
     fft_complex_tk(table, k - 2, (vtype*)abs);
 
@@ -130,6 +124,48 @@ void fft_abs(const TwiddleTable<Context>& table, int k, float* abs, float* real)
     BitReverse<Context>::interleave_f32(k - 1, abs, real);
 }
 
+template <typename Context>
+void fft_abs(const TwiddleTable<Context>& table, int k, float* abs, float* real){
+    using vtype = typename Context::vtype;
+
+    if (k - 2 < Context::BASE_COMPLEX_TRANSFORM_K){
+        fft_abs_scalar<Context>(table, k, abs, real);
+        return;
+    }
+
+    //  Initial split-radix reduction.
+    Reductions<Context>::fft_real_split_reduce(table, k, (vtype*)real, (vtype*)abs);
+
+    fft_abs_reduced(table, k, abs, real);
+}
+
+template <typename Context>
+void fft_abs(const TwiddleTable<Context>& table, int k, float* abs, const float* const quarters[4], float* scratch){
+    using vtype = typename Context::vtype;
+
+    size_t block = (size_t)1 << (k - 2);
+
+    if (k - 2 < Context::BASE_COMPLEX_TRANSFORM_K){
+        for (size_t c = 0; c < 4; c++){
+            memcpy(scratch + c*block, quarters[c], block * sizeof(float));
+        }
+        fft_abs_scalar<Context>(table, k, abs, scratch);
+        return;
+    }
+
+    //  Initial split-radix reduction. This is the only pass that reads the
+    //  input. Everything after works in "scratch".
+    const vtype* vquarters[4] = {
+        (const vtype*)quarters[0],
+        (const vtype*)quarters[1],
+        (const vtype*)quarters[2],
+        (const vtype*)quarters[3],
+    };
+    Reductions<Context>::fft_real_split_reduce(table, k, (vtype*)scratch, vquarters, (vtype*)abs);
+
+    fft_abs_reduced(table, k, abs, scratch);
+}
+
 
 
 
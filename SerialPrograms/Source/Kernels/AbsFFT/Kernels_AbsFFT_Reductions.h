@@ -46,17 +46,36 @@ static PA_FORCE_INLINE void fft_real_split_reduce_scalar(const TwiddleTable<Cont
 
 static PA_FORCE_INLINE void fft_real_split_reduce(const TwiddleTable<Context>& table, int k, vtype* real, vtype* upper_complex){
     size_t vstride = (size_t)1 << (k - 2 - Context::VECTOR_K);
+    const vtype* quarters[4] = {
+        real + 0*vstride,
+        real + 1*vstride,
+        real + 2*vstride,
+        real + 3*vstride,
+    };
+    fft_real_split_reduce(table, k, real, quarters, upper_complex);
+}
+
+//  Same as above, but read the input from 4 separate quarters instead of from
+//  "real". Only the lower half of "real" is written. The quarters may alias
+//  "real" as long as they are in order.
+static PA_FORCE_INLINE void fft_real_split_reduce(
+    const TwiddleTable<Context>& table, int k,
+    vtype* real, const vtype* const quarters[4], vtype* upper_complex
+){
+    size_t vstride = (size_t)1 << (k - 2 - Context::VECTOR_K);
+    const vtype* Q0 = quarters[0];
+    const vtype* Q1 = quarters[1];
+    const vtype* Q2 = quarters[2];
+    const vtype* Q3 = quarters[3];
     vtype* R0 = real;
     vtype* R1 = R0 + vstride;
-    vtype* R2 = R1 + vstride;
-    vtype* R3 = R2 + vstride;
     const vcomplex<Context>* w = table[k].w1.data();
     size_t lc = vstride;
     do{
-        vtype r0 = R0[0];
-        vtype r1 = R1[0];
-        vtype r2 = R2[0];
-        vtype r3 = R3[0];
+        vtype r0 = Q0[0];
+        vtype r1 = Q1[0];
+        vtype r2 = Q2[0];
+        vtype r3 = Q3[0];
 
         R0[0] = Context::vadd(r0, r2);
         R1[0] = Context::vadd(r1, r3);
@@ -68,10 +87,12 @@ static PA_FORCE_INLINE void fft_real_split_reduce(const TwiddleTable<Context>& t
         upper_complex[0] = r0;
         upper_complex[1] = r1;
 
+        Q0++;
+        Q1++;
+        Q2++;
+        Q3++;
         R0++;
         R1++;
-        R2++;
-        R3++;
         upper_complex += 2;
         w++;
     }while (--lc);
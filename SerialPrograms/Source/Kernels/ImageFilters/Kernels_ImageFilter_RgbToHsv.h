@@ -0,0 +1,36 @@
+/*  Image Filter RGB to HSV
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Convert RGB32 pixels to HSV32.
+ *
+ *  The output uses the same layout as ImageHSV32:
+ *      Bits 24-31: Alpha   (copied from the input)
+ *      Bits 16-23: Hue     (0 - 255 maps to 0 - 360 degrees)
+ *      Bits  8-15: Saturation
+ *      Bits  0- 7: Value
+ *
+ *  Every implementation gives bit-identical results.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageFilter_RgbToHsv_H
+#define PokemonAutomation_Kernels_ImageFilter_RgbToHsv_H
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void convert_rgb32_to_hsv32(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+);
+
+
+
+}
+}
+#endif
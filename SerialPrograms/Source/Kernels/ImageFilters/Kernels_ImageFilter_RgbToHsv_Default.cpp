@@ -0,0 +1,58 @@
+/*  Image Filter RGB to HSV (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include "Kernels_ImageFilter_RgbToHsv_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+class RgbToHsv_Default{
+public:
+    static const size_t VECTOR_SIZE = 1;
+
+    static PA_FORCE_INLINE void convert(uint32_t* out, const uint32_t* in){
+        uint32_t pixel = in[0];
+        int r = (pixel >> 16) & 0xff;
+        int g = (pixel >> 8) & 0xff;
+        int b = pixel & 0xff;
+
+        int M = std::max(std::max(r, g), b);
+        int m = std::min(std::min(r, g), b);
+        int d = M - m;
+
+        int S = M == 0 ? 0 : 255 - (m*255 + M/2) / M;
+
+        int n;
+        if (M == r){
+            n = g - b;
+        }else if (M == g){
+            n = b - r + 2*d;
+        }else{
+            n = r - g + 4*d;
+        }
+        int H = std::max((256*n + 3*d) / (6*std::max(d, 1)), 0);
+
+        out[0] = (pixel & 0xff000000) | ((uint32_t)H << 16) | ((uint32_t)S << 8) | (uint32_t)M;
+    }
+};
+
+
+void convert_rgb32_to_hsv32_Default(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    convert_rgb32_to_hsv32<RgbToHsv_Default>(
+        in, in_bytes_per_row, width, height,
+        out, out_bytes_per_row
+    );
+}
+
+
+
+}
+}
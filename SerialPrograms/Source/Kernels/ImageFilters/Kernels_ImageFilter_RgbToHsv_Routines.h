@@ -0,0 +1,79 @@
+/*  Image Filter RGB to HSV Routines
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageFilter_RgbToHsv_Routines_H
+#define PokemonAutomation_Kernels_ImageFilter_RgbToHsv_Routines_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  All the implementations compute the following with exact integer results:
+//
+//      M = max(r, g, b)
+//      m = min(r, g, b)
+//      d = M - m
+//
+//      V = M
+//      S = M == 0 ? 0 : 255 - (m*255 + M/2) / M
+//
+//      n = M == r ? g - b
+//        : M == g ? b - r + 2*d
+//        :          r - g + 4*d
+//      H = max((256*n + 3*d) / (6*max(d, 1)), 0)
+//
+//  Both divisions have integer operands less than 2^24 and quotients that are
+//  at least 1/1530 away from the next integer unless they are exact. So they
+//  can be done in single-precision float with truncation.
+//
+//  The results are identical to the original floating-point formulation:
+//      H = max(int(Hf * 256/6 + 0.5) % 256, 0) with Hf in [-1, 5]
+//  including the clamping of negative hues (red with b > g) to zero.
+
+
+//  Converter interface:
+//  - static size_t Converter::VECTOR_SIZE, how many pixels in an SIMD vector.
+//  - Converter::convert(uint32_t* out, const uint32_t* in), convert a full vector.
+template <typename Converter>
+PA_FORCE_INLINE void convert_rgb32_to_hsv32(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    if (width == 0 || height == 0){
+        return;
+    }
+    const size_t VECTOR_SIZE = Converter::VECTOR_SIZE;
+    do{
+        const uint32_t* i0 = in;
+        uint32_t* o0 = out;
+        size_t lc = width / VECTOR_SIZE;
+        while (lc--){
+            Converter::convert(o0, i0);
+            i0 += VECTOR_SIZE;
+            o0 += VECTOR_SIZE;
+        }
+        size_t left = width % VECTOR_SIZE;
+        if (left != 0){
+            uint32_t buffer[VECTOR_SIZE] = {};
+            memcpy(buffer, i0, left * sizeof(uint32_t));
+            Converter::convert(buffer, buffer);
+            memcpy(o0, buffer, left * sizeof(uint32_t));
+        }
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }while (--height);
+}
+
+
+
+}
+}
+#endif
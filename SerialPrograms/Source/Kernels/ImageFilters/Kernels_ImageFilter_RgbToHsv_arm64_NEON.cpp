@@ -0,0 +1,84 @@
+/*  Image Filter RGB to HSV (arm64 NEON)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_arm64_20_M1
+
+#include <arm_neon.h>
+#include "Kernels_ImageFilter_RgbToHsv_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+class RgbToHsv_arm64_NEON{
+public:
+    static const size_t VECTOR_SIZE = 4;
+
+    static PA_FORCE_INLINE void convert(uint32_t* out, const uint32_t* in){
+        uint32x4_t pixel = vld1q_u32(in);
+        vst1q_u32(out, process_word(pixel));
+    }
+
+private:
+    static PA_FORCE_INLINE int32x4_t divide(int32x4_t num, int32x4_t den){
+        //  vcvtq_s32_f32() rounds towards zero.
+        return vcvtq_s32_f32(vdivq_f32(vcvtq_f32_s32(num), vcvtq_f32_s32(den)));
+    }
+    static PA_FORCE_INLINE uint32x4_t process_word(uint32x4_t pixel){
+        const uint32x4_t byte_u32 = vdupq_n_u32(0xff);
+        const int32x4_t byte = vdupq_n_s32(0xff);
+        const int32x4_t one = vdupq_n_s32(1);
+        const int32x4_t zero = vdupq_n_s32(0);
+
+        int32x4_t r = vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(pixel, 16), byte_u32));
+        int32x4_t g = vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(pixel, 8), byte_u32));
+        int32x4_t b = vreinterpretq_s32_u32(vandq_u32(pixel, byte_u32));
+
+        int32x4_t M = vmaxq_s32(vmaxq_s32(r, g), b);
+        int32x4_t m = vminq_s32(vminq_s32(r, g), b);
+        int32x4_t d = vsubq_s32(M, m);
+
+        //  S = 255 - (m*255 + M/2) / M
+        int32x4_t num = vaddq_s32(vmulq_n_s32(m, 255), vshrq_n_s32(M, 1));
+        int32x4_t S = vsubq_s32(byte, divide(num, vmaxq_s32(M, one)));
+        S = vbslq_s32(vceqq_s32(M, zero), zero, S);
+
+        //  Hue offset within the sector of the max channel.
+        int32x4_t n_r = vsubq_s32(g, b);
+        int32x4_t n_g = vaddq_s32(vsubq_s32(b, r), vshlq_n_s32(d, 1));
+        int32x4_t n_b = vaddq_s32(vsubq_s32(r, g), vshlq_n_s32(d, 2));
+        int32x4_t n = vbslq_s32(vceqq_s32(M, g), n_g, n_b);
+        n = vbslq_s32(vceqq_s32(M, r), n_r, n);
+
+        //  H = max((256*n + 3*d) / (6*d), 0)
+        num = vaddq_s32(vshlq_n_s32(n, 8), vmulq_n_s32(d, 3));
+        int32x4_t den = vmulq_n_s32(vmaxq_s32(d, one), 6);
+        int32x4_t H = vmaxq_s32(divide(num, den), zero);
+
+        uint32x4_t out = vandq_u32(pixel, vdupq_n_u32(0xff000000));
+        out = vorrq_u32(out, vshlq_n_u32(vreinterpretq_u32_s32(H), 16));
+        out = vorrq_u32(out, vshlq_n_u32(vreinterpretq_u32_s32(S), 8));
+        out = vorrq_u32(out, vreinterpretq_u32_s32(M));
+        return out;
+    }
+};
+
+
+void convert_rgb32_to_hsv32_arm64_NEON(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    convert_rgb32_to_hsv32<RgbToHsv_arm64_NEON>(
+        in, in_bytes_per_row, width, height,
+        out, out_bytes_per_row
+    );
+}
+
+
+
+}
+}
+#endif
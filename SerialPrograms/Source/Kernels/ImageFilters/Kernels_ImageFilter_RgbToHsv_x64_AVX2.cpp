@@ -0,0 +1,82 @@
+/*  Image Filter RGB to HSV (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <immintrin.h>
+#include "Kernels_ImageFilter_RgbToHsv_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+class RgbToHsv_x64_AVX2{
+public:
+    static const size_t VECTOR_SIZE = 8;
+
+    static PA_FORCE_INLINE void convert(uint32_t* out, const uint32_t* in){
+        __m256i pixel = _mm256_loadu_si256((const __m256i*)in);
+        _mm256_storeu_si256((__m256i*)out, process_word(pixel));
+    }
+
+private:
+    static PA_FORCE_INLINE __m256i divide(__m256i num, __m256i den){
+        return _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(num), _mm256_cvtepi32_ps(den)));
+    }
+    static PA_FORCE_INLINE __m256i process_word(__m256i pixel){
+        const __m256i byte = _mm256_set1_epi32(0xff);
+        const __m256i one = _mm256_set1_epi32(1);
+        const __m256i zero = _mm256_setzero_si256();
+
+        __m256i r = _mm256_and_si256(_mm256_srli_epi32(pixel, 16), byte);
+        __m256i g = _mm256_and_si256(_mm256_srli_epi32(pixel, 8), byte);
+        __m256i b = _mm256_and_si256(pixel, byte);
+
+        __m256i M = _mm256_max_epi32(_mm256_max_epi32(r, g), b);
+        __m256i m = _mm256_min_epi32(_mm256_min_epi32(r, g), b);
+        __m256i d = _mm256_sub_epi32(M, m);
+
+        //  S = 255 - (m*255 + M/2) / M
+        __m256i num = _mm256_add_epi32(_mm256_sub_epi32(_mm256_slli_epi32(m, 8), m), _mm256_srli_epi32(M, 1));
+        __m256i S = _mm256_sub_epi32(byte, divide(num, _mm256_max_epi32(M, one)));
+        S = _mm256_andnot_si256(_mm256_cmpeq_epi32(M, zero), S);
+
+        //  Hue offset within the sector of the max channel.
+        __m256i n_r = _mm256_sub_epi32(g, b);
+        __m256i n_g = _mm256_add_epi32(_mm256_sub_epi32(b, r), _mm256_add_epi32(d, d));
+        __m256i n_b = _mm256_add_epi32(_mm256_sub_epi32(r, g), _mm256_slli_epi32(d, 2));
+        __m256i n = _mm256_blendv_epi8(n_b, n_g, _mm256_cmpeq_epi32(M, g));
+        n = _mm256_blendv_epi8(n, n_r, _mm256_cmpeq_epi32(M, r));
+
+        //  H = max((256*n + 3*d) / (6*d), 0)
+        num = _mm256_add_epi32(_mm256_slli_epi32(n, 8), _mm256_add_epi32(d, _mm256_add_epi32(d, d)));
+        __m256i den = _mm256_mullo_epi32(_mm256_max_epi32(d, one), _mm256_set1_epi32(6));
+        __m256i H = _mm256_max_epi32(divide(num, den), zero);
+
+        __m256i out = _mm256_and_si256(pixel, _mm256_set1_epi32(0xff000000));
+        out = _mm256_or_si256(out, _mm256_slli_epi32(H, 16));
+        out = _mm256_or_si256(out, _mm256_slli_epi32(S, 8));
+        out = _mm256_or_si256(out, M);
+        return out;
+    }
+};
+
+
+void convert_rgb32_to_hsv32_x64_AVX2(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    convert_rgb32_to_hsv32<RgbToHsv_x64_AVX2>(
+        in, in_bytes_per_row, width, height,
+        out, out_bytes_per_row
+    );
+}
+
+
+
+}
+}
+#endif
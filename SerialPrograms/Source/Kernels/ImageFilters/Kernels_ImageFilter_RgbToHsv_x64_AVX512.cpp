@@ -0,0 +1,82 @@
+/*  Image Filter RGB to HSV (x64 AVX512)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_17_Skylake
+
+#include <immintrin.h>
+#include "Kernels_ImageFilter_RgbToHsv_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+class RgbToHsv_x64_AVX512{
+public:
+    static const size_t VECTOR_SIZE = 16;
+
+    static PA_FORCE_INLINE void convert(uint32_t* out, const uint32_t* in){
+        __m512i pixel = _mm512_loadu_si512((const __m512i*)in);
+        _mm512_storeu_si512((__m512i*)out, process_word(pixel));
+    }
+
+private:
+    static PA_FORCE_INLINE __m512i divide(__m512i num, __m512i den){
+        return _mm512_cvttps_epi32(_mm512_div_ps(_mm512_cvtepi32_ps(num), _mm512_cvtepi32_ps(den)));
+    }
+    static PA_FORCE_INLINE __m512i process_word(__m512i pixel){
+        const __m512i byte = _mm512_set1_epi32(0xff);
+        const __m512i one = _mm512_set1_epi32(1);
+        const __m512i zero = _mm512_setzero_si512();
+
+        __m512i r = _mm512_and_si512(_mm512_srli_epi32(pixel, 16), byte);
+        __m512i g = _mm512_and_si512(_mm512_srli_epi32(pixel, 8), byte);
+        __m512i b = _mm512_and_si512(pixel, byte);
+
+        __m512i M = _mm512_max_epi32(_mm512_max_epi32(r, g), b);
+        __m512i m = _mm512_min_epi32(_mm512_min_epi32(r, g), b);
+        __m512i d = _mm512_sub_epi32(M, m);
+
+        //  S = 255 - (m*255 + M/2) / M
+        __m512i num = _mm512_add_epi32(_mm512_sub_epi32(_mm512_slli_epi32(m, 8), m), _mm512_srli_epi32(M, 1));
+        __m512i S = _mm512_sub_epi32(byte, divide(num, _mm512_max_epi32(M, one)));
+        S = _mm512_maskz_mov_epi32(_mm512_cmpneq_epi32_mask(M, zero), S);
+
+        //  Hue offset within the sector of the max channel.
+        __m512i n_r = _mm512_sub_epi32(g, b);
+        __m512i n_g = _mm512_add_epi32(_mm512_sub_epi32(b, r), _mm512_add_epi32(d, d));
+        __m512i n_b = _mm512_add_epi32(_mm512_sub_epi32(r, g), _mm512_slli_epi32(d, 2));
+        __m512i n = _mm512_mask_blend_epi32(_mm512_cmpeq_epi32_mask(M, g), n_b, n_g);
+        n = _mm512_mask_blend_epi32(_mm512_cmpeq_epi32_mask(M, r), n, n_r);
+
+        //  H = max((256*n + 3*d) / (6*d), 0)
+        num = _mm512_add_epi32(_mm512_slli_epi32(n, 8), _mm512_add_epi32(d, _mm512_add_epi32(d, d)));
+        __m512i den = _mm512_mullo_epi32(_mm512_max_epi32(d, one), _mm512_set1_epi32(6));
+        __m512i H = _mm512_max_epi32(divide(num, den), zero);
+
+        __m512i out = _mm512_and_si512(pixel, _mm512_set1_epi32(0xff000000));
+        out = _mm512_or_si512(out, _mm512_slli_epi32(H, 16));
+        out = _mm512_or_si512(out, _mm512_slli_epi32(S, 8));
+        out = _mm512_or_si512(out, M);
+        return out;
+    }
+};
+
+
+void convert_rgb32_to_hsv32_x64_AVX512(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    convert_rgb32_to_hsv32<RgbToHsv_x64_AVX512>(
+        in, in_bytes_per_row, width, height,
+        out, out_bytes_per_row
+    );
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,82 @@
+/*  Image Filter RGB to HSV (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <smmintrin.h>
+#include "Kernels_ImageFilter_RgbToHsv_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+class RgbToHsv_x64_SSE41{
+public:
+    static const size_t VECTOR_SIZE = 4;
+
+    static PA_FORCE_INLINE void convert(uint32_t* out, const uint32_t* in){
+        __m128i pixel = _mm_loadu_si128((const __m128i*)in);
+        _mm_storeu_si128((__m128i*)out, process_word(pixel));
+    }
+
+private:
+    static PA_FORCE_INLINE __m128i divide(__m128i num, __m128i den){
+        return _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(num), _mm_cvtepi32_ps(den)));
+    }
+    static PA_FORCE_INLINE __m128i process_word(__m128i pixel){
+        const __m128i byte = _mm_set1_epi32(0xff);
+        const __m128i one = _mm_set1_epi32(1);
+        const __m128i zero = _mm_setzero_si128();
+
+        __m128i r = _mm_and_si128(_mm_srli_epi32(pixel, 16), byte);
+        __m128i g = _mm_and_si128(_mm_srli_epi32(pixel, 8), byte);
+        __m128i b = _mm_and_si128(pixel, byte);
+
+        __m128i M = _mm_max_epi32(_mm_max_epi32(r, g), b);
+        __m128i m = _mm_min_epi32(_mm_min_epi32(r, g), b);
+        __m128i d = _mm_sub_epi32(M, m);
+
+        //  S = 255 - (m*255 + M/2) / M
+        __m128i num = _mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(m, 8), m), _mm_srli_epi32(M, 1));
+        __m128i S = _mm_sub_epi32(byte, divide(num, _mm_max_epi32(M, one)));
+        S = _mm_andnot_si128(_mm_cmpeq_epi32(M, zero), S);
+
+        //  Hue offset within the sector of the max channel.
+        __m128i n_r = _mm_sub_epi32(g, b);
+        __m128i n_g = _mm_add_epi32(_mm_sub_epi32(b, r), _mm_add_epi32(d, d));
+        __m128i n_b = _mm_add_epi32(_mm_sub_epi32(r, g), _mm_slli_epi32(d, 2));
+        __m128i n = _mm_blendv_epi8(n_b, n_g, _mm_cmpeq_epi32(M, g));
+        n = _mm_blendv_epi8(n, n_r, _mm_cmpeq_epi32(M, r));
+
+        //  H = max((256*n + 3*d) / (6*d), 0)
+        num = _mm_add_epi32(_mm_slli_epi32(n, 8), _mm_add_epi32(d, _mm_add_epi32(d, d)));
+        __m128i den = _mm_mullo_epi32(_mm_max_epi32(d, one), _mm_set1_epi32(6));
+        __m128i H = _mm_max_epi32(divide(num, den), zero);
+
+        __m128i out = _mm_and_si128(pixel, _mm_set1_epi32(0xff000000));
+        out = _mm_or_si128(out, _mm_slli_epi32(H, 16));
+        out = _mm_or_si128(out, _mm_slli_epi32(S, 8));
+        out = _mm_or_si128(out, M);
+        return out;
+    }
+};
+
+
+void convert_rgb32_to_hsv32_x64_SSE41(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    convert_rgb32_to_hsv32<RgbToHsv_x64_SSE41>(
+        in, in_bytes_per_row, width, height,
+        out, out_bytes_per_row
+    );
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,54 @@
+/*  Pixel Block Sums
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImagePixelBlockSums.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void pixel_block_sums_Default(
+    PixelBlockSums* blocks,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+);
+void pixel_block_sums_x64_SSE41(
+    PixelBlockSums* blocks,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+);
+void pixel_block_sums_x64_AVX2(
+    PixelBlockSums* blocks,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+);
+
+
+void pixel_block_sums(
+    PixelBlockSums* blocks,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        pixel_block_sums_x64_AVX2(blocks, width, height, image, bytes_per_row);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        pixel_block_sums_x64_SSE41(blocks, width, height, image, bytes_per_row);
+        return;
+    }
+#endif
+    pixel_block_sums_Default(blocks, width, height, image, bytes_per_row);
+}
+
+
+
+}
+}
@@ -0,0 +1,48 @@
+/*  Pixel Block Sums
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Downsample an image into 8x8 blocks. Each block keeps the same sums as
+ *  "pixel_sum_sqr()". So the stats of any region made of whole blocks can be
+ *  added up from the blocks without touching the pixels again.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImagePixelBlockSums_H
+#define PokemonAutomation_Kernels_ImagePixelBlockSums_H
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+const size_t PIXEL_BLOCK_SIZE = 8;
+
+//  Padded to 32 bytes so the vector kernels can store a whole block at once.
+struct PixelBlockSums{
+    uint32_t count;
+    uint32_t sumR;
+    uint32_t sumG;
+    uint32_t sumB;
+    uint32_t sqrR;
+    uint32_t sqrG;
+    uint32_t sqrB;
+    uint32_t reserved;
+};
+
+
+//  "blocks" has (width / 8) * (height / 8) entries in row-major order.
+//  Partial blocks on the right and bottom edges are skipped.
+//  Like "pixel_sum_sqr()", pixels are active if their alpha is >= 128.
+void pixel_block_sums(
+    PixelBlockSums* blocks,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+);
+
+
+}
+}
+#endif
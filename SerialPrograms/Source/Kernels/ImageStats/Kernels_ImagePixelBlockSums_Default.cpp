@@ -0,0 +1,73 @@
+/*  Pixel Block Sums (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Compiler.h"
+#include "Kernels_ImagePixelBlockSums.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE void pixel_block_sums_Default(
+    PixelBlockSums& block,
+    const uint32_t* image, size_t bytes_per_row
+){
+    uint32_t count = 0;
+    uint32_t sumB = 0;
+    uint32_t sumG = 0;
+    uint32_t sumR = 0;
+    uint32_t sqrB = 0;
+    uint32_t sqrG = 0;
+    uint32_t sqrR = 0;
+
+    for (size_t r = 0; r < PIXEL_BLOCK_SIZE; r++){
+        for (size_t c = 0; c < PIXEL_BLOCK_SIZE; c++){
+            uint32_t p = image[c];
+            int32_t m = (int32_t)p >> 31;
+            p &= (uint32_t)m;
+
+            uint32_t r0 = p & 0x000000ff;
+            uint32_t r1 = (p >>  8) & 0x000000ff;
+            uint32_t r2 = (p >> 16) & 0x000000ff;
+
+            count -= m;
+            sumB += r0;
+            sumG += r1;
+            sumR += r2;
+            sqrB += r0 * r0;
+            sqrG += r1 * r1;
+            sqrR += r2 * r2;
+        }
+        image = (const uint32_t*)((const char*)image + bytes_per_row);
+    }
+
+    block.count = count;
+    block.sumR = sumR;
+    block.sumG = sumG;
+    block.sumB = sumB;
+    block.sqrR = sqrR;
+    block.sqrG = sqrG;
+    block.sqrB = sqrB;
+    block.reserved = 0;
+}
+void pixel_block_sums_Default(
+    PixelBlockSums* blocks,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+){
+    size_t blocks_x = width / PIXEL_BLOCK_SIZE;
+    size_t blocks_y = height / PIXEL_BLOCK_SIZE;
+    for (size_t by = 0; by < blocks_y; by++){
+        const uint32_t* row = (const uint32_t*)((const char*)image + by * PIXEL_BLOCK_SIZE * bytes_per_row);
+        for (size_t bx = 0; bx < blocks_x; bx++){
+            pixel_block_sums_Default(*blocks++, row + bx * PIXEL_BLOCK_SIZE, bytes_per_row);
+        }
+    }
+}
+
+
+}
+}
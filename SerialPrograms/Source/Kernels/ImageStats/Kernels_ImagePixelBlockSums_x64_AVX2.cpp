@@ -0,0 +1,86 @@
+/*  Pixel Block Sums (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <immintrin.h>
+#include "Kernels/Kernels_x64_AVX2.h"
+#include "Kernels_ImagePixelBlockSums.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+struct PixelBlockSums_x64_AVX2{
+    __m256i count = _mm256_setzero_si256();
+    __m256i sumR = _mm256_setzero_si256();
+    __m256i sumG = _mm256_setzero_si256();
+    __m256i sumB = _mm256_setzero_si256();
+    __m256i sqrR = _mm256_setzero_si256();
+    __m256i sqrG = _mm256_setzero_si256();
+    __m256i sqrB = _mm256_setzero_si256();
+
+    PA_FORCE_INLINE void add(__m256i p){
+        __m256i m = _mm256_srai_epi32(p, 31);
+        p = _mm256_and_si256(p, m);
+
+        __m256i r0 = _mm256_and_si256(p, _mm256_set1_epi32(0x000000ff));
+        __m256i r1 = _mm256_shuffle_epi8(p, _mm256_setr_epi8(
+            1, -1, -1, -1, 5, -1, -1, -1, 9, -1, -1, -1, 13, -1, -1, -1,
+            1, -1, -1, -1, 5, -1, -1, -1, 9, -1, -1, -1, 13, -1, -1, -1
+        ));
+        __m256i r2 = _mm256_shuffle_epi8(p, _mm256_setr_epi8(
+            2, -1, -1, -1, 6, -1, -1, -1, 10, -1, -1, -1, 14, -1, -1, -1,
+            2, -1, -1, -1, 6, -1, -1, -1, 10, -1, -1, -1, 14, -1, -1, -1
+        ));
+
+        count = _mm256_sub_epi32(count, m);
+        sumB = _mm256_add_epi32(sumB, r0);
+        sumG = _mm256_add_epi32(sumG, r1);
+        sumR = _mm256_add_epi32(sumR, r2);
+
+        //  The squares fit in the low 16 bits of each lane.
+        sqrB = _mm256_add_epi32(sqrB, _mm256_mullo_epi16(r0, r0));
+        sqrG = _mm256_add_epi32(sqrG, _mm256_mullo_epi16(r1, r1));
+        sqrR = _mm256_add_epi32(sqrR, _mm256_mullo_epi16(r2, r2));
+    }
+    //  Reduce all the sums together in the same order as the fields.
+    PA_FORCE_INLINE void store(PixelBlockSums& block) const{
+        __m256i sums = _mm256_hadd_epi32(_mm256_hadd_epi32(count, sumR), _mm256_hadd_epi32(sumG, sumB));
+        __m256i sqrs = _mm256_hadd_epi32(_mm256_hadd_epi32(sqrR, sqrG), _mm256_hadd_epi32(sqrB, _mm256_setzero_si256()));
+        __m256i lo = _mm256_permute2x128_si256(sums, sqrs, 0x20);
+        __m256i hi = _mm256_permute2x128_si256(sums, sqrs, 0x31);
+        _mm256_storeu_si256((__m256i*)&block, _mm256_add_epi32(lo, hi));
+    }
+};
+
+
+void pixel_block_sums_x64_AVX2(
+    PixelBlockSums* blocks,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+){
+    size_t blocks_x = width / PIXEL_BLOCK_SIZE;
+    size_t blocks_y = height / PIXEL_BLOCK_SIZE;
+    for (size_t by = 0; by < blocks_y; by++){
+        const uint32_t* row = (const uint32_t*)((const char*)image + by * PIXEL_BLOCK_SIZE * bytes_per_row);
+        for (size_t bx = 0; bx < blocks_x; bx++){
+            PixelBlockSums_x64_AVX2 sums;
+            const uint32_t* ptr = row + bx * PIXEL_BLOCK_SIZE;
+            for (size_t r = 0; r < PIXEL_BLOCK_SIZE; r++){
+                sums.add(_mm256_loadu_si256((const __m256i*)ptr));
+                ptr = (const uint32_t*)((const char*)ptr + bytes_per_row);
+            }
+            sums.store(*blocks++);
+        }
+    }
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,80 @@
+/*  Pixel Block Sums (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <smmintrin.h>
+#include "Kernels/Kernels_x64_SSE41.h"
+#include "Kernels_ImagePixelBlockSums.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+struct PixelBlockSums_x64_SSE41{
+    __m128i count = _mm_setzero_si128();
+    __m128i sumR = _mm_setzero_si128();
+    __m128i sumG = _mm_setzero_si128();
+    __m128i sumB = _mm_setzero_si128();
+    __m128i sqrR = _mm_setzero_si128();
+    __m128i sqrG = _mm_setzero_si128();
+    __m128i sqrB = _mm_setzero_si128();
+
+    PA_FORCE_INLINE void add(__m128i p){
+        __m128i m = _mm_srai_epi32(p, 31);
+        p = _mm_and_si128(p, m);
+
+        __m128i r0 = _mm_and_si128(p, _mm_set1_epi32(0x000000ff));
+        __m128i r1 = _mm_shuffle_epi8(p, _mm_setr_epi8(1, -1, -1, -1, 5, -1, -1, -1, 9, -1, -1, -1, 13, -1, -1, -1));
+        __m128i r2 = _mm_shuffle_epi8(p, _mm_setr_epi8(2, -1, -1, -1, 6, -1, -1, -1, 10, -1, -1, -1, 14, -1, -1, -1));
+
+        count = _mm_sub_epi32(count, m);
+        sumB = _mm_add_epi32(sumB, r0);
+        sumG = _mm_add_epi32(sumG, r1);
+        sumR = _mm_add_epi32(sumR, r2);
+
+        //  The squares fit in the low 16 bits of each lane.
+        sqrB = _mm_add_epi32(sqrB, _mm_mullo_epi16(r0, r0));
+        sqrG = _mm_add_epi32(sqrG, _mm_mullo_epi16(r1, r1));
+        sqrR = _mm_add_epi32(sqrR, _mm_mullo_epi16(r2, r2));
+    }
+    //  Reduce all the sums together in the same order as the fields.
+    PA_FORCE_INLINE void store(PixelBlockSums& block) const{
+        __m128i sums = _mm_hadd_epi32(_mm_hadd_epi32(count, sumR), _mm_hadd_epi32(sumG, sumB));
+        __m128i sqrs = _mm_hadd_epi32(_mm_hadd_epi32(sqrR, sqrG), _mm_hadd_epi32(sqrB, _mm_setzero_si128()));
+        _mm_storeu_si128((__m128i*)&block + 0, sums);
+        _mm_storeu_si128((__m128i*)&block + 1, sqrs);
+    }
+};
+
+
+void pixel_block_sums_x64_SSE41(
+    PixelBlockSums* blocks,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+){
+    size_t blocks_x = width / PIXEL_BLOCK_SIZE;
+    size_t blocks_y = height / PIXEL_BLOCK_SIZE;
+    for (size_t by = 0; by < blocks_y; by++){
+        const uint32_t* row = (const uint32_t*)((const char*)image + by * PIXEL_BLOCK_SIZE * bytes_per_row);
+        for (size_t bx = 0; bx < blocks_x; bx++){
+            PixelBlockSums_x64_SSE41 sums;
+            const uint32_t* ptr = row + bx * PIXEL_BLOCK_SIZE;
+            for (size_t r = 0; r < PIXEL_BLOCK_SIZE; r++){
+                sums.add(_mm_loadu_si128((const __m128i*)ptr + 0));
+                sums.add(_mm_loadu_si128((const __m128i*)ptr + 1));
+                ptr = (const uint32_t*)((const char*)ptr + bytes_per_row);
+            }
+            sums.store(*blocks++);
+        }
+    }
+}
+
+
+
+}
+}
+#endif
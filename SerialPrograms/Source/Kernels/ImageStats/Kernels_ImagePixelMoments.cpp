@@ -0,0 +1,128 @@
+/*  Pixel Moments
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImagePixelMoments.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+template <SumSquareMode mode>
+void pixel_moments_Default(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+);
+template <SumSquareMode mode>
+void pixel_moments_x64_SSE41(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+);
+template <SumSquareMode mode>
+void pixel_moments_x64_AVX2(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+);
+
+
+
+template <SumSquareMode mode>
+void pixel_moments(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background = 0
+){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        pixel_moments_x64_AVX2<mode>(
+            moments,
+            width, height,
+            ref, ref_bytes_per_line,
+            img, img_bytes_per_line,
+            background
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        pixel_moments_x64_SSE41<mode>(
+            moments,
+            width, height,
+            ref, ref_bytes_per_line,
+            img, img_bytes_per_line,
+            background
+        );
+        return;
+    }
+#endif
+    pixel_moments_Default<mode>(
+        moments,
+        width, height,
+        ref, ref_bytes_per_line,
+        img, img_bytes_per_line,
+        background
+    );
+}
+
+
+void pixel_moments(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line
+){
+    pixel_moments<SumSquareMode::REFERENCE_ALPHA>(
+        moments,
+        width, height,
+        ref, ref_bytes_per_line,
+        img, img_bytes_per_line
+    );
+}
+void pixel_moments(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+){
+    pixel_moments<SumSquareMode::USE_BACKGROUND>(
+        moments,
+        width, height,
+        ref, ref_bytes_per_line,
+        img, img_bytes_per_line,
+        background
+    );
+}
+void pixel_moments_masked(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line
+){
+    pixel_moments<SumSquareMode::ARBITRATE_ALPHAS>(
+        moments,
+        width, height,
+        ref, ref_bytes_per_line,
+        img, img_bytes_per_line
+    );
+}
+
+
+
+}
+}
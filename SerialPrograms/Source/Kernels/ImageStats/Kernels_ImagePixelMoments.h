@@ -0,0 +1,125 @@
+/*  Pixel Moments
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Everything needed to compute the RMSD between "img" and "ref" after
+ *      the brightness of "ref" is scaled by an arbitrary factor per channel.
+ *
+ *  For a channel scaled by "s":
+ *
+ *      sum((s*ref - img)^2) = s^2 * sum(ref^2) - 2*s * sum(ref*img) + sum(img^2)
+ *
+ *  So the RMSD can be computed for any scale without scaling "ref" and
+ *  without another pass over the pixels.
+ *
+ *  Scaled values are saturated at 255. Values of "ref" that can saturate are
+ *  kept in bins by value so that can be applied exactly afterwards.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImagePixelMoments_H
+#define PokemonAutomation_Kernels_ImagePixelMoments_H
+
+#include <stdint.h>
+#include <cstddef>
+#include "Kernels_ImagePixelSumSqrDev.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Values of "ref" below this stay below 255 for scales up to 255/221 = 1.154.
+//  Values from here up are binned.
+constexpr uint32_t PIXEL_MOMENTS_BRIGHT_START = 222;
+constexpr size_t PIXEL_MOMENTS_BRIGHT_BINS = 256 - PIXEL_MOMENTS_BRIGHT_START;
+
+
+//  Sums of "img" for each bright value of "ref" on one channel.
+struct PixelMomentsBright{
+    uint64_t count[PIXEL_MOMENTS_BRIGHT_BINS] = {};
+    uint64_t sum[PIXEL_MOMENTS_BRIGHT_BINS] = {};
+    uint64_t sqr[PIXEL_MOMENTS_BRIGHT_BINS] = {};
+
+    void add(uint32_t ref, uint32_t img){
+        size_t bin = ref - PIXEL_MOMENTS_BRIGHT_START;
+        count[bin]++;
+        sum[bin] += img;
+        sqr[bin] += img * img;
+    }
+};
+
+
+struct PixelMoments{
+    //  # of non-zero alpha pixels in "ref".
+    uint64_t count = 0;
+
+    //  Sum of "img" over the non-zero alpha pixels in "ref".
+    uint64_t sumR = 0;
+    uint64_t sumG = 0;
+    uint64_t sumB = 0;
+
+    //  Over the pixels that are compared against the scaled "ref" and where
+    //  "ref" is below PIXEL_MOMENTS_BRIGHT_START on that channel.
+    uint64_t ref_sqrR = 0;  //  sum(ref^2)
+    uint64_t ref_sqrG = 0;
+    uint64_t ref_sqrB = 0;
+    uint64_t dotR = 0;      //  sum(ref*img)
+    uint64_t dotG = 0;
+    uint64_t dotB = 0;
+    uint64_t img_sqrR = 0;  //  sum(img^2)
+    uint64_t img_sqrG = 0;
+    uint64_t img_sqrB = 0;
+
+    //  The rest of the compared pixels.
+    PixelMomentsBright brightR;
+    PixelMomentsBright brightG;
+    PixelMomentsBright brightB;
+
+    //  Sum of squares of differences of the pixels that do not depend on the
+    //  scale. (background pixels and pixels where the alphas disagree)
+    uint64_t fixed_sumsqrs = 0;
+};
+
+
+//
+//  Same pixels as "sum_sqr_deviation()".
+//  Zero-alpha pixels in "ref" are ignored.
+//
+void pixel_moments(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line
+);
+
+
+//
+//  Same pixels as "sum_sqr_deviation()" with a background.
+//  Zero-alpha pixels in "ref" are replaced with "background". The background
+//  is not scaled.
+//
+void pixel_moments(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+);
+
+
+//
+//  Same pixels as "sum_sqr_deviation_masked()".
+//  Pixels where the two images disagree on alpha status are treated as maximum
+//  possible difference.
+//
+void pixel_moments_masked(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line
+);
+
+
+}
+}
+#endif
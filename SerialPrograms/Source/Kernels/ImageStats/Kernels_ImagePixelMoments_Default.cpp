@@ -0,0 +1,132 @@
+/*  Pixel Moments (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <stdint.h>
+#include "Common/Compiler.h"
+#include "Kernels_ImagePixelMoments.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE void pixel_moments_Default(
+    uint64_t& ref_sqr, uint64_t& dot, uint64_t& img_sqr,
+    PixelMomentsBright& bright,
+    uint32_t r, uint32_t i
+){
+    if (r >= PIXEL_MOMENTS_BRIGHT_START){
+        bright.add(r, i);
+        return;
+    }
+    ref_sqr += r * r;
+    dot += r * i;
+    img_sqr += i * i;
+}
+
+template <SumSquareMode mode>
+PA_FORCE_INLINE void pixel_moments_Default(
+    PixelMoments& moments,
+    size_t width,
+    const uint32_t* ref, const uint32_t* img,
+    uint32_t background
+){
+    for (size_t c = 0; c < width; c++){
+        uint32_t r = ref[c];
+        uint32_t i = img[c];
+
+        uint32_t alphaR = (int32_t)r >> 31;
+        uint32_t active = alphaR;
+
+        if (mode == SumSquareMode::USE_BACKGROUND && !alphaR){
+            uint32_t b0 = background & 0x000000ff;
+            uint32_t b1 = (background >> 8) & 0x000000ff;
+            uint32_t b2 = (background >> 16) & 0x000000ff;
+            b0 -= i & 0x000000ff;
+            b1 -= (i >> 8) & 0x000000ff;
+            b2 -= (i >> 16) & 0x000000ff;
+            moments.fixed_sumsqrs += b0*b0 + b1*b1 + b2*b2;
+        }
+        if (mode == SumSquareMode::ARBITRATE_ALPHAS){
+            uint32_t alphaI = (int32_t)i >> 31;
+            active &= alphaI;
+            if (alphaI ^ alphaR){
+                moments.fixed_sumsqrs += 3 * 255 * 255;
+            }
+        }
+
+        if (!alphaR){
+            continue;
+        }
+
+        uint32_t i0 = i & 0x000000ff;
+        uint32_t i1 = (i >> 8) & 0x000000ff;
+        uint32_t i2 = (i >> 16) & 0x000000ff;
+
+        moments.count++;
+        moments.sumB += i0;
+        moments.sumG += i1;
+        moments.sumR += i2;
+
+        if (!active){
+            continue;
+        }
+
+        uint32_t r0 = r & 0x000000ff;
+        uint32_t r1 = (r >> 8) & 0x000000ff;
+        uint32_t r2 = (r >> 16) & 0x000000ff;
+
+        pixel_moments_Default(moments.ref_sqrB, moments.dotB, moments.img_sqrB, moments.brightB, r0, i0);
+        pixel_moments_Default(moments.ref_sqrG, moments.dotG, moments.img_sqrG, moments.brightG, r1, i1);
+        pixel_moments_Default(moments.ref_sqrR, moments.dotR, moments.img_sqrR, moments.brightR, r2, i2);
+    }
+}
+
+template <SumSquareMode mode>
+void pixel_moments_Default(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+){
+    for (size_t r = 0; r < height; r++){
+        pixel_moments_Default<mode>(moments, width, ref, img, background);
+        ref = (const uint32_t*)((const char*)ref + ref_bytes_per_line);
+        img = (const uint32_t*)((const char*)img + img_bytes_per_line);
+    }
+}
+
+
+template
+void pixel_moments_Default<SumSquareMode::REFERENCE_ALPHA>(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+);
+template
+void pixel_moments_Default<SumSquareMode::USE_BACKGROUND>(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+);
+template
+void pixel_moments_Default<SumSquareMode::ARBITRATE_ALPHAS>(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+);
+
+
+
+
+}
+}
@@ -0,0 +1,262 @@
+/*  Pixel Moments (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <immintrin.h>
+#include "Common/Cpp/Exceptions.h"
+#include "Kernels/Kernels_x64_AVX2.h"
+#include "Kernels/PartialWordAccess/Kernels_PartialWordAccess_x64_AVX2.h"
+#include "Kernels_ImagePixelMoments.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+template <SumSquareMode mode>
+void pixel_moments_Default(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+);
+
+
+
+struct PixelMoments_x64_AVX2{
+    __m256i count = _mm256_setzero_si256();
+    __m256i sumR = _mm256_setzero_si256();
+    __m256i sumG = _mm256_setzero_si256();
+    __m256i sumB = _mm256_setzero_si256();
+    __m256i ref_sqrR = _mm256_setzero_si256();
+    __m256i ref_sqrG = _mm256_setzero_si256();
+    __m256i ref_sqrB = _mm256_setzero_si256();
+    __m256i dotR = _mm256_setzero_si256();
+    __m256i dotG = _mm256_setzero_si256();
+    __m256i dotB = _mm256_setzero_si256();
+    __m256i img_sqrR = _mm256_setzero_si256();
+    __m256i img_sqrG = _mm256_setzero_si256();
+    __m256i img_sqrB = _mm256_setzero_si256();
+    __m256i fixed_sumsqrs = _mm256_setzero_si256();
+
+    //  Move the bright values of "ref" on one channel into the bins and zero
+    //  them out of the vectors.
+    static void bin_bright(PixelMomentsBright& bright, __m256i& r, __m256i& i){
+        alignas(32) uint32_t ref[8];
+        alignas(32) uint32_t img[8];
+        _mm256_store_si256((__m256i*)ref, r);
+        _mm256_store_si256((__m256i*)img, i);
+        for (size_t c = 0; c < 8; c++){
+            if (ref[c] >= PIXEL_MOMENTS_BRIGHT_START){
+                bright.add(ref[c], img[c]);
+                ref[c] = 0;
+                img[c] = 0;
+            }
+        }
+        r = _mm256_load_si256((const __m256i*)ref);
+        i = _mm256_load_si256((const __m256i*)img);
+    }
+
+    static PA_FORCE_INLINE void split(__m256i x, __m256i& r, __m256i& g, __m256i& b){
+        b = _mm256_and_si256(x, _mm256_set1_epi32(0x000000ff));
+        g = _mm256_shuffle_epi8(x, _mm256_setr_epi8(
+            1, -1, -1, -1, 5, -1, -1, -1, 9, -1, -1, -1, 13, -1, -1, -1,
+            1, -1, -1, -1, 5, -1, -1, -1, 9, -1, -1, -1, 13, -1, -1, -1
+        ));
+        r = _mm256_shuffle_epi8(x, _mm256_setr_epi8(
+            2, -1, -1, -1, 6, -1, -1, -1, 10, -1, -1, -1, 14, -1, -1, -1,
+            2, -1, -1, -1, 6, -1, -1, -1, 10, -1, -1, -1, 14, -1, -1, -1
+        ));
+    }
+
+    template <SumSquareMode mode>
+    PA_FORCE_INLINE void process(PixelMoments& moments, __m256i r, __m256i i, __m256i background){
+        __m256i alphaR = _mm256_srai_epi32(r, 31);
+        __m256i active = alphaR;
+
+        if (mode == SumSquareMode::USE_BACKGROUND){
+            __m256i b = _mm256_andnot_si256(alphaR, background);
+            __m256i x = _mm256_andnot_si256(alphaR, i);
+            __m256i b0 = _mm256_and_si256(b, _mm256_set1_epi32(0x00ff00ff));
+            __m256i x0 = _mm256_and_si256(x, _mm256_set1_epi32(0x00ff00ff));
+            __m256i b1 = _mm256_shuffle_epi8(b, _mm256_setr_epi8(
+                1, -1, -1, -1, 5, -1, -1, -1, 9, -1, -1, -1, 13, -1, -1, -1,
+                1, -1, -1, -1, 5, -1, -1, -1, 9, -1, -1, -1, 13, -1, -1, -1
+            ));
+            __m256i x1 = _mm256_shuffle_epi8(x, _mm256_setr_epi8(
+                1, -1, -1, -1, 5, -1, -1, -1, 9, -1, -1, -1, 13, -1, -1, -1,
+                1, -1, -1, -1, 5, -1, -1, -1, 9, -1, -1, -1, 13, -1, -1, -1
+            ));
+            b0 = _mm256_sub_epi16(b0, x0);
+            b1 = _mm256_sub_epi16(b1, x1);
+            fixed_sumsqrs = _mm256_add_epi32(fixed_sumsqrs, _mm256_madd_epi16(b0, b0));
+            fixed_sumsqrs = _mm256_add_epi32(fixed_sumsqrs, _mm256_madd_epi16(b1, b1));
+        }
+        if (mode == SumSquareMode::ARBITRATE_ALPHAS){
+            __m256i alphaI = _mm256_srai_epi32(i, 31);
+            active = _mm256_and_si256(active, alphaI);
+            __m256i mismatch = _mm256_xor_si256(alphaI, alphaR);
+            fixed_sumsqrs = _mm256_add_epi32(fixed_sumsqrs, _mm256_and_si256(mismatch, _mm256_set1_epi32(3 * 255 * 255)));
+        }
+
+        __m256i iR, iG, iB;
+        split(_mm256_and_si256(i, alphaR), iR, iG, iB);
+        count = _mm256_sub_epi32(count, alphaR);
+        sumR = _mm256_add_epi32(sumR, iR);
+        sumG = _mm256_add_epi32(sumG, iG);
+        sumB = _mm256_add_epi32(sumB, iB);
+
+        if (mode == SumSquareMode::ARBITRATE_ALPHAS){
+            split(_mm256_and_si256(i, active), iR, iG, iB);
+        }
+        __m256i rR, rG, rB;
+        split(_mm256_and_si256(r, active), rR, rG, rB);
+
+        __m256i bright = _mm256_max_epi32(_mm256_max_epi32(rR, rG), rB);
+        bright = _mm256_cmpgt_epi32(bright, _mm256_set1_epi32(PIXEL_MOMENTS_BRIGHT_START - 1));
+        if (!_mm256_testz_si256(bright, bright)){
+            bin_bright(moments.brightR, rR, iR);
+            bin_bright(moments.brightG, rG, iG);
+            bin_bright(moments.brightB, rB, iB);
+        }
+
+        //  All values are < 256 and the upper halves are zero. So "madd" is
+        //  just a 32-bit multiply.
+        ref_sqrR = _mm256_add_epi32(ref_sqrR, _mm256_madd_epi16(rR, rR));
+        ref_sqrG = _mm256_add_epi32(ref_sqrG, _mm256_madd_epi16(rG, rG));
+        ref_sqrB = _mm256_add_epi32(ref_sqrB, _mm256_madd_epi16(rB, rB));
+        dotR = _mm256_add_epi32(dotR, _mm256_madd_epi16(rR, iR));
+        dotG = _mm256_add_epi32(dotG, _mm256_madd_epi16(rG, iG));
+        dotB = _mm256_add_epi32(dotB, _mm256_madd_epi16(rB, iB));
+        img_sqrR = _mm256_add_epi32(img_sqrR, _mm256_madd_epi16(iR, iR));
+        img_sqrG = _mm256_add_epi32(img_sqrG, _mm256_madd_epi16(iG, iG));
+        img_sqrB = _mm256_add_epi32(img_sqrB, _mm256_madd_epi16(iB, iB));
+    }
+
+    PA_FORCE_INLINE void reduce(PixelMoments& moments) const{
+        moments.count += reduce_add32_x64_AVX2(count);
+        moments.sumR += reduce_add32_x64_AVX2(sumR);
+        moments.sumG += reduce_add32_x64_AVX2(sumG);
+        moments.sumB += reduce_add32_x64_AVX2(sumB);
+        moments.ref_sqrR += reduce_add32_x64_AVX2(ref_sqrR);
+        moments.ref_sqrG += reduce_add32_x64_AVX2(ref_sqrG);
+        moments.ref_sqrB += reduce_add32_x64_AVX2(ref_sqrB);
+        moments.dotR += reduce_add32_x64_AVX2(dotR);
+        moments.dotG += reduce_add32_x64_AVX2(dotG);
+        moments.dotB += reduce_add32_x64_AVX2(dotB);
+        moments.img_sqrR += reduce_add32_x64_AVX2(img_sqrR);
+        moments.img_sqrG += reduce_add32_x64_AVX2(img_sqrG);
+        moments.img_sqrB += reduce_add32_x64_AVX2(img_sqrB);
+        moments.fixed_sumsqrs += reduce_add32_x64_AVX2(fixed_sumsqrs);
+    }
+};
+
+
+
+template <SumSquareMode mode>
+PA_FORCE_INLINE void pixel_moments_x64_AVX2(
+    PixelMoments& moments,
+    uint16_t width,
+    const uint32_t* ref, const uint32_t* img,
+    __m256i background
+){
+    PixelMoments_x64_AVX2 sums;
+
+    const __m256i* ptrR = (const __m256i*)ref;
+    const __m256i* ptrI = (const __m256i*)img;
+
+    size_t lc = width / 8;
+    do{
+        __m256i r = _mm256_loadu_si256(ptrR);
+        __m256i i = _mm256_loadu_si256(ptrI);
+        sums.process<mode>(moments, r, i, background);
+        ptrR++;
+        ptrI++;
+    }while (--lc);
+
+    if (width % 8){
+        //  Masked-off lanes load as zero. Zero alpha and zero background add
+        //  nothing.
+        PartialWordAccess32_x64_AVX2 loader(width % 8);
+        __m256i r = loader.load_i32(ptrR);
+        __m256i i = loader.load_i32(ptrI);
+        __m256i mask = _mm256_cmpgt_epi32(
+            _mm256_set1_epi32(width % 8),
+            _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)
+        );
+        background = _mm256_and_si256(background, mask);
+        sums.process<mode>(moments, r, i, background);
+    }
+
+    sums.reduce(moments);
+}
+
+
+template <SumSquareMode mode>
+void pixel_moments_x64_AVX2(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+){
+    if (width < 8){
+        pixel_moments_Default<mode>(
+            moments,
+            width, height,
+            ref, ref_bytes_per_line,
+            img, img_bytes_per_line,
+            background
+        );
+        return;
+    }
+    if (width > 22017){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Width limit exceeded: " + std::to_string(width));
+    }
+    __m256i vbackground = _mm256_set1_epi32(background);
+    for (size_t r = 0; r < height; r++){
+        pixel_moments_x64_AVX2<mode>(
+            moments,
+            (uint16_t)width, ref, img, vbackground
+        );
+        ref = (const uint32_t*)((const char*)ref + ref_bytes_per_line);
+        img = (const uint32_t*)((const char*)img + img_bytes_per_line);
+    }
+}
+
+
+template
+void pixel_moments_x64_AVX2<SumSquareMode::REFERENCE_ALPHA>(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+);
+template
+void pixel_moments_x64_AVX2<SumSquareMode::USE_BACKGROUND>(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+);
+template
+void pixel_moments_x64_AVX2<SumSquareMode::ARBITRATE_ALPHAS>(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+);
+
+
+
+
+}
+}
+#endif
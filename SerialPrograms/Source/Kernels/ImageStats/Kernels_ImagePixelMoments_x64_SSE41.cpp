@@ -0,0 +1,254 @@
+/*  Pixel Moments (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <smmintrin.h>
+#include "Common/Cpp/Exceptions.h"
+#include "Kernels/Kernels_x64_SSE41.h"
+#include "Kernels_ImagePixelMoments.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+template <SumSquareMode mode>
+void pixel_moments_Default(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+);
+
+
+
+struct PixelMoments_x64_SSE41{
+    __m128i count = _mm_setzero_si128();
+    __m128i sumR = _mm_setzero_si128();
+    __m128i sumG = _mm_setzero_si128();
+    __m128i sumB = _mm_setzero_si128();
+    __m128i ref_sqrR = _mm_setzero_si128();
+    __m128i ref_sqrG = _mm_setzero_si128();
+    __m128i ref_sqrB = _mm_setzero_si128();
+    __m128i dotR = _mm_setzero_si128();
+    __m128i dotG = _mm_setzero_si128();
+    __m128i dotB = _mm_setzero_si128();
+    __m128i img_sqrR = _mm_setzero_si128();
+    __m128i img_sqrG = _mm_setzero_si128();
+    __m128i img_sqrB = _mm_setzero_si128();
+    __m128i fixed_sumsqrs = _mm_setzero_si128();
+
+    //  Move the bright values of "ref" on one channel into the bins and zero
+    //  them out of the vectors.
+    static void bin_bright(PixelMomentsBright& bright, __m128i& r, __m128i& i){
+        alignas(16) uint32_t ref[4];
+        alignas(16) uint32_t img[4];
+        _mm_store_si128((__m128i*)ref, r);
+        _mm_store_si128((__m128i*)img, i);
+        for (size_t c = 0; c < 4; c++){
+            if (ref[c] >= PIXEL_MOMENTS_BRIGHT_START){
+                bright.add(ref[c], img[c]);
+                ref[c] = 0;
+                img[c] = 0;
+            }
+        }
+        r = _mm_load_si128((const __m128i*)ref);
+        i = _mm_load_si128((const __m128i*)img);
+    }
+
+    static PA_FORCE_INLINE void split(__m128i x, __m128i& r, __m128i& g, __m128i& b){
+        b = _mm_and_si128(x, _mm_set1_epi32(0x000000ff));
+        g = _mm_shuffle_epi8(x, _mm_setr_epi8(1, -1, -1, -1, 5, -1, -1, -1, 9, -1, -1, -1, 13, -1, -1, -1));
+        r = _mm_shuffle_epi8(x, _mm_setr_epi8(2, -1, -1, -1, 6, -1, -1, -1, 10, -1, -1, -1, 14, -1, -1, -1));
+    }
+
+    template <SumSquareMode mode>
+    PA_FORCE_INLINE void process(PixelMoments& moments, __m128i r, __m128i i, __m128i background){
+        __m128i alphaR = _mm_srai_epi32(r, 31);
+        __m128i active = alphaR;
+
+        if (mode == SumSquareMode::USE_BACKGROUND){
+            __m128i b = _mm_andnot_si128(alphaR, background);
+            __m128i x = _mm_andnot_si128(alphaR, i);
+            __m128i b0 = _mm_and_si128(b, _mm_set1_epi32(0x00ff00ff));
+            __m128i x0 = _mm_and_si128(x, _mm_set1_epi32(0x00ff00ff));
+            __m128i b1 = _mm_shuffle_epi8(b, _mm_setr_epi8(1, -1, -1, -1, 5, -1, -1, -1, 9, -1, -1, -1, 13, -1, -1, -1));
+            __m128i x1 = _mm_shuffle_epi8(x, _mm_setr_epi8(1, -1, -1, -1, 5, -1, -1, -1, 9, -1, -1, -1, 13, -1, -1, -1));
+            b0 = _mm_sub_epi16(b0, x0);
+            b1 = _mm_sub_epi16(b1, x1);
+            fixed_sumsqrs = _mm_add_epi32(fixed_sumsqrs, _mm_madd_epi16(b0, b0));
+            fixed_sumsqrs = _mm_add_epi32(fixed_sumsqrs, _mm_madd_epi16(b1, b1));
+        }
+        if (mode == SumSquareMode::ARBITRATE_ALPHAS){
+            __m128i alphaI = _mm_srai_epi32(i, 31);
+            active = _mm_and_si128(active, alphaI);
+            __m128i mismatch = _mm_xor_si128(alphaI, alphaR);
+            fixed_sumsqrs = _mm_add_epi32(fixed_sumsqrs, _mm_and_si128(mismatch, _mm_set1_epi32(3 * 255 * 255)));
+        }
+
+        __m128i iR, iG, iB;
+        split(_mm_and_si128(i, alphaR), iR, iG, iB);
+        count = _mm_sub_epi32(count, alphaR);
+        sumR = _mm_add_epi32(sumR, iR);
+        sumG = _mm_add_epi32(sumG, iG);
+        sumB = _mm_add_epi32(sumB, iB);
+
+        if (mode == SumSquareMode::ARBITRATE_ALPHAS){
+            split(_mm_and_si128(i, active), iR, iG, iB);
+        }
+        __m128i rR, rG, rB;
+        split(_mm_and_si128(r, active), rR, rG, rB);
+
+        __m128i bright = _mm_max_epi32(_mm_max_epi32(rR, rG), rB);
+        bright = _mm_cmpgt_epi32(bright, _mm_set1_epi32(PIXEL_MOMENTS_BRIGHT_START - 1));
+        if (!_mm_test_all_zeros(bright, bright)){
+            bin_bright(moments.brightR, rR, iR);
+            bin_bright(moments.brightG, rG, iG);
+            bin_bright(moments.brightB, rB, iB);
+        }
+
+        //  All values are < 256 and the upper halves are zero. So "madd" is
+        //  just a 32-bit multiply.
+        ref_sqrR = _mm_add_epi32(ref_sqrR, _mm_madd_epi16(rR, rR));
+        ref_sqrG = _mm_add_epi32(ref_sqrG, _mm_madd_epi16(rG, rG));
+        ref_sqrB = _mm_add_epi32(ref_sqrB, _mm_madd_epi16(rB, rB));
+        dotR = _mm_add_epi32(dotR, _mm_madd_epi16(rR, iR));
+        dotG = _mm_add_epi32(dotG, _mm_madd_epi16(rG, iG));
+        dotB = _mm_add_epi32(dotB, _mm_madd_epi16(rB, iB));
+        img_sqrR = _mm_add_epi32(img_sqrR, _mm_madd_epi16(iR, iR));
+        img_sqrG = _mm_add_epi32(img_sqrG, _mm_madd_epi16(iG, iG));
+        img_sqrB = _mm_add_epi32(img_sqrB, _mm_madd_epi16(iB, iB));
+    }
+
+    PA_FORCE_INLINE void reduce(PixelMoments& moments) const{
+        moments.count += reduce32_x64_SSE41(count);
+        moments.sumR += reduce32_x64_SSE41(sumR);
+        moments.sumG += reduce32_x64_SSE41(sumG);
+        moments.sumB += reduce32_x64_SSE41(sumB);
+        moments.ref_sqrR += reduce32_x64_SSE41(ref_sqrR);
+        moments.ref_sqrG += reduce32_x64_SSE41(ref_sqrG);
+        moments.ref_sqrB += reduce32_x64_SSE41(ref_sqrB);
+        moments.dotR += reduce32_x64_SSE41(dotR);
+        moments.dotG += reduce32_x64_SSE41(dotG);
+        moments.dotB += reduce32_x64_SSE41(dotB);
+        moments.img_sqrR += reduce32_x64_SSE41(img_sqrR);
+        moments.img_sqrG += reduce32_x64_SSE41(img_sqrG);
+        moments.img_sqrB += reduce32_x64_SSE41(img_sqrB);
+        moments.fixed_sumsqrs += reduce32_x64_SSE41(fixed_sumsqrs);
+    }
+};
+
+
+
+template <SumSquareMode mode>
+PA_FORCE_INLINE void pixel_moments_x64_SSE41(
+    PixelMoments& moments,
+    uint16_t width,
+    const uint32_t* ref, const uint32_t* img,
+    __m128i background
+){
+    PixelMoments_x64_SSE41 sums;
+
+    const __m128i* ptrR = (const __m128i*)ref;
+    const __m128i* ptrI = (const __m128i*)img;
+
+    size_t lc = width / 4;
+    do{
+        __m128i r = _mm_loadu_si128(ptrR);
+        __m128i i = _mm_loadu_si128(ptrI);
+        sums.process<mode>(moments, r, i, background);
+        ptrR++;
+        ptrI++;
+    }while (--lc);
+
+    if (width % 4){
+        //  Reload the last 4 pixels and shift out the ones that were already
+        //  done. Zeroed lanes have zero alpha and zero background so they add
+        //  nothing.
+        __m128i r = _mm_loadu_si128((const __m128i*)(ref + width - 4));
+        __m128i i = _mm_loadu_si128((const __m128i*)(img + width - 4));
+
+        uint8_t shift = (uint8_t)(ref + width - (const uint32_t*)ptrR);
+
+        __m128i s = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        s = _mm_add_epi8(s, _mm_set1_epi8(128 - 4*shift));
+
+        r = _mm_shuffle_epi8(r, s);
+        i = _mm_shuffle_epi8(i, s);
+        background = _mm_shuffle_epi8(background, s);
+
+        sums.process<mode>(moments, r, i, background);
+    }
+
+    sums.reduce(moments);
+}
+
+
+template <SumSquareMode mode>
+void pixel_moments_x64_SSE41(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+){
+    if (width < 4){
+        pixel_moments_Default<mode>(
+            moments,
+            width, height,
+            ref, ref_bytes_per_line,
+            img, img_bytes_per_line,
+            background
+        );
+        return;
+    }
+    if (width > 22017){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Width limit exceeded: " + std::to_string(width));
+    }
+    __m128i vbackground = _mm_set1_epi32(background);
+    for (size_t r = 0; r < height; r++){
+        pixel_moments_x64_SSE41<mode>(
+            moments,
+            (uint16_t)width, ref, img, vbackground
+        );
+        ref = (const uint32_t*)((const char*)ref + ref_bytes_per_line);
+        img = (const uint32_t*)((const char*)img + img_bytes_per_line);
+    }
+}
+
+
+template
+void pixel_moments_x64_SSE41<SumSquareMode::REFERENCE_ALPHA>(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+);
+template
+void pixel_moments_x64_SSE41<SumSquareMode::USE_BACKGROUND>(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+);
+template
+void pixel_moments_x64_SSE41<SumSquareMode::ARBITRATE_ALPHAS>(
+    PixelMoments& moments,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background
+);
+
+
+
+
+}
+}
+#endif
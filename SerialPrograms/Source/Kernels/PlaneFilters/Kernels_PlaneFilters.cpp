@@ -0,0 +1,161 @@
+/*  Plane Filters
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_PlaneFilters.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace PlaneFilters{
+
+
+void filter_5tap_horizontal_Default   (float* out, const float* in, size_t length, const float kernel[5]);
+void filter_5tap_horizontal_x86_SSE41 (float* out, const float* in, size_t length, const float kernel[5]);
+void filter_5tap_horizontal_x86_AVX2  (float* out, const float* in, size_t length, const float kernel[5]);
+void filter_5tap_horizontal_x86_AVX512(float* out, const float* in, size_t length, const float kernel[5]);
+void filter_5tap_horizontal_arm64_NEON(float* out, const float* in, size_t length, const float kernel[5]);
+
+void filter_5tap_vertical_Default   (float* out, const float* const rows[5], size_t length, const float kernel[5]);
+void filter_5tap_vertical_x86_SSE41 (float* out, const float* const rows[5], size_t length, const float kernel[5]);
+void filter_5tap_vertical_x86_AVX2  (float* out, const float* const rows[5], size_t length, const float kernel[5]);
+void filter_5tap_vertical_x86_AVX512(float* out, const float* const rows[5], size_t length, const float kernel[5]);
+void filter_5tap_vertical_arm64_NEON(float* out, const float* const rows[5], size_t length, const float kernel[5]);
+
+void sobel_3x3_Default   (float* gx, float* gy, const float* r0, const float* r1, const float* r2, size_t length);
+void sobel_3x3_x86_SSE41 (float* gx, float* gy, const float* r0, const float* r1, const float* r2, size_t length);
+void sobel_3x3_x86_AVX2  (float* gx, float* gy, const float* r0, const float* r1, const float* r2, size_t length);
+void sobel_3x3_x86_AVX512(float* gx, float* gy, const float* r0, const float* r1, const float* r2, size_t length);
+void sobel_3x3_arm64_NEON(float* gx, float* gy, const float* r0, const float* r1, const float* r2, size_t length);
+
+void min_3x3_Default   (float* out, const float* r0, const float* r1, const float* r2, size_t length);
+void min_3x3_x86_SSE41 (float* out, const float* r0, const float* r1, const float* r2, size_t length);
+void min_3x3_x86_AVX2  (float* out, const float* r0, const float* r1, const float* r2, size_t length);
+void min_3x3_x86_AVX512(float* out, const float* r0, const float* r1, const float* r2, size_t length);
+void min_3x3_arm64_NEON(float* out, const float* r0, const float* r1, const float* r2, size_t length);
+
+
+void filter_5tap_horizontal(
+    float* out, const float* in, size_t length, const float kernel[5]
+){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        filter_5tap_horizontal_x86_AVX512(out, in, length, kernel);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        filter_5tap_horizontal_x86_AVX2(out, in, length, kernel);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        filter_5tap_horizontal_x86_SSE41(out, in, length, kernel);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        filter_5tap_horizontal_arm64_NEON(out, in, length, kernel);
+        return;
+    }
+#endif
+    filter_5tap_horizontal_Default(out, in, length, kernel);
+}
+void filter_5tap_vertical(
+    float* out, const float* const rows[5], size_t length, const float kernel[5]
+){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        filter_5tap_vertical_x86_AVX512(out, rows, length, kernel);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        filter_5tap_vertical_x86_AVX2(out, rows, length, kernel);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        filter_5tap_vertical_x86_SSE41(out, rows, length, kernel);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        filter_5tap_vertical_arm64_NEON(out, rows, length, kernel);
+        return;
+    }
+#endif
+    filter_5tap_vertical_Default(out, rows, length, kernel);
+}
+void sobel_3x3(
+    float* gx, float* gy, const float* r0, const float* r1, const float* r2, size_t length
+){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        sobel_3x3_x86_AVX512(gx, gy, r0, r1, r2, length);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        sobel_3x3_x86_AVX2(gx, gy, r0, r1, r2, length);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        sobel_3x3_x86_SSE41(gx, gy, r0, r1, r2, length);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        sobel_3x3_arm64_NEON(gx, gy, r0, r1, r2, length);
+        return;
+    }
+#endif
+    sobel_3x3_Default(gx, gy, r0, r1, r2, length);
+}
+void min_3x3(
+    float* out, const float* r0, const float* r1, const float* r2, size_t length
+){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        min_3x3_x86_AVX512(out, r0, r1, r2, length);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        min_3x3_x86_AVX2(out, r0, r1, r2, length);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        min_3x3_x86_SSE41(out, r0, r1, r2, length);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        min_3x3_arm64_NEON(out, r0, r1, r2, length);
+        return;
+    }
+#endif
+    min_3x3_Default(out, r0, r1, r2, length);
+}
+
+
+
+}
+}
+}
@@ -0,0 +1,59 @@
+/*  Plane Filters
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Small convolution filters over rows of single-channel float planes.
+ *  Multi-channel images are split into one plane per channel first. None of
+ *  these read outside the ranges documented below so the caller is responsible
+ *  for any padding.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_PlaneFilters_H
+#define PokemonAutomation_Kernels_PlaneFilters_H
+
+#include <stddef.h>
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace PlaneFilters{
+
+
+//  Horizontal 5-tap filter. For 0 <= x < length:
+//      out[x] = k[0]*in[x] + k[1]*in[x+1] + k[2]*in[x+2] + k[3]*in[x+3] + k[4]*in[x+4]
+//  "in" must be readable for [0, length + 4).
+void filter_5tap_horizontal(
+    float* out, const float* in, size_t length,
+    const float kernel[5]
+);
+
+//  Vertical 5-tap filter. For 0 <= x < length:
+//      out[x] = k[0]*rows[0][x] + k[1]*rows[1][x] + ... + k[4]*rows[4][x]
+void filter_5tap_vertical(
+    float* out, const float* const rows[5], size_t length,
+    const float kernel[5]
+);
+
+//  3x3 Sobel filter. For 0 <= x < length:
+//      gx[x] = (r0[x+2] - r0[x]) + 2*(r1[x+2] - r1[x]) + (r2[x+2] - r2[x])
+//      gy[x] = (r0[x] + 2*r0[x+1] + r0[x+2]) - (r2[x] + 2*r2[x+1] + r2[x+2])
+//  The rows must be readable for [0, length + 2).
+void sobel_3x3(
+    float* gx, float* gy,
+    const float* r0, const float* r1, const float* r2, size_t length
+);
+
+//  3x3 minimum. For 0 <= x < length:
+//      out[x] = min of r0[x..x+2], r1[x..x+2], r2[x..x+2]
+//  The rows must be readable for [0, length + 2).
+void min_3x3(
+    float* out,
+    const float* r0, const float* r1, const float* r2, size_t length
+);
+
+
+
+}
+}
+}
+#endif
@@ -0,0 +1,71 @@
+/*  Plane Filters (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Kernels_PlaneFilters_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace PlaneFilters{
+
+
+struct Context_Default{
+    using vtype = float;
+    static constexpr size_t VECTOR_LENGTH = 1;
+
+    static PA_FORCE_INLINE float broadcast(float x){
+        return x;
+    }
+    static PA_FORCE_INLINE float load(const float* ptr){
+        return ptr[0];
+    }
+    static PA_FORCE_INLINE void store(float* ptr, float x){
+        ptr[0] = x;
+    }
+    static PA_FORCE_INLINE float add(float x, float y){
+        return x + y;
+    }
+    static PA_FORCE_INLINE float sub(float x, float y){
+        return x - y;
+    }
+    static PA_FORCE_INLINE float mul(float x, float y){
+        return x * y;
+    }
+    static PA_FORCE_INLINE float min(float x, float y){
+        return std::min(x, y);
+    }
+};
+
+
+void filter_5tap_horizontal_Default(
+    float* out, const float* in, size_t length,
+    const float kernel[5]
+){
+    filter_5tap_horizontal<Context_Default>(out, in, length, kernel);
+}
+void filter_5tap_vertical_Default(
+    float* out, const float* const rows[5], size_t length,
+    const float kernel[5]
+){
+    filter_5tap_vertical<Context_Default>(out, rows, length, kernel);
+}
+void sobel_3x3_Default(
+    float* gx, float* gy,
+    const float* r0, const float* r1, const float* r2, size_t length
+){
+    sobel_3x3<Context_Default>(gx, gy, r0, r1, r2, length);
+}
+void min_3x3_Default(
+    float* out,
+    const float* r0, const float* r1, const float* r2, size_t length
+){
+    min_3x3<Context_Default>(out, r0, r1, r2, length);
+}
+
+
+
+}
+}
+}
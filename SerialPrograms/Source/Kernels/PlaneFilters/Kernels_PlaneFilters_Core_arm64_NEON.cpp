@@ -0,0 +1,75 @@
+/*  Plane Filters (arm64 NEON)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_arm64_20_M1
+
+#include <arm_neon.h>
+#include "Kernels_PlaneFilters_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace PlaneFilters{
+
+
+struct Context_arm64_NEON{
+    using vtype = float32x4_t;
+    static constexpr size_t VECTOR_LENGTH = sizeof(vtype) / sizeof(float);
+
+    static PA_FORCE_INLINE float32x4_t broadcast(float x){
+        return vdupq_n_f32(x);
+    }
+    static PA_FORCE_INLINE float32x4_t load(const float* ptr){
+        return vld1q_f32(ptr);
+    }
+    static PA_FORCE_INLINE void store(float* ptr, float32x4_t x){
+        vst1q_f32(ptr, x);
+    }
+    static PA_FORCE_INLINE float32x4_t add(float32x4_t x, float32x4_t y){
+        return vaddq_f32(x, y);
+    }
+    static PA_FORCE_INLINE float32x4_t sub(float32x4_t x, float32x4_t y){
+        return vsubq_f32(x, y);
+    }
+    static PA_FORCE_INLINE float32x4_t mul(float32x4_t x, float32x4_t y){
+        return vmulq_f32(x, y);
+    }
+    static PA_FORCE_INLINE float32x4_t min(float32x4_t x, float32x4_t y){
+        return vminq_f32(x, y);
+    }
+};
+
+
+void filter_5tap_horizontal_arm64_NEON(
+    float* out, const float* in, size_t length,
+    const float kernel[5]
+){
+    filter_5tap_horizontal<Context_arm64_NEON>(out, in, length, kernel);
+}
+void filter_5tap_vertical_arm64_NEON(
+    float* out, const float* const rows[5], size_t length,
+    const float kernel[5]
+){
+    filter_5tap_vertical<Context_arm64_NEON>(out, rows, length, kernel);
+}
+void sobel_3x3_arm64_NEON(
+    float* gx, float* gy,
+    const float* r0, const float* r1, const float* r2, size_t length
+){
+    sobel_3x3<Context_arm64_NEON>(gx, gy, r0, r1, r2, length);
+}
+void min_3x3_arm64_NEON(
+    float* out,
+    const float* r0, const float* r1, const float* r2, size_t length
+){
+    min_3x3<Context_arm64_NEON>(out, r0, r1, r2, length);
+}
+
+
+
+}
+}
+}
+#endif
@@ -0,0 +1,75 @@
+/*  Plane Filters (x86 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <immintrin.h>
+#include "Kernels_PlaneFilters_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace PlaneFilters{
+
+
+struct Context_x86_AVX2{
+    using vtype = __m256;
+    static constexpr size_t VECTOR_LENGTH = sizeof(vtype) / sizeof(float);
+
+    static PA_FORCE_INLINE __m256 broadcast(float x){
+        return _mm256_set1_ps(x);
+    }
+    static PA_FORCE_INLINE __m256 load(const float* ptr){
+        return _mm256_loadu_ps(ptr);
+    }
+    static PA_FORCE_INLINE void store(float* ptr, __m256 x){
+        _mm256_storeu_ps(ptr, x);
+    }
+    static PA_FORCE_INLINE __m256 add(__m256 x, __m256 y){
+        return _mm256_add_ps(x, y);
+    }
+    static PA_FORCE_INLINE __m256 sub(__m256 x, __m256 y){
+        return _mm256_sub_ps(x, y);
+    }
+    static PA_FORCE_INLINE __m256 mul(__m256 x, __m256 y){
+        return _mm256_mul_ps(x, y);
+    }
+    static PA_FORCE_INLINE __m256 min(__m256 x, __m256 y){
+        return _mm256_min_ps(x, y);
+    }
+};
+
+
+void filter_5tap_horizontal_x86_AVX2(
+    float* out, const float* in, size_t length,
+    const float kernel[5]
+){
+    filter_5tap_horizontal<Context_x86_AVX2>(out, in, length, kernel);
+}
+void filter_5tap_vertical_x86_AVX2(
+    float* out, const float* const rows[5], size_t length,
+    const float kernel[5]
+){
+    filter_5tap_vertical<Context_x86_AVX2>(out, rows, length, kernel);
+}
+void sobel_3x3_x86_AVX2(
+    float* gx, float* gy,
+    const float* r0, const float* r1, const float* r2, size_t length
+){
+    sobel_3x3<Context_x86_AVX2>(gx, gy, r0, r1, r2, length);
+}
+void min_3x3_x86_AVX2(
+    float* out,
+    const float* r0, const float* r1, const float* r2, size_t length
+){
+    min_3x3<Context_x86_AVX2>(out, r0, r1, r2, length);
+}
+
+
+
+}
+}
+}
+#endif
@@ -0,0 +1,75 @@
+/*  Plane Filters (x86 AVX512)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_17_Skylake
+
+#include <immintrin.h>
+#include "Kernels_PlaneFilters_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace PlaneFilters{
+
+
+struct Context_x86_AVX512{
+    using vtype = __m512;
+    static constexpr size_t VECTOR_LENGTH = sizeof(vtype) / sizeof(float);
+
+    static PA_FORCE_INLINE __m512 broadcast(float x){
+        return _mm512_set1_ps(x);
+    }
+    static PA_FORCE_INLINE __m512 load(const float* ptr){
+        return _mm512_loadu_ps(ptr);
+    }
+    static PA_FORCE_INLINE void store(float* ptr, __m512 x){
+        _mm512_storeu_ps(ptr, x);
+    }
+    static PA_FORCE_INLINE __m512 add(__m512 x, __m512 y){
+        return _mm512_add_ps(x, y);
+    }
+    static PA_FORCE_INLINE __m512 sub(__m512 x, __m512 y){
+        return _mm512_sub_ps(x, y);
+    }
+    static PA_FORCE_INLINE __m512 mul(__m512 x, __m512 y){
+        return _mm512_mul_ps(x, y);
+    }
+    static PA_FORCE_INLINE __m512 min(__m512 x, __m512 y){
+        return _mm512_min_ps(x, y);
+    }
+};
+
+
+void filter_5tap_horizontal_x86_AVX512(
+    float* out, const float* in, size_t length,
+    const float kernel[5]
+){
+    filter_5tap_horizontal<Context_x86_AVX512>(out, in, length, kernel);
+}
+void filter_5tap_vertical_x86_AVX512(
+    float* out, const float* const rows[5], size_t length,
+    const float kernel[5]
+){
+    filter_5tap_vertical<Context_x86_AVX512>(out, rows, length, kernel);
+}
+void sobel_3x3_x86_AVX512(
+    float* gx, float* gy,
+    const float* r0, const float* r1, const float* r2, size_t length
+){
+    sobel_3x3<Context_x86_AVX512>(gx, gy, r0, r1, r2, length);
+}
+void min_3x3_x86_AVX512(
+    float* out,
+    const float* r0, const float* r1, const float* r2, size_t length
+){
+    min_3x3<Context_x86_AVX512>(out, r0, r1, r2, length);
+}
+
+
+
+}
+}
+}
+#endif
@@ -0,0 +1,75 @@
+/*  Plane Filters (x86 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <smmintrin.h>
+#include "Kernels_PlaneFilters_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace PlaneFilters{
+
+
+struct Context_x86_SSE41{
+    using vtype = __m128;
+    static constexpr size_t VECTOR_LENGTH = sizeof(vtype) / sizeof(float);
+
+    static PA_FORCE_INLINE __m128 broadcast(float x){
+        return _mm_set1_ps(x);
+    }
+    static PA_FORCE_INLINE __m128 load(const float* ptr){
+        return _mm_loadu_ps(ptr);
+    }
+    static PA_FORCE_INLINE void store(float* ptr, __m128 x){
+        _mm_storeu_ps(ptr, x);
+    }
+    static PA_FORCE_INLINE __m128 add(__m128 x, __m128 y){
+        return _mm_add_ps(x, y);
+    }
+    static PA_FORCE_INLINE __m128 sub(__m128 x, __m128 y){
+        return _mm_sub_ps(x, y);
+    }
+    static PA_FORCE_INLINE __m128 mul(__m128 x, __m128 y){
+        return _mm_mul_ps(x, y);
+    }
+    static PA_FORCE_INLINE __m128 min(__m128 x, __m128 y){
+        return _mm_min_ps(x, y);
+    }
+};
+
+
+void filter_5tap_horizontal_x86_SSE41(
+    float* out, const float* in, size_t length,
+    const float kernel[5]
+){
+    filter_5tap_horizontal<Context_x86_SSE41>(out, in, length, kernel);
+}
+void filter_5tap_vertical_x86_SSE41(
+    float* out, const float* const rows[5], size_t length,
+    const float kernel[5]
+){
+    filter_5tap_vertical<Context_x86_SSE41>(out, rows, length, kernel);
+}
+void sobel_3x3_x86_SSE41(
+    float* gx, float* gy,
+    const float* r0, const float* r1, const float* r2, size_t length
+){
+    sobel_3x3<Context_x86_SSE41>(gx, gy, r0, r1, r2, length);
+}
+void min_3x3_x86_SSE41(
+    float* out,
+    const float* r0, const float* r1, const float* r2, size_t length
+){
+    min_3x3<Context_x86_SSE41>(out, r0, r1, r2, length);
+}
+
+
+
+}
+}
+}
+#endif
@@ -0,0 +1,182 @@
+/*  Plane Filters
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_PlaneFilters_Routines_H
+#define PokemonAutomation_Kernels_PlaneFilters_Routines_H
+
+#include <algorithm>
+#include "Common/Compiler.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace PlaneFilters{
+
+
+//  Every routine runs full vectors first and then finishes the remaining
+//  (length % VECTOR_LENGTH) elements with scalar code. The scalar tail does the
+//  same operations in the same order as the vector body.
+
+
+template <typename Context>
+PA_FORCE_INLINE void filter_5tap_horizontal(
+    float* out, const float* in, size_t length,
+    const float kernel[5]
+){
+    using vtype = typename Context::vtype;
+    constexpr size_t VECTOR_LENGTH = Context::VECTOR_LENGTH;
+
+    const vtype k0 = Context::broadcast(kernel[0]);
+    const vtype k1 = Context::broadcast(kernel[1]);
+    const vtype k2 = Context::broadcast(kernel[2]);
+    const vtype k3 = Context::broadcast(kernel[3]);
+    const vtype k4 = Context::broadcast(kernel[4]);
+
+    size_t c = 0;
+    for (; c + VECTOR_LENGTH <= length; c += VECTOR_LENGTH){
+        vtype sum = Context::mul(k0, Context::load(in + c + 0));
+        sum = Context::add(sum, Context::mul(k1, Context::load(in + c + 1)));
+        sum = Context::add(sum, Context::mul(k2, Context::load(in + c + 2)));
+        sum = Context::add(sum, Context::mul(k3, Context::load(in + c + 3)));
+        sum = Context::add(sum, Context::mul(k4, Context::load(in + c + 4)));
+        Context::store(out + c, sum);
+    }
+    for (; c < length; c++){
+        float sum = kernel[0] * in[c + 0];
+        sum += kernel[1] * in[c + 1];
+        sum += kernel[2] * in[c + 2];
+        sum += kernel[3] * in[c + 3];
+        sum += kernel[4] * in[c + 4];
+        out[c] = sum;
+    }
+}
+
+
+template <typename Context>
+PA_FORCE_INLINE void filter_5tap_vertical(
+    float* out, const float* const rows[5], size_t length,
+    const float kernel[5]
+){
+    using vtype = typename Context::vtype;
+    constexpr size_t VECTOR_LENGTH = Context::VECTOR_LENGTH;
+
+    const vtype k0 = Context::broadcast(kernel[0]);
+    const vtype k1 = Context::broadcast(kernel[1]);
+    const vtype k2 = Context::broadcast(kernel[2]);
+    const vtype k3 = Context::broadcast(kernel[3]);
+    const vtype k4 = Context::broadcast(kernel[4]);
+
+    const float* r0 = rows[0];
+    const float* r1 = rows[1];
+    const float* r2 = rows[2];
+    const float* r3 = rows[3];
+    const float* r4 = rows[4];
+
+    size_t c = 0;
+    for (; c + VECTOR_LENGTH <= length; c += VECTOR_LENGTH){
+        vtype sum = Context::mul(k0, Context::load(r0 + c));
+        sum = Context::add(sum, Context::mul(k1, Context::load(r1 + c)));
+        sum = Context::add(sum, Context::mul(k2, Context::load(r2 + c)));
+        sum = Context::add(sum, Context::mul(k3, Context::load(r3 + c)));
+        sum = Context::add(sum, Context::mul(k4, Context::load(r4 + c)));
+        Context::store(out + c, sum);
+    }
+    for (; c < length; c++){
+        float sum = kernel[0] * r0[c];
+        sum += kernel[1] * r1[c];
+        sum += kernel[2] * r2[c];
+        sum += kernel[3] * r3[c];
+        sum += kernel[4] * r4[c];
+        out[c] = sum;
+    }
+}
+
+
+template <typename Context>
+PA_FORCE_INLINE void sobel_3x3(
+    float* gx, float* gy,
+    const float* r0, const float* r1, const float* r2, size_t length
+){
+    using vtype = typename Context::vtype;
+    constexpr size_t VECTOR_LENGTH = Context::VECTOR_LENGTH;
+
+    size_t c = 0;
+    for (; c + VECTOR_LENGTH <= length; c += VECTOR_LENGTH){
+        vtype a0 = Context::load(r0 + c + 0);
+        vtype a1 = Context::load(r0 + c + 1);
+        vtype a2 = Context::load(r0 + c + 2);
+        vtype b0 = Context::load(r1 + c + 0);
+        vtype b2 = Context::load(r1 + c + 2);
+        vtype c0 = Context::load(r2 + c + 0);
+        vtype c1 = Context::load(r2 + c + 1);
+        vtype c2 = Context::load(r2 + c + 2);
+
+        vtype mid = Context::sub(b2, b0);
+        vtype x = Context::add(Context::sub(a2, a0), Context::add(mid, mid));
+        x = Context::add(x, Context::sub(c2, c0));
+
+        vtype top = Context::add(Context::add(a0, a1), Context::add(a1, a2));
+        vtype bot = Context::add(Context::add(c0, c1), Context::add(c1, c2));
+
+        Context::store(gx + c, x);
+        Context::store(gy + c, Context::sub(top, bot));
+    }
+    for (; c < length; c++){
+        float mid = r1[c + 2] - r1[c];
+        float x = (r0[c + 2] - r0[c]) + (mid + mid);
+        x = x + (r2[c + 2] - r2[c]);
+
+        float top = (r0[c] + r0[c + 1]) + (r0[c + 1] + r0[c + 2]);
+        float bot = (r2[c] + r2[c + 1]) + (r2[c + 1] + r2[c + 2]);
+
+        gx[c] = x;
+        gy[c] = top - bot;
+    }
+}
+
+
+template <typename Context>
+PA_FORCE_INLINE void min_3x3(
+    float* out,
+    const float* r0, const float* r1, const float* r2, size_t length
+){
+    using vtype = typename Context::vtype;
+    constexpr size_t VECTOR_LENGTH = Context::VECTOR_LENGTH;
+
+    size_t c = 0;
+    for (; c + VECTOR_LENGTH <= length; c += VECTOR_LENGTH){
+        vtype m = Context::min(Context::load(r0 + c), Context::load(r1 + c));
+        m = Context::min(m, Context::load(r2 + c));
+        m = Context::min(m, Context::load(r0 + c + 1));
+        m = Context::min(m, Context::load(r1 + c + 1));
+        m = Context::min(m, Context::load(r2 + c + 1));
+        m = Context::min(m, Context::load(r0 + c + 2));
+        m = Context::min(m, Context::load(r1 + c + 2));
+        m = Context::min(m, Context::load(r2 + c + 2));
+        Context::store(out + c, m);
+    }
+    for (; c < length; c++){
+        float m = std::min(r0[c], r1[c]);
+        m = std::min(m, r2[c]);
+        m = std::min(m, r0[c + 1]);
+        m = std::min(m, r1[c + 1]);
+        m = std::min(m, r2[c + 1]);
+        m = std::min(m, r0[c + 2]);
+        m = std::min(m, r1[c + 2]);
+        m = std::min(m, r2[c + 2]);
+        out[c] = m;
+    }
+}
+
+
+
+}
+}
+}
+#endif
@@ -6,6 +6,7 @@
 
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/CpuId/CpuId.h"
+#include "Common/Cpp/Tracing.h"
 #include "Kernels_Waterfill.h"
 #include "Kernels_Waterfill_Session.h"
 
@@ -32,6 +33,7 @@ std::vector<WaterfillObject> find_objects_inplace_64x8_arm64_NEON   (PackedBinar
 
 std::vector<WaterfillObject> find_objects_inplace(PackedBinaryMatrix_IB& matrix, size_t min_area){
 //    cout << "find_objects_inplace" << endl;
+    PA_TRACE_ZONE("Waterfill::find_objects_inplace");
 
     switch (matrix.type()){
 
@@ -10,6 +10,7 @@
 #include <set>
 #include <map>
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Tracing.h"
 #include "Kernels/Kernels_BitSet.h"
 #include "Kernels/BinaryMatrix/Kernels_BinaryMatrix_t.h"
 #include "Kernels/BinaryMatrix/Kernels_PackedBinaryMatrixCore.h"
@@ -379,6 +380,7 @@ bool WaterfillSession_t<Tile, TileRoutines>::find_object(
 
 template <typename Tile, typename TileRoutines>
 bool WaterfillIterator_t<Tile, TileRoutines>::find_next(WaterfillObject& object, bool keep_object){
+    PA_TRACE_ZONE("Waterfill::find_next");
     while (m_tile_row < m_session.tile_height()){
         while (m_tile_col < m_session.tile_width()){
             while (true){
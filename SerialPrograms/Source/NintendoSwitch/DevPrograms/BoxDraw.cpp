@@ -44,6 +44,7 @@ public:
     }
     Overlay(BoxDraw& parent, VideoOverlay& overlay)
         : m_parent(parent)
+        , m_overlay(overlay)
         , m_overlay_set(overlay)
     {
         try{
@@ -58,6 +59,7 @@ public:
     }
     virtual void value_changed() override{
         std::lock_guard<std::mutex> lg(m_lock);
+        OverlayTransaction transaction(m_overlay);
         m_overlay_set.clear();
         m_overlay_set.add(COLOR_RED, {m_parent.X, m_parent.Y, m_parent.WIDTH, m_parent.HEIGHT});
     }
@@ -72,6 +74,7 @@ private:
 
 private:
     BoxDraw& m_parent;
+    VideoOverlay& m_overlay;
     VideoOverlaySet m_overlay_set;
     std::mutex m_lock;
 };
@@ -316,7 +316,7 @@ void TestProgramComputer::program(ProgramEnvironment& env, CancellableScope& sco
 #if 0
     {
         ImageRGB32 image("20230630-084354220241.jpg");
-        TeraLobbyReader reader(env.logger(), env.inference_dispatcher());
+        TeraLobbyReader reader(env.logger());
         reader.read_names(env.logger(), {Language::Japanese}, image);
     }
     {
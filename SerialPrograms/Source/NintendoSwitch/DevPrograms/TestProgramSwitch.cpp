@@ -479,7 +479,7 @@ void TestProgram::program(MultiSwitchProgramEnvironment& env, CancellableScope&
 
 #if 0
     VideoSnapshot image = feed.snapshot();
-    IngredientSession session(env.inference_dispatcher(), console, context, Language::English);
+    IngredientSession session(console, context, Language::English);
     session.read_current_page();
 #endif
 
@@ -487,7 +487,7 @@ void TestProgram::program(MultiSwitchProgramEnvironment& env, CancellableScope&
 
 #if 0
     add_sandwich_ingredients(
-        env.inference_dispatcher(), console, context, Language::English,
+        console, context, Language::English,
         {
             {"pickle", 1},
             {"cucumber", 1},
@@ -502,7 +502,7 @@ void TestProgram::program(MultiSwitchProgramEnvironment& env, CancellableScope&
 
 
 #if 0
-    IngredientSession session(env.inference_dispatcher(), console, context, Language::English);
+    IngredientSession session(console, context, Language::English);
 //    basic_catcher(console, context, Language::English, "poke-ball", true);
 
 
@@ -804,7 +804,7 @@ void TestProgram::program(MultiSwitchProgramEnvironment& env, CancellableScope&
 
 #if 0
     auto image = feed.snapshot();
-    TeraLobbyReader detector(console.logger(), env.realtime_dispatcher());
+    TeraLobbyReader detector(console.logger());
     detector.make_overlays(overlays);
     cout << detector.detect(image) << endl;
 #endif
@@ -824,7 +824,7 @@ void TestProgram::program(MultiSwitchProgramEnvironment& env, CancellableScope&
     open_hosting_lobby(env.program_info(), host, host_context, HostingMode::ONLINE_CODED);
 
     TeraLobbyReader lobby_reader;
-    std::string code = lobby_reader.raid_code(env.logger(), env.realtime_dispatcher(), host.video().snapshot());
+    std::string code = lobby_reader.raid_code(env.logger(), host.video().snapshot());
     std::string normalized_code;
     const char* error = normalize_code(normalized_code, code);
     if (error){
@@ -5,14 +5,18 @@
  */
 
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Tracing.h"
 #include "Common/Cpp/Concurrency/SpinPause.h"
+#include "Common/Cpp/Concurrency/AdaptiveLock.h"
 #include "Common/Cpp/Containers/FixedLimitVector.tpp"
+#include "CommonFramework/Globals.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/Exceptions/ProgramFinishedException.h"
 #include "CommonFramework/Exceptions/OperationFailedException.h"
 #include "CommonFramework/Notifications/ProgramInfo.h"
 #include "CommonFramework/Notifications/ProgramNotifications.h"
 #include "CommonFramework/Tools/BlackBorderCheck.h"
+#include "CommonFramework/Tools/ErrorDumper.h"
 #include "NintendoSwitch_MultiSwitchProgramOption.h"
 #include "NintendoSwitch_MultiSwitchProgramSession.h"
 
@@ -84,6 +88,8 @@ void MultiSwitchProgramSession::run_program_instance(MultiSwitchProgramEnvironme
         start_program_video_check(env.consoles[c], m_option.descriptor().feedback());
     }
 
+    m_option.instance().PRELOAD_MATCHERS.run_async();
+
     m_scope.store(&scope, std::memory_order_release);
 
     try{
@@ -119,6 +125,7 @@ void MultiSwitchProgramSession::internal_stop_program(){
 }
 void MultiSwitchProgramSession::internal_run_program(){
     GlobalSettings::instance().REALTIME_THREAD_PRIORITY0.set_on_this_thread();
+    set_trace_thread_name("Program: " + identifier());
     m_option.options().reset_state();
 
     //  Lock the system to prevent the # of Switches from changing.
@@ -155,6 +162,9 @@ void MultiSwitchProgramSession::internal_run_program(){
         std::move(handles)
     );
 
+    //  Other programs may be running. Only report what this one contended.
+    const std::vector<LockContentionStats> lock_baseline = lock_contention_stats();
+
     try{
         logger().log("<b>Starting Program: " + identifier() + "</b>");
         run_program_instance(env, scope);
@@ -204,6 +214,15 @@ void MultiSwitchProgramSession::internal_run_program(){
             "Unknown error."
         );
     }
+
+    dump_trace(logger(), DEBUG_PATH() + "Traces/", "ProgramStop");
+
+    if (lock_stats_enabled()){
+        std::string report = lock_contention_report(lock_baseline);
+        if (!report.empty()){
+            logger().log(report, COLOR_BLUE);
+        }
+    }
 }
 
 
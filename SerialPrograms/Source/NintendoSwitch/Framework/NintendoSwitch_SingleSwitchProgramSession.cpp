@@ -5,13 +5,17 @@
  */
 
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Tracing.h"
 #include "Common/Cpp/Concurrency/SpinPause.h"
+#include "Common/Cpp/Concurrency/AdaptiveLock.h"
+#include "CommonFramework/Globals.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/Exceptions/ProgramFinishedException.h"
 #include "CommonFramework/Exceptions/OperationFailedException.h"
 #include "CommonFramework/Notifications/ProgramInfo.h"
 #include "CommonFramework/Notifications/ProgramNotifications.h"
 #include "CommonFramework/Tools/BlackBorderCheck.h"
+#include "CommonFramework/Tools/ErrorDumper.h"
 #include "NintendoSwitch_SingleSwitchProgramOption.h"
 #include "NintendoSwitch_SingleSwitchProgramSession.h"
 
@@ -63,6 +67,8 @@ void SingleSwitchProgramSession::run_program_instance(SingleSwitchProgramEnviron
 
     start_program_video_check(env.console, m_option.descriptor().feedback());
 
+    m_option.instance().PRELOAD_MATCHERS.run_async();
+
     m_scope.store(&scope, std::memory_order_release);
 
     try{
@@ -92,6 +98,7 @@ void SingleSwitchProgramSession::internal_stop_program(){
 }
 void SingleSwitchProgramSession::internal_run_program(){
     GlobalSettings::instance().REALTIME_THREAD_PRIORITY0.set_on_this_thread();
+    set_trace_thread_name("Program: " + identifier());
     m_option.options().reset_state();
 
     ProgramInfo program_info(
@@ -113,6 +120,9 @@ void SingleSwitchProgramSession::internal_run_program(){
         m_system.audio()
     );
 
+    //  Other programs may be running. Only report what this one contended.
+    const std::vector<LockContentionStats> lock_baseline = lock_contention_stats();
+
     try{
         logger().log("<b>Starting Program: " + identifier() + "</b>");
         run_program_instance(env, scope);
@@ -162,6 +172,15 @@ void SingleSwitchProgramSession::internal_run_program(){
             "Unknown error."
         );
     }
+
+    dump_trace(logger(), DEBUG_PATH() + "Traces/", "ProgramStop");
+
+    if (lock_stats_enabled()){
+        std::string report = lock_contention_report(lock_baseline);
+        if (!report.empty()){
+            logger().log(report, COLOR_BLUE);
+        }
+    }
 }
 
 
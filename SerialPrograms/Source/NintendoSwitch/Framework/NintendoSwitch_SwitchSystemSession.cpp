@@ -6,6 +6,8 @@
 
 #include "CommonFramework/VideoPipeline/Stats/CpuUtilizationStats.h"
 #include "CommonFramework/VideoPipeline/Stats/ThreadUtilizationStats.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/VideoPipeline/RollingVideoBuffer.h"
 #include "CommonFramework/VideoPipeline/Backends/CameraImplementations.h"
 #include "Integrations/ProgramTracker.h"
 #include "NintendoSwitch/NintendoSwitch_Settings.h"
@@ -28,6 +30,7 @@ SwitchSystemSession::~SwitchSystemSession(){
     ProgramTracker::instance().remove_console(m_console_id);
     m_overlay.remove_stat(*m_main_thread_utilization);
     m_overlay.remove_stat(*m_cpu_utilization);
+    m_rolling_video.reset();
     m_option.m_camera.info = m_camera->current_device();
     m_option.m_camera.current_resolution = m_camera->current_resolution();
 }
@@ -48,6 +51,11 @@ SwitchSystemSession::SwitchSystemSession(
 {
     m_camera->set_resolution(option.m_camera.current_resolution);
     m_camera->set_source(option.m_camera.info);
+    m_rolling_video.reset(new RollingVideoBuffer(
+        m_logger, *m_camera,
+        "Console" + std::to_string(console_number),
+        GlobalSettings::instance().ROLLING_VIDEO_SECONDS
+    ));
     m_console_id = ProgramTracker::instance().add_console(program_id, *this);
     m_overlay.add_stat(*m_cpu_utilization);
     m_overlay.add_stat(*m_main_thread_utilization);
@@ -31,6 +31,7 @@
 namespace PokemonAutomation{
     class CpuUtilizationStat;
     class ThreadUtilizationStat;
+    class RollingVideoBuffer;
 namespace NintendoSwitch{
 
 class SwitchSystemOption;
@@ -85,6 +86,8 @@ private:
     AudioSession m_audio;
     VideoOverlaySession m_overlay;
 
+    std::unique_ptr<RollingVideoBuffer> m_rolling_video;
+
     std::unique_ptr<CpuUtilizationStat> m_cpu_utilization;
     std::unique_ptr<ThreadUtilizationStat> m_main_thread_utilization;
 };
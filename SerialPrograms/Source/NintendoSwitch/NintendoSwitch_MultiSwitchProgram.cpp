@@ -31,6 +31,7 @@ MultiSwitchProgramEnvironment::MultiSwitchProgramEnvironment(
 {
     for (ConsoleHandle& console : consoles){
         console.initialize_inference_threads(scope, inference_dispatcher());
+        add_video_feed(console.video());
     }
 }
 
@@ -13,6 +13,7 @@
 #include "Common/Cpp/Options/BatchOption.h"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/Notifications/EventNotificationOption.h"
+#include "CommonFramework/ImageMatch/TemplateMatcherWarmup.h"
 #include "CommonFramework/ControllerDevices/SerialPortGlobals.h"
 #include "CommonFramework/Tools/ProgramEnvironment.h"
 #include "CommonFramework/Tools/ConsoleHandle.h"
@@ -153,6 +154,10 @@ public:
     EventNotificationOption NOTIFICATION_PROGRAM_FINISH;
     EventNotificationOption NOTIFICATION_ERROR_RECOVERABLE;
     EventNotificationOption NOTIFICATION_ERROR_FATAL;
+
+    //  Matchers used by this program. They are built in the background when
+    //  the program starts.
+    ImageMatch::TemplateMatcherWarmup PRELOAD_MATCHERS;
 };
 
 
@@ -11,6 +11,7 @@
 #include "Common/Cpp/Options/BatchOption.h"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/Notifications/EventNotificationOption.h"
+#include "CommonFramework/ImageMatch/TemplateMatcherWarmup.h"
 #include "CommonFramework/ControllerDevices/SerialPortGlobals.h"
 #include "CommonFramework/Tools/ProgramEnvironment.h"
 #include "CommonFramework/Tools/ConsoleHandle.h"
@@ -44,6 +45,7 @@ private:
         , console(0, std::forward<Args>(args)...)
     {
         console.initialize_inference_threads(scope, inference_dispatcher());
+        add_video_feed(console.video());
     }
 };
 
@@ -133,6 +135,10 @@ public:
     EventNotificationOption NOTIFICATION_PROGRAM_FINISH;
     EventNotificationOption NOTIFICATION_ERROR_RECOVERABLE;
     EventNotificationOption NOTIFICATION_ERROR_FATAL;
+
+    //  Matchers used by this program. They are built in the background when
+    //  the program starts.
+    ImageMatch::TemplateMatcherWarmup PRELOAD_MATCHERS;
 };
 
 
@@ -4,6 +4,11 @@
  *
  */
 
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
+#include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Json/JsonValue.h"
 #include "Common/Cpp/Json/JsonArray.h"
 #include "CommonFramework/Globals.h"
@@ -49,5 +54,71 @@ const std::map<std::string, size_t>& SLUGS_TO_NATIONAL_DEX(){
 }
 
 
+
+struct PokemonSlugInterner{
+    std::shared_mutex lock;
+    std::unordered_map<std::string, PokemonSlugId> ids;
+    std::deque<std::string> slugs;  //  Deque so references stay valid.
+
+    static PokemonSlugInterner& instance(){
+        static PokemonSlugInterner interner;
+        return interner;
+    }
+    PokemonSlugInterner(){
+        for (const std::string& slug : PokemonSlugDatabase::instance().national_dex){
+            add(slug);
+        }
+    }
+
+    //  Must hold the lock exclusively.
+    PokemonSlugId add(const std::string& slug){
+        auto iter = ids.find(slug);
+        if (iter != ids.end()){
+            return iter->second;
+        }
+        if (slugs.size() >= INVALID_POKEMON_SLUG_ID){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Too many slugs.");
+        }
+        PokemonSlugId id = (PokemonSlugId)slugs.size();
+        slugs.emplace_back(slug);
+        ids.emplace(slug, id);
+        return id;
+    }
+};
+
+
+PokemonSlugId intern_pokemon_slug(const std::string& slug){
+    PokemonSlugInterner& interner = PokemonSlugInterner::instance();
+    {
+        std::shared_lock<std::shared_mutex> lg(interner.lock);
+        auto iter = interner.ids.find(slug);
+        if (iter != interner.ids.end()){
+            return iter->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lg(interner.lock);
+    return interner.add(slug);
+}
+PokemonSlugId find_pokemon_slug_id(const std::string& slug){
+    PokemonSlugInterner& interner = PokemonSlugInterner::instance();
+    std::shared_lock<std::shared_mutex> lg(interner.lock);
+    auto iter = interner.ids.find(slug);
+    return iter == interner.ids.end() ? INVALID_POKEMON_SLUG_ID : iter->second;
+}
+const std::string& pokemon_slug_from_id(PokemonSlugId id){
+    PokemonSlugInterner& interner = PokemonSlugInterner::instance();
+    std::shared_lock<std::shared_mutex> lg(interner.lock);
+    if (id >= interner.slugs.size()){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid slug ID: " + std::to_string(id));
+    }
+    return interner.slugs[id];
+}
+size_t pokemon_slug_id_count(){
+    PokemonSlugInterner& interner = PokemonSlugInterner::instance();
+    std::shared_lock<std::shared_mutex> lg(interner.lock);
+    return interner.slugs.size();
+}
+
+
 }
 }
@@ -7,6 +7,7 @@
 #ifndef PokemonAutomation_Pokemon_PokemonSlugs_H
 #define PokemonAutomation_Pokemon_PokemonSlugs_H
 
+#include <stdint.h>
 #include <vector>
 #include <string>
 #include <set>
@@ -21,6 +22,30 @@ const std::vector<std::string>& NATIONAL_DEX_SLUGS();
 const std::map<std::string, size_t>& SLUGS_TO_NATIONAL_DEX();
 
 
+
+//  Compact IDs for slugs so hot tables can be arrays instead of maps keyed by
+//  strings.
+//
+//  The national dex is interned first in dex order. So those IDs are stable
+//  for a given Pokedex resource. (ID = national dex # - 1) Anything else
+//  (forms, etc...) gets the next ID the first time it's interned. Those are
+//  only stable within a run. Never save IDs to disk.
+using PokemonSlugId = uint16_t;
+const PokemonSlugId INVALID_POKEMON_SLUG_ID = (PokemonSlugId)-1;
+
+//  Return the ID of "slug". Add it if it doesn't exist.
+PokemonSlugId intern_pokemon_slug(const std::string& slug);
+
+//  Return the ID of "slug" or INVALID_POKEMON_SLUG_ID if it has never been
+//  interned.
+PokemonSlugId find_pokemon_slug_id(const std::string& slug);
+
+const std::string& pokemon_slug_from_id(PokemonSlugId id);
+
+//  All IDs so far are less than this.
+size_t pokemon_slug_id_count();
+
+
 }
 }
 #endif
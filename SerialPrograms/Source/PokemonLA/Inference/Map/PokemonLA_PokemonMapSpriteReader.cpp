@@ -22,6 +22,7 @@
 #include "CommonFramework/Logging/Logger.h"
 #include "CommonFramework/Resources/SpriteDatabase.h"
 #include "CommonFramework/Tools/DebugDumper.h"
+#include "Kernels/PlaneFilters/Kernels_PlaneFilters.h"
 #include "PokemonLA_PokemonMapSpriteReader.h"
 #include "PokemonLA/Resources/PokemonLA_AvailablePokemon.h"
 #include "PokemonLA/Resources/PokemonLA_PokemonSprites.h"
@@ -76,20 +77,6 @@ inline bool is_transparent(uint32_t g){
 }
 
 
-FeatureType feature_distance(const FeatureVector& a, const FeatureVector& b){
-    if (a.size() != b.size()){
-        cout << "Error, feature size mismatch " << a.size() << " " << b.size() << endl;
-        throw std::runtime_error("feature size mismatch");
-    }
-    FeatureType sum = 0.0f;
-    for(size_t i = 0; i < a.size(); i++){
-        FeatureType d = a[i] - b[i];
-        sum += d*d;
-    }
-
-    return sum;
-}
-
 std::string feature_to_str(const FeatureVector& a){
     std::ostringstream os;
     os << "[";
@@ -103,60 +90,59 @@ std::string feature_to_str(const FeatureVector& a){
     return os.str();
 }
 
-void run_Sobel_gradient_filter(const ImageViewRGB32& image, std::function<void(size_t x, size_t y, int sum_x[3], int sum_y[3])> process_gradient){
+//  Split "image" into two float planes of the same dimensions:
+//      sum_plane:      r + g + b
+//      alpha_plane:    1 if the pixel is opaque. 0 if it is transparent.
+void split_sum_and_alpha_planes(const ImageViewRGB32& image, float* sum_plane, float* alpha_plane){
     const size_t width = image.width();
     const size_t height = image.height();
-    // Kernel for computing gradient along x axis
-    const int kx[3][3] = {
-        {-1, 0, 1},
-        {-2, 0, 2},
-        {-1, 0, 1},
-    };
-    // kernel for gradient along y axis
-    const int ky[3][3] = {
-        { 1,  2,  1},
-        { 0,  0,  0},
-        {-1, -2, -1},
-    };
-    const int ksz = 3; // kernel size
+    for(size_t y = 0; y < height; y++){
+        float* sum_row = sum_plane + y * width;
+        float* alpha_row = alpha_plane + y * width;
+        for(size_t x = 0; x < width; x++){
+            uint32_t p = image.pixel(x, y);
+            sum_row[x] = (float)((p & 0xff) + ((p >> 8) & 0xff) + ((p >> 16) & 0xff));
+            alpha_row[x] = is_transparent(p) ? 0.0f : 1.0f;
+        }
+    }
+}
+
+//  Run a 3x3 Sobel filter over the sum of the RGB channels.
+//  "process_gradient" is called for every pixel whose 3x3 neighborhood is fully
+//  opaque.
+void run_Sobel_gradient_filter(const ImageViewRGB32& image, std::function<void(size_t x, size_t y, int gx, int gy)> process_gradient){
+    const size_t width = image.width();
+    const size_t height = image.height();
+    const size_t ksz = 3; // kernel size
     if (width <= ksz || height <= ksz){
         return;
     }
     const size_t x_end = width - ksz + 1;
     const size_t y_end = height - ksz + 1;
 
+    std::vector<float> sum_plane(width * height);
+    std::vector<float> alpha_plane(width * height);
+    split_sum_and_alpha_planes(image, sum_plane.data(), alpha_plane.data());
+
+    std::vector<float> gx(x_end);
+    std::vector<float> gy(x_end);
+    std::vector<float> opaque(x_end);
     for(size_t y = 0; y < y_end; y++){
+        const float* s0 = sum_plane.data() + (y + 0) * width;
+        const float* s1 = sum_plane.data() + (y + 1) * width;
+        const float* s2 = sum_plane.data() + (y + 2) * width;
+        const float* a0 = alpha_plane.data() + (y + 0) * width;
+        const float* a1 = alpha_plane.data() + (y + 1) * width;
+        const float* a2 = alpha_plane.data() + (y + 2) * width;
+        Kernels::PlaneFilters::sobel_3x3(gx.data(), gy.data(), s0, s1, s2, x_end);
+        Kernels::PlaneFilters::min_3x3(opaque.data(), a0, a1, a2, x_end);
         for(size_t x = 0; x < x_end; x++){
-            int sum_x[3] = {0, 0, 0};
-            int sum_y[3] = {0, 0, 0};
-            bool has_alpha_pixel = false;
-            for(size_t sy = 0; sy < 3; sy++){
-                for(size_t sx = 0; sx < 3; sx++){
-                    uint32_t p = image.pixel(x + sx, y + sy);
-                    int alpha = p >> 24;
-                    if (alpha < 128){
-                        // We don't compute gradient when there is a pixel in the kernel
-                        // scope that is transparent
-                        has_alpha_pixel = true;
-                        break;
-                    }
-                    for(int ch = 0; ch < 3; ch++){ // rgb channel
-                        int shift = ch * 8;
-                        int c = (uint32_t(0xff) & p >> shift);
-
-                        sum_x[ch] += c * kx[sy][sx];
-                        sum_y[ch] += c * ky[sy][sx];
-                    }
-                }
-                if (has_alpha_pixel){
-                    break;
-                }
-            } // end of kernel operation
-            if (has_alpha_pixel){
+            // We don't compute gradient when there is a pixel in the kernel
+            // scope that is transparent
+            if (opaque[x] == 0){
                 continue;
             }
-
-            process_gradient(x+1, y+1, sum_x, sum_y);
+            process_gradient(x+1, y+1, (int)gx[x], (int)gy[x]);
         }
     }
 }
@@ -167,87 +153,96 @@ ImageRGB32 smooth_image(const ImageViewRGB32& image){
     //     image.save("./test_smooth_before_" + std::to_string(count) + ".png");
     // }
 
-    ImageRGB32 result(image.width(), image.height());
+    const size_t image_width = image.width();
+    const size_t image_height = image.height();
+
+    ImageRGB32 result(image_width, image_height);
     result.fill(0);
+    if (image_width == 0 || image_height == 0){
+        return result;
+    }
 
     const float filter[5] = {0.062f, 0.244f, 0.388f, 0.244f, 0.062f};
 
-    size_t image_width = image.width();
-    size_t image_height = image.height();
+    //  Planes of r, g, b and weight. Colors are premultiplied by the weight
+    //  so transparent pixels drop out of the filter sums. Each plane is
+    //  padded by 2 zero pixels on every side so the filters never need to
+    //  special-case the borders.
+    const size_t stride = image_width + 4;
+    const size_t plane_size = stride * (image_height + 4);
+    std::vector<float> planes[4];
+    for(std::vector<float>& plane : planes){
+        plane.assign(plane_size, 0.0f);
+    }
     for(size_t y = 0; y < image_height; y++){
         for(size_t x = 0; x < image_width; x++){
-            float sum[3] = {0,0,0};
-            float weights = 0.0;
-            for(size_t i = 0; i < 5; i++){
-                if (x + i < 2 || x + i >= image_width + 2){
-                    continue;
-                }
-                size_t sx = x + i - 2;
-            
-                uint32_t p = image.pixel(sx, y);
-                if (is_transparent(p)){
-                    continue;
-                }
-
-                weights += filter[i];
-
-                for(int ch = 0; ch < 3; ch++){
-                    int shift = 16 - ch * 8;
-                    int c = (uint32_t(0xff) & p >> shift);
-                    sum[ch] += filter[i] * c;
-                }
-            }
-            if (weights == 0){
+            uint32_t p = image.pixel(x, y);
+            if (is_transparent(p)){
                 continue;
             }
-
-            char c[3];
-            for(int ch = 0; ch < 3; ch++){
-                sum[ch] /= weights;
-                int v = std::min(std::max(int(sum[ch] + 0.5f), 0), 255);
-                c[ch] = (char)v;
-            }
-            result.pixel(x, y) = combine_rgb(c[0], c[1], c[2]);
+            size_t index = (y + 2) * stride + x + 2;
+            planes[0][index] = (float)((p >> 16) & 0xff);
+            planes[1][index] = (float)((p >> 8) & 0xff);
+            planes[2][index] = (float)(p & 0xff);
+            planes[3][index] = 1.0f;
         }
     }
 
-    ImageRGB32 result2(image.width(), image.height());
-    result2.fill(0);
+    //  Divide out the weight and round. Pixels with no weight stay transparent.
+    //  Returns false if the pixel should be left transparent.
+    auto normalize = [](const float sum[3], float weights, uint8_t c[3]){
+        if (weights == 0){
+            return false;
+        }
+        for(int ch = 0; ch < 3; ch++){
+            int v = std::min(std::max(int(sum[ch] / weights + 0.5f), 0), 255);
+            c[ch] = (uint8_t)v;
+        }
+        return true;
+    };
 
+    //  Horizontal pass. The result is written back into the planes after
+    //  rounding since the vertical pass runs on the rounded colors.
+    std::vector<float> filtered[4];
+    for(std::vector<float>& plane : filtered){
+        plane.resize(image_width);
+    }
     for(size_t y = 0; y < image_height; y++){
+        size_t row = (y + 2) * stride;
+        for(size_t ch = 0; ch < 4; ch++){
+            Kernels::PlaneFilters::filter_5tap_horizontal(
+                filtered[ch].data(), planes[ch].data() + row, image_width, filter
+            );
+        }
         for(size_t x = 0; x < image_width; x++){
-            float sum[3] = {0,0,0};
-            float weights = 0.0;
-            for(size_t i = 0; i < 5; i++){
-                if (y + i < 2 || y + i - 2 >= image_height){
-                    continue;
-                }
-                size_t sy = y + i - 2;
-
-                uint32_t p = result.pixel(x, sy);
-                if (is_transparent(p)){
-                    continue;
-                }
-
-                weights += filter[i];
+            const float sum[3] = {filtered[0][x], filtered[1][x], filtered[2][x]};
+            uint8_t c[3] = {0, 0, 0};
+            bool opaque = normalize(sum, filtered[3][x], c);
+            size_t index = row + x + 2;
+            planes[0][index] = c[0];
+            planes[1][index] = c[1];
+            planes[2][index] = c[2];
+            planes[3][index] = opaque ? 1.0f : 0.0f;
+        }
+    }
 
-                for(int ch = 0; ch < 3; ch++){
-                    int shift = 16 - ch * 8;
-                    int c = (uint32_t(0xff) & (p >> shift));
-                    sum[ch] += filter[i] * c;
-                }
-            }
-            if (weights == 0){
-                continue;
+    //  Vertical pass.
+    for(size_t y = 0; y < image_height; y++){
+        for(size_t ch = 0; ch < 4; ch++){
+            const float* rows[5];
+            for(size_t i = 0; i < 5; i++){
+                rows[i] = planes[ch].data() + (y + i) * stride + 2;
             }
-
-            char c[3];
-            for(int ch = 0; ch < 3; ch++){
-                sum[ch] /= weights;
-                int v = std::min(std::max(int(sum[ch] + 0.5f), 0), 255);
-                c[ch] = (char)v;
+            Kernels::PlaneFilters::filter_5tap_vertical(
+                filtered[ch].data(), rows, image_width, filter
+            );
+        }
+        for(size_t x = 0; x < image_width; x++){
+            const float sum[3] = {filtered[0][x], filtered[1][x], filtered[2][x]};
+            uint8_t c[3];
+            if (normalize(sum, filtered[3][x], c)){
+                result.pixel(x, y) = combine_rgb(c[0], c[1], c[2]);
             }
-            result2.pixel(x, y) = combine_rgb(c[0], c[1], c[2]);
         }
     }
 
@@ -258,7 +253,7 @@ ImageRGB32 smooth_image(const ImageViewRGB32& image){
     // }
     // exit(0);
 
-    return result2;
+    return result;
 }
 
 
@@ -266,9 +261,9 @@ ImageRGB32 compute_image_gradient(const ImageViewRGB32& image){
     ImageRGB32 result(image.width(), image.height());
     result.fill(0);
 
-    run_Sobel_gradient_filter(image, [&](size_t x, size_t y, int sum_x[3], int sum_y[3]){
-        int gx = (sum_x[0] + sum_x[1] + sum_x[2] + 1) / 3;
-        int gy = (sum_y[0] + sum_y[1] + sum_y[2] + 1) / 3;
+    run_Sobel_gradient_filter(image, [&](size_t x, size_t y, int sum_gx, int sum_gy){
+        int gx = (sum_gx + 1) / 3;
+        int gy = (sum_gy + 1) / 3;
 
         uint8_t gxc = (uint8_t)std::min(std::abs(gx), 255);
         uint8_t gyc = (uint8_t)std::min(std::abs(gy), 255);
@@ -288,9 +283,7 @@ FeatureVector compute_gradient_histogram(const ImageViewRGB32& image){
 
     int num_grad = 0;
 
-    run_Sobel_gradient_filter(image, [&](size_t x, size_t y, int sum_x[3], int sum_y[3]){
-        int gx = sum_x[0] + sum_x[1] + sum_x[2];
-        int gy = sum_y[0] + sum_y[1] + sum_y[2];
+    run_Sobel_gradient_filter(image, [&](size_t x, size_t y, int gx, int gy){
         if (gx*gx + gy*gy <= 2000){
             return;
         }
@@ -406,12 +399,80 @@ const MMOSpriteMatchingMap& MMO_SPRITE_MATCHING_DATA(){
 }
 
 
-std::multimap<double, std::string> match_pokemon_map_sprite_feature(const ImageViewRGB32& image, MapRegion region){
-    const FeatureVector& image_feature = compute_feature(image);
+//  The features of all the sprites available in one region packed into a
+//  single matrix. It is stored dimension-major so that computing the distance
+//  from one feature to every sprite walks contiguous memory.
+struct PackedFeatureMatrix{
+    size_t dimensions = 0;
+    std::vector<std::string> slugs;
+    std::vector<FeatureType> data;  //  data[d * slugs.size() + s]
+
+    //  Write the squared distance from "feature" to every sprite into "distances".
+    void compute_distances(std::vector<FeatureType>& distances, const FeatureVector& feature) const{
+        if (feature.size() != dimensions){
+            throw InternalProgramError(
+                nullptr, PA_CURRENT_FUNCTION,
+                "Feature size mismatch: " + std::to_string(feature.size()) + " " + std::to_string(dimensions)
+            );
+        }
+        const size_t count = slugs.size();
+        distances.assign(count, 0.0);
+        FeatureType* out = distances.data();
+        for(size_t d = 0; d < dimensions; d++){
+            const FeatureType value = feature[d];
+            const FeatureType* column = data.data() + d * count;
+            for(size_t i = 0; i < count; i++){
+                FeatureType diff = value - column[i];
+                out[i] += diff * diff;
+            }
+        }
+    }
+};
 
+std::array<PackedFeatureMatrix, 5> build_MMO_region_feature_matrices(){
     const MMOSpriteMatchingMap& sprite_map = MMO_SPRITE_MATCHING_DATA();
-
     const std::array<std::vector<std::string>, 5>& region_available_sprites = MMO_FIRST_WAVE_REGION_SPRITE_SLUGS();
+
+    std::array<PackedFeatureMatrix, 5> result;
+    for(size_t region = 0; region < region_available_sprites.size(); region++){
+        const std::vector<std::string>& slugs = region_available_sprites[region];
+        PackedFeatureMatrix& matrix = result[region];
+        matrix.slugs = slugs;
+        if (slugs.empty()){
+            continue;
+        }
+
+        const size_t count = slugs.size();
+        for(size_t i = 0; i < count; i++){
+            auto it = sprite_map.find(slugs[i]);
+            if (it == sprite_map.end()){
+                throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Inconsistent sprite slug definitions in resource: " + slugs[i]);
+            }
+            const FeatureVector& feature = it->second.feature;
+            if (i == 0){
+                matrix.dimensions = feature.size();
+                matrix.data.resize(matrix.dimensions * count);
+            }else if (feature.size() != matrix.dimensions){
+                throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Feature size mismatch: " + slugs[i]);
+            }
+            for(size_t d = 0; d < matrix.dimensions; d++){
+                matrix.data[d * count + i] = feature[d];
+            }
+        }
+    }
+    return result;
+}
+
+const std::array<PackedFeatureMatrix, 5>& MMO_REGION_FEATURE_MATRICES(){
+    const static auto& matrices = build_MMO_region_feature_matrices();
+
+    return matrices;
+}
+
+
+std::multimap<double, std::string> match_pokemon_map_sprite_feature(const ImageViewRGB32& image, MapRegion region){
+    const FeatureVector& image_feature = compute_feature(image);
+
     int region_index = 0;
     switch(region){
     case MapRegion::FIELDLANDS:
@@ -436,25 +497,16 @@ std::multimap<double, std::string> match_pokemon_map_sprite_feature(const ImageV
 
     // cout << "input image feature: " << feature_to_str(image_feature) << endl;
 
-    // FeatureType closest_dist = FLT_MAX;
-    // std::string closest_slug = "";
-
-    std::multimap<double, std::string> result;
+    const PackedFeatureMatrix& matrix = MMO_REGION_FEATURE_MATRICES()[region_index];
 
-    for(const auto& slug : region_available_sprites[region_index]){
-        auto it = sprite_map.find(slug);
-        if (it == sprite_map.end()){
-            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Inconsistent sprite slug definitions in resource: " + slug);
-        }
+    std::vector<FeatureType> distances;
+    matrix.compute_distances(distances, image_feature);
 
-        const FeatureVector& feature = it->second.feature;
-        const FeatureType dist = feature_distance(image_feature, feature);
-        result.emplace(dist, slug);
+    std::multimap<double, std::string> result;
+    for(size_t i = 0; i < distances.size(); i++){
+        result.emplace(distances[i], matrix.slugs[i]);
     }
 
-    // cout << "Closest feature distance " << closest_dist << ", slug " << closest_slug << endl;
-    // cout << feature_to_str(features.find(closest_slug)->second) << endl;
-
     return result;
 }
 
@@ -552,14 +604,14 @@ double compute_MMO_sprite_gradient_distance(const ImageViewRGB32& gradient_templ
     double score = 0.0f;
     int max_offset = 2;
 
-    auto compute_pixel_dist = [](uint32_t t_g, uint32_t g){
+    //  The pixel distance times 255. This is an integer so it can be summed
+    //  exactly.
+    auto compute_pixel_dist_x255 = [](uint32_t t_g, uint32_t g){
         int gx = uint32_t(0xff) & (g >> 16);
         int gy = uint32_t(0xff) & (g >> 8);
         int t_gx = uint32_t(0xff) & (t_g >> 16);
         int t_gy = uint32_t(0xff) & (t_g >> 8);
-        double pixel_score = std::max(t_gx, gx) * (gx - t_gx) * (gx - t_gx) + std::max(t_gy, gy) * (gy - t_gy) * (gy - t_gy);
-        pixel_score /= 255;
-        return pixel_score;
+        return std::max(t_gx, gx) * (gx - t_gx) * (gx - t_gx) + std::max(t_gy, gy) * (gy - t_gy) * (gy - t_gy);
     };
 
 
@@ -593,7 +645,7 @@ double compute_MMO_sprite_gradient_distance(const ImageViewRGB32& gradient_templ
 
                     num_gradients++;
 
-                    float pixel_score = compute_pixel_dist(t_g, g);
+                    float pixel_score = compute_pixel_dist_x255(t_g, g) / 255.;
                     match_score += pixel_score;
 
                     // output.setPixelColor(x, y, QColor(
@@ -671,59 +723,79 @@ double compute_MMO_sprite_gradient_distance(const ImageViewRGB32& gradient_templ
 #endif
 
 #ifdef USE_BLOCK_LEVEL_TRANSLATION
-    int block_radius = 5;
+    //  For every opaque pixel and every offset, the block score is the average
+    //  pixel distance over the block around the pixel. Rather than summing each
+    //  block separately, build summed-area tables of the pixel distances and
+    //  the pixel counts once per offset and read each block in constant time.
+    const int block_radius = 5;
+    const int width = (int)gradient.width();
+    const int height = (int)gradient.height();
+    const size_t table_width = (size_t)width + 1;
+    const size_t table_size = table_width * ((size_t)height + 1);
+
+    std::vector<double> min_block_scores((size_t)width * height, FLT_MAX);
+    std::vector<int64_t> dist_table(table_size, 0);
+    std::vector<int32_t> count_table(table_size, 0);
 
-    score = 0;
-    int num_gradients = 0;
+    for(int oy = -max_offset; oy <= max_offset; oy++){ // offset_y
+        for(int ox = -max_offset; ox <= max_offset; ox++){ // offset_x
 
-    for(int y = 0; y < (int)gradient.height(); y++){
-        for(int x = 0; x < (int)gradient.width(); x++){
-            uint32_t g = gradient.pixel(x, y);
-            if (is_transparent(g)){
-                continue;
+            for(int y = 0; y < height; y++){
+                int64_t row_dist = 0;
+                int32_t row_count = 0;
+                const size_t above = (size_t)y * table_width;
+                const size_t current = above + table_width;
+                for(int x = 0; x < width; x++){
+                    uint32_t g = gradient.pixel(x, y);
+                    int ty = y + oy; // template y
+                    int tx = x + ox; // template x
+                    if (!is_transparent(g) && tx >= 0 && tx < tempt_width && ty >= 0 && ty < tempt_height){
+                        uint32_t t_g = gradient_template.pixel(tx, ty);
+                        if (!is_transparent(t_g)){
+                            row_dist += compute_pixel_dist_x255(t_g, g);
+                            row_count++;
+                        }
+                    }
+                    dist_table[current + x + 1] = dist_table[above + x + 1] + row_dist;
+                    count_table[current + x + 1] = count_table[above + x + 1] + row_count;
+                }
             }
 
-            double min_block_score = FLT_MAX;
-            for(int oy = -max_offset; oy <= max_offset; oy++){ // offset_y
-                for(int ox = -max_offset; ox <= max_offset; ox++){ // offset_x
+            for(int y = 0; y < height; y++){
+                const size_t top = (size_t)std::max(y - block_radius, 0) * table_width;
+                const size_t bottom = (size_t)std::min(y + block_radius + 1, height) * table_width;
+                for(int x = 0; x < width; x++){
+                    if (is_transparent(gradient.pixel(x, y))){
+                        continue;
+                    }
+                    const size_t left = (size_t)std::max(x - block_radius, 0);
+                    const size_t right = (size_t)std::min(x + block_radius + 1, width);
 
-                    double block_score = 0.0;
-                    int block_size = 0;
-                    for(int by = y - block_radius; by <= y + block_radius; by++){
-                        for(int bx = x - block_radius; bx <= x + block_radius; bx++){
-                            if (bx < 0 || bx >= (int)gradient.width() || by < 0 || by >= (int)gradient.height()){
-                                continue;
-                            }
-
-                            uint32_t bg = gradient.pixel(bx, by);
-                            if (is_transparent(bg)){
-                                continue;
-                            }
-
-                            int ty = by + oy; // template y
-                            int tx = bx + ox; // template x
-                            if (tx < 0 || tx >= tempt_width || ty < 0 || ty >= tempt_height){
-                                continue;
-                            }
-                            uint32_t t_bg = gradient_template.pixel(tx, ty);
-                            if (is_transparent(t_bg)){
-                                continue;
-                            }
-
-                            block_score += compute_pixel_dist(t_bg, bg);
-                            block_size++;
-                        }
+                    int32_t block_size =
+                        count_table[bottom + right] - count_table[bottom + left] -
+                        count_table[top + right] + count_table[top + left];
+                    if (block_size == 0){
+                        continue;
                     }
-                    block_score = block_score / block_size;
+                    int64_t block_dist =
+                        dist_table[bottom + right] - dist_table[bottom + left] -
+                        dist_table[top + right] + dist_table[top + left];
+
+                    double block_score = block_dist / 255. / block_size;
+                    double& min_block_score = min_block_scores[(size_t)y * width + x];
                     min_block_score = std::min(min_block_score, block_score);
                 }
-            } // end offset
-
-            if (min_block_score < FLT_MAX){
-                score += min_block_score;
-                num_gradients++;
             }
         }
+    } // end offset
+
+    score = 0;
+    int num_gradients = 0;
+    for(double min_block_score : min_block_scores){
+        if (min_block_score < FLT_MAX){
+            score += min_block_score;
+            num_gradients++;
+        }
     }
     score = std::sqrt(score / num_gradients);
 #endif
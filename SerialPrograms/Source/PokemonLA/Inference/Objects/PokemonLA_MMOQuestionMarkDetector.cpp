@@ -176,7 +176,9 @@ std::vector<ImagePixelBox> MMOQuestionMarkDetector::detect_MMOs_on_region_map(co
         return size_t(size * rel_scale);
     };
 
-    match_template_by_waterfill(
+    //  The question marks are large. (over 1300 pixels at 1080p) So they
+    //  survive downsampling by 2 and most other objects can be rejected there.
+    match_template_by_waterfill_coarse_to_fine(
         map_image, MMOQuestionMarkBackgroundMatcher::instance(),
         {{combine_rgb(0, 5, 30), combine_rgb(100, 130, 130)}},
         {scale(min_bg_size), scale(max_bg_size)}, 110,
@@ -20,6 +20,7 @@
 #include "PokemonLA/Programs/PokemonLA_BattleRoutines.h"
 #include "PokemonLA_IngoBattleGrinder.h"
 #include "PokemonLA/Inference/Objects/PokemonLA_ArcPhoneDetector.h"
+#include "PokemonLA/Inference/Objects/PokemonLA_ButtonDetector.h"
 #include "PokemonLA/Inference/Objects/PokemonLA_DialogueEllipseDetector.h"
 #include "PokemonLA/Inference/PokemonLA_DialogDetector.h"
 
@@ -85,6 +86,10 @@ IngoBattleGrinder::IngoBattleGrinder()
     PA_ADD_OPTION(POKEMON_ACTIONS);
 
     PA_ADD_OPTION(NOTIFICATIONS);
+
+    PRELOAD_MATCHERS.add(&ButtonMatcher::A);
+    PRELOAD_MATCHERS.add(&DialogueEllipseMatcher::instance);
+    PRELOAD_MATCHERS.add(&ArcPhoneMatcher::instance);
 }
 
 
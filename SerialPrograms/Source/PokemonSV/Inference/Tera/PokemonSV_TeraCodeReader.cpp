@@ -6,9 +6,10 @@
 
 #include <map>
 #include "Common/Cpp/AbstractLogger.h"
-#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
+#include "Common/Cpp/Concurrency/ComputationThreadPool.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
 #include "CommonFramework/Globals.h"
+#include "CommonFramework/GlobalServices.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTools/ImageBoxes.h"
 #include "CommonFramework/ImageTools/ImageFilter.h"
@@ -146,7 +147,6 @@ struct WaterfillOCRResult{
 
 
 std::vector<WaterfillOCRResult> waterfill_OCR(
-    AsyncDispatcher& dispatcher,
     const ImageViewRGB32& image,
     uint32_t threshold
 ){
@@ -173,7 +173,7 @@ std::vector<WaterfillOCRResult> waterfill_OCR(
         ret.emplace_back(WaterfillOCRResult{std::move(item.second), ""});
     }
 
-    dispatcher.run_in_parallel(
+    global_compute_pool().parallel_for(
         0, ret.size(),
         [&](size_t index){
             WaterfillObject& object = ret[index].object;
@@ -182,7 +182,8 @@ std::vector<WaterfillOCRResult> waterfill_OCR(
             filter_by_mask(tmp, cropped, Color(0xffffffff), true);
             ImageRGB32 padded = pad_image(cropped, cropped.width(), 0xffffffff);
             ret[index].ocr = OCR::ocr_read(Language::English, padded);
-        }
+        },
+        1
     );
 
 #ifdef PA_ENABLE_CODE_DEBUG
@@ -201,8 +202,8 @@ std::vector<WaterfillOCRResult> waterfill_OCR(
 }
 
 
-int16_t read_raid_timer(Logger& logger, AsyncDispatcher& dispatcher, const ImageViewRGB32& image){
-    std::vector<WaterfillOCRResult> characters = waterfill_OCR(dispatcher, image, 0xff7f7f7f);
+int16_t read_raid_timer(Logger& logger, const ImageViewRGB32& image){
+    std::vector<WaterfillOCRResult> characters = waterfill_OCR(image, 0xff7f7f7f);
 
 //    cout << "map.size() = " << map.size() << endl;
 //    for (auto& item : map){
@@ -262,14 +263,14 @@ int16_t read_raid_timer(Logger& logger, AsyncDispatcher& dispatcher, const Image
 }
 
 
-std::string read_raid_code(Logger& logger, AsyncDispatcher& dispatcher, const ImageViewRGB32& image){
+std::string read_raid_code(Logger& logger, const ImageViewRGB32& image){
     std::vector<uint32_t> filters{
         0xff5f5f5f,
         0xff7f7f7f,
     };
 
     for (uint32_t filter : filters){
-        std::vector<WaterfillOCRResult> characters = waterfill_OCR(dispatcher, image, filter);
+        std::vector<WaterfillOCRResult> characters = waterfill_OCR(image, filter);
 
         static const std::map<char, char> SUBSTITUTIONS{
             {'I', '1'},
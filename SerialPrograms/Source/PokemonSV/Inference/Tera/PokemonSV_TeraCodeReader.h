@@ -11,7 +11,6 @@
 
 namespace PokemonAutomation{
     class Logger;
-    class AsyncDispatcher;
 namespace NintendoSwitch{
 namespace PokemonSV{
 
@@ -20,10 +19,10 @@ void preload_code_templates();
 
 
 //  Returns # of seconds left. Returns -1 if unable to read.
-int16_t read_raid_timer(Logger& logger, AsyncDispatcher& dispatcher, const ImageViewRGB32& image);
+int16_t read_raid_timer(Logger& logger, const ImageViewRGB32& image);
 
 //  Returns empty string if unable to read.
-std::string read_raid_code(Logger& logger, AsyncDispatcher& dispatcher, const ImageViewRGB32& image);
+std::string read_raid_code(Logger& logger, const ImageViewRGB32& image);
 
 
 
@@ -5,7 +5,6 @@
  */
 
 #include "Common/Cpp/CancellableScope.h"
-#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
 //#include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/Notifications/ProgramNotifications.h"
 #include "CommonFramework/ImageTools/ImageFilter.h"
@@ -104,7 +103,7 @@ void wait_for_video_code_and_join(
             break;
         }
         case VideoFceOcrMethod::TERA_CARD:
-            code = read_raid_code(env.logger(), env.realtime_dispatcher(), snapshot);
+            code = read_raid_code(env.logger(), snapshot);
         }
         const char* error = enter_code(env, scope, fce_settings, code, false);
         if (error == nullptr){
@@ -171,7 +170,7 @@ void VideoFastCodeEntry::program(MultiSwitchProgramEnvironment& env, Cancellable
     FastCodeEntrySettings settings(FCE_SETTINGS);
 
     if (MODE == Mode::MANUAL){
-        std::string code = read_raid_code(env.logger(), env.realtime_dispatcher(), SCREEN_WATCHER.screenshot());
+        std::string code = read_raid_code(env.logger(), SCREEN_WATCHER.screenshot());
         const char* error = enter_code(env, scope, settings, code, !SKIP_CONNECT_TO_CONTROLLER);
         if (error){
             env.log("No valid code found: " + std::string(error), COLOR_RED);
@@ -184,9 +183,6 @@ void VideoFastCodeEntry::program(MultiSwitchProgramEnvironment& env, Cancellable
         pbf_press_button(context, BUTTON_PLUS, 5, 3);
     });
 
-    //  Preload 6 threads to OCR the code.
-    env.realtime_dispatcher().ensure_threads(6);
-
     wait_for_video_code_and_join(env, scope, SCREEN_WATCHER, JOIN_METHOD, FCE_SETTINGS);
 
     send_program_finished_notification(env, NOTIFICATION_PROGRAM_FINISH);
@@ -6,8 +6,9 @@
 
 #include <algorithm>
 #include "Common/Cpp/Containers/FixedLimitVector.tpp"
-#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
+#include "Common/Cpp/Concurrency/ComputationThreadPool.h"
 #include "NintendoSwitch/Commands/NintendoSwitch_Commands_PushButtons.h"
+#include "CommonFramework/GlobalServices.h"
 #include "CommonFramework/Exceptions/OperationFailedException.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "CommonFramework/Tools/ConsoleHandle.h"
@@ -22,12 +23,10 @@ namespace PokemonSV{
 IngredientSession::~IngredientSession() = default;
 
 IngredientSession::IngredientSession(
-    AsyncDispatcher& dispatcher,
     ConsoleHandle& console, BotBaseContext& context,
     Language language, SandwichIngredientType type
 )
-    : m_dispatcher(dispatcher)
-    , m_console(console)
+    : m_console(console)
     , m_context(context)
     , m_language(language)
     , m_overlays(console.overlay())
@@ -65,7 +64,7 @@ PageIngredients IngredientSession::read_screen(std::shared_ptr<const ImageRGB32>
 
     //  Read the names of every line and the sprite of the selected line.
     ImageMatch::ImageMatchResult image_result;
-    m_dispatcher.run_in_parallel(0, INGREDIENT_PAGE_LINES + 1, [&](size_t index){
+    global_compute_pool().parallel_for(0, INGREDIENT_PAGE_LINES + 1, [&](size_t index){
         if (index < INGREDIENT_PAGE_LINES){
             // Read text at line `index`
             OCR::StringMatchResult result = m_ingredients[index].read_with_ocr(*screen, m_console, m_language);
@@ -275,20 +274,19 @@ void IngredientSession::add_ingredients(
 
 
 void add_sandwich_ingredients(
-    AsyncDispatcher& dispatcher,
     ConsoleHandle& console, BotBaseContext& context,
     Language language,
     std::map<std::string, uint8_t>&& fillings,
     std::map<std::string, uint8_t>&& condiments
 ){
     {
-        IngredientSession session(dispatcher, console, context, language, SandwichIngredientType::FILLING);
+        IngredientSession session(console, context, language, SandwichIngredientType::FILLING);
         session.add_ingredients(console, context, std::move(fillings));
         pbf_press_button(context, BUTTON_PLUS, 20, 230);
     }
 
     {
-        IngredientSession session(dispatcher, console, context, language, SandwichIngredientType::CONDIMENT);
+        IngredientSession session(console, context, language, SandwichIngredientType::CONDIMENT);
         // If there are herbs, we search first from bottom
         if (std::any_of(condiments.begin(), condiments.end(), [&](const auto& p){return p.first.find("herba") != std::string::npos;})){
             pbf_press_dpad(context, DPAD_UP, 20, 105);
@@ -15,7 +15,6 @@
 #include "PokemonSV/Inference/Picnics/PokemonSV_SandwichIngredientDetector.h"
 
 namespace PokemonAutomation{
-    class AsyncDispatcher;
     class ConsoleHandle;
     class BotBaseContext;
 namespace NintendoSwitch{
@@ -37,7 +36,6 @@ class IngredientSession{
 public:
     ~IngredientSession();
     IngredientSession(
-        AsyncDispatcher& dispatcher,
         ConsoleHandle& console, BotBaseContext& context,
         Language language, SandwichIngredientType type
     );
@@ -62,7 +60,6 @@ public:
 
 
 private:
-    AsyncDispatcher& m_dispatcher;
     ConsoleHandle& m_console;
     BotBaseContext& m_context;
     Language m_language;
@@ -78,7 +75,6 @@ private:
 //  user must stack the fillings.
 //  If any ingredient is not found or insuffient, it will throw OperationFailedException.
 void add_sandwich_ingredients(
-    AsyncDispatcher& dispatcher,
     ConsoleHandle& console, BotBaseContext& context,
     Language language,
     std::map<std::string, uint8_t>&& fillings,  //  {slug, quantity}
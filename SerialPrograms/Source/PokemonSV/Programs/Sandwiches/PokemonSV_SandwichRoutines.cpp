@@ -689,7 +689,7 @@ void make_two_herbs_sandwich(
         throw InternalProgramError(&console.logger(), PA_CURRENT_FUNCTION,
             "Invalid EggSandwichType for make_two_herbs_sandwich()");
     }
-    add_sandwich_ingredients(dispatcher, console, context, language, std::move(fillings), std::move(condiments));
+    add_sandwich_ingredients(console, context, language, std::move(fillings), std::move(condiments));
 
     finish_two_herbs_sandwich(info, dispatcher, console, context);
 }
@@ -852,7 +852,7 @@ void run_sandwich_maker(SingleSwitchProgramEnvironment& env, BotBaseContext& con
     //Player must be on default sandwich menu
     std::map<std::string, uint8_t> fillings_copy(fillings); //Making a copy as we need the map for later
     enter_custom_sandwich_mode(env.program_info(), env.console, context);
-    add_sandwich_ingredients(env.realtime_dispatcher(), env.console, context, language,
+    add_sandwich_ingredients(env.console, context, language,
         std::move(fillings_copy), std::move(condiments));
     wait_for_initial_hand(env.program_info(), env.console, context);
 
@@ -98,7 +98,7 @@ private:
 class TeraLobbyJoinWatcher2 : public TeraLobbyReader, public VisualInferenceCallback{
 public:
     TeraLobbyJoinWatcher2(
-        Logger& logger, AsyncDispatcher& dispatcher, Color color,
+        Logger& logger, Color color,
         uint8_t host_players
     );
 
@@ -120,7 +120,7 @@ private:
 class TeraLobbyNameWatcher : public TeraLobbyReader, public VisualInferenceCallback{
 public:
     TeraLobbyNameWatcher(
-        Logger& logger, AsyncDispatcher& dispatcher, Color color,
+        Logger& logger, Color color,
         RaidJoinReportOption& report_settings,
         RaidPlayerBanList& ban_settings,
         uint8_t host_players
@@ -333,7 +333,7 @@ void TeraMultiFarmer::join_lobby(
 
         enter_code(console, context, FastCodeEntrySettings(), normalized_code, false);
 
-        TeraLobbyWatcher lobby(console.logger(), env.realtime_dispatcher(), COLOR_RED);
+        TeraLobbyWatcher lobby(console.logger(), COLOR_RED);
         AdvanceDialogWatcher wrong_code(COLOR_YELLOW);
         CodeEntryWatcher incomplete_code(COLOR_GREEN);
         context.wait_for_all_requests();
@@ -411,7 +411,7 @@ bool TeraMultiFarmer::run_raid(
     //  Open lobby and read code.
     WallClock lobby_start_time;
     try{
-        TeraLobbyReader lobby_reader(host_console.logger(), env.realtime_dispatcher());
+        TeraLobbyReader lobby_reader(host_console.logger());
         open_hosting_lobby(
             env, host_console, host_context,
             HOSTING_MODE == Mode::HOST_ONLINE
@@ -419,7 +419,7 @@ bool TeraMultiFarmer::run_raid(
                 : HostingMode::LOCAL
         );
         lobby_start_time = current_time();
-        std::string code = lobby_reader.raid_code(env.logger(), env.realtime_dispatcher(), host_console.video().snapshot());
+        std::string code = lobby_reader.raid_code(env.logger(), host_console.video().snapshot());
         const char* error = normalize_code(lobby_code, code);
         if (error){
             throw OperationFailedException(
@@ -141,7 +141,7 @@ void open_hosting_lobby(
         }
 
         TeraCardWatcher card_detector(COLOR_YELLOW);
-        TeraLobbyWatcher lobby(console.logger(), env.realtime_dispatcher(), COLOR_BLUE);
+        TeraLobbyWatcher lobby(console.logger(), COLOR_BLUE);
         context.wait_for_all_requests();
         int ret = wait_until(
             console, context,
@@ -4,7 +4,10 @@
  *
  */
 
+#include <cmath>
 #include <map>
+#include <array>
+#include <limits>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Json/JsonValue.h"
 #include "Common/Cpp/Json/JsonArray.h"
@@ -20,9 +23,15 @@ namespace PokemonSwSh{
 namespace MaxLairInternal{
 
 
+const size_t TYPE_COUNT = (size_t)PokemonType::FAIRY + 1;
+using TypeWeights = std::array<double, TYPE_COUNT>;
+
+
 struct PathMatchDatabase{
-    std::map<PokemonType, std::set<std::string>> rentals_by_type;
-    std::map<std::string, std::map<PokemonType, double>> type_vs_boss;
+    std::array<std::set<std::string>, TYPE_COUNT> rentals_by_type;
+
+    //  Indexed by the slug ID of the boss. NaN if not in the file.
+    std::vector<TypeWeights> type_vs_boss;
 
     static const PathMatchDatabase& instance(){
         static PathMatchDatabase database;
@@ -42,7 +51,7 @@ private:
                     continue;
                 }
                 JsonArray& array = obj.get_array_throw(type.second, path);
-                std::set<std::string>& set = rentals_by_type[type.first];
+                std::set<std::string>& set = rentals_by_type[(size_t)type.first];
                 for (auto& item : array){
                     std::string& str = item.get_string_throw(path);
                     set.insert(std::move(str));
@@ -52,7 +61,13 @@ private:
 
         JsonObject& node = root.get_object_throw("base_node", path).get_object_throw("hash_table");
         for (auto& item : node){
-            std::map<PokemonType, double>& boss = type_vs_boss[item.first];
+            PokemonSlugId id = intern_pokemon_slug(item.first);
+            if (type_vs_boss.size() <= id){
+                TypeWeights missing;
+                missing.fill(std::numeric_limits<double>::quiet_NaN());
+                type_vs_boss.resize((size_t)id + 1, missing);
+            }
+            TypeWeights& boss = type_vs_boss[id];
 
             JsonObject& obj = item.second.get_object_throw(path).get_object_throw("hash_table", path);
 
@@ -60,7 +75,7 @@ private:
                 if (type.first == PokemonType::NONE){
                     continue;
                 }
-                boss[type.first] = obj.get_double_throw(type.second, path);
+                boss[(size_t)type.first] = obj.get_double_throw(type.second, path);
             }
         }
     }
@@ -71,44 +86,84 @@ private:
 
 const std::set<std::string>& rentals_by_type(PokemonType type){
     const PathMatchDatabase& database = PathMatchDatabase::instance();
-    auto iter = database.rentals_by_type.find(type);
-    if (iter == database.rentals_by_type.end()){
+    if (type == PokemonType::NONE || (size_t)type >= TYPE_COUNT){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Type: " + std::to_string((int)type));
     }
-    return iter->second;
+    return database.rentals_by_type[(size_t)type];
 }
 
-double type_vs_boss(PokemonType type, const std::string& boss_slug){
+double type_vs_boss(PokemonType type, PokemonSlugId boss){
     const PathMatchDatabase& database = PathMatchDatabase::instance();
-
-    auto iter0 = database.type_vs_boss.find(boss_slug);
-    if (iter0 == database.type_vs_boss.end()){
-        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Boss: " + boss_slug);
+    if (boss >= database.type_vs_boss.size() || std::isnan(database.type_vs_boss[boss][(size_t)PokemonType::NORMAL])){
+        throw InternalProgramError(
+            nullptr, PA_CURRENT_FUNCTION,
+            "Invalid Boss: " + (boss == INVALID_POKEMON_SLUG_ID ? std::string("(unknown)") : pokemon_slug_from_id(boss))
+        );
     }
-
-    auto iter1 = iter0->second.find(type);
-    if (iter1 == iter0->second.end()){
+    if (type == PokemonType::NONE || (size_t)type >= TYPE_COUNT){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Type: " + std::to_string((int)type));
     }
-
-    return iter1->second;
+    return database.type_vs_boss[boss][(size_t)type];
+}
+double type_vs_boss(PokemonType type, const std::string& boss_slug){
+    PokemonSlugId id = find_pokemon_slug_id(boss_slug);
+    if (id == INVALID_POKEMON_SLUG_ID){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Boss: " + boss_slug);
+    }
+    return type_vs_boss(type, id);
 }
-double type_vs_boss(PokemonType type, PokemonType boss_type){
-    using namespace papkmnlib;
 
-    Type pkmnlib_type = serial_type_to_pkmnlib(boss_type);
 
-    double weight = 0;
-    size_t count = 0;
-    for (const auto& item : all_bosses_by_dex()){
-        const Pokemon& boss = get_pokemon(item.second);
-        if (boss_type == PokemonType::NONE || boss.has_type(pkmnlib_type)){
-            weight += type_vs_boss(type, boss.name());
-            count++;
+//  Average of "type" against every boss of "boss_type". This only depends on
+//  the resources. So the whole table is computed once.
+struct TypeVsBossTypeTable{
+    std::array<TypeWeights, TYPE_COUNT> weights;
+
+    static const TypeVsBossTypeTable& instance(){
+        static TypeVsBossTypeTable table;
+        return table;
+    }
+
+private:
+    TypeVsBossTypeTable(){
+        using namespace papkmnlib;
+
+        std::vector<PokemonSlugId> all_bosses;
+        std::vector<const Pokemon*> boss_mons;
+        for (const auto& item : all_bosses_by_dex()){
+            const Pokemon& boss = get_pokemon(item.second);
+            all_bosses.emplace_back(find_pokemon_slug_id(boss.name()));
+            boss_mons.emplace_back(&boss);
+        }
+
+        for (size_t b = 0; b < TYPE_COUNT; b++){
+            PokemonType boss_type = (PokemonType)b;
+            Type pkmnlib_type = serial_type_to_pkmnlib(boss_type);
+            for (size_t t = 0; t < TYPE_COUNT; t++){
+                PokemonType type = (PokemonType)t;
+                if (type == PokemonType::NONE){
+                    weights[b][t] = std::numeric_limits<double>::quiet_NaN();
+                    continue;
+                }
+                double weight = 0;
+                size_t count = 0;
+                for (size_t c = 0; c < all_bosses.size(); c++){
+                    if (boss_type == PokemonType::NONE || boss_mons[c]->has_type(pkmnlib_type)){
+                        weight += type_vs_boss(type, all_bosses[c]);
+                        count++;
+                    }
+                }
+                weights[b][t] = weight / (double)count;
+            }
         }
     }
+};
 
-    return weight / (double)count;
+double type_vs_boss(PokemonType type, PokemonType boss_type){
+    if (type == PokemonType::NONE || (size_t)type >= TYPE_COUNT || (size_t)boss_type >= TYPE_COUNT){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Type: " + std::to_string((int)type));
+    }
+    return TypeVsBossTypeTable::instance().weights[(size_t)boss_type][(size_t)type];
 }
 
 
@@ -268,8 +323,12 @@ std::vector<PathNode> select_path(
             rank.emplace(evaluate_path(pathmap.boss, path), path);
         }
     }else{
+        PokemonSlugId boss_id = find_pokemon_slug_id(boss);
+        if (boss_id == INVALID_POKEMON_SLUG_ID){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Boss: " + boss);
+        }
         for (const std::vector<PathNode>& path : paths){
-            rank.emplace(evaluate_path(boss, path), path);
+            rank.emplace(evaluate_path(boss_id, path), path);
         }
     }
     std::string str = "Available Paths:\n";
@@ -11,6 +11,7 @@
 #include <set>
 #include "CommonFramework/Logging/Logger.h"
 #include "Pokemon/Pokemon_Types.h"
+#include "Pokemon/Resources/Pokemon_PokemonSlugs.h"
 #include "PokemonSwSh/MaxLair/Framework/PokemonSwSh_MaxLair_State.h"
 
 namespace PokemonAutomation{
@@ -21,6 +22,7 @@ using namespace Pokemon;
 
 
 const std::set<std::string>& rentals_by_type(PokemonType type);
+double type_vs_boss(PokemonType type, PokemonSlugId boss);
 double type_vs_boss(PokemonType type, const std::string& boss_slug);
 double type_vs_boss(PokemonType type, PokemonType boss_type);
 
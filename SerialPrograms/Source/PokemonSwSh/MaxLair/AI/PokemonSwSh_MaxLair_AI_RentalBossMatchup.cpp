@@ -4,7 +4,8 @@
  *
  */
 
-#include <map>
+#include <cmath>
+#include <limits>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Json/JsonValue.h"
 #include "Common/Cpp/Json/JsonObject.h"
@@ -16,57 +17,134 @@ namespace PokemonAutomation{
 namespace NintendoSwitch{
 namespace PokemonSwSh{
 namespace MaxLairInternal{
+using namespace Pokemon;
 
 
 
+//  The AI looks these up thousands of times per decision. So it's a dense
+//  rental x boss matrix instead of nested maps of strings.
 struct MatchupDatabase{
-    std::map<std::string, std::map<std::string, double>> map;
+    static const uint16_t MISSING = (uint16_t)-1;
+
+    //  Indexed by slug ID. Row/column of the slug in "matchups".
+    std::vector<uint16_t> rental_index;
+    std::vector<uint16_t> boss_index;
+
+    std::vector<PokemonSlugId> bosses;
+    size_t rentals = 0;
+    std::vector<double> matchups;       //  [rental][boss]
+    std::vector<double> boss_average;   //  [boss], average over all rentals
 
     static const MatchupDatabase& instance(){
         static MatchupDatabase database;
         return database;
     }
 
-    double get(const std::string& rental, const std::string& boss) const{
-        auto iter0 = map.find(rental);
-        if (iter0 == map.end()){
-            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Rental not found: " + rental);
+    static uint16_t lookup(const std::vector<uint16_t>& index, PokemonSlugId id){
+        return id < index.size() ? index[id] : MISSING;
+    }
+
+    double get(PokemonSlugId rental, PokemonSlugId boss) const{
+        uint16_t row = lookup(rental_index, rental);
+        if (row == MISSING){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Rental not found: " + slug_name(rental));
+        }
+        uint16_t col = lookup(boss_index, boss);
+        if (col == MISSING){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss not found: " + slug_name(boss));
+        }
+        double ret = matchups[row * bosses.size() + col];
+        if (std::isnan(ret)){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss not found: " + slug_name(boss));
+        }
+        return ret;
+    }
+    double average(PokemonSlugId boss) const{
+        uint16_t col = lookup(boss_index, boss);
+        if (col == MISSING){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss not found: " + slug_name(boss));
         }
-        auto iter1 = iter0->second.find(boss);
-        if (iter1 == iter0->second.end()){
-            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss not found: " + rental);
+        double ret = boss_average[col];
+        if (std::isnan(ret)){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss is missing for some rentals: " + slug_name(boss));
         }
-        return iter1->second;
+        return ret;
     }
 
 private:
+    static std::string slug_name(PokemonSlugId id){
+        return id == INVALID_POKEMON_SLUG_ID ? "(unknown)" : pokemon_slug_from_id(id);
+    }
+    static void set_index(std::vector<uint16_t>& index, PokemonSlugId id, size_t position){
+        if (index.size() <= id){
+            index.resize((size_t)id + 1, MISSING);
+        }
+        index[id] = (uint16_t)position;
+    }
+
     MatchupDatabase(){
         std::string path = RESOURCE_PATH() + "PokemonSwSh/MaxLair/boss_matchup_LUT.json";
         JsonValue json = load_json_file(path);
         JsonObject& root = json.get_object_throw(path);
+
+        //  Columns are every boss that appears for any rental.
+        for (auto& item0 : root){
+            JsonObject& obj = item0.second.get_object_throw(path);
+            for (auto& item1 : obj){
+                PokemonSlugId id = intern_pokemon_slug(item1.first);
+                if (lookup(boss_index, id) == MISSING){
+                    set_index(boss_index, id, bosses.size());
+                    bosses.emplace_back(id);
+                }
+            }
+        }
+
+        //  Pairs that aren't in the file are left as NaN.
         for (auto& item0 : root){
-            std::map<std::string, double>& sub = map[item0.first];
+            set_index(rental_index, intern_pokemon_slug(item0.first), rentals++);
+            matchups.resize(rentals * bosses.size(), std::numeric_limits<double>::quiet_NaN());
+            double* row = &matchups[(rentals - 1) * bosses.size()];
             JsonObject& obj = item0.second.get_object_throw(path);
             for (auto& item1 : obj){
-                sub[item1.first] = item1.second.get_double_throw(path);
+                row[lookup(boss_index, find_pokemon_slug_id(item1.first))] = item1.second.get_double_throw(path);
+            }
+        }
+
+        boss_average.resize(bosses.size(), 0);
+        for (size_t r = 0; r < rentals; r++){
+            for (size_t c = 0; c < bosses.size(); c++){
+                boss_average[c] += matchups[r * bosses.size() + c];
             }
         }
+        for (double& x : boss_average){
+            x /= (double)rentals;
+        }
     }
 };
 
-double rental_vs_boss_matchup(const std::string& rental, const std::string& boss){
+double rental_vs_boss_matchup(PokemonSlugId rental, PokemonSlugId boss){
     return MatchupDatabase::instance().get(rental, boss);
 }
+double rental_vs_boss_matchup(const std::string& rental, const std::string& boss){
+    return MatchupDatabase::instance().get(
+        find_pokemon_slug_id(rental),
+        find_pokemon_slug_id(boss)
+    );
+}
+double average_rental_vs_boss_matchup(PokemonSlugId boss){
+    return MatchupDatabase::instance().average(boss);
+}
 double rental_vs_boss_matchup(const std::string& rental, const std::vector<std::string>& bosses){
     using namespace papkmnlib;
 
     double score = 0;
     if (bosses.empty()){
         const auto& all_bosses = all_boss_pokemon();
+        PokemonSlugId rental_id = find_pokemon_slug_id(rental);
         for (const auto& boss : all_bosses){
-            score += rental_vs_boss_matchup(rental, boss.second.name());
+            score += rental_vs_boss_matchup(rental_id, find_pokemon_slug_id(boss.second.name()));
         }
-        score /= bosses.size();
+        score /= all_bosses.size();
     }else{
         for (const std::string& boss : bosses){
             score += rental_vs_boss_matchup(rental, boss);
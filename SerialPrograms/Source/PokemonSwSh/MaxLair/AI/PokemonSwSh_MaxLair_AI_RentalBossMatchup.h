@@ -9,6 +9,7 @@
 
 #include <string>
 #include <vector>
+#include "Pokemon/Resources/Pokemon_PokemonSlugs.h"
 
 namespace PokemonAutomation{
 namespace NintendoSwitch{
@@ -16,9 +17,16 @@ namespace PokemonSwSh{
 namespace MaxLairInternal{
 
 
+using namespace Pokemon;
+
+
+double rental_vs_boss_matchup(PokemonSlugId rental, PokemonSlugId boss);
 double rental_vs_boss_matchup(const std::string& rental, const std::string& boss);
 double rental_vs_boss_matchup(const std::string& rental, const std::vector<std::string>& bosses);
 
+//  Average matchup of every rental against "boss".
+double average_rental_vs_boss_matchup(PokemonSlugId boss);
+
 
 
 }
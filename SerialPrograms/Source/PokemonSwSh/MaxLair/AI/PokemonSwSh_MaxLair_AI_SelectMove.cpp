@@ -4,7 +4,12 @@
  *
  */
 
+#include <cmath>
+#include <algorithm>
+#include "Common/Cpp/PrettyPrint.h"
+#include "CommonFramework/GlobalServices.h"
 #include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Matchup.h"
+#include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Simulation.h"
 #include "PokemonSwSh/Resources/PokemonSwSh_TypeMatchup.h"
 #include "PokemonSwSh/Resources/PokemonSwSh_MaxLairDatabase.h"
 #include "PokemonSwSh_MaxLair_AI.h"
@@ -16,6 +21,14 @@ namespace PokemonSwSh{
 namespace MaxLairInternal{
 
 
+//  Time allowed for the rollouts. Well within the in-game move timer.
+const std::chrono::milliseconds MOVE_SIMULATION_BUDGET(250);
+const uint64_t MOVE_SIMULATION_ROLLOUTS = 20000;
+
+//  Win rates closer than this many standard errors are a tie.
+const double MOVE_WIN_RATE_TIE_STDERRS = 2.0;
+
+
 
 std::pair<uint8_t, bool> select_move_ai(
     Logger& logger,
@@ -30,6 +43,8 @@ std::pair<uint8_t, bool> select_move_ai(
 
     std::unique_ptr<Pokemon> self;
     std::vector<std::unique_ptr<Pokemon>> teammates;
+    std::vector<SimulatedPlayer> simulated;
+    size_t simulated_self = 0;
 
     for (size_t c = 0; c < 4; c++){
         const PlayerState& player = state.players[c];
@@ -40,7 +55,11 @@ std::pair<uint8_t, bool> select_move_ai(
         std::unique_ptr<Pokemon> pokemon = convert_player_to_pkmnlib(player);
         pokemon->transform_from_ditto(boss);
 
+        //  The pointer stays valid after "pokemon" is moved out.
+        simulated.emplace_back(SimulatedPlayer{pokemon.get(), player.dmax_turns_left});
+
         if (c == player_index){
+            simulated_self = simulated.size() - 1;
             self = std::move(pokemon);
         }else{
             teammates.emplace_back(std::move(pokemon));
@@ -56,7 +75,8 @@ std::pair<uint8_t, bool> select_move_ai(
         teammates_v.emplace_back(item.get());
     }
 
-    std::multimap<double, std::pair<uint8_t, bool>, std::greater<double>> rank;
+    std::vector<BattleOption> options;
+    std::vector<double> scores;
 
     //  No dmax.
     if (state.players[player_index].dmax_turns_left <= 0){
@@ -67,11 +87,8 @@ std::pair<uint8_t, bool> select_move_ai(
             if (state.players[player_index].move_blocked[c]){
                 continue;
             }
-            double score = calc_move_score(*self, boss, teammates_v, c, field);
-            rank.emplace(
-                score,
-                std::pair<uint8_t, bool>{(uint8_t)c, false}
-            );
+            options.emplace_back(BattleOption{(uint8_t)c, false});
+            scores.emplace_back(calc_move_score(*self, boss, teammates_v, c, field));
         }
     }
 
@@ -85,36 +102,85 @@ std::pair<uint8_t, bool> select_move_ai(
             if (state.players[player_index].move_blocked[c]){
                 continue;
             }
-            double score = calc_move_score(*self, boss, teammates_v, c, field);
-            rank.emplace(
-                score,
-                std::pair<uint8_t, bool>{(uint8_t)c, true}
-            );
+            options.emplace_back(BattleOption{(uint8_t)c, true});
+            scores.emplace_back(calc_move_score(*self, boss, teammates_v, c, field));
+        }
+    }
+
+    if (options.empty()){
+        logger.log("Unable to calculate moves. Picking a random move...", COLOR_RED);
+        return {(uint8_t)random(0, 3), false};
+    }
+
+    //  Play out the rest of the battle for each option. Rank by win rate,
+    //  then by how much of the boss is left, then by the heuristic score.
+    //  Win rates are sampled, so near-equal ones count as ties.
+    //  The heuristic decides by itself if the rollouts ran out of time.
+    uint8_t lives = state.lives_left < 0 ? 4 : (uint8_t)state.lives_left;
+    BattleSimulator simulator(boss, simulated, simulated_self, field, lives);
+    std::vector<RolloutResult> results = simulator.evaluate(
+        global_compute_pool(), options,
+        MOVE_SIMULATION_BUDGET, MOVE_SIMULATION_ROLLOUTS,
+        std::chrono::steady_clock::now().time_since_epoch().count()
+    );
+
+    std::vector<size_t> rank;
+    for (size_t c = 0; c < options.size(); c++){
+        rank.emplace_back(c);
+    }
+    std::sort(rank.begin(), rank.end(), [&](size_t a, size_t b){
+        return results[a].win_rate() > results[b].win_rate();
+    });
+
+    //  Group the options by win rate. An option joins the current group if
+    //  it is within the tolerance of the group's best. Comparing groups
+    //  instead of raw win rates keeps the ordering transitive.
+    std::vector<size_t> tier(options.size());
+    size_t leader = rank[0];
+    size_t current_tier = 0;
+    for (size_t index : rank){
+        double gap = results[leader].win_rate() - results[index].win_rate();
+        double error = std::sqrt(results[leader].win_rate_variance() + results[index].win_rate_variance());
+        if (gap > MOVE_WIN_RATE_TIE_STDERRS * error){
+            leader = index;
+            current_tier++;
         }
+        tier[index] = current_tier;
     }
 
+    std::sort(rank.begin(), rank.end(), [&](size_t a, size_t b){
+        if (tier[a] != tier[b]){
+            return tier[a] < tier[b];
+        }
+        if (results[a].boss_hp_left != results[b].boss_hp_left){
+            return results[a].boss_hp_left < results[b].boss_hp_left;
+        }
+        return scores[a] > scores[b];
+    });
+
     //  Print options and scores.
-    std::string move_dump = "Move Score:\n";
-    for (const auto& move : rank){
-        uint8_t slot = move.second.first;
-        move_dump += std::to_string(move.first) + " : ";
-        move_dump += move.second.second
+    std::string move_dump = "Move Score (win rate, boss HP left, heuristic, rollouts):\n";
+    for (size_t index : rank){
+        const RolloutResult& result = results[index];
+        uint8_t slot = options[index].move_index;
+        move_dump += tostr_fixed(result.win_rate() * 100, 1) + "%, ";
+        move_dump += tostr_fixed(result.boss_hp_left * 100, 1) + "%, ";
+        move_dump += std::to_string(scores[index]) + ", ";
+        move_dump += std::to_string(result.rollouts) + " : ";
+        move_dump += options[index].dmax
             ? self->max_move(slot).name()
             : self->move(slot).name();
         move_dump += "\n";
     }
     logger.log(move_dump);
 
-    if (rank.empty()){
-        logger.log("Unable to calculate moves. Picking a random move...", COLOR_RED);
-        return {(uint8_t)random(0, 3), false};
-    }
-    if (rank.begin()->first < 0){
+    size_t best = rank[0];
+    if (results[best].rollouts == 0 && scores[best] < 0){
         logger.log("No viable moves found. Picking a random move...", COLOR_RED);
         return {(uint8_t)random(0, 3), false};
     }
 
-    return rank.begin()->second;
+    return {options[best].move_index, options[best].dmax};
 }
 
 
@@ -23,6 +23,13 @@ void calc_damage_range(
 );
 
 
+//  Damage range of one hit before crits. Returns the accuracy of the move.
+double damage_range(
+    const Pokemon& attacker, const Pokemon& defender,
+    size_t moveIdx, const Field& field, bool multipleTargets,
+    uint16_t& lower_bound, uint16_t& upper_bound
+);
+
 double damage_score(
     const Pokemon& attacker, const Pokemon& defender,
     size_t moveIdx, const Field& field, bool multipleTargets = false
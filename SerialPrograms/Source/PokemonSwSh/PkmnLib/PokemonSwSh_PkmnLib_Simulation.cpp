@@ -0,0 +1,372 @@
+/*  PkmnLib Simulation
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Concurrency/ComputationThreadPool.h"
+#include "PokemonSwSh_PkmnLib_Battle.h"
+#include "PokemonSwSh_PkmnLib_Simulation.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSwSh{
+namespace papkmnlib{
+
+
+
+//  SplitMix64. Fast, small, and good enough for dice rolls.
+class BattleSimulator::Random{
+public:
+    Random(uint64_t seed)
+        : m_state(seed)
+    {}
+
+    uint64_t next(){
+        uint64_t z = (m_state += 0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+    uint32_t next32(){
+        return (uint32_t)(next() >> 32);
+    }
+
+    //  Uniform in [0, n).
+    size_t below(size_t n){
+        return (size_t)(((uint64_t)next32() * n) >> 32);
+    }
+    bool chance(double probability){
+        return next32() < (uint64_t)(probability * 4294967296.);
+    }
+
+private:
+    uint64_t m_state;
+};
+
+
+struct BattleSimulator::BattleState{
+    uint16_t boss_hp;
+    uint8_t lives;
+    uint16_t hp[MAX_PLAYERS];
+    int8_t pp[MAX_PLAYERS][MAX_MOVES];
+    int8_t dmax_turns[MAX_PLAYERS];
+};
+
+
+
+BattleSimulator::DamageRange BattleSimulator::make_range(uint16_t lower, uint16_t upper, double accuracy){
+    accuracy = std::min(std::max(accuracy, 0.0), 1.0);
+    DamageRange range;
+    range.lower = std::min(lower, upper);
+    range.upper = upper;
+    range.hit_threshold = (uint64_t)(accuracy * 4294967296.);
+    range.expected = (lower + upper) * accuracy / 2;
+    return range;
+}
+
+BattleSimulator::BattleSimulator(
+    const Pokemon& boss,
+    const std::vector<SimulatedPlayer>& players, size_t self,
+    const Field& field, uint8_t lives
+)
+    : m_players(std::min(players.size(), MAX_PLAYERS))
+    , m_self(self)
+    , m_lives(std::max(lives, (uint8_t)1))
+{
+    if (m_self >= m_players || players[m_self].pokemon == nullptr){
+        throw InternalProgramError(
+            nullptr, PA_CURRENT_FUNCTION,
+            "Invalid player index: " + std::to_string(self)
+        );
+    }
+
+    //  Unknown HP comes in as garbage. Assume full HP.
+    auto starting_hp = [](const Pokemon& pokemon){
+        uint16_t hp = pokemon.current_hp();
+        return hp == 0 || hp > pokemon.max_hp() ? pokemon.max_hp() : hp;
+    };
+
+    Pokemon boss_normal = boss;
+    Pokemon boss_dmax = boss;
+    boss_normal.set_is_dynamax(false);
+    boss_dmax.set_is_dynamax(true);
+
+    m_boss_max_hp = std::max(boss.max_hp(), (uint16_t)1);
+    m_boss_hp = starting_hp(boss);
+    m_boss_moves = std::min(boss.num_moves(), MAX_MOVES);
+    for (size_t move = 0; move < m_boss_moves; move++){
+        m_boss_spread[move] = boss.move(move).is_spread();
+    }
+
+    for (size_t player = 0; player < m_players; player++){
+        const Pokemon* pokemon = players[player].pokemon;
+        if (pokemon == nullptr){
+            throw InternalProgramError(
+                nullptr, PA_CURRENT_FUNCTION,
+                "Missing Pokemon for player: " + std::to_string(player)
+            );
+        }
+
+        m_max_hp[player] = std::max(pokemon->max_hp(), (uint16_t)1);
+        m_hp[player] = starting_hp(*pokemon);
+        m_dmax_turns[player] = std::max(players[player].dmax_turns_left, (int8_t)0);
+        m_moves[player] = std::min(pokemon->num_moves(), MAX_MOVES);
+        m_before_boss[player] = pokemon->speed() >= boss.speed();
+
+        Pokemon attacker = *pokemon;
+        for (size_t move = 0; move < m_moves[player]; move++){
+            m_pp[player][move] = (int8_t)pokemon->pp(move);
+            m_wide_guard[player][move] = pokemon->move(move) == "wide-guard";
+
+            for (size_t dmax = 0; dmax < 2; dmax++){
+                attacker.set_is_dynamax(dmax != 0);
+                uint16_t lower, upper;
+                double accuracy = damage_range(attacker, boss_normal, move, field, false, lower, upper);
+                m_player_damage[player][dmax][move] = make_range(lower, upper, accuracy);
+            }
+        }
+
+        //  The boss hits whoever is out there. So compute it against the
+        //  player as they are now. (not dynamaxed)
+        Pokemon defender = *pokemon;
+        defender.set_is_dynamax(false);
+        for (size_t move = 0; move < m_boss_moves; move++){
+            uint16_t lower, upper;
+            double accuracy = damage_range(boss_normal, defender, move, field, m_boss_spread[move], lower, upper);
+            m_boss_damage[0][move][player] = make_range(lower, upper, accuracy);
+            accuracy = damage_range(boss_dmax, defender, move, field, false, lower, upper);
+            m_boss_damage[1][move][player] = make_range(lower, upper, accuracy);
+        }
+    }
+}
+
+
+uint16_t BattleSimulator::roll_damage(const DamageRange& range, Random& random){
+    if (random.next32() >= range.hit_threshold){
+        return 0;
+    }
+    uint32_t damage = range.lower + (uint32_t)random.below(range.upper - range.lower + 1);
+
+    //  Crits are 1 in 24 and do 1.5x.
+    if (random.below(24) == 0){
+        damage = damage * 3 / 2;
+    }
+    return (uint16_t)std::min(damage, (uint32_t)65535);
+}
+
+size_t BattleSimulator::pick_move(const BattleState& state, size_t player) const{
+    size_t dmax = state.dmax_turns[player] > 0 ? 1 : 0;
+    size_t best = MAX_MOVES;
+    double best_damage = -1;
+    for (size_t move = 0; move < m_moves[player]; move++){
+        if (state.pp[player][move] <= 0){
+            continue;
+        }
+        double damage = m_player_damage[player][dmax][move].expected;
+        if (damage > best_damage){
+            best = move;
+            best_damage = damage;
+        }
+    }
+    return best;
+}
+
+
+uint16_t BattleSimulator::rollout(const BattleOption& option, Random& random) const{
+    BattleState state;
+    state.boss_hp = m_boss_hp;
+    state.lives = m_lives;
+    for (size_t player = 0; player < m_players; player++){
+        state.hp[player] = m_hp[player];
+        state.dmax_turns[player] = m_dmax_turns[player];
+        for (size_t move = 0; move < MAX_MOVES; move++){
+            state.pp[player][move] = m_pp[player][move];
+        }
+    }
+    if (option.dmax && state.dmax_turns[m_self] <= 0){
+        state.dmax_turns[m_self] = DMAX_TURNS;
+    }
+
+    for (uint8_t turn = 0; turn < MAX_TURNS; turn++){
+        size_t moves[MAX_PLAYERS];
+        bool fainted[MAX_PLAYERS];
+        bool wide_guard = false;
+        for (size_t player = 0; player < m_players; player++){
+            size_t move = turn == 0 && player == m_self
+                ? std::min((size_t)option.move_index, MAX_MOVES)
+                : pick_move(state, player);
+            moves[player] = move;
+            fainted[player] = false;
+            if (move >= m_moves[player]){
+                moves[player] = MAX_MOVES;
+                continue;
+            }
+            state.pp[player][move]--;
+            if (state.dmax_turns[player] <= 0 && m_wide_guard[player][move]){
+                wide_guard = true;
+            }
+        }
+
+        auto player_attacks = [&](size_t player){
+            size_t move = moves[player];
+            if (move >= MAX_MOVES || fainted[player]){
+                return;
+            }
+            size_t dmax = state.dmax_turns[player] > 0 ? 1 : 0;
+            uint16_t damage = roll_damage(m_player_damage[player][dmax][move], random);
+            state.boss_hp = damage >= state.boss_hp ? 0 : state.boss_hp - damage;
+        };
+        auto hit_player = [&](size_t player, const DamageRange& range){
+            uint16_t damage = roll_damage(range, random);
+            if (damage < state.hp[player]){
+                state.hp[player] -= damage;
+                return;
+            }
+            //  Fainted. Costs a life and comes back next turn.
+            state.lives--;
+            state.hp[player] = m_max_hp[player];
+            state.dmax_turns[player] = 0;
+            fainted[player] = true;
+        };
+
+        for (size_t player = 0; player < m_players; player++){
+            if (m_before_boss[player]){
+                player_attacks(player);
+            }
+        }
+        if (state.boss_hp == 0){
+            return 0;
+        }
+
+        if (m_boss_moves > 0){
+            size_t move = random.below(m_boss_moves);
+            size_t dmax = random.chance(BOSS_MAX_MOVE_PROBABILITY) ? 1 : 0;
+            if (dmax == 0 && m_boss_spread[move]){
+                if (!wide_guard){
+                    for (size_t player = 0; player < m_players && state.lives > 0; player++){
+                        hit_player(player, m_boss_damage[0][move][player]);
+                    }
+                }
+            }else{
+                size_t player = random.below(m_players);
+                hit_player(player, m_boss_damage[dmax][move][player]);
+            }
+            if (state.lives == 0){
+                return state.boss_hp;
+            }
+        }
+
+        for (size_t player = 0; player < m_players; player++){
+            if (!m_before_boss[player]){
+                player_attacks(player);
+            }
+        }
+        if (state.boss_hp == 0){
+            return 0;
+        }
+
+        for (size_t player = 0; player < m_players; player++){
+            if (state.dmax_turns[player] > 0){
+                state.dmax_turns[player]--;
+            }
+        }
+    }
+
+    return state.boss_hp;
+}
+
+
+RolloutResult BattleSimulator::evaluate(const BattleOption& option, uint64_t rollouts, uint64_t seed) const{
+    Random random(seed);
+    RolloutResult result;
+    result.option = option;
+    uint64_t boss_hp = 0;
+    for (uint64_t c = 0; c < rollouts; c++){
+        uint16_t hp = rollout(option, random);
+        result.wins += hp == 0;
+        boss_hp += hp;
+    }
+    result.rollouts = rollouts;
+    result.boss_hp_left = rollouts == 0 ? 1.0 : (double)boss_hp / ((double)rollouts * m_boss_max_hp);
+    return result;
+}
+
+std::vector<RolloutResult> BattleSimulator::evaluate(
+    ComputationThreadPool& pool,
+    const std::vector<BattleOption>& options,
+    std::chrono::milliseconds budget,
+    uint64_t max_rollouts,
+    uint64_t seed
+) const{
+    //  Rollouts are handed out in chunks. The chunks of the different options
+    //  are interleaved so that if time runs out, they all have about the
+    //  same number of samples.
+    const uint64_t CHUNK = 256;
+
+    struct Counter{
+        std::atomic<uint64_t> rollouts{0};
+        std::atomic<uint64_t> wins{0};
+        std::atomic<double> boss_hp_left{0};
+    };
+
+    size_t count = options.size();
+    std::unique_ptr<Counter[]> counters(new Counter[count]);
+    uint64_t chunks = (max_rollouts + CHUNK - 1) / CHUNK;
+
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + budget;
+    std::atomic<bool> expired(false);
+
+    pool.parallel_for(0, (size_t)(chunks * count), [&](size_t index){
+        if (expired.load(std::memory_order_relaxed)){
+            return;
+        }
+        if (std::chrono::steady_clock::now() >= deadline){
+            expired.store(true, std::memory_order_relaxed);
+            return;
+        }
+
+        size_t option = index % count;
+        uint64_t chunk = index / count;
+        uint64_t rollouts = std::min(CHUNK, max_rollouts - chunk * CHUNK);
+
+        RolloutResult result = evaluate(options[option], rollouts, seed + index);
+
+        Counter& counter = counters[option];
+        counter.rollouts.fetch_add(result.rollouts, std::memory_order_relaxed);
+        counter.wins.fetch_add(result.wins, std::memory_order_relaxed);
+        double boss_hp_left = counter.boss_hp_left.load(std::memory_order_relaxed);
+        while (!counter.boss_hp_left.compare_exchange_weak(
+            boss_hp_left, boss_hp_left + result.boss_hp_left * result.rollouts,
+            std::memory_order_relaxed
+        ));
+    });
+
+    std::vector<RolloutResult> ret;
+    for (size_t c = 0; c < count; c++){
+        RolloutResult result;
+        result.option = options[c];
+        result.rollouts = counters[c].rollouts.load(std::memory_order_relaxed);
+        result.wins = counters[c].wins.load(std::memory_order_relaxed);
+        result.boss_hp_left = result.rollouts == 0
+            ? 1.0
+            : counters[c].boss_hp_left.load(std::memory_order_relaxed) / result.rollouts;
+        ret.emplace_back(result);
+    }
+    return ret;
+}
+
+
+
+}
+}
+}
+}
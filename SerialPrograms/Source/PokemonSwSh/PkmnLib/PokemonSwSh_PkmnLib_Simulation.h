@@ -0,0 +1,165 @@
+/*  PkmnLib Simulation
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Monte-Carlo rollouts of a Max Lair battle.
+ *
+ *  Every damage number the battle can need is computed once up front with
+ *  "damage_range()". After that a rollout is a few hundred bytes of state on
+ *  the stack and a random number generator. It never allocates and never
+ *  touches a Pokemon or Move object.
+ *
+ *  Each rollout plays out the rest of the battle:
+ *    - The deciding player uses the option being evaluated on the first turn.
+ *    - After that, every player uses its most damaging move that has PP left.
+ *    - Damage is rolled in the 85-100% range. Misses and crits are rolled.
+ *    - The boss uses a random move and a max move with some probability.
+ *      Single target moves hit a random player.
+ *    - A fainted player costs a life and comes back at full HP.
+ *
+ *  The battle is won if the boss faints. It is lost if the lives run out or
+ *  it lasts longer than the turn limit.
+ *
+ */
+
+#ifndef _PokemonAutomation_PokemonSwSh_PkmnLib_Simulation_H
+#define _PokemonAutomation_PokemonSwSh_PkmnLib_Simulation_H
+
+#include <stdint.h>
+#include <vector>
+#include <chrono>
+#include "PokemonSwSh_PkmnLib_Field.h"
+#include "PokemonSwSh_PkmnLib_Pokemon.h"
+
+namespace PokemonAutomation{
+    class ComputationThreadPool;
+namespace NintendoSwitch{
+namespace PokemonSwSh{
+namespace papkmnlib{
+
+
+struct SimulatedPlayer{
+    const Pokemon* pokemon = nullptr;
+    int8_t dmax_turns_left = 0;
+};
+
+struct BattleOption{
+    uint8_t move_index = 0;
+    bool dmax = false;
+};
+
+struct RolloutResult{
+    BattleOption option;
+    uint64_t rollouts = 0;
+    uint64_t wins = 0;
+
+    //  Average fraction of the boss HP left at the end. Tells options apart
+    //  when they all win or all lose.
+    double boss_hp_left = 0;
+
+    double win_rate() const{
+        return rollouts == 0 ? 0 : (double)wins / rollouts;
+    }
+
+    //  Variance of "win_rate()" as an estimate of the true win rate.
+    double win_rate_variance() const{
+        if (rollouts == 0){
+            return 0;
+        }
+        double p = win_rate();
+        return p * (1 - p) / rollouts;
+    }
+};
+
+
+class BattleSimulator{
+public:
+    static constexpr size_t MAX_PLAYERS = 4;
+    static constexpr size_t MAX_MOVES = 4;
+
+    //  Max Lair battles end after 10 turns.
+    static constexpr uint8_t MAX_TURNS = 10;
+
+    static constexpr uint8_t DMAX_TURNS = 3;
+
+    //  This is an estimate. There is no hard data for it. It is the same
+    //  value the matchup heuristic uses. (PokemonSwSh_PkmnLib_Matchup.cpp)
+    static constexpr double BOSS_MAX_MOVE_PROBABILITY = 0.3;
+
+public:
+    //  "players[self]" is the player making the decision.
+    BattleSimulator(
+        const Pokemon& boss,
+        const std::vector<SimulatedPlayer>& players, size_t self,
+        const Field& field, uint8_t lives
+    );
+
+    //  Run rollouts of every option in parallel on "pool" until each has
+    //  "max_rollouts" or "budget" runs out. Results are in the same order as
+    //  "options".
+    std::vector<RolloutResult> evaluate(
+        ComputationThreadPool& pool,
+        const std::vector<BattleOption>& options,
+        std::chrono::milliseconds budget,
+        uint64_t max_rollouts,
+        uint64_t seed
+    ) const;
+
+    //  Run "rollouts" rollouts of "option" on the calling thread.
+    RolloutResult evaluate(const BattleOption& option, uint64_t rollouts, uint64_t seed) const;
+
+
+private:
+    struct DamageRange{
+        uint16_t lower = 0;
+        uint16_t upper = 0;
+        uint64_t hit_threshold = 0;     //  Hits if a 32-bit random number is below this.
+        double expected = 0;
+    };
+
+    struct BattleState;
+    class Random;
+
+    //  Runs one battle to the end. Returns the HP the boss has left.
+    uint16_t rollout(const BattleOption& option, Random& random) const;
+
+    size_t pick_move(const BattleState& state, size_t player) const;
+
+    static DamageRange make_range(uint16_t lower, uint16_t upper, double accuracy);
+    static uint16_t roll_damage(const DamageRange& range, Random& random);
+
+
+private:
+    size_t m_players;
+    size_t m_self;
+    uint8_t m_lives;
+
+    uint16_t m_boss_hp;
+    uint16_t m_boss_max_hp;
+    size_t m_boss_moves;
+    bool m_boss_spread[MAX_MOVES] = {};
+
+    uint16_t m_hp[MAX_PLAYERS];
+    uint16_t m_max_hp[MAX_PLAYERS];
+    int8_t m_pp[MAX_PLAYERS][MAX_MOVES] = {};
+    int8_t m_dmax_turns[MAX_PLAYERS];
+    size_t m_moves[MAX_PLAYERS];
+    bool m_wide_guard[MAX_PLAYERS][MAX_MOVES];
+
+    //  Players that are faster than the boss move before it.
+    bool m_before_boss[MAX_PLAYERS];
+
+    //  [player][dmax][move]
+    DamageRange m_player_damage[MAX_PLAYERS][2][MAX_MOVES];
+
+    //  [dmax][move][player]
+    DamageRange m_boss_damage[2][MAX_MOVES][MAX_PLAYERS];
+};
+
+
+
+}
+}
+}
+}
+#endif
@@ -7,6 +7,9 @@
 
 #include "CommandLineTests.h"
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Concurrency/ParallelTaskRunner.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "PokemonLA_Tests.h"
 #include "TestMap.h"
@@ -15,8 +18,12 @@
 #include <QFileInfo>
 
 #include <iostream>
+#include <streambuf>
 #include <chrono>
 #include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
 #include <map>
 #include <list>
 #include <functional>
@@ -46,24 +53,221 @@ void print_equals(){
         } \
     } while (0)
 
-#define RETURN_IF_TEST_FAILED(test_func, file_path, num_passed) \
-    do { \
-        int _ret = 0; \
-        try { \
-            _ret = test_func(file_path); \
-        } catch (const std::exception& e) { \
-            cout << "Test: " << (file_path) << " threw exception: " << e.what() << endl; \
-        } catch (const Exception& e) {\
-           cout << "Test: " << (file_path) << " threw " << e.name() << ": <<<" << e.message() << ">>>" << endl; \
-        } \
-        if (_ret > 0) {\
-            print_equals(); \
-            cout << "Test: " << (file_path) << " failed." << endl; \
-            return _ret; \
-        } else if (_ret == 0){ \
-            num_passed++; \
-        } \
-    } while (0)
+// One test file and the function that tests it.
+struct TestCase{
+    // The test object folder, e.g. "PokemonLA/BattleMenuDetector". Printed once before its first test.
+    std::string test_object;
+    TestFunction test_func;
+    std::string file_path;
+};
+
+struct TestResult{
+    int ret = 0;
+    bool done = false;
+    std::chrono::microseconds time{0};
+    // Everything the test printed.
+    std::string output;
+};
+
+
+// Output from a thread that is running a test goes to that test's buffer
+// instead of the stream.
+thread_local std::string* t_test_output = nullptr;
+
+// Replaces the buffer of a stream for as long as it is alive. Output from
+// threads that are not running a test passes through to the old buffer.
+class TestOutputCapture : public std::streambuf{
+public:
+    TestOutputCapture(std::ostream& stream)
+        : m_stream(stream)
+        , m_original(stream.rdbuf(this))
+    {}
+    ~TestOutputCapture(){
+        m_stream.rdbuf(m_original);
+    }
+
+protected:
+    virtual int_type overflow(int_type ch) override{
+        if (traits_type::eq_int_type(ch, traits_type::eof())){
+            return traits_type::not_eof(ch);
+        }
+        char c = traits_type::to_char_type(ch);
+        xsputn(&c, 1);
+        return ch;
+    }
+    virtual std::streamsize xsputn(const char* str, std::streamsize count) override{
+        if (t_test_output != nullptr){
+            t_test_output->append(str, (size_t)count);
+            return count;
+        }
+        std::lock_guard<std::mutex> lg(m_lock);
+        return m_original->sputn(str, count);
+    }
+    virtual int sync() override{
+        if (t_test_output != nullptr){
+            return 0;
+        }
+        std::lock_guard<std::mutex> lg(m_lock);
+        return m_original->pubsync();
+    }
+
+private:
+    std::ostream& m_stream;
+    std::streambuf* m_original;
+    std::mutex m_lock;
+};
+
+
+// Call the test function. Same contract as TestFunction: returns 0 if the
+// test passed, > 0 if it failed and < 0 if the file was skipped.
+int run_test(const TestCase& test){
+    int ret = 0;
+    try{
+        ret = test.test_func(test.file_path);
+    }catch (const std::exception& e){
+        cout << "Test: " << test.file_path << " threw exception: " << e.what() << endl;
+    }catch (const Exception& e){
+        cout << "Test: " << test.file_path << " threw " << e.name() << ": <<<" << e.message() << ">>>" << endl;
+    }
+    return ret;
+}
+
+
+// Runs the tests on a thread pool and prints their output in order as they
+// finish. Stops at the first failed test.
+class ParallelTestRunner{
+public:
+    static constexpr size_t SLOWEST_TESTS = 10;
+
+    ParallelTestRunner(const std::vector<TestCase>& tests)
+        : m_tests(tests)
+        , m_results(tests.size())
+        , m_first_failure(SIZE_MAX)
+    {}
+
+    // Returns 0 if all tests passed. Otherwise the return value of the first failed test.
+    int run(size_t threads){
+        if (threads == 0){
+            threads = std::thread::hardware_concurrency();
+        }
+        threads = std::max<size_t>(threads, 1);
+        threads = std::min<size_t>(threads, std::max<size_t>(m_tests.size(), 1));
+        cout << "Running " << m_tests.size() << " test file" << (m_tests.size() != 1 ? "s" : "")
+             << " on " << threads << " thread" << (threads != 1 ? "s" : "") << "." << endl;
+
+        WallClock start = current_time();
+        {
+            TestOutputCapture capture_cout(cout);
+            TestOutputCapture capture_cerr(cerr);
+            ParallelTaskRunner runner(nullptr, 0, threads);
+            for (size_t index = 0; index < m_tests.size(); index++){
+                if (index > m_first_failure.load(std::memory_order_acquire)){
+                    break;
+                }
+                runner.dispatch([this, index]{ run_one(index); });
+            }
+            runner.wait_for_everything();
+        }
+        m_wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(current_time() - start);
+
+        size_t failed = m_first_failure.load(std::memory_order_acquire);
+        return failed == SIZE_MAX ? 0 : m_results[failed].ret;
+    }
+
+    size_t num_passed() const{
+        return m_num_passed;
+    }
+
+    void print_summary() const{
+        std::vector<size_t> order;
+        std::chrono::microseconds total(0);
+        for (size_t c = 0; c < m_results.size(); c++){
+            if (m_results[c].done){
+                order.emplace_back(c);
+                total += m_results[c].time;
+            }
+        }
+        if (order.empty()){
+            return;
+        }
+        std::sort(order.begin(), order.end(), [this](size_t a, size_t b){
+            return m_results[a].time > m_results[b].time;
+        });
+
+        print_equals();
+        cout << "Test time: " << tostr_fixed(total.count() / 1000000., 3) << " s"
+             << ", Wall time: " << tostr_fixed(m_wall_time.count() / 1000., 3) << " s" << endl;
+        cout << "Slowest tests:" << endl;
+        for (size_t c = 0; c < order.size() && c < SLOWEST_TESTS; c++){
+            const TestResult& result = m_results[order[c]];
+            cout << "    " << tostr_fixed(result.time.count() / 1000., 3) << " ms : " << m_tests[order[c]].file_path << endl;
+        }
+    }
+
+private:
+    void run_one(size_t index){
+        TestResult& result = m_results[index];
+
+        //  Don't bother running anything after a test that has already failed.
+        //  Everything before it still runs so that the first failure is the
+        //  same as it would be in order.
+        if (index <= m_first_failure.load(std::memory_order_acquire)){
+            t_test_output = &result.output;
+            WallClock time0 = current_time();
+            result.ret = run_test(m_tests[index]);
+            WallClock time1 = current_time();
+            t_test_output = nullptr;
+            result.time = std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0);
+
+            if (result.ret > 0){
+                size_t expected = m_first_failure.load(std::memory_order_acquire);
+                while (index < expected && !m_first_failure.compare_exchange_weak(expected, index)){}
+            }
+        }
+
+        std::lock_guard<std::mutex> lg(m_lock);
+        result.done = true;
+        print_finished();
+    }
+
+    //  Print every finished test that is next in order.
+    void print_finished(){
+        size_t failed = m_first_failure.load(std::memory_order_acquire);
+        while (m_next_print < m_results.size() && m_next_print <= failed && m_results[m_next_print].done){
+            const TestCase& test = m_tests[m_next_print];
+            const TestResult& result = m_results[m_next_print];
+
+            if (m_next_print == 0 || test.test_object != m_tests[m_next_print - 1].test_object){
+                print_equals();
+                cout << "Testing " << test.test_object << ":" << endl;
+            }else{
+                cout << "-------------------------------------------" << endl;
+            }
+            cout << test.file_path << endl;
+            cout << result.output;
+            cout << "(" << tostr_fixed(result.time.count() / 1000., 3) << " ms)" << endl;
+
+            if (result.ret > 0){
+                print_equals();
+                cout << "Test: " << test.file_path << " failed." << endl;
+            }else if (result.ret == 0){
+                m_num_passed++;
+            }
+            m_next_print++;
+        }
+    }
+
+private:
+    const std::vector<TestCase>& m_tests;
+    std::vector<TestResult> m_results;
+    std::atomic<size_t> m_first_failure;
+
+    std::mutex m_lock;
+    size_t m_next_print = 0;
+    size_t m_num_passed = 0;
+    std::chrono::milliseconds m_wall_time{0};
+};
+
 
 bool skip_ignored_path(const QString& file_path, const std::vector<QString>& ignore_list){
     for(const auto& path_prefix : ignore_list){
@@ -75,23 +279,33 @@ bool skip_ignored_path(const QString& file_path, const std::vector<QString>& ign
     return false;
 }
 
-int run_test_obj_dir(TestFunction test_func, const QString& directory_path, size_t& num_passed, const std::vector<QString>& ignore_list){
+// Gather the test files inside a directory in path order.
+void collect_test_obj_dir(
+    const std::string& test_object, const TestFunction& test_func, const QString& directory_path,
+    std::vector<TestCase>& tests, const std::vector<QString>& ignore_list
+){
     QDirIterator file_iter(directory_path, QDir::Filter::Files, QDirIterator::IteratorFlag::Subdirectories);
 
-    bool first_test_file = true;
+    //  The iteration order is up to the file system. Sort them so the output
+    //  is the same everywhere.
+    std::vector<QString> files;
     while (file_iter.hasNext()){
-        if (first_test_file == false){
-            cout << "-------------------------------------------" << endl;
-        }
-        first_test_file = false;
+        files.emplace_back(file_iter.next());
+    }
+    std::sort(files.begin(), files.end());
 
-        const QString next_file = file_iter.next();
+    for (const QString& next_file : files){
         
         // If filename starts with _, its considered a "hidden" file so skip it.
+        // The same goes for everything inside a folder that starts with _.
         const QFileInfo file_info(next_file);
         if (file_info.fileName().startsWith('_')){
             continue;
         }
+        const QString relative_path = QDir(directory_path).relativeFilePath(next_file);
+        if (relative_path.startsWith('_') || relative_path.contains("/_")){
+            continue;
+        }
         const std::string file_path = next_file.toStdString();
 
         // Check ignore list to determine whether to skip the test
@@ -99,23 +313,18 @@ int run_test_obj_dir(TestFunction test_func, const QString& directory_path, size
             continue;
         }
 
-        // Call the function to do the actual test:
-        cout << file_path << endl;
-        RETURN_IF_TEST_FAILED(test_func, file_path, num_passed);
+        tests.emplace_back(TestCase{test_object, test_func, file_path});
     }
-
-    return 0;
 }
 
-// Run the tests inside a folder representing a "test object".
+// Gather the tests inside a folder representing a "test object".
 // It is usually defined as one detector, e.g. CommandLineTests/PokemonLA/BattleMenuDetector/
-int run_test_obj(const std::string& test_space, const QFileInfo& obj_info, size_t& num_passed, const std::vector<QString>& ignore_list){
+int collect_test_obj(const std::string& test_space, const QFileInfo& obj_info, std::vector<TestCase>& tests, const std::vector<QString>& ignore_list){
     const std::string test_name = obj_info.fileName().toStdString();
     if (test_name == "." || test_name == ".."){
         return 0;
     }
 
-    print_equals();
     const TestFunction test_func = find_test_function(test_space, test_name);
     if (test_func == nullptr){
         // No corresponding test code, skip the folder.
@@ -126,16 +335,15 @@ int run_test_obj(const std::string& test_space, const QFileInfo& obj_info, size_
         return 0;
     }
 
-    cout << "Testing " << test_name << ":" << endl;
-
     // Recursively get test filenames, like:
     // ./CommandLineTests/PokemonLA/BattleMenuDetector/IngoBattleMenuDayTime_True.png
-    return run_test_obj_dir(test_func, obj_info.filePath(), num_passed, ignore_list);
+    collect_test_obj_dir(test_space + "/" + test_name, test_func, obj_info.filePath(), tests, ignore_list);
+    return 0;
 }
 
-// Run the tests inside a folder representing a "test space".
+// Gather the tests inside a folder representing a "test space".
 // It is usually defined as one pokemon game, e.g. CommandLineTests/PokemonLA/
-int run_test_space(const QFileInfo& space_info, size_t& num_passed, const std::vector<QString>& ignore_list){
+int collect_test_space(const QFileInfo& space_info, std::vector<TestCase>& tests, const std::vector<QString>& ignore_list){
     QDir sub_dir(space_info.filePath());
     if (!sub_dir.exists()){
         cerr << "Error: cannot access " << space_info.filePath().toStdString() << endl;
@@ -157,7 +365,7 @@ int run_test_space(const QFileInfo& space_info, size_t& num_passed, const std::v
     // ./CommandLineTests/PokemonLA/BattleMenuDetector/
     const QFileInfoList obj_list = sub_dir.entryInfoList();
     for(const QFileInfo& obj_info : obj_list){
-        RETURN_IF_NOT_ZERO(run_test_obj(test_space, obj_info, num_passed, ignore_list));
+        RETURN_IF_NOT_ZERO(collect_test_obj(test_space, obj_info, tests, ignore_list));
     }
 
     return 0;
@@ -181,7 +389,7 @@ int run_command_line_tests(){
 
     QFileInfo test_root_info(root_folder_name.c_str());
 
-    size_t num_passed = 0;
+    std::vector<TestCase> tests;
 
     const auto& selected_test_list = GlobalSettings::instance().COMMAND_LINE_TEST_LIST;
 
@@ -206,7 +414,7 @@ int run_command_line_tests(){
         test_root_dir.setFilter(QDir::Filter::Dirs);
         const QFileInfoList sub_dir_list = test_root_dir.entryInfoList();
         for(const QFileInfo& sub_dir_info : sub_dir_list){
-            RETURN_IF_NOT_ZERO(run_test_space(sub_dir_info, num_passed, ignore_list));
+            RETURN_IF_NOT_ZERO(collect_test_space(sub_dir_info, tests, ignore_list));
         }
     } else{
         // Only run on selected tests
@@ -259,7 +467,7 @@ int run_command_line_tests(){
             QFileInfo test_space_info(cur_dir.filePath(*it));
             cur_dir = QDir(test_space_info.filePath());
             if (path_components.size() == 1){
-                RETURN_IF_NOT_ZERO(run_test_space(test_space_info, num_passed, ignore_list));
+                RETURN_IF_NOT_ZERO(collect_test_space(test_space_info, tests, ignore_list));
                 continue;
             }
 
@@ -267,7 +475,7 @@ int run_command_line_tests(){
             std::string test_name = it->toStdString();
             QFileInfo test_obj_info(cur_dir.filePath(*it));
             if (path_components.size() == 2){
-                RETURN_IF_NOT_ZERO(run_test_obj(test_space, test_obj_info, num_passed, ignore_list));
+                RETURN_IF_NOT_ZERO(collect_test_obj(test_space, test_obj_info, tests, ignore_list));
                 continue;
             }
 
@@ -276,17 +484,24 @@ int run_command_line_tests(){
                 return 2;
             }
 
-            print_equals();
             if (selected_path_info.isFile()){
-                // Call the function to do the actual test:
-                RETURN_IF_TEST_FAILED(test_func, full_path_cleaned.toStdString(), num_passed);
+                tests.emplace_back(TestCase{test_space + "/" + test_name, test_func, full_path_cleaned.toStdString()});
             } else{
                 // selected_path_info is a directory, go through each file recursively in the directory
-                RETURN_IF_NOT_ZERO(run_test_obj_dir(test_func, full_path_cleaned, num_passed, ignore_list));
+                collect_test_obj_dir(test_space + "/" + test_name, test_func, full_path_cleaned, tests, ignore_list);
             }
         } // end selected_test_list
     }
 
+    // Run everything that was gathered.
+    ParallelTestRunner runner(tests);
+    const int ret = runner.run(GlobalSettings::instance().COMMAND_LINE_TEST_THREADS);
+    runner.print_summary();
+    if (ret != 0){
+        return ret;
+    }
+
+    const size_t num_passed = runner.num_passed();
     print_equals();
     cout << num_passed << " test" << (num_passed > 1 ? "s" : "") << " passed" << std::endl;
     return 0;
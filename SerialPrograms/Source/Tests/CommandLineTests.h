@@ -45,6 +45,16 @@
  *  "20-GlobalSettings": "COMMAND_LINE_TESTS": "IGNORE_LIST" as a list of strings to skip the paths to those tests.
  *  Each string in the list serves as a prefix to the test path that the test framework uses to filter out paths.
  *  
+ *  Tests run one at a time by default. Set "20-GlobalSettings": "COMMAND_LINE_TESTS": "THREADS" to run that many at the same
+ *  time, or to 0 to use all cores. Parallel runs are opt-in because the tests have not all been checked for thread safety:
+ *  test functions running at the same time must not share mutable state, output printed by threads that a test starts itself is
+ *  not captured, and stream formatting state (std::setw(), flags) on cout and cerr is shared between tests.
+ *  Everything a test prints to cout or cerr is held until the test finishes and then printed in path order, so the output is the
+ *  same no matter how many threads are used. Each test's time is printed after it, and the slowest tests are listed at the end.
+ *  If a test fails, no new tests are started and the output stops at the first failed test, the same as running them in order.
+ *
+ *  Files whose names start with "_" are "hidden" and are not run as tests. The same goes for all the files inside a folder
+ *  whose name starts with "_".
  * Those "hidden" files are useful for storing some metadata in the folder, or serving as an extra file in case some tests need more than one test files.
  * 
  *  How to add new test code:
@@ -81,6 +91,29 @@
  *  - Write the function declaration in PokemonLA_Tests.h
  *  - Add a new entry to TestMap.cpp:TEST_MAP by utilizing screen_bool_detector_helper:
  *    {"PokemonLA_BattleMenuDetector", std::bind(screen_bool_detector_helper, test_pokemonLA_BattleMenuDetector, _1)}
+ *
+ *  Video replay tests:
+ *
+ *  To benchmark visual inference callbacks on real gameplay, a test object can replay recordings through a set of callbacks
+ *  instead of testing single images. See TestMap.cpp:video_replay_helper. A test file is either:
+ *  - An MJPEG AVI, like the clips saved by the rolling video buffer.
+ *  - A .replay text file whose first line is the path to a folder of frames, relative to the .replay file. Put the frames in
+ *    a hidden folder (e.g. "_BattleClip01/") so they aren't run as tests themselves. Frames named "...-<time>ms.jpg" are
+ *    played at those times, otherwise at 10 fps.
+ *  The test prints the time spent in each callback and when each one triggered. If the file name ends with _True or _False,
+ *  the test also checks whether any callback triggered. The callbacks are run as fast as possible while keeping the same
+ *  schedule they would have live. Set "20-GlobalSettings": "COMMAND_LINE_TESTS": "REPLAY_REAL_TIME" to true to play them
+ *  in real time on a real inference pivot instead.
+ *  To add a set of callbacks, write a function that constructs them (e.g. PokemonSV_Tests.cpp:make_pokemonSV_BattleCallbacks)
+ *  and add it to TEST_MAP:
+ *    {"PokemonSV_BattleReplay", std::bind(video_replay_helper, make_pokemonSV_BattleCallbacks, _1)}
+ *
+ *  Audio replay tests work the same way with TestMap.cpp:audio_replay_helper. The test file is a .wav or .mp3 recorded at
+ *  48000 Hz. It is pushed through the real audio pipeline (AudioStreamToFloat -> AudioFloatToFFT -> AudioSpectrumHolder) and
+ *  the test prints the time spent in each detector, when each one triggered and, for spectrogram detectors, the error
+ *  coefficient of each detection. The function that constructs the detectors is given a dummy ConsoleHandle to build them on
+ *  (e.g. PokemonLA_Tests.cpp:make_pokemonLA_ShinySoundCallbacks):
+ *    {"PokemonLA_ShinySoundReplay", std::bind(audio_replay_helper, make_pokemonLA_ShinySoundCallbacks, _1)}
  */
 
 
@@ -5,11 +5,19 @@
  */
 
 
+#include <cmath>
+#include <tuple>
+#include <algorithm>
 #include "Common/Compiler.h"
+#include "Common/Cpp/Color.h"
 #include "Common/Cpp/Time.h"
+#include "Kernels/Waterfill/Kernels_Waterfill_Types.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/ImageMatch/WaterfillTemplateMatcher.h"
+#include "CommonFramework/ImageTools/WaterfillUtilities.h"
 #include "CommonFramework/Inference/BlackBorderDetector.h"
+#include "CommonFramework/Inference/BlackScreenDetector.h"
 #include "CommonFramework_Tests.h"
 #include "TestUtils.h"
 
@@ -32,4 +40,228 @@ int test_CommonFramework_BlackBorderDetector(const ImageViewRGB32& image, bool t
 }
 
 
+
+namespace{
+
+//  A disc with a wedge cut out of its right side. Red with a gradient so that
+//  the RMSD has some detail to match. Transparent outside the shape.
+ImageRGB32 make_coarse_to_fine_template(size_t size){
+    ImageRGB32 ret(size, size);
+    ret.fill(0);
+    const double radius = size / 2.0;
+    for (size_t y = 0; y < size; y++){
+        for (size_t x = 0; x < size; x++){
+            double dx = x + 0.5 - radius;
+            double dy = y + 0.5 - radius;
+            if (dx*dx + dy*dy > radius*radius){
+                continue;
+            }
+            if (dx > 0 && std::abs(dy) < dx * 0.6){
+                continue;
+            }
+            ret.pixel(x, y) = combine_rgb((uint8_t)(160 + 95 * x / size), (uint8_t)(10 + 60 * y / size), 30);
+        }
+    }
+    return ret;
+}
+
+void fill_box(ImageRGB32& image, size_t x, size_t y, size_t width, size_t height, uint32_t pixel){
+    for (size_t r = 0; r < height; r++){
+        for (size_t c = 0; c < width; c++){
+            image.pixel(x + c, y + r) = pixel;
+        }
+    }
+}
+
+//  Paint the opaque pixels of "sprite" onto "image".
+void paint_sprite(ImageRGB32& image, const ImageViewRGB32& sprite, size_t x, size_t y){
+    for (size_t r = 0; r < sprite.height(); r++){
+        for (size_t c = 0; c < sprite.width(); c++){
+            uint32_t pixel = sprite.pixel(c, r);
+            if ((pixel >> 24) != 0){
+                image.pixel(x + c, y + r) = pixel;
+            }
+        }
+    }
+}
+
+struct MatchedObject{
+    size_t min_x;
+    size_t min_y;
+    size_t max_x;
+    size_t max_y;
+    size_t area;
+
+    bool operator<(const MatchedObject& x) const{
+        return std::tie(min_y, min_x, max_y, max_x, area) < std::tie(x.min_y, x.min_x, x.max_y, x.max_x, x.area);
+    }
+    bool operator==(const MatchedObject& x) const{
+        return std::tie(min_y, min_x, max_y, max_x, area) == std::tie(x.min_y, x.min_x, x.max_y, x.max_x, x.area);
+    }
+};
+
+}
+
+
+//  Plant copies of a template at several sizes on the image along with shapes
+//  that only look like it at a glance. Then check that the coarse-to-fine
+//  search only matches what the exhaustive search matches, and that it finds
+//  every copy that is still a few pixels wide after downsampling.
+int test_CommonFramework_WaterfillCoarseToFine(const ImageViewRGB32& image){
+    using Kernels::Waterfill::WaterfillObject;
+
+    const size_t CELL = 128;
+    const size_t columns = image.width() / CELL;
+    const size_t rows = image.height() / CELL;
+    cout << "Testing test_CommonFramework_WaterfillCoarseToFine(), image size " << image.width() << " x " << image.height() << endl;
+    if (columns == 0 || rows == 0){
+        cerr << "Error: image must be at least " << CELL << " x " << CELL << "." << endl;
+        return 1;
+    }
+
+    const Color min_color(150, 0, 0);
+    const Color max_color(255, 100, 100);
+    ImageRGB32 reference = make_coarse_to_fine_template(64);
+    ImageMatch::WaterfillTemplateMatcher matcher(reference, min_color, max_color, 100);
+
+    //  Every 5th cell keeps the original image. The rest are cleared and get
+    //  one shape each.
+    const size_t SIZES[] = {24, 32, 48, 64, 96, 112};
+    struct Planted{
+        size_t x;
+        size_t y;
+        size_t size;
+    };
+    std::vector<Planted> planted;
+    ImageRGB32 canvas = image.copy();
+    for (size_t i = 0; i < rows * columns; i++){
+        if (i % 5 == 4){
+            continue;
+        }
+        const size_t cell_x = i % columns * CELL;
+        const size_t cell_y = i / columns * CELL;
+        fill_box(canvas, cell_x, cell_y, CELL, CELL, combine_rgb(0, 0, 0));
+
+        const size_t size = SIZES[i / 5 % (sizeof(SIZES) / sizeof(SIZES[0]))];
+        const size_t x = cell_x + (CELL - size) / 2;
+        const size_t y = cell_y + (CELL - size) / 2;
+        const uint32_t red = combine_rgb(220, 40, 30);
+        switch (i % 5){
+        case 0:
+            paint_sprite(canvas, reference.scale_to(size, size), x, y);
+            planted.emplace_back(Planted{x, y, size});
+            break;
+        case 1:
+            //  Right size and color, wrong shape.
+            fill_box(canvas, x, y + size / 4, size, size / 2, red);
+            break;
+        case 2:{
+            //  A full disc. Close in shape, but the wedge is missing.
+            ImageRGB32 disc(size, size);
+            disc.fill(0);
+            for (size_t r = 0; r < size; r++){
+                for (size_t c = 0; c < size; c++){
+                    double dx = c + 0.5 - size / 2.0;
+                    double dy = r + 0.5 - size / 2.0;
+                    if (dx*dx + dy*dy <= size * size / 4.0){
+                        disc.pixel(c, r) = red;
+                    }
+                }
+            }
+            paint_sprite(canvas, disc, x, y);
+            break;
+        }
+        case 3:
+            //  The template touching a bar. Neither search should see the
+            //  template on its own.
+            paint_sprite(canvas, reference.scale_to(size, size), x, y);
+            fill_box(canvas, cell_x, y + size / 2, CELL, 2, red);
+            break;
+        }
+    }
+
+    const std::vector<std::pair<uint32_t, uint32_t>> filters{{(uint32_t)min_color, (uint32_t)max_color}};
+    const std::pair<size_t, size_t> area_thresholds(200, SIZE_MAX);
+    const double rmsd_threshold = 80;
+
+    auto run = [&](const char* name, auto&& search){
+        std::vector<MatchedObject> matched;
+        WallClock start = current_time();
+        search([&](WaterfillObject& object){
+            matched.emplace_back(MatchedObject{object.min_x, object.min_y, object.max_x, object.max_y, object.area});
+            return false;
+        });
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(current_time() - start).count();
+        cout << name << ": " << matched.size() << " matched in " << elapsed << " us" << endl;
+        std::sort(matched.begin(), matched.end());
+        return matched;
+    };
+    //  Whether a planted template was matched. Its cell is otherwise empty, so
+    //  anything big matched inside its box is the template. (The wedge makes
+    //  the object narrower than the sprite.)
+    auto found = [](const std::vector<MatchedObject>& matched, const Planted& item){
+        for (const MatchedObject& object : matched){
+            if (item.x <= object.min_x && object.max_x <= item.x + item.size &&
+                item.y <= object.min_y && object.max_y <= item.y + item.size &&
+                object.max_x - object.min_x >= item.size / 2
+            ){
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::vector<MatchedObject> exhaustive = run("Exhaustive", [&](auto&& callback){
+        match_template_by_waterfill(canvas, matcher, filters, area_thresholds, rmsd_threshold, callback);
+    });
+    for (const Planted& item : planted){
+        if (!found(exhaustive, item)){
+            cerr << "Error: exhaustive search missed the template at (" << item.x << ", " << item.y << "), size " << item.size << "." << endl;
+            return 1;
+        }
+    }
+
+    for (size_t scale : {2, 4}){
+        WaterfillPyramidOptions options;
+        options.scale = scale;
+        std::string name = "Coarse-to-fine x" + std::to_string(scale);
+        std::vector<MatchedObject> coarse_to_fine = run(name.c_str(), [&](auto&& callback){
+            match_template_by_waterfill_coarse_to_fine(canvas, matcher, filters, area_thresholds, rmsd_threshold, callback, options);
+        });
+
+        //  Everything it matches must also be matched by the exhaustive search.
+        for (size_t c = 1; c < coarse_to_fine.size(); c++){
+            TEST_RESULT_COMPONENT_EQUAL(coarse_to_fine[c - 1] == coarse_to_fine[c], false, name + " duplicate match");
+        }
+        TEST_RESULT_COMPONENT_EQUAL(
+            std::includes(exhaustive.begin(), exhaustive.end(), coarse_to_fine.begin(), coarse_to_fine.end()),
+            true, name + " subset of exhaustive"
+        );
+
+        //  Templates that are at least 16 pixels wide after downsampling must
+        //  not be lost.
+        for (const Planted& item : planted){
+            if (item.size < 16 * scale){
+                continue;
+            }
+            if (!found(coarse_to_fine, item)){
+                cerr << "Error: " << name << " missed the template at (" << item.x << ", " << item.y << "), size " << item.size << "." << endl;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+std::vector<std::unique_ptr<VisualInferenceCallback>> make_CommonFramework_ScreenTransitionCallbacks(){
+    return make_callback_set<VisualInferenceCallback>(
+        std::make_unique<BlackScreenWatcher>(),
+        std::make_unique<BlackScreenOverWatcher>(),
+        std::make_unique<WhiteScreenOverWatcher>()
+    );
+}
+
+
 }
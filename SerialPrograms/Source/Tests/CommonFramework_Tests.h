@@ -9,12 +9,20 @@
 #ifndef PokemonAutomation_Tests_CommonFramework_Tests_H
 #define PokemonAutomation_Tests_CommonFramework_Tests_H
 
+#include <vector>
+#include <memory>
+
 namespace PokemonAutomation{
 
 class ImageViewRGB32;
+class VisualInferenceCallback;
 
 int test_CommonFramework_BlackBorderDetector(const ImageViewRGB32& image, bool target);
 
+int test_CommonFramework_WaterfillCoarseToFine(const ImageViewRGB32& image);
+
+std::vector<std::unique_ptr<VisualInferenceCallback>> make_CommonFramework_ScreenTransitionCallbacks();
+
 }
 
 #endif
@@ -0,0 +1,1002 @@
+/*  Kernel Benchmarks
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Common/Cpp/Containers/AlignedVector.h"
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Json/JsonLazyObject.h"
+#include "Common/Cpp/Json/JsonTools.h"
+#include "CommonFramework/Globals.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/Environment/Environment.h"
+#include "Kernels/AbsFFT/Kernels_AbsFFT.h"
+#include "Kernels/AudioStreamConversion/AudioStreamConversion.h"
+#include "Kernels/BinaryMatrix/Kernels_BinaryMatrix.h"
+#include "Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.h"
+#include "Kernels/ImageFilters/Kernels_ImageFilter_Basic.h"
+#include "Kernels/ImageFilters/Kernels_ImageFilter_RgbToHsv.h"
+#include "Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqr.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelMoments.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelBlockSums.h"
+#include "Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch.h"
+#include "Kernels/SpikeConvolution/Kernels_SpikeConvolution.h"
+#include "Kernels/Waterfill/Kernels_Waterfill.h"
+#include "KernelBenchmarks.h"
+
+#include <iostream>
+#include <iomanip>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+namespace PokemonAutomation{
+
+using namespace Kernels;
+
+
+
+namespace{
+
+
+struct ImageSize{
+    size_t width;
+    size_t height;
+
+    std::string str() const{
+        return std::to_string(width) + "x" + std::to_string(height);
+    }
+};
+
+//  From a small inference box up to a full 1080p frame.
+const ImageSize IMAGE_SIZES[] = {
+    {64, 64},
+    {320, 180},
+    {960, 540},
+    {1920, 1080},
+};
+
+//  Spectrogram shapes. (frequencies x windows)
+const ImageSize SPECTROGRAM_SIZES[] = {
+    {64, 8},
+    {256, 40},
+    {1024, 100},
+};
+
+//  Samples per call for the audio kernels.
+const size_t AUDIO_LENGTHS[] = {1024, 16384, 262144};
+const size_t SPIKE_LENGTHS[] = {512, 2048, 8192};
+const int FFT_POWERS[] = {8, 10, 12, 14};
+
+//  Big resources that are loaded at startup. Relative to RESOURCE_PATH().
+const char* JSON_RESOURCES[] = {
+    "PokemonSwSh/MaxLair/rental_pokemon.json",
+    "PokemonSwSh/MaxLair/boss_matchup_LUT.json",
+    "Pokemon/PokemonNameDisplay.json",
+    "Pokemon/PokemonNameOCR/PokemonOCR-eng.json",
+    "PokemonLA/PokemonSprites.json",
+};
+
+
+//  Each timed batch is sized to take about this long.
+const std::chrono::microseconds TARGET_BATCH_TIME(1000);
+const std::chrono::milliseconds WARMUP_TIME(20);
+const size_t MAX_BATCH = 10000;
+
+//  Flag a benchmark as a regression if both its median over the rounds and
+//  its fastest sample are this much slower than the baseline. Single medians
+//  on a busy machine vary by more than 10% from run to run. Load only ever
+//  makes things slower, so a real regression also shows up in the minimum.
+const double REGRESSION_THRESHOLD = 1.25;
+
+//  Floating-point kernels may round differently at each level. (e.g. FMA)
+const double FLOAT_TOLERANCE = 1e-3;
+//  Integer kernels that go through floating-point may round some values to
+//  the other neighbor. (e.g. scale_brightness() and the euclidean filters)
+const double ROUNDING_TOLERANCE = 1e-2;
+
+
+//  Results of kernels that return something go here so that the calls
+//  can't be optimized out.
+volatile uint64_t sink;
+
+
+//  Deterministic noise so every run and every commit sees the same data.
+class Noise{
+public:
+    Noise(uint32_t seed = 1)
+        : m_state(seed)
+    {}
+    uint32_t next(){
+        m_state = m_state * 1664525 + 1013904223;
+        return m_state;
+    }
+
+private:
+    uint32_t m_state;
+};
+
+AlignedVector<uint32_t> make_noise_image(const ImageSize& size){
+    AlignedVector<uint32_t> image(size.width * size.height);
+    Noise noise;
+    for (uint32_t& pixel : image){
+        pixel = noise.next() | 0xff000000;
+    }
+    return image;
+}
+AlignedVector<float> make_noise_floats(size_t length){
+    AlignedVector<float> data(length);
+    Noise noise;
+    for (float& x : data){
+        x = (float)(noise.next() >> 8) / (1 << 24) - 0.5f;
+    }
+    return data;
+}
+std::unique_ptr<PackedBinaryMatrix_IB> make_noise_matrix(const ImageSize& size){
+    AlignedVector<uint32_t> image = make_noise_image(size);
+    std::unique_ptr<PackedBinaryMatrix_IB> matrix = make_PackedBinaryMatrix(get_BinaryMatrixType(), size.width, size.height);
+    compress_rgb32_to_binary_range(
+        image.data(), size.width * sizeof(uint32_t), *matrix,
+        0xff000000, 0xffffff7f
+    );
+    return matrix;
+}
+
+
+//  Exact digest of a buffer for the output checks. Cut to 53 bits so it
+//  survives being stored as a double.
+double hash_bytes(const void* data, size_t bytes){
+    const uint8_t* ptr = (const uint8_t*)data;
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t c = 0; c < bytes; c++){
+        hash ^= ptr[c];
+        hash *= 1099511628211ull;
+    }
+    return (double)(hash >> 11);
+}
+double hash_matrix(const PackedBinaryMatrix_IB& matrix){
+    std::string bits = matrix.dump();
+    return hash_bytes(bits.data(), bits.size());
+}
+//  Digest of a buffer that can be compared with a tolerance. The positive
+//  and negative parts are summed separately so they don't cancel out.
+template <typename Type>
+std::vector<double> sum_digest(const Type* data, size_t length){
+    double positive = 0;
+    double negative = 0;
+    for (size_t c = 0; c < length; c++){
+        double x = (double)data[c];
+        (x < 0 ? negative : positive) += std::abs(x);
+    }
+    return {positive, negative};
+}
+//  Sum of each channel, to be compared with ROUNDING_TOLERANCE.
+std::vector<double> pixel_digest(const uint32_t* pixels, size_t count){
+    std::vector<double> sums(4);
+    for (size_t c = 0; c < count; c++){
+        uint32_t pixel = pixels[c];
+        sums[0] += pixel & 0xff;
+        sums[1] += (pixel >> 8) & 0xff;
+        sums[2] += (pixel >> 16) & 0xff;
+        sums[3] += pixel >> 24;
+    }
+    return sums;
+}
+double count_ones(const PackedBinaryMatrix_IB& matrix){
+    std::string bits = matrix.dump();
+    return (double)std::count(bits.begin(), bits.end(), '1');
+}
+
+
+
+struct BenchmarkResult{
+    std::string family;
+    std::string kernel;
+    std::string size;
+    std::string level;
+
+    size_t bytes = 0;       //  Bytes read + written per call.
+    size_t batch = 0;       //  Calls per timed batch.
+    double median_ns = 0;
+    double p95_ns = 0;
+    double min_ns = 0;
+
+    std::string key() const{
+        return family + "/" + kernel + "/" + size + "/" + level;
+    }
+    double gbps() const{
+        return median_ns > 0 ? bytes / median_ns : 0;
+    }
+
+    JsonObject to_json() const{
+        JsonObject obj;
+        obj["Family"] = family;
+        obj["Kernel"] = kernel;
+        obj["Size"] = size;
+        obj["Level"] = level;
+        obj["Bytes"] = bytes;
+        obj["Batch"] = batch;
+        obj["MedianNs"] = median_ns;
+        obj["P95Ns"] = p95_ns;
+        obj["MinNs"] = min_ns;
+        obj["GBps"] = gbps();
+        return obj;
+    }
+};
+
+
+class BenchmarkRunner{
+public:
+    BenchmarkRunner(size_t repetitions)
+        : m_repetitions(repetitions)
+    {}
+
+    void set_level(std::string level){
+        m_level = std::move(level);
+    }
+    std::vector<BenchmarkResult>& results(){
+        return m_results;
+    }
+    size_t failures() const{
+        return m_failures;
+    }
+
+    //  Report a kernel that gave the wrong answer.
+    void fail(const std::string& message){
+        cerr << "Failed: " << message << endl;
+        m_failures++;
+    }
+
+    //  Compare a digest of a kernel's output against the first level that
+    //  ran the same kernel and size. That is the C++ only level since it is
+    //  always run first.
+    void check(
+        const char* family, const char* kernel, const std::string& size,
+        std::vector<double> values, double tolerance = 0
+    ){
+        std::string key = std::string(family) + "/" + kernel + "/" + size;
+        auto iter = m_references.find(key);
+        if (iter == m_references.end()){
+            m_references.emplace(std::move(key), Reference{m_level, std::move(values)});
+            return;
+        }
+        const Reference& reference = iter->second;
+        bool same = reference.values.size() == values.size();
+        for (size_t c = 0; same && c < values.size(); c++){
+            double x = reference.values[c];
+            same = std::abs(values[c] - x) <= tolerance * std::max(std::abs(x), 1.);
+        }
+        if (!same){
+            fail(key + ": " + m_level + " does not match " + reference.level + ".");
+        }
+    }
+
+    //  "prepare(batch)" is called before each timed batch and is not timed.
+    //  "run(index)" is called "batch" times per batch.
+    template <typename PrepareFunction, typename RunFunction>
+    void run(
+        const char* family, const char* kernel, const std::string& size, size_t bytes,
+        PrepareFunction&& prepare, RunFunction&& run
+    ){
+        //  Warmup. This also estimates how long a call takes.
+        size_t calls = 0;
+        WallClock start = current_time();
+        WallClock now;
+        do{
+            prepare(1);
+            run(0);
+            calls++;
+            now = current_time();
+        }while (calls < 2 || now - start < WARMUP_TIME);
+
+        double call_ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count() / calls;
+        size_t batch = (size_t)(std::chrono::duration_cast<std::chrono::nanoseconds>(TARGET_BATCH_TIME).count() / std::max(call_ns, 1.));
+        batch = std::max<size_t>(batch, 1);
+        batch = std::min<size_t>(batch, MAX_BATCH);
+
+        std::vector<double> samples;
+        samples.reserve(m_repetitions);
+        for (size_t r = 0; r < m_repetitions; r++){
+            prepare(batch);
+            WallClock time0 = current_time();
+            for (size_t c = 0; c < batch; c++){
+                run(c);
+            }
+            WallClock time1 = current_time();
+            samples.emplace_back((double)std::chrono::duration_cast<std::chrono::nanoseconds>(time1 - time0).count() / batch);
+        }
+        std::sort(samples.begin(), samples.end());
+
+        BenchmarkResult result;
+        result.family = family;
+        result.kernel = kernel;
+        result.size = size;
+        result.level = m_level;
+        result.bytes = bytes;
+        result.batch = batch;
+        result.median_ns = samples[samples.size() / 2];
+        result.p95_ns = samples[std::min(samples.size() - 1, (size_t)std::ceil(samples.size() * 0.95) - 1)];
+        result.min_ns = samples[0];
+
+        cout << std::left << std::setw(72) << result.key()
+             << std::right << std::setw(14) << tostr_fixed(result.median_ns / 1000, 3) << " us"
+             << std::setw(14) << tostr_fixed(result.p95_ns / 1000, 3) << " us"
+             << std::setw(10) << tostr_fixed(result.gbps(), 2) << " GB/s" << endl;
+
+        m_results.emplace_back(std::move(result));
+    }
+    template <typename RunFunction>
+    void run(
+        const char* family, const char* kernel, const std::string& size, size_t bytes,
+        RunFunction&& run
+    ){
+        this->run(family, kernel, size, bytes, [](size_t){}, std::forward<RunFunction>(run));
+    }
+
+private:
+    struct Reference{
+        std::string level;
+        std::vector<double> values;
+    };
+
+    const size_t m_repetitions;
+    std::string m_level;
+    std::vector<BenchmarkResult> m_results;
+    std::map<std::string, Reference> m_references;
+    size_t m_failures = 0;
+};
+
+
+
+void benchmark_ImageFilters(BenchmarkRunner& runner){
+    const char* FAMILY = "ImageFilters";
+    for (const ImageSize& size : IMAGE_SIZES){
+        const size_t w = size.width;
+        const size_t h = size.height;
+        const size_t bytes_per_row = w * sizeof(uint32_t);
+        const size_t pixels = w * h;
+        AlignedVector<uint32_t> in = make_noise_image(size);
+        AlignedVector<uint32_t> out(pixels);
+
+        size_t count = 0;
+
+        runner.run(FAMILY, "filter_rgb32_range", size.str(), pixels * 8, [&](size_t){
+            sink = count = filter_rgb32_range(
+                in.data(), bytes_per_row, w, h,
+                out.data(), bytes_per_row,
+                0xff404040, 0xffc0c0c0, 0xff000000, false
+            );
+        });
+        runner.check(FAMILY, "filter_rgb32_range", size.str(), {(double)count, hash_bytes(out.data(), pixels * 4)});
+
+        runner.run(FAMILY, "filter_rgb32_euclidean", size.str(), pixels * 8, [&](size_t){
+            sink = count = filter_rgb32_euclidean(
+                in.data(), bytes_per_row, w, h,
+                out.data(), bytes_per_row,
+                0xff808080, 100, 0xff000000, false
+            );
+        });
+        std::vector<double> digest = pixel_digest(out.data(), pixels);
+        digest.emplace_back((double)count);
+        runner.check(FAMILY, "filter_rgb32_euclidean", size.str(), std::move(digest), ROUNDING_TOLERANCE);
+
+        runner.run(FAMILY, "to_blackwhite_rgb32_range", size.str(), pixels * 8, [&](size_t){
+            sink = count = to_blackwhite_rgb32_range(
+                in.data(), bytes_per_row, w, h,
+                out.data(), bytes_per_row,
+                0xff404040, 0xffc0c0c0, true
+            );
+        });
+        runner.check(FAMILY, "to_blackwhite_rgb32_range", size.str(), {(double)count, hash_bytes(out.data(), pixels * 4)});
+
+        runner.run(FAMILY, "convert_rgb32_to_hsv32", size.str(), pixels * 8, [&](size_t){
+            convert_rgb32_to_hsv32(
+                in.data(), bytes_per_row, w, h,
+                out.data(), bytes_per_row
+            );
+        });
+        runner.check(FAMILY, "convert_rgb32_to_hsv32", size.str(), {hash_bytes(out.data(), pixels * 4)});
+    }
+}
+void benchmark_ImageScaleBrightness(BenchmarkRunner& runner){
+    const char* FAMILY = "ImageScaleBrightness";
+    for (const ImageSize& size : IMAGE_SIZES){
+        const size_t pixels = size.width * size.height;
+        AlignedVector<uint32_t> image = make_noise_image(size);
+
+        //  A scale of 1 keeps the image the same from one call to the next.
+        runner.run(FAMILY, "scale_brightness", size.str(), pixels * 8, [&](size_t){
+            scale_brightness(
+                size.width, size.height,
+                image.data(), size.width * sizeof(uint32_t),
+                1.0f, 1.0f, 1.0f
+            );
+        });
+
+        //  That doesn't check much. So check one call with real scales.
+        scale_brightness(
+            size.width, size.height,
+            image.data(), size.width * sizeof(uint32_t),
+            1.2f, 0.9f, 0.5f
+        );
+        runner.check(FAMILY, "scale_brightness", size.str(), pixel_digest(image.data(), pixels), ROUNDING_TOLERANCE);
+    }
+}
+void benchmark_ImageStats(BenchmarkRunner& runner){
+    const char* FAMILY = "ImageStats";
+    for (const ImageSize& size : IMAGE_SIZES){
+        const size_t w = size.width;
+        const size_t h = size.height;
+        const size_t bytes_per_row = w * sizeof(uint32_t);
+        const size_t pixels = w * h;
+        AlignedVector<uint32_t> image = make_noise_image(size);
+        AlignedVector<uint32_t> reference(pixels);
+        Noise noise(2);
+        for (uint32_t& pixel : reference){
+            pixel = noise.next() | 0xff000000;
+        }
+
+        PixelSums sums;
+        runner.run(FAMILY, "pixel_sum_sqr", size.str(), pixels * 8, [&](size_t){
+            sums = PixelSums();
+            pixel_sum_sqr(
+                sums, w, h,
+                image.data(), bytes_per_row,
+                image.data(), bytes_per_row
+            );
+            sink = sums.count;
+        });
+        runner.check(FAMILY, "pixel_sum_sqr", size.str(), {
+            (double)sums.count,
+            (double)sums.sumR, (double)sums.sumG, (double)sums.sumB,
+            (double)sums.sqrR, (double)sums.sqrG, (double)sums.sqrB,
+        });
+
+        uint64_t count = 0;
+        uint64_t sumsqrs = 0;
+        runner.run(FAMILY, "sum_sqr_deviation", size.str(), pixels * 8, [&](size_t){
+            count = 0;
+            sumsqrs = 0;
+            sum_sqr_deviation(
+                count, sumsqrs, w, h,
+                reference.data(), bytes_per_row,
+                image.data(), bytes_per_row
+            );
+            sink = sumsqrs;
+        });
+        runner.check(FAMILY, "sum_sqr_deviation", size.str(), {(double)count, (double)sumsqrs});
+
+        runner.run(FAMILY, "sum_sqr_deviation_masked", size.str(), pixels * 8, [&](size_t){
+            count = 0;
+            sumsqrs = 0;
+            sum_sqr_deviation_masked(
+                count, sumsqrs, w, h,
+                reference.data(), bytes_per_row,
+                image.data(), bytes_per_row
+            );
+            sink = sumsqrs;
+        });
+        runner.check(FAMILY, "sum_sqr_deviation_masked", size.str(), {(double)count, (double)sumsqrs});
+
+        PixelMoments moments;
+        runner.run(FAMILY, "pixel_moments", size.str(), pixels * 8, [&](size_t){
+            moments = PixelMoments();
+            pixel_moments(
+                moments, w, h,
+                reference.data(), bytes_per_row,
+                image.data(), bytes_per_row
+            );
+            sink = moments.dotR;
+        });
+        runner.check(FAMILY, "pixel_moments", size.str(), {hash_bytes(&moments, sizeof(moments))});
+
+        std::vector<PixelBlockSums> blocks((w / PIXEL_BLOCK_SIZE) * (h / PIXEL_BLOCK_SIZE));
+        runner.run(FAMILY, "pixel_block_sums", size.str(), pixels * 4, [&](size_t){
+            pixel_block_sums(blocks.data(), w, h, image.data(), bytes_per_row);
+            sink = blocks.empty() ? 0 : blocks[0].sqrR;
+        });
+        runner.check(FAMILY, "pixel_block_sums", size.str(), {hash_bytes(blocks.data(), blocks.size() * sizeof(PixelBlockSums))});
+    }
+}
+void benchmark_BinaryImageFilters(BenchmarkRunner& runner){
+    const char* FAMILY = "BinaryImageFilters";
+    for (const ImageSize& size : IMAGE_SIZES){
+        const size_t bytes_per_row = size.width * sizeof(uint32_t);
+        const size_t pixels = size.width * size.height;
+        AlignedVector<uint32_t> image = make_noise_image(size);
+        std::unique_ptr<PackedBinaryMatrix_IB> matrix = make_PackedBinaryMatrix(get_BinaryMatrixType(), size.width, size.height);
+
+        runner.run(FAMILY, "compress_rgb32_to_binary_range", size.str(), pixels * 4 + pixels / 8, [&](size_t){
+            compress_rgb32_to_binary_range(
+                image.data(), bytes_per_row, *matrix,
+                0xff404040, 0xffc0c0c0
+            );
+        });
+        runner.check(FAMILY, "compress_rgb32_to_binary_range", size.str(), {hash_matrix(*matrix)});
+
+        runner.run(FAMILY, "compress_rgb32_to_binary_euclidean", size.str(), pixels * 4 + pixels / 8, [&](size_t){
+            compress_rgb32_to_binary_euclidean(
+                image.data(), bytes_per_row, *matrix,
+                0xff808080, 100
+            );
+        });
+        runner.check(FAMILY, "compress_rgb32_to_binary_euclidean", size.str(), {count_ones(*matrix)}, ROUNDING_TOLERANCE);
+
+        //  The filter overwrites the image. So each call gets its own copy
+        //  which is made outside the timed region.
+        std::vector<AlignedVector<uint32_t>> copies;
+        auto prepare = [&](size_t batch){
+            copies.resize(batch);
+            for (AlignedVector<uint32_t>& copy : copies){
+                copy = image;
+            }
+        };
+        runner.run(FAMILY, "filter_by_mask", size.str(), pixels * 8 + pixels / 8, prepare, [&](size_t index){
+            filter_by_mask(
+                *matrix, copies[index].data(), bytes_per_row,
+                0xff000000, true
+            );
+        });
+        runner.check(FAMILY, "filter_by_mask", size.str(), pixel_digest(copies.back().data(), pixels), ROUNDING_TOLERANCE);
+    }
+}
+void benchmark_BinaryMatrix(BenchmarkRunner& runner){
+    const char* FAMILY = "BinaryMatrix";
+    for (const ImageSize& size : IMAGE_SIZES){
+        const size_t bytes = size.width * size.height / 8;
+        std::unique_ptr<PackedBinaryMatrix_IB> x = make_PackedBinaryMatrix(get_BinaryMatrixType(), size.width, size.height);
+        std::unique_ptr<PackedBinaryMatrix_IB> y = make_PackedBinaryMatrix(get_BinaryMatrixType(), size.width, size.height);
+        y->set_ones();
+
+        runner.run(FAMILY, "set_ones", size.str(), bytes, [&](size_t){
+            x->set_ones();
+        });
+        runner.run(FAMILY, "invert", size.str(), bytes * 2, [&](size_t){
+            x->invert();
+        });
+        runner.run(FAMILY, "xor", size.str(), bytes * 3, [&](size_t){
+            *x ^= *y;
+        });
+        runner.run(FAMILY, "submatrix", size.str(), bytes / 2, [&](size_t){
+            sink = x->submatrix(size.width / 4, size.height / 4, size.width / 2, size.height / 2)->width();
+        });
+
+        //  What "x" holds now depends on how many calls were timed. So check
+        //  one call of each on a known matrix instead.
+        std::unique_ptr<PackedBinaryMatrix_IB> known = make_noise_matrix(size);
+        x = known->clone();
+        x->invert();
+        runner.check(FAMILY, "invert", size.str(), {hash_matrix(*x)});
+        *x ^= *y;
+        runner.check(FAMILY, "xor", size.str(), {hash_matrix(*x)});
+        runner.check(FAMILY, "submatrix", size.str(), {
+            hash_matrix(*known->submatrix(size.width / 4, size.height / 4, size.width / 2, size.height / 2))
+        });
+        x->set_ones();
+        runner.check(FAMILY, "set_ones", size.str(), {hash_matrix(*x)});
+    }
+}
+void benchmark_Waterfill(BenchmarkRunner& runner){
+    const char* FAMILY = "Waterfill";
+    for (const ImageSize& size : IMAGE_SIZES){
+        //  About half the bits set. The worst case for waterfill is lots of
+        //  small objects that touch each other.
+        std::unique_ptr<PackedBinaryMatrix_IB> source = make_noise_matrix(size);
+
+        //  Waterfill destroys its input. So each call gets its own copy which
+        //  is made outside the timed region.
+        std::vector<std::unique_ptr<PackedBinaryMatrix_IB>> copies;
+        auto prepare = [&](size_t batch){
+            copies.resize(batch);
+            for (std::unique_ptr<PackedBinaryMatrix_IB>& copy : copies){
+                copy = source->clone();
+            }
+        };
+
+        std::vector<Waterfill::WaterfillObject> objects;
+        runner.run(FAMILY, "find_objects_inplace", size.str(), size.width * size.height / 8, prepare, [&](size_t index){
+            objects = Waterfill::find_objects_inplace(*copies[index], 1);
+            sink = objects.size();
+        });
+
+        //  The order of the objects depends on the tile shape. So only check
+        //  totals.
+        std::vector<double> totals(6);
+        totals[0] = (double)objects.size();
+        for (const Waterfill::WaterfillObject& object : objects){
+            totals[1] += (double)object.area;
+            totals[2] += (double)object.sum_x;
+            totals[3] += (double)object.sum_y;
+            totals[4] += (double)(object.min_x + object.max_x);
+            totals[5] += (double)(object.min_y + object.max_y);
+        }
+        runner.check(FAMILY, "find_objects_inplace", size.str(), std::move(totals));
+    }
+}
+void benchmark_ScaleInvariantMatrixMatch(BenchmarkRunner& runner){
+    const char* FAMILY = "ScaleInvariantMatrixMatch";
+    for (const ImageSize& size : SPECTROGRAM_SIZES){
+        const size_t w = size.width;
+        const size_t h = size.height;
+
+        //  Keep every row aligned the same way as the program does.
+        const size_t stride = (w + 15) / 16 * 16;
+        AlignedVector<float> A = make_noise_floats(stride * h);
+        AlignedVector<float> T = make_noise_floats(stride * h);
+        AlignedVector<float> W = make_noise_floats(stride * h);
+        std::vector<const float*> rowsA, rowsT, rowsW;
+        for (size_t r = 0; r < h; r++){
+            rowsA.emplace_back(A.data() + r * stride);
+            rowsT.emplace_back(T.data() + r * stride);
+            rowsW.emplace_back(W.data() + r * stride);
+        }
+        const size_t bytes = w * h * sizeof(float);
+
+        volatile float result;
+        runner.run(FAMILY, "compute_scale", size.str(), bytes * 2, [&](size_t){
+            result = ScaleInvariantMatrixMatch::compute_scale(w, h, rowsA.data(), rowsT.data());
+        });
+        runner.check(FAMILY, "compute_scale", size.str(), {result}, FLOAT_TOLERANCE);
+
+        runner.run(FAMILY, "compute_scale_weighted", size.str(), bytes * 3, [&](size_t){
+            result = ScaleInvariantMatrixMatch::compute_scale(w, h, rowsA.data(), rowsT.data(), rowsW.data());
+        });
+        runner.check(FAMILY, "compute_scale_weighted", size.str(), {result}, FLOAT_TOLERANCE);
+
+        runner.run(FAMILY, "compute_error", size.str(), bytes * 2, [&](size_t){
+            result = ScaleInvariantMatrixMatch::compute_error(w, h, 1.0f, rowsA.data(), rowsT.data());
+        });
+        runner.check(FAMILY, "compute_error", size.str(), {result}, FLOAT_TOLERANCE);
+
+        runner.run(FAMILY, "compute_error_weighted", size.str(), bytes * 3, [&](size_t){
+            result = ScaleInvariantMatrixMatch::compute_error(w, h, 1.0f, rowsA.data(), rowsT.data(), rowsW.data());
+        });
+        runner.check(FAMILY, "compute_error_weighted", size.str(), {result}, FLOAT_TOLERANCE);
+    }
+}
+void benchmark_SpikeConvolution(BenchmarkRunner& runner){
+    const char* FAMILY = "SpikeConvolution";
+    const size_t KERNEL_LENGTH = 32;
+    AlignedVector<float> kernel = make_noise_floats(KERNEL_LENGTH);
+    for (size_t length : SPIKE_LENGTHS){
+        const size_t out_length = length - KERNEL_LENGTH + 1;
+        AlignedVector<float> in = make_noise_floats(length);
+        AlignedVector<float> out(length);
+
+        runner.run(FAMILY, "compute_spike_kernel", std::to_string(length), (length + out_length) * sizeof(float), [&](size_t){
+            SpikeConvolution::compute_spike_kernel(
+                out.data(), in.data(), length,
+                kernel.data(), KERNEL_LENGTH
+            );
+        });
+        runner.check(FAMILY, "compute_spike_kernel", std::to_string(length), sum_digest(out.data(), out_length), FLOAT_TOLERANCE);
+    }
+}
+void benchmark_AbsFFT(BenchmarkRunner& runner){
+    const char* FAMILY = "AbsFFT";
+    for (int k : FFT_POWERS){
+        const size_t length = (size_t)1 << k;
+        AlignedVector<float> input = make_noise_floats(length);
+        AlignedVector<float> work(length);
+        AlignedVector<float> output(length / 2);
+
+        //  The transform overwrites its input. So it is copied each time as
+        //  FFTStreamer does.
+        runner.run(FAMILY, "fft_abs", std::to_string(length), (length + length / 2) * sizeof(float), [&](size_t){
+            memcpy(work.data(), input.data(), length * sizeof(float));
+            AbsFFT::fft_abs(k, output.data(), work.data());
+        });
+        runner.check(FAMILY, "fft_abs", std::to_string(length), sum_digest(output.data(), length / 2), FLOAT_TOLERANCE);
+    }
+}
+void benchmark_AudioStreamConversion(BenchmarkRunner& runner){
+    using namespace AudioStreamConversion;
+    const char* FAMILY = "AudioStreamConversion";
+    for (size_t length : AUDIO_LENGTHS){
+        const std::string size = std::to_string(length);
+        AlignedVector<float> f = make_noise_floats(length);
+        AlignedVector<uint8_t> u8(length);
+        AlignedVector<int16_t> s16(length);
+        AlignedVector<int32_t> s32(length);
+        convert_audio_float_to_uint8(u8.data(), f.data(), length);
+        convert_audio_float_to_sint16(s16.data(), f.data(), length);
+        convert_audio_float_to_sint32(s32.data(), f.data(), length);
+
+        runner.run(FAMILY, "uint8_to_float", size, length * 5, [&](size_t){
+            convert_audio_uint8_to_float(f.data(), u8.data(), length, 1.0f);
+        });
+        runner.check(FAMILY, "uint8_to_float", size, sum_digest(f.data(), length), FLOAT_TOLERANCE);
+
+        runner.run(FAMILY, "float_to_uint8", size, length * 5, [&](size_t){
+            convert_audio_float_to_uint8(u8.data(), f.data(), length);
+        });
+        runner.check(FAMILY, "float_to_uint8", size, sum_digest(u8.data(), length), ROUNDING_TOLERANCE);
+
+        runner.run(FAMILY, "sint16_to_float", size, length * 6, [&](size_t){
+            convert_audio_sint16_to_float(f.data(), s16.data(), length, 1.0f);
+        });
+        runner.check(FAMILY, "sint16_to_float", size, sum_digest(f.data(), length), FLOAT_TOLERANCE);
+
+        runner.run(FAMILY, "float_to_sint16", size, length * 6, [&](size_t){
+            convert_audio_float_to_sint16(s16.data(), f.data(), length);
+        });
+        runner.check(FAMILY, "float_to_sint16", size, sum_digest(s16.data(), length), ROUNDING_TOLERANCE);
+
+        runner.run(FAMILY, "sint32_to_float", size, length * 8, [&](size_t){
+            convert_audio_sint32_to_float(f.data(), s32.data(), length, 1.0f);
+        });
+        runner.check(FAMILY, "sint32_to_float", size, sum_digest(f.data(), length), FLOAT_TOLERANCE);
+
+        runner.run(FAMILY, "float_to_sint32", size, length * 8, [&](size_t){
+            convert_audio_float_to_sint32(s32.data(), f.data(), length);
+        });
+        runner.check(FAMILY, "float_to_sint32", size, sum_digest(s32.data(), length), ROUNDING_TOLERANCE);
+    }
+}
+
+void benchmark_JsonParse(BenchmarkRunner& runner){
+    const char* FAMILY = "JsonParse";
+    for (const char* resource : JSON_RESOURCES){
+        std::string path = RESOURCE_PATH() + resource;
+        std::string text;
+        try{
+            text = file_to_string(path);
+        }catch (const FileException&){
+            cerr << "Skipping missing resource: " << path << endl;
+            continue;
+        }
+
+        //  The fast parser must give the same tree as the nlohmann path it
+        //  replaced. Otherwise its timings don't mean anything.
+        try{
+            std::string expected = from_nlohmann(nlohmann::json::parse(text, nullptr, false)).dump();
+            std::string actual = load_json_file(path).dump();
+            if (actual != expected){
+                runner.fail(std::string(FAMILY) + ": load_json_file() does not match nlohmann for " + resource);
+            }
+        }catch (const Exception& e){
+            runner.fail(std::string(FAMILY) + ": load_json_file() threw on " + resource + ": " + e.message());
+        }
+
+        //  What "load_json_file()" used to do.
+        runner.run(FAMILY, "nlohmann_convert", resource, text.size(), [&](size_t){
+            JsonValue json = from_nlohmann(nlohmann::json::parse(file_to_string(path), nullptr, false));
+            sink = (uint64_t)json.type();
+        });
+        runner.run(FAMILY, "load_json_file", resource, text.size(), [&](size_t){
+            JsonValue json = load_json_file(path);
+            sink = (uint64_t)json.type();
+        });
+        if (parse_json(text).is_object()){
+            runner.run(FAMILY, "lazy_object", resource, text.size(), [&](size_t){
+                JsonLazyObject json(path);
+                sink = json.size();
+            });
+        }
+    }
+}
+
+
+using BenchmarkFunction = void (*)(BenchmarkRunner& runner);
+
+const std::vector<std::pair<std::string, BenchmarkFunction>>& BENCHMARKS(){
+    static const std::vector<std::pair<std::string, BenchmarkFunction>> LIST{
+        {"ImageFilters",                benchmark_ImageFilters},
+        {"ImageScaleBrightness",        benchmark_ImageScaleBrightness},
+        {"ImageStats",                  benchmark_ImageStats},
+        {"BinaryImageFilters",          benchmark_BinaryImageFilters},
+        {"BinaryMatrix",                benchmark_BinaryMatrix},
+        {"Waterfill",                   benchmark_Waterfill},
+        {"ScaleInvariantMatrixMatch",   benchmark_ScaleInvariantMatrixMatch},
+        {"SpikeConvolution",            benchmark_SpikeConvolution},
+        {"AbsFFT",                      benchmark_AbsFFT},
+        {"AudioStreamConversion",       benchmark_AudioStreamConversion},
+        {"JsonParse",                   benchmark_JsonParse},
+    };
+    return LIST;
+}
+
+
+
+//  Combine the results of every round into one per benchmark, in the order
+//  they first ran. Each time is the median over the rounds so that one round
+//  disturbed by something else on the machine doesn't move it.
+std::vector<BenchmarkResult> median_of_rounds(const std::vector<BenchmarkResult>& results){
+    std::vector<std::string> order;
+    std::map<std::string, std::vector<const BenchmarkResult*>> rounds;
+    for (const BenchmarkResult& result : results){
+        std::vector<const BenchmarkResult*>& list = rounds[result.key()];
+        if (list.empty()){
+            order.emplace_back(result.key());
+        }
+        list.emplace_back(&result);
+    }
+
+    auto median = [](std::vector<double> samples){
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    };
+
+    std::vector<BenchmarkResult> ret;
+    for (const std::string& key : order){
+        const std::vector<const BenchmarkResult*>& list = rounds[key];
+        std::vector<double> median_ns, p95_ns, min_ns;
+        for (const BenchmarkResult* result : list){
+            median_ns.emplace_back(result->median_ns);
+            p95_ns.emplace_back(result->p95_ns);
+            min_ns.emplace_back(result->min_ns);
+        }
+        BenchmarkResult result = *list[0];
+        result.median_ns = median(std::move(median_ns));
+        result.p95_ns = median(std::move(p95_ns));
+        result.min_ns = *std::min_element(min_ns.begin(), min_ns.end());
+        ret.emplace_back(std::move(result));
+    }
+    return ret;
+}
+
+
+//  Compare against a previous run. Returns the # of regressions.
+//  Returns SIZE_MAX if the baseline can't be loaded.
+size_t compare_to_baseline(const std::vector<BenchmarkResult>& results, const std::string& path){
+    struct Baseline{
+        double median_ns;
+        double min_ns;
+    };
+    std::map<std::string, Baseline> baseline;
+    try{
+        JsonValue json = load_json_file(path);
+        const JsonArray& array = json.get_object_throw(path).get_array_throw("Results", path);
+        for (const JsonValue& item : array){
+            const JsonObject& obj = item.get_object_throw(path);
+            BenchmarkResult result;
+            result.family = obj.get_string_throw("Family", path);
+            result.kernel = obj.get_string_throw("Kernel", path);
+            result.size = obj.get_string_throw("Size", path);
+            result.level = obj.get_string_throw("Level", path);
+            baseline[result.key()] = Baseline{
+                obj.get_double_throw("MedianNs", path),
+                obj.get_double_throw("MinNs", path),
+            };
+        }
+    }catch (const Exception& e){
+        cerr << "Unable to load baseline: " << e.message() << endl;
+        return SIZE_MAX;
+    }
+
+    cout << endl;
+    cout << "Comparing against baseline: " << path << endl;
+    size_t matched = 0;
+    size_t regressions = 0;
+    for (const BenchmarkResult& result : results){
+        auto iter = baseline.find(result.key());
+        if (iter == baseline.end() || iter->second.median_ns <= 0 || iter->second.min_ns <= 0){
+            continue;
+        }
+        matched++;
+        double ratio = result.median_ns / iter->second.median_ns;
+        bool regressed =
+            ratio > REGRESSION_THRESHOLD &&
+            result.min_ns / iter->second.min_ns > REGRESSION_THRESHOLD;
+        regressions += regressed;
+        cout << std::left << std::setw(72) << result.key()
+             << std::right << std::setw(10) << tostr_fixed(ratio, 3) << "x"
+             << (regressed ? "  <-- REGRESSION" : "") << endl;
+    }
+    cout << "Matched " << matched << " / " << results.size() << " benchmarks. Regressions: " << regressions << endl;
+    return regressions;
+}
+
+
+}
+
+
+
+int run_kernel_benchmarks(){
+    const GlobalSettings& settings = GlobalSettings::instance();
+    const std::vector<std::string>& selected = settings.KERNEL_BENCHMARK_FAMILIES;
+    const size_t repetitions = std::max<size_t>(settings.KERNEL_BENCHMARK_REPETITIONS, 1);
+    const size_t rounds = std::max<size_t>(settings.KERNEL_BENCHMARK_ROUNDS, 1);
+
+    for (const std::string& name : selected){
+        bool found = false;
+        for (const auto& item : BENCHMARKS()){
+            found |= item.first == name;
+        }
+        if (!found){
+            cerr << "Warning: no kernel family named " << name << "." << endl;
+        }
+    }
+
+    cout << "Processor: " << get_processor_name() << " (" << PA_ARCH_STRING << ")" << endl;
+    cout << "Repetitions: " << repetitions << endl;
+    cout << "Rounds: " << rounds << endl;
+
+    //  Whole rounds instead of more repetitions in a row. So anything else
+    //  that slows down the machine for a while only lands in one round.
+    const CPU_Features saved = CPU_CAPABILITY_CURRENT;
+    BenchmarkRunner runner(repetitions);
+    try{
+        for (size_t round = 0; round < rounds; round++){
+            for (const CpuCapabilityOption& level : AVAILABLE_CAPABILITIES()){
+                if (!level.available){
+                    continue;
+                }
+                CPU_CAPABILITY_CURRENT = level.features;
+                runner.set_level(level.slug);
+                cout << endl << "Round " << round + 1 << " / " << rounds << ", Processor Level: " << level.display << endl;
+
+                for (const auto& item : BENCHMARKS()){
+                    if (!selected.empty() && std::find(selected.begin(), selected.end(), item.first) == selected.end()){
+                        continue;
+                    }
+                    item.second(runner);
+                }
+            }
+        }
+    }catch (...){
+        CPU_CAPABILITY_CURRENT = saved;
+        throw;
+    }
+    CPU_CAPABILITY_CURRENT = saved;
+
+    std::vector<BenchmarkResult> results = median_of_rounds(runner.results());
+
+    JsonArray array;
+    for (const BenchmarkResult& result : results){
+        array.push_back(result.to_json());
+    }
+    JsonObject root;
+    root["Version"] = PROGRAM_VERSION;
+    root["Timestamp"] = now_to_filestring();
+    root["Processor"] = get_processor_name();
+    root["Arch"] = PA_ARCH_STRING;
+    root["Repetitions"] = repetitions;
+    root["Rounds"] = rounds;
+    root["Results"] = std::move(array);
+
+    const std::string& output = settings.KERNEL_BENCHMARK_OUTPUT;
+    try{
+        JsonValue(std::move(root)).dump(output);
+        cout << endl << "Wrote " << results.size() << " results to " << output << endl;
+    }catch (const Exception& e){
+        cerr << "Unable to write results: " << e.message() << endl;
+        return 1;
+    }
+
+    if (runner.failures() != 0){
+        cerr << "Kernels with wrong results: " << runner.failures() << endl;
+        return 1;
+    }
+
+    //  Fail on any regression so a baseline comparison can gate CI.
+    if (!settings.KERNEL_BENCHMARK_BASELINE.empty()){
+        size_t regressions = compare_to_baseline(results, settings.KERNEL_BENCHMARK_BASELINE);
+        if (regressions != 0){
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+
+
+}
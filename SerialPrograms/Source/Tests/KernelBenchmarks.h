@@ -0,0 +1,65 @@
+/*  Kernel Benchmarks
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Microbenchmarks for the SIMD kernel families. Every family is run at
+ *  every processor level the CPU supports (by switching CPU_CAPABILITY_CURRENT
+ *  the same way the "Processor Specific Optimization" setting does) over a
+ *  matrix of input sizes.
+ *
+ *  Each benchmark is warmed up, then timed in batches sized so a batch takes
+ *  about a millisecond. The median, 95th percentile and best time per call are
+ *  reported along with the throughput in GB/s. (bytes read + written per call)
+ *  The whole suite is run "ROUNDS" times and each benchmark keeps its median
+ *  over the rounds.
+ *
+ *  Levels without a dedicated core for a kernel fall back to the next lower
+ *  one, exactly as they do in the program. So two levels with the same times
+ *  share the same core.
+ *
+ *  Enable it in SerialPrograms-Settings.json:
+ *
+ *    "20-GlobalSettings": {
+ *        "KERNEL_BENCHMARKS": {
+ *            "RUN": true,
+ *            "OUTPUT": "KernelBenchmarks.json",
+ *            "BASELINE": "KernelBenchmarks-main.json",
+ *            "FAMILIES": ["ImageFilters", "Waterfill"],
+ *            "REPETITIONS": 25,
+ *            "ROUNDS": 5
+ *        }
+ *    }
+ *
+ *  "FAMILIES" is optional. If empty, every family is run.
+ *  "BASELINE" is optional. If set, it is the output of a previous run (e.g.
+ *  from another commit) and every benchmark is compared against it. The
+ *  program then exits with 1 if anything is more than 25% slower (both the
+ *  median and the fastest sample) or the baseline can't be loaded.
+ *
+ *  The output of every SIMD kernel is checked against the C++ only level.
+ *  (exactly for integer kernels, within a small tolerance for floating-point
+ *  ones) The JSON parser is checked against nlohmann. The program exits with 1
+ *  if any check fails.
+ *
+ *  The program runs the benchmarks, writes the results to "OUTPUT" and exits
+ *  without launching the GUI.
+ *
+ */
+
+#ifndef PokemonAutomation_Tests_KernelBenchmarks_H
+#define PokemonAutomation_Tests_KernelBenchmarks_H
+
+
+namespace PokemonAutomation{
+
+
+// Called by main() to run the kernel benchmarks without launching any GUI.
+// This function is only called when GlobalSettings::KERNEL_BENCHMARK_MODE is true.
+// Return 0 if the benchmarks ran, every check passed and nothing regressed
+// against the baseline.
+int run_kernel_benchmarks();
+
+
+
+}
+#endif
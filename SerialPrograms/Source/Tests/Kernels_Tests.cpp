@@ -29,9 +29,17 @@
 #include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Core_64xH_Default.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Routines.h"
+#include "Kernels/ImageFilters/Kernels_ImageFilter_RgbToHsv.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelBlockSums.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelMoments.h"
+#include "Kernels/PlaneFilters/Kernels_PlaneFilters.h"
 #include "Kernels_Tests.h"
 #include "TestUtils.h"
 
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <algorithm>
 #include <functional>
 #include <iostream>
 using std::cout;
@@ -48,6 +56,67 @@ namespace Kernels{}
 namespace {
 
 
+//  Run "run()" at every processor level this machine supports and compare the
+//  result of each against the first level, which is always the C++ only
+//  (Default) implementation. Returns the # of levels that don't match.
+template <typename RunFunction, typename SameFunction>
+int test_kernel_all_levels(const std::string& name, RunFunction&& run, SameFunction&& same){
+    const std::vector<CpuCapabilityOption>& levels = AVAILABLE_CAPABILITIES();
+    const CPU_Features saved = CPU_CAPABILITY_CURRENT;
+
+    int errors = 0;
+    try{
+        CPU_CAPABILITY_CURRENT = levels[0].features;
+        const auto reference = run();
+
+        for (size_t c = 1; c < levels.size(); c++){
+            if (!levels[c].available){
+                continue;
+            }
+            CPU_CAPABILITY_CURRENT = levels[c].features;
+            if (same(reference, run())){
+                cout << name << ": " << levels[c].display << " matches the C++ implementation." << endl;
+            }else{
+                cout << "Error: " << name << ": " << levels[c].display << " does not match the C++ implementation." << endl;
+                errors++;
+            }
+        }
+    }catch (...){
+        CPU_CAPABILITY_CURRENT = saved;
+        throw;
+    }
+    CPU_CAPABILITY_CURRENT = saved;
+    return errors;
+}
+
+//  For kernels that are allowed to round differently. (e.g. FMA contraction)
+bool same_floats(const std::vector<float>& x, const std::vector<float>& y){
+    if (x.size() != y.size()){
+        return false;
+    }
+    for (size_t c = 0; c < x.size(); c++){
+        if (std::abs(x[c] - y[c]) > 1e-4f * std::max(1.f, std::abs(x[c]))){
+            cout << "Mismatch at " << c << ": " << x[c] << " vs " << y[c] << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+//  For kernels that must be bit-identical.
+bool same_pixels(const std::vector<uint32_t>& x, const std::vector<uint32_t>& y){
+    if (x.size() != y.size()){
+        return false;
+    }
+    for (size_t c = 0; c < x.size(); c++){
+        if (x[c] != y[c]){
+            cout << "Mismatch at " << c << ": " << std::hex << x[c] << " vs " << y[c] << std::dec << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
 
 }
 
@@ -980,4 +1049,334 @@ int test_binary_matrix_tile(){
     return 0;
 }
 
+
+
+int test_kernels_PlaneFilters(const ImageViewRGB32& image){
+    const size_t width = image.width();
+    const size_t height = image.height();
+    cout << "Testing PlaneFilters, image size " << width << " x " << height << endl;
+    if (width < 8 || height < 5){
+        cout << "Error: image is too small. Need at least 8 x 5." << endl;
+        return 1;
+    }
+
+    //  One float plane with fractional values from two channels.
+    std::vector<float> plane(width * height);
+    for (size_t y = 0; y < height; y++){
+        for (size_t x = 0; x < width; x++){
+            const Color color(image.pixel(x, y));
+            plane[y * width + x] = color.green() + color.red() / 256.f;
+        }
+    }
+    const float* rows[5];
+    for (size_t c = 0; c < 5; c++){
+        rows[c] = plane.data() + c * width;
+    }
+    const float kernel[5] = {0.0625f, 0.25f, 0.375f, 0.25f, 0.0625f};
+
+    //  Every length up to a few vectors of the widest ISA, so every tail
+    //  length is covered. Then the whole row. Start one element in so the
+    //  loads are unaligned.
+    std::vector<size_t> lengths;
+    for (size_t length = 1; length <= 67 && length + 5 <= width; length++){
+        lengths.emplace_back(length);
+    }
+    lengths.emplace_back(width - 5);
+
+    using namespace Kernels::PlaneFilters;
+    auto run = [&]{
+        std::vector<float> ret;
+        for (size_t length : lengths){
+            std::vector<float> out0(length), out1(length);
+
+            filter_5tap_horizontal(out0.data(), rows[0] + 1, length, kernel);
+            ret.insert(ret.end(), out0.begin(), out0.end());
+
+            const float* shifted[5] = {rows[0] + 1, rows[1] + 1, rows[2] + 1, rows[3] + 1, rows[4] + 1};
+            filter_5tap_vertical(out0.data(), shifted, length, kernel);
+            ret.insert(ret.end(), out0.begin(), out0.end());
+
+            sobel_3x3(out0.data(), out1.data(), rows[0] + 1, rows[1] + 1, rows[2] + 1, length);
+            ret.insert(ret.end(), out0.begin(), out0.end());
+            ret.insert(ret.end(), out1.begin(), out1.end());
+
+            min_3x3(out0.data(), rows[0] + 1, rows[1] + 1, rows[2] + 1, length);
+            ret.insert(ret.end(), out0.begin(), out0.end());
+        }
+        return ret;
+    };
+
+    return test_kernel_all_levels("PlaneFilters", run, same_floats);
+}
+
+
+
+//  The original scalar floating-point conversion that the kernels replace.
+static uint32_t rgb32_to_hsv32_reference(uint32_t p){
+    int r = (uint32_t(0xff) & (p >> 16));
+    int g = (uint32_t(0xff) & (p >> 8));
+    int b = (uint32_t(0xff) & p);
+
+    int M = std::max(std::max(r, g), b);
+    int m = std::min(std::min(r, g), b);
+    int delta = M - m;
+
+    int S = 0;
+    if (M > 0){
+        S = std::min(std::max(255 - (m*255 + M/2)/M, 0), 255);
+    }
+
+    double Hf = 0;
+    if (delta > 0){
+        if (M == r){
+            Hf = std::fmod((g - b)/(double)delta, 6.0);
+        }else if (M == g){
+            Hf = (b - r)/(double)delta + 2.0;
+        }else{
+            Hf = (r - g)/(double)delta + 4.0;
+        }
+    }
+    int H = std::max(int(Hf * 256.0 / 6.0 + 0.5) % 256, 0);
+
+    return (p & 0xff000000) |
+           ((uint32_t)(uint8_t)H << 16) |
+           ((uint32_t)(uint8_t)S << 8) |
+           (uint8_t)M;
+}
+
+int test_kernels_RgbToHsv(const ImageViewRGB32& image){
+    cout << "Testing RgbToHsv, image size " << image.width() << " x " << image.height() << endl;
+
+    int errors = 0;
+    auto check = [&](const std::string& name, const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height){
+        std::vector<uint32_t> expected;
+        expected.reserve(width * height);
+        for (size_t y = 0; y < height; y++){
+            const uint32_t* row = (const uint32_t*)((const char*)in + y * in_bytes_per_row);
+            for (size_t x = 0; x < width; x++){
+                expected.emplace_back(rgb32_to_hsv32_reference(row[x]));
+            }
+        }
+        auto run = [&]{
+            std::vector<uint32_t> out(width * height);
+            Kernels::convert_rgb32_to_hsv32(in, in_bytes_per_row, width, height, out.data(), width * sizeof(uint32_t));
+            return out;
+        };
+
+        //  The C++ kernel against the original conversion, then every SIMD
+        //  kernel against the C++ kernel.
+        if (same_pixels(expected, run())){
+            cout << name << ": C++ implementation matches the scalar conversion." << endl;
+        }else{
+            cout << "Error: " << name << ": C++ implementation does not match the scalar conversion." << endl;
+            errors++;
+        }
+        errors += test_kernel_all_levels(name, run, same_pixels);
+    };
+
+    //  Every RGB value with assorted alphas. The odd width leaves a partial
+    //  vector at the end of each row and the padding makes the rows unaligned.
+    {
+        const size_t width = 4111;
+        const size_t height = ((size_t)1 << 24) / width + 1;
+        const size_t stride = width + 3;
+        std::vector<uint32_t> pixels(stride * height);
+        uint32_t rgb = 0;
+        for (size_t y = 0; y < height; y++){
+            for (size_t x = 0; x < width; x++){
+                uint32_t alpha = (rgb * 2654435761u) >> 24;
+                pixels[y * stride + x] = (alpha << 24) | (rgb & 0x00ffffff);
+                rgb++;
+            }
+        }
+        check("RgbToHsv (all colors)", pixels.data(), stride * sizeof(uint32_t), width, height);
+    }
+
+    check("RgbToHsv (image)", image.data(), image.bytes_per_row(), image.width(), image.height());
+
+    return errors;
+}
+
+
+
+int test_kernels_PixelMoments(const ImageViewRGB32& image){
+    const size_t width = image.width();
+    const size_t height = image.height();
+    cout << "Testing PixelMoments, image size " << width << " x " << height << endl;
+    if (width < 2 || height < 1){
+        cout << "Error: image is too small. Need at least 2 x 1." << endl;
+        return 1;
+    }
+
+    //  "ref" is the image with some transparent pixels and some channels
+    //  pushed into the bright bins. "img" is the image shifted by one pixel
+    //  with transparent pixels in other places so that the alphas disagree
+    //  on some pixels.
+    const size_t ref_stride = width + 1;
+    std::vector<uint32_t> ref(ref_stride * height);
+    std::vector<uint32_t> img(width * height);
+    for (size_t y = 0; y < height; y++){
+        for (size_t x = 0; x < width; x++){
+            uint32_t pixel = image.pixel(x, y) | 0xff000000;
+            if ((x + y) % 5 == 0){
+                pixel = (pixel & 0xff00ffff) | (uint32_t)(Kernels::PIXEL_MOMENTS_BRIGHT_START + x % Kernels::PIXEL_MOMENTS_BRIGHT_BINS) << 16;
+            }
+            if ((x * 7 + y * 3) % 11 == 0){
+                pixel &= 0x7fffffff;
+            }
+            ref[y * ref_stride + x] = pixel;
+
+            pixel = image.pixel((x + 1) % width, y) | 0xff000000;
+            if ((x + y) % 13 == 0){
+                pixel &= 0x7fffffff;
+            }
+            img[y * width + x] = pixel;
+        }
+    }
+
+    //  Every width up to a few vectors so every tail length is covered,
+    //  then the whole image.
+    std::vector<size_t> widths;
+    for (size_t w = 1; w <= 35 && w < width; w++){
+        widths.emplace_back(w);
+    }
+    widths.emplace_back(width);
+
+    auto run = [&]{
+        std::vector<Kernels::PixelMoments> ret;
+        for (size_t w : widths){
+            ret.emplace_back();
+            Kernels::pixel_moments(
+                ret.back(), w, height,
+                ref.data(), ref_stride * sizeof(uint32_t),
+                img.data(), width * sizeof(uint32_t)
+            );
+            ret.emplace_back();
+            Kernels::pixel_moments(
+                ret.back(), w, height,
+                ref.data(), ref_stride * sizeof(uint32_t),
+                img.data(), width * sizeof(uint32_t),
+                0xff204060
+            );
+            ret.emplace_back();
+            Kernels::pixel_moments_masked(
+                ret.back(), w, height,
+                ref.data(), ref_stride * sizeof(uint32_t),
+                img.data(), width * sizeof(uint32_t)
+            );
+        }
+        return ret;
+    };
+    auto same = [](const std::vector<Kernels::PixelMoments>& x, const std::vector<Kernels::PixelMoments>& y){
+        for (size_t c = 0; c < x.size(); c++){
+            if (memcmp(&x[c], &y[c], sizeof(Kernels::PixelMoments)) != 0){
+                cout << "Mismatch at width index " << c / 3 << ", function " << c % 3 << endl;
+                return false;
+            }
+        }
+        return x.size() == y.size();
+    };
+
+    return test_kernel_all_levels("PixelMoments", run, same);
+}
+
+
+
+int test_kernels_PixelBlockSums(const ImageViewRGB32& image){
+    using Kernels::PixelBlockSums;
+    using Kernels::PIXEL_BLOCK_SIZE;
+
+    const size_t width = image.width();
+    const size_t height = image.height();
+    cout << "Testing PixelBlockSums, image size " << width << " x " << height << endl;
+
+    //  The image with some pixels made inactive. The padding makes the rows
+    //  unaligned.
+    const size_t stride = width + 3;
+    std::vector<uint32_t> pixels(stride * height);
+    for (size_t y = 0; y < height; y++){
+        for (size_t x = 0; x < width; x++){
+            uint32_t pixel = image.pixel(x, y);
+            if ((x * 5 + y * 3) % 7 == 0){
+                pixel = (pixel & 0x00ffffff) | 0x7f000000;
+            }
+            pixels[y * stride + x] = pixel;
+        }
+    }
+    const size_t bytes_per_row = stride * sizeof(uint32_t);
+
+    //  Sizes on both sides of the block boundaries, then the whole image.
+    std::vector<std::pair<size_t, size_t>> sizes;
+    for (size_t w : {7, 8, 9, 15, 17, 31, 33, 63, 65, 71}){
+        for (size_t h : {7, 8, 9, 17, 23}){
+            if (w <= width && h <= height){
+                sizes.emplace_back(w, h);
+            }
+        }
+    }
+    sizes.emplace_back(width, height);
+
+    //  Block sums for every size in order, plus a sentinel block after each
+    //  one to catch writes past the end.
+    const uint32_t SENTINEL = 0xdeadbeef;
+    auto run = [&]{
+        std::vector<uint32_t> ret;
+        for (const auto& size : sizes){
+            size_t blocks = (size.first / PIXEL_BLOCK_SIZE) * (size.second / PIXEL_BLOCK_SIZE);
+            std::vector<PixelBlockSums> out(blocks + 1);
+            memset(out.data(), 0xef, out.size() * sizeof(PixelBlockSums));
+            out.back().count = SENTINEL;
+            Kernels::pixel_block_sums(out.data(), size.first, size.second, pixels.data(), bytes_per_row);
+            for (const PixelBlockSums& block : out){
+                ret.insert(ret.end(), {
+                    block.count, block.sumR, block.sumG, block.sumB,
+                    block.sqrR, block.sqrG, block.sqrB,
+                });
+            }
+        }
+        return ret;
+    };
+
+    //  Straightforward per-pixel sums.
+    std::vector<uint32_t> expected;
+    for (const auto& size : sizes){
+        for (size_t by = 0; by < size.second / PIXEL_BLOCK_SIZE; by++){
+            for (size_t bx = 0; bx < size.first / PIXEL_BLOCK_SIZE; bx++){
+                uint32_t sums[7] = {};
+                for (size_t y = by * PIXEL_BLOCK_SIZE; y < (by + 1) * PIXEL_BLOCK_SIZE; y++){
+                    for (size_t x = bx * PIXEL_BLOCK_SIZE; x < (bx + 1) * PIXEL_BLOCK_SIZE; x++){
+                        uint32_t pixel = pixels[y * stride + x];
+                        if ((pixel >> 24) < 128){
+                            continue;
+                        }
+                        uint32_t r = (pixel >> 16) & 0xff;
+                        uint32_t g = (pixel >> 8) & 0xff;
+                        uint32_t b = pixel & 0xff;
+                        sums[0]++;
+                        sums[1] += r;
+                        sums[2] += g;
+                        sums[3] += b;
+                        sums[4] += r * r;
+                        sums[5] += g * g;
+                        sums[6] += b * b;
+                    }
+                }
+                expected.insert(expected.end(), sums, sums + 7);
+            }
+        }
+        //  Only the count of the sentinel block is known.
+        expected.insert(expected.end(), {SENTINEL, 0xefefefef, 0xefefefef, 0xefefefef, 0xefefefef, 0xefefefef, 0xefefefef});
+    }
+
+    int errors = 0;
+    if (same_pixels(expected, run())){
+        cout << "PixelBlockSums: C++ implementation matches the per-pixel sums." << endl;
+    }else{
+        cout << "Error: PixelBlockSums: C++ implementation does not match the per-pixel sums." << endl;
+        errors++;
+    }
+    errors += test_kernel_all_levels("PixelBlockSums", run, same_pixels);
+    return errors;
+}
+
 }
@@ -31,6 +31,14 @@ int test_kernels_CompressRGB32ToBinaryEuclidean(const ImageViewRGB32& image);
 
 int test_kernels_Waterfill(const ImageViewRGB32& image);
 
+int test_kernels_PlaneFilters(const ImageViewRGB32& image);
+
+int test_kernels_RgbToHsv(const ImageViewRGB32& image);
+
+int test_kernels_PixelMoments(const ImageViewRGB32& image);
+
+int test_kernels_PixelBlockSums(const ImageViewRGB32& image);
+
 
 }
 
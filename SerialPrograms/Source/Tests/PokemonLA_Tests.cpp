@@ -502,6 +502,14 @@ int test_pokemonLA_shinySoundDetector(const std::vector<AudioSpectrum>& spectrum
     return 0;
 }
 
+std::vector<std::unique_ptr<AudioInferenceCallback>> make_pokemonLA_ShinySoundCallbacks(ConsoleHandle& console){
+    return make_callback_set<AudioInferenceCallback>(
+        std::make_unique<ShinySoundDetector>(console, [](float error_coefficient) -> bool{
+            return true;
+        })
+    );
+}
+
 // Load an image with MMO question marks from an MMO event, with filename <XXX.png>
 // Load an image with MMO question marks revealed by Munchlax to show each pokemon sprite from the same MMO event, with filename <_XXX.png>
 // Load a text file with each line the pokemon in the MMO event, with filename <_XXX.txt>. If more than one pokemon of the same species appears,
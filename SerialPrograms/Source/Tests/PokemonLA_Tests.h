@@ -11,12 +11,15 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 
 #include "CommonFramework/AudioPipeline/AudioFeed.h"
 
 namespace PokemonAutomation{
 
 class ImageViewRGB32;
+class ConsoleHandle;
+class AudioInferenceCallback;
 
 
 int test_pokemonLA_BattleMenuDetector(const ImageViewRGB32& image, bool target);
@@ -55,6 +58,8 @@ int test_pokemonLA_BerryTreeDetector(const ImageViewRGB32& image);
 
 int test_pokemonLA_shinySoundDetector(const std::vector<AudioSpectrum>& spectrums, bool target);
 
+std::vector<std::unique_ptr<AudioInferenceCallback>> make_pokemonLA_ShinySoundCallbacks(ConsoleHandle& console);
+
 int test_pokemonLA_MMOSpriteMatcher(const std::string& filepath);
 
 int test_pokemonLA_MapWeatherAndTimeReader(const ImageViewRGB32& image, const std::vector<std::string>& keywords);
@@ -543,4 +543,13 @@ int test_pokemonSV_RecentlyBattledDetector(const ImageViewRGB32& image, bool tar
     return 0;
 }
 
+std::vector<std::unique_ptr<VisualInferenceCallback>> make_pokemonSV_BattleCallbacks(){
+    return make_callback_set<VisualInferenceCallback>(
+        std::make_unique<NormalBattleMenuWatcher>(COLOR_RED),
+        std::make_unique<MoveSelectWatcher>(COLOR_YELLOW),
+        std::make_unique<OverworldWatcher>(COLOR_CYAN),
+        std::make_unique<AdvanceDialogWatcher>(COLOR_GREEN)
+    );
+}
+
 }
@@ -11,10 +11,12 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 
 namespace PokemonAutomation{
 
 class ImageViewRGB32;
+class VisualInferenceCallback;
 
 int test_pokemonSV_MapDetector(const ImageViewRGB32& image, const std::vector<std::string>& words);
 
@@ -64,6 +66,8 @@ int test_pokemonSV_SandwichPlateDetector(const ImageViewRGB32& image, const std:
 
 int test_pokemonSV_RecentlyBattledDetector(const ImageViewRGB32& image, bool target);
 
+std::vector<std::unique_ptr<VisualInferenceCallback>> make_pokemonSV_BattleCallbacks();
+
 }
 
 #endif
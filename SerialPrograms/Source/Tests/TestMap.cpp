@@ -15,8 +15,17 @@
 #include "TestMap.h"
 #include "TestUtils.h"
 #include "CommonFramework/AudioPipeline/AudioTemplate.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/AudioPipeline/AudioReplayFeed.h"
+#include "CommonFramework/InferenceInfra/AudioInferenceCallback.h"
+#include "CommonFramework/InferenceInfra/AudioInferenceReplay.h"
+#include "CommonFramework/InferenceInfra/VisualInferenceCallback.h"
+#include "CommonFramework/InferenceInfra/VisualInferenceReplay.h"
+#include "CommonFramework/VideoPipeline/VideoReplayFeed.h"
 
 #include <QFileInfo>
+#include <QDir>
+#include <QFile>
 
 #include <iostream>
 #include <algorithm>
@@ -48,6 +57,10 @@ using ImageVoidDetectorFunction = std::function<int(const ImageViewRGB32& image)
 
 using SoundBoolDetectorFunction = std::function<int(const std::vector<AudioSpectrum>& spectrums, bool target)>;
 
+using VisualCallbackSetFunction = std::function<std::vector<std::unique_ptr<VisualInferenceCallback>>()>;
+
+using AudioCallbackSetFunction = std::function<std::vector<std::unique_ptr<AudioInferenceCallback>>(ConsoleHandle& console)>;
+
 // Basic check on whether an image can be loaded.
 // Also strip the image format suffix (.png and so on)
 
@@ -216,6 +229,90 @@ int sound_bool_detector_helper(SoundBoolDetectorFunction test_func, const std::s
 }
 
 
+// Shared part of the replay helpers below.
+// run_replay: plays the recording through the callbacks and returns the report.
+// Prints the report. If the filename ends with _True or _False, checks whether any of the
+// callbacks triggered. Otherwise it only reports.
+template <typename CallbackType, typename RunReplay>
+int replay_helper(
+    const QFileInfo& file_info,
+    const std::vector<std::unique_ptr<CallbackType>>& callbacks,
+    RunReplay&& run_replay
+){
+    const std::vector<std::string> words = parse_words(file_info.completeBaseName().toStdString());
+    bool target_bool = false;
+    const bool has_target = words.size() > 0 && parse_bool(words.back(), target_bool);
+
+    std::vector<PeriodicInferenceCallback> periodic_callbacks;
+    for (const std::unique_ptr<CallbackType>& callback : callbacks){
+        periodic_callbacks.emplace_back(*callback);
+    }
+
+    const InferenceReplayReport report = run_replay(periodic_callbacks);
+    cout << report.dump();
+
+    if (has_target){
+        TEST_RESULT_EQUAL(report.triggered(), target_bool);
+    }
+    return 0;
+}
+
+// Helper for replaying a recording through a set of visual inference callbacks.
+// Prints the time spent in each callback and when each of them triggered.
+// The test file is either an MJPEG AVI or a .replay text file whose first line is
+// the path of a folder of frames, relative to the .replay file.
+// If the filename ends with _True or _False, the test checks whether any of the
+// callbacks triggered during the recording. Otherwise it only reports.
+int video_replay_helper(VisualCallbackSetFunction make_callbacks, const std::string& test_path){
+    const QFileInfo file_info(QString::fromStdString(test_path));
+    const QString suffix = file_info.suffix().toLower();
+
+    std::string recording_path;
+    if (suffix == "avi"){
+        recording_path = test_path;
+    }else if (suffix == "replay"){
+        QFile file(file_info.filePath());
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)){
+            cerr << "Error: cannot open replay file " << test_path << endl;
+            return 1;
+        }
+        const QString folder = QString::fromUtf8(file.readLine()).trimmed();
+        recording_path = QDir::cleanPath(file_info.dir().filePath(folder)).toStdString();
+    }else{
+        cout << "Skip " << test_path << " as it is not a recording" << endl;
+        return -1;
+    }
+
+    Logger& logger = global_logger_command_line();
+    VideoReplayFeed feed(logger, recording_path, GlobalSettings::instance().COMMAND_LINE_REPLAY_REAL_TIME);
+
+    return replay_helper(file_info, make_callbacks(), [&](const std::vector<PeriodicInferenceCallback>& callbacks){
+        return run_visual_replay(logger, feed, callbacks);
+    });
+}
+
+int audio_replay_helper(AudioCallbackSetFunction make_callbacks, const std::string& test_path){
+    const QFileInfo file_info(QString::fromStdString(test_path));
+    const QString suffix = file_info.suffix().toLower();
+    if (suffix != "wav" && suffix != "mp3"){
+        cout << "Skip " << test_path << " as it is not an audio file" << endl;
+        return -1;
+    }
+
+    Logger& logger = global_logger_command_line();
+    AudioReplayFeed feed(logger, test_path);
+
+    DummyBotBase botbase(logger);
+    DummyVideoFeed video_feed;
+    DummyVideoOverlay video_overlay;
+    ConsoleHandle console(0, logger, &botbase, video_feed, video_overlay, feed);
+
+    return replay_helper(file_info, make_callbacks(console), [&](const std::vector<PeriodicInferenceCallback>& callbacks){
+        return run_audio_replay(logger, feed, callbacks, GlobalSettings::instance().COMMAND_LINE_REPLAY_REAL_TIME);
+    });
+}
+
+
 
 
 const std::map<std::string, TestFunction> TEST_MAP = {
@@ -227,7 +324,13 @@ const std::map<std::string, TestFunction> TEST_MAP = {
     {"Kernels_FilterByMask", std::bind(image_void_detector_helper, test_kernels_FilterByMask, _1)},
     {"Kernels_CompressRGB32ToBinaryEuclidean", std::bind(image_void_detector_helper, test_kernels_CompressRGB32ToBinaryEuclidean, _1)},
     {"Kernels_Waterfill", std::bind(image_void_detector_helper, test_kernels_Waterfill, _1)},
+    {"Kernels_PlaneFilters", std::bind(image_void_detector_helper, test_kernels_PlaneFilters, _1)},
+    {"Kernels_RgbToHsv", std::bind(image_void_detector_helper, test_kernels_RgbToHsv, _1)},
+    {"Kernels_PixelMoments", std::bind(image_void_detector_helper, test_kernels_PixelMoments, _1)},
+    {"Kernels_PixelBlockSums", std::bind(image_void_detector_helper, test_kernels_PixelBlockSums, _1)},
     {"CommonFramework_BlackBorderDetector", std::bind(image_bool_detector_helper, test_CommonFramework_BlackBorderDetector, _1)},
+    {"CommonFramework_WaterfillCoarseToFine", std::bind(image_void_detector_helper, test_CommonFramework_WaterfillCoarseToFine, _1)},
+    {"CommonFramework_ScreenTransitionReplay", std::bind(video_replay_helper, make_CommonFramework_ScreenTransitionCallbacks, _1)},
     {"NintendoSwitch_UpdateMenuDetector", std::bind(image_bool_detector_helper, test_NintendoSwitch_UpdateMenuDetector, _1)},
     {"PokemonSwSh_YCommMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_YCommMenuDetector, _1)},
     {"PokemonSwSh_MaxLair_BattleMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_MaxLair_BattleMenuDetector, _1)},
@@ -258,6 +361,7 @@ const std::map<std::string, TestFunction> TEST_MAP = {
     {"PokemonLA_BattleSpriteArrowDetector", std::bind(image_int_detector_helper, test_pokemonLA_BattleSpriteArrowDetector, _1)},
     {"PokemonLA_MapMissionTabReader", std::bind(image_bool_detector_helper, test_pokemonLA_MapMissionTabReader, _1)},
     {"PokemonLA_ShinySoundDetector", std::bind(sound_bool_detector_helper, test_pokemonLA_shinySoundDetector, _1)},
+    {"PokemonLA_ShinySoundReplay", std::bind(audio_replay_helper, make_pokemonLA_ShinySoundCallbacks, _1)},
     {"PokemonLA_MMOSpriteMatcher", test_pokemonLA_MMOSpriteMatcher},
     {"PokemonLA_MapWeatherAndTimeReader", std::bind(image_words_detector_helper, test_pokemonLA_MapWeatherAndTimeReader, _1)},
     {"PokemonLA_FlagTrackerPerformance", std::bind(image_int_detector_helper, test_pokemonLA_FlagTracker_performance, _1)},
@@ -284,7 +388,8 @@ const std::map<std::string, TestFunction> TEST_MAP = {
     {"PokemonSV_ESPPressedEmotionDetector", std::bind(image_bool_detector_helper, test_pokemonSV_ESPPressedEmotionDetector, _1)},
     {"PokemonSV_MapFlyMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSV_MapFlyMenuDetector, _1)},
     {"PokemonSV_SandwichPlateDetector", std::bind(image_words_detector_helper, test_pokemonSV_SandwichPlateDetector, _1)},
-    {"PokemonSV_RecentlyBattledDetector", std::bind(image_bool_detector_helper, test_pokemonSV_RecentlyBattledDetector, _1)}
+    {"PokemonSV_RecentlyBattledDetector", std::bind(image_bool_detector_helper, test_pokemonSV_RecentlyBattledDetector, _1)},
+    {"PokemonSV_BattleReplay", std::bind(video_replay_helper, make_pokemonSV_BattleCallbacks, _1)}
 };
 
 TestFunction find_test_function(const std::string& test_space, const std::string& test_name){
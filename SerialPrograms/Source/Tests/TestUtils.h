@@ -22,6 +22,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 
 namespace PokemonAutomation{
 
@@ -50,6 +51,15 @@ bool load_sprite_count(const std::string& filepath, std::map<std::string, int>&
 // Each line is a slug.
 bool load_slug_list(const std::string& filepath, std::vector<std::string>& sprites);
 
+// Collect the callbacks of a replay test into the set that the replay helpers take. e.g.
+//   return make_callback_set<VisualInferenceCallback>(std::make_unique<BlackScreenWatcher>());
+template <typename CallbackType, typename... Callbacks>
+std::vector<std::unique_ptr<CallbackType>> make_callback_set(std::unique_ptr<Callbacks>... callbacks){
+    std::vector<std::unique_ptr<CallbackType>> ret;
+    (ret.emplace_back(std::move(callbacks)), ...);
+    return ret;
+}
+
 
 // Implement the dummy interface of BotBase so that we can run the test code
 // that relies on a BotBase.